@@ -321,6 +321,14 @@ function SearchBox(name, resultsPath, inFrame, label)
     var hasResultsPage;
 
     var idx = indexSectionsWithContent[this.searchIndex].indexOf(idxChar);
+    var shards = (idx!=-1) ? indexSectionShards[this.searchIndex][idx] : undefined;
+    if (shards && searchValue.length>idxChar.length)
+    {
+       // large letters are split on the second character
+       var shardChar = searchValue.substr(idxChar.length, 1).toLowerCase();
+       var shard = shards.indexOf(shardChar);
+       idx = (shard!=-1) ? idx.toString(10)+'_'+shard.toString(10) : -1;
+    }
     if (idx!=-1)
     {
        var hexCode=idx.toString(10);
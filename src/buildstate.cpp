@@ -0,0 +1,323 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QTextStream>
+
+#include <buildstate.h>
+
+#include <config.h>
+#include <doxy_build_info.h>
+#include <message.h>
+
+static const QString s_stateHeader = QString("DoxyPress build state ") + versionString;
+
+// dependencies and pages of the compound written on this thread
+static thread_local BuildState::Capture *s_capture = nullptr;
+
+BuildState *BuildState::instance()
+{
+   static BuildState theInstance;
+   return &theInstance;
+}
+
+BuildState::BuildState()
+   : m_enabled(false), m_changedInputs(0), m_skippedOutputs(0), m_reusedCompounds(0)
+{
+}
+
+void BuildState::capture(Capture *capture)
+{
+   s_capture = capture;
+}
+
+void BuildState::addDependency(const QString &fileName)
+{
+   if (s_capture != nullptr && ! fileName.isEmpty()) {
+      s_capture->inputs.insert(fileName);
+   }
+}
+
+void BuildState::addPage(const QString &fileName)
+{
+   if (s_capture != nullptr) {
+      s_capture->pages.append(fileName);
+   }
+}
+
+void BuildState::load(const QString &outputDir)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_enabled = Config::getBool("incremental-build");
+
+   if (! m_enabled) {
+      return;
+   }
+
+   m_fileName = outputDir + "/doxypress.state";
+   m_stateDir = m_fileName + ".d";
+
+   QDir dir;
+
+   if (! dir.mkpath(m_stateDir + "/records")) {
+      err("Unable to create build state directory %s\n", csPrintable(m_stateDir));
+   }
+
+   QFile f(m_fileName);
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      // first run
+      return;
+   }
+
+   QTextStream t(&f);
+
+   if (t.readLine() != s_stateHeader) {
+      // written by a different version, everything is treated as changed
+      return;
+   }
+
+   while (! t.atEnd()) {
+      QString line = t.readLine();
+
+      // format is: <kind> <hash> <file name>
+      int pos1 = line.indexOf(' ');
+      int pos2 = line.indexOf(' ', pos1 + 1);
+
+      if (pos1 != 1 || pos2 == -1) {
+         continue;
+      }
+
+      QByteArray hashValue = line.mid(pos1 + 1, pos2 - pos1 - 1).toLatin1();
+      QString name = line.mid(pos2 + 1);
+
+      if (line[0] == 'I') {
+         m_oldInputs.insert(name, hashValue);
+
+      } else if (line[0] == 'O') {
+         m_oldOutputs.insert(name, hashValue);
+
+      } else if (line[0] == 'G') {
+         m_oldSharedHash = hashValue;
+
+      }
+   }
+}
+
+void BuildState::save()
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (! m_enabled) {
+      return;
+   }
+
+   QFile f(m_fileName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s, error: %d\n", csPrintable(m_fileName), f.error());
+      return;
+   }
+
+   QTextStream t(&f);
+
+   t << s_stateHeader << "\n";
+
+   if (! m_sharedHash.isEmpty()) {
+      t << "G " << m_sharedHash << " shared\n";
+   }
+
+   for (auto iter = m_inputs.begin(); iter != m_inputs.end(); ++iter) {
+      t << "I " << iter.value() << " " << iter.key() << "\n";
+   }
+
+   for (auto iter = m_outputs.begin(); iter != m_outputs.end(); ++iter) {
+      t << "O " << iter.value() << " " << iter.key() << "\n";
+   }
+
+   // records of compounds which no longer exist
+   QDir dir(m_stateDir + "/records");
+
+   for (const auto &name : dir.entryList(QStringList("*.rec"), QDir::Files)) {
+      if (! m_records.contains(name)) {
+         dir.remove(name);
+      }
+   }
+}
+
+QString BuildState::stateDir() const
+{
+   return m_stateDir;
+}
+
+void BuildState::setSharedHash(const QByteArray &hashValue)
+{
+   QMutexLocker locker(&m_mutex);
+   m_sharedHash = hashValue;
+}
+
+bool BuildState::canReuse() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_enabled && ! m_sharedHash.isEmpty() && m_sharedHash == m_oldSharedHash;
+}
+
+QByteArray BuildState::fileHash(const QString &fileName)
+{
+   {
+      QMutexLocker locker(&m_mutex);
+
+      auto iter = m_inputs.find(fileName);
+
+      if (iter != m_inputs.end()) {
+         return iter.value();
+      }
+
+      iter = m_otherFiles.find(fileName);
+
+      if (iter != m_otherFiles.end()) {
+         return iter.value();
+      }
+   }
+
+   QByteArray retval;
+   QFile f(fileName);
+
+   if (f.open(QIODevice::ReadOnly)) {
+      retval = hash(f.readAll());
+   }
+
+   QMutexLocker locker(&m_mutex);
+   m_otherFiles.insert(fileName, retval);
+
+   return retval;
+}
+
+bool BuildState::keepOutputs(const QStringList &fileNames)
+{
+   QMutexLocker locker(&m_mutex);
+
+   for (const auto &fileName : fileNames) {
+      if (! m_oldOutputs.contains(fileName) || ! QFileInfo(fileName).exists()) {
+         return false;
+      }
+   }
+
+   for (const auto &fileName : fileNames) {
+      m_outputs.insert(fileName, m_oldOutputs.value(fileName));
+   }
+
+   m_skippedOutputs += fileNames.count();
+
+   return true;
+}
+
+QString BuildState::recordFileName(const QString &key)
+{
+   QString name = QString::fromLatin1(hash(key)) + ".rec";
+
+   QMutexLocker locker(&m_mutex);
+   m_records.insert(name);
+
+   return m_stateDir + "/records/" + name;
+}
+
+void BuildState::addReusedCompound()
+{
+   QMutexLocker locker(&m_mutex);
+   ++m_reusedCompounds;
+}
+
+QByteArray BuildState::hash(const QString &contents)
+{
+   return hash(contents.toUtf8());
+}
+
+QByteArray BuildState::hash(const QByteArray &contents)
+{
+   return QCryptographicHash::hash(contents, QCryptographicHash::Md5).toHex();
+}
+
+bool BuildState::updateInput(const QString &fileName, const QByteArray &hashValue)
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (! m_enabled) {
+      return true;
+   }
+
+   m_inputs.insert(fileName, hashValue);
+
+   if (m_oldInputs.value(fileName) == hashValue) {
+      return false;
+   }
+
+   ++m_changedInputs;
+
+   return true;
+}
+
+bool BuildState::updateOutput(const QString &fileName, const QByteArray &contents)
+{
+   if (! m_enabled) {
+      return true;
+   }
+
+   QByteArray hashValue = hash(contents);
+
+   QMutexLocker locker(&m_mutex);
+
+   m_outputs.insert(fileName, hashValue);
+
+   if (m_oldOutputs.value(fileName) != hashValue) {
+      return true;
+   }
+
+   // file may have been removed or modified since the last run
+   QFileInfo fi(fileName);
+
+   if (! fi.exists() || fi.size() != contents.size()) {
+      return true;
+   }
+
+   ++m_skippedOutputs;
+
+   return false;
+}
+
+int BuildState::changedInputs() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_changedInputs;
+}
+
+int BuildState::skippedOutputs() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_skippedOutputs;
+}
+
+int BuildState::reusedCompounds() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_reusedCompounds;
+}
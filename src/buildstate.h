@@ -0,0 +1,132 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef BUILDSTATE_H
+#define BUILDSTATE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/** @brief Content hashes of the input and output files of the previous run.
+ *
+ *  When incremental-build is enabled the state is kept in the output directory.
+ *  Output files whose generated contents did not change are not rewritten, their
+ *  time stamps are kept so tools which synchronize or post process the output
+ *  only see the pages which really changed.
+ *
+ *  The state directory next to the state file holds the Entry cache and a record for each
+ *  compound, which lists the input files used to write its pages. A compound is not written
+ *  again when its inputs and the shared hash, which covers the configuration and the symbols
+ *  of all compounds, are the same as in the previous run. All methods are thread safe.
+ */
+class BuildState
+{
+ public:
+   static BuildState *instance();
+
+   /** Input files and pages collected while a compound is written */
+   struct Capture {
+      QSet<QString> inputs;
+      QStringList   pages;
+   };
+
+   /** Collects the dependencies and pages added on the calling thread in \a capture, nullptr stops */
+   static void capture(Capture *capture);
+
+   /** Records the page being generated on the calling thread uses the contents of \a fileName */
+   static void addDependency(const QString &fileName);
+
+   /** Records \a fileName is written by the calling thread */
+   static void addPage(const QString &fileName);
+
+   /** Reads the state file in \a outputDir, a state written by a different version is ignored */
+   void load(const QString &outputDir);
+
+   /** Writes the hashes of the files seen during this run */
+   void save();
+
+   bool isEnabled() const {
+      return m_enabled;
+   }
+
+   /** Directory for the Entry cache and the compound records, empty when not enabled */
+   QString stateDir() const;
+
+   /** Sets the hash of everything the pages of a compound depend on besides its own input files */
+   void setSharedHash(const QByteArray &hashValue);
+
+   /** Returns true if the shared hash is the same as in the previous run */
+   bool canReuse() const;
+
+   /** Returns the content hash of \a fileName, for input files the hash of the text which was parsed */
+   QByteArray fileHash(const QString &fileName);
+
+   /** Keeps the output files written by the previous run, returns false if one is unknown or was removed */
+   bool keepOutputs(const QStringList &fileNames);
+
+   /** Returns the file name of the record for \a key, the record is not removed by save() */
+   QString recordFileName(const QString &key);
+
+   void addReusedCompound();
+
+   /** Returns the content hash of \a contents */
+   static QByteArray hash(const QString &contents);
+   static QByteArray hash(const QByteArray &contents);
+
+   /** Records the hash of an input file, returns true if it differs from the previous run */
+   bool updateInput(const QString &fileName, const QByteArray &hashValue);
+
+   /** Records the hash of an output file, returns false if the file on disk is up to date */
+   bool updateOutput(const QString &fileName, const QByteArray &contents);
+
+   int changedInputs() const;
+   int skippedOutputs() const;
+   int reusedCompounds() const;
+
+ private:
+   BuildState();
+
+   QString m_fileName;
+   QString m_stateDir;
+   bool m_enabled;
+
+   int m_changedInputs;
+   int m_skippedOutputs;
+   int m_reusedCompounds;
+
+   QByteArray m_oldSharedHash;
+   QByteArray m_sharedHash;
+
+   QHash<QString, QByteArray> m_oldInputs;
+   QHash<QString, QByteArray> m_oldOutputs;
+
+   QHash<QString, QByteArray> m_inputs;
+   QHash<QString, QByteArray> m_outputs;
+
+   // hashes of files read while writing pages which are not input files
+   QHash<QString, QByteArray> m_otherFiles;
+
+   QSet<QString> m_records;
+
+   mutable QMutex m_mutex;
+};
+
+#endif
@@ -1078,13 +1078,13 @@ int yyparse ();
 
 
 /* The lookahead symbol.  */
-int yychar;
+thread_local int yychar;
 
 /* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
+thread_local YYSTYPE yylval;
 
 /* Number of syntax errors so far.  */
-int yynerrs;
+thread_local int yynerrs;
 
 #ifdef YYPARSE_PARAM
 #if (defined __STDC__ || defined __C99__FUNC__ \
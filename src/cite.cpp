@@ -25,6 +25,7 @@
 #include <message.h>
 #include <portable.h>
 #include <resourcemgr.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 const QString CiteConsts::fileName("citelist");
@@ -216,7 +217,7 @@ void CiteDict::generatePage() const
    portable_sysTimerStop();
 
    QString temp = "\"" + bib2xhtmlFile + "\" " + bibOutputFiles + " \"" + citeListFile + "\"";
-   int exitCode = portable_system("perl", temp); 
+   int exitCode = ToolExecutor::instance()->run("bibtex", "perl", temp);
 
    if (exitCode != 0) {
       err("Unable to run BibTeX. Verify the command 'perl --version' works from the command line. Exit code: %d\n", exitCode);
@@ -78,6 +78,11 @@ class CiteDict
     */
    bool isEmpty() const;
 
+   /** returns the number of citations in the database */
+   int count() const {
+      return m_entries.count();
+   }
+
    /** writes the latex code for the standard bibliography
     *  section to text stream \a t
     */
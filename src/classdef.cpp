@@ -22,6 +22,7 @@
 
 #include <classdef.h>
 
+#include <buildstate.h>
 #include <config.h>
 #include <dot.h>
 #include <defargs.h>
@@ -1892,6 +1893,8 @@ void ClassDef::writeDocumentation(OutputList &ol)
 {
    QSharedPointer<ClassDef> self = sharedFrom(this);
 
+   BuildState::addDependency(getDefFileName());
+
    static bool generateTreeView = Config::getBool("generate-treeview");
    // static bool fortranOpt = Config::getBool("optimize-fortran");
 
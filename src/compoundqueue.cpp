@@ -0,0 +1,361 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+
+#include <QDir>
+#include <QMutexLocker>
+
+#include <compoundqueue.h>
+
+#include <code.h>
+#include <config.h>
+#include <definition.h>
+#include <doxy_build_info.h>
+#include <doxy_globals.h>
+#include <filestorage.h>
+#include <marshal.h>
+#include <memberdef.h>
+#include <message.h>
+#include <tooltip.h>
+
+// increase when the layout of the records changes
+static const uint s_recordMagic   = ('D' << 24) + ('X' << 16) + ('C' << 8) + 'R';
+static const uint s_recordVersion = 1;
+
+CompoundQueue::Recording::Recording(SearchIndexIntf *searchIndex)
+   : indexCalls(new IndexRecorder), searchCalls(searchIndex ? searchIndex->kind() : SearchIndexIntf::Internal),
+     m_oldIndexList(Doxy_Globals::indexList), m_oldSearchIndex(Doxy_Globals::searchIndex)
+{
+   m_indexList.addIndex(indexCalls);
+
+   Doxy_Globals::indexList   = &m_indexList;
+   Doxy_Globals::searchIndex = searchIndex ? &searchCalls : nullptr;
+}
+
+CompoundQueue::Recording::~Recording()
+{
+   Doxy_Globals::indexList   = m_oldIndexList;
+   Doxy_Globals::searchIndex = m_oldSearchIndex;
+}
+
+CompoundQueue::CompoundQueue(const QList<QSharedPointer<Definition>> &list, CompoundWriteFunc writeFunc,
+                  int numThreads, OutputListFactory createOutputList)
+   : m_list(list), m_slots(list.count()), m_writeFunc(writeFunc), m_nextIndex(0), m_takenIndex(0),
+     m_stop(false), m_searchIndex(Doxy_Globals::searchIndex)
+{
+   numThreads = qMin(32, numThreads);
+
+   if (numThreads == 0) {
+      numThreads = qMax(2, QThread::idealThreadCount());
+   }
+
+   // pages of large compounds use a lot of memory, do not let the workers run far ahead
+   m_window = 2 * numThreads;
+
+   if (numThreads > 1 && list.count() > 1) {
+
+      for (int i = 0; i < numThreads; i++) {
+         CompoundWorkerThread *thread = new CompoundWorkerThread(this, createOutputList());
+         thread->start();
+
+         if (thread->isRunning()) {
+            m_workers.append(thread);
+         } else {
+            // no more threads available
+            delete thread;
+         }
+      }
+   }
+}
+
+CompoundQueue::~CompoundQueue()
+{
+   {
+      QMutexLocker locker(&m_mutex);
+
+      m_stop = true;
+      m_slotFree.wakeAll();
+   }
+
+   for (auto thread : m_workers) {
+      thread->wait();
+      delete thread;
+   }
+}
+
+CompoundQueue::Result CompoundQueue::take(int index)
+{
+   if (m_workers.isEmpty()) {
+      // recorded like on a worker, apply() adds the calls to the real index
+      Recording recording(m_searchIndex);
+      return process(index, *Doxy_Globals::g_outputList, recording);
+   }
+
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_slots[index].ready) {
+      m_slotReady.wait(&m_mutex);
+   }
+
+   Result retval;
+   qSwap(retval, m_slots[index].result);
+
+   if (index >= m_takenIndex) {
+      m_takenIndex = index + 1;
+      m_slotFree.wakeAll();
+   }
+
+   return retval;
+}
+
+void CompoundQueue::apply(const Result &result)
+{
+   printMessages(result.messages);
+   printWarnings(result.warnings);
+
+   result.indexCalls.replay(Doxy_Globals::indexList);
+
+   if (Doxy_Globals::searchIndex) {
+      result.searchCalls.replay(Doxy_Globals::searchIndex);
+   }
+
+   applyCrossReferences(result.crossReferences);
+}
+
+int CompoundQueue::claim()
+{
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_stop && m_nextIndex < m_list.count() && m_nextIndex >= m_takenIndex + m_window) {
+      // wait for the caller to catch up
+      m_slotFree.wait(&m_mutex);
+   }
+
+   if (m_stop || m_nextIndex >= m_list.count()) {
+      return -1;
+   }
+
+   return m_nextIndex++;
+}
+
+void CompoundQueue::store(int index, const Result &result)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_slots[index].result = result;
+   m_slots[index].ready  = true;
+
+   m_slotReady.wakeAll();
+}
+
+CompoundQueue::Result CompoundQueue::process(int index, OutputList &ol, Recording &recording)
+{
+   Result retval;
+
+   QSharedPointer<Definition> def = m_list.at(index);
+   BuildState *buildState = BuildState::instance();
+
+   QString key;
+   QString recordName;
+
+   // a key shared by several compounds does not identify the record
+   if (buildState->isEnabled() && findDefinitionByKey(definitionKey(def)) == def) {
+      key        = definitionKey(def);
+      recordName = buildState->recordFileName(key);
+
+      if (buildState->canReuse() && loadRecord(recordName, key, retval)) {
+         buildState->addReusedCompound();
+         return retval;
+      }
+   }
+
+   BuildState::Capture capture;
+
+   BuildState::capture(&capture);
+   captureMessages(&retval.messages);
+   captureWarnings(&retval.warnings);
+   captureCrossReferences(&retval.crossReferences);
+
+   m_writeFunc(def, ol);
+
+   BuildState::capture(nullptr);
+   captureMessages(nullptr);
+   captureWarnings(nullptr);
+   captureCrossReferences(nullptr);
+
+   retval.indexCalls = *recording.indexCalls;
+   recording.indexCalls->clear();
+
+   retval.searchCalls = recording.searchCalls;
+   recording.searchCalls.clear();
+
+   if (! recordName.isEmpty()) {
+      saveRecord(recordName, key, retval, capture);
+   }
+
+   return retval;
+}
+
+bool CompoundQueue::loadRecord(const QString &fileName, const QString &key, Result &result)
+{
+   BuildState *buildState = BuildState::instance();
+
+   FileStorage f(fileName);
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      return false;
+   }
+
+   if (unmarshalUInt(&f) != s_recordMagic || unmarshalUInt(&f) != s_recordVersion ||
+         unmarshalQString(&f) != versionString || unmarshalQString(&f) != key) {
+
+      // written by a different version
+      return false;
+   }
+
+   uint count = unmarshalUInt(&f);
+
+   for (uint i = 0; i < count; i++) {
+      QString inputName = unmarshalQString(&f);
+
+      if (unmarshalQByteArray(&f) != buildState->fileHash(inputName)) {
+         // input file changed since the compound was written
+         return false;
+      }
+   }
+
+   QStringList pages;
+   count = unmarshalUInt(&f);
+
+   for (uint i = 0; i < count; i++) {
+      pages.append(unmarshalQString(&f));
+   }
+
+   result.messages = unmarshalQString(&f);
+   result.warnings = unmarshalQString(&f);
+
+   if (! result.indexCalls.unmarshal(&f) || ! result.searchCalls.unmarshal(&f)) {
+      return false;
+   }
+
+   count = unmarshalUInt(&f);
+
+   for (uint i = 0; i < count; i++) {
+      QSharedPointer<MemberDef> src = findDefinitionByKey(unmarshalQString(&f)).dynamicCast<MemberDef>();
+      QSharedPointer<MemberDef> dst = findDefinitionByKey(unmarshalQString(&f)).dynamicCast<MemberDef>();
+
+      if (src == nullptr || dst == nullptr) {
+         return false;
+      }
+
+      result.crossReferences.append(qMakePair(src, dst));
+   }
+
+   if (unmarshalUInt(&f) != s_recordMagic) {
+      // truncated
+      return false;
+   }
+
+   return buildState->keepOutputs(pages);
+}
+
+void CompoundQueue::saveRecord(const QString &fileName, const QString &key, const Result &result,
+                  const BuildState::Capture &capture)
+{
+   BuildState *buildState = BuildState::instance();
+
+   // write to a temporary file and rename, a partial record is never read
+   QString tempName = fileName + ".tmp";
+
+   FileStorage f(tempName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s\n", csPrintable(tempName));
+      return;
+   }
+
+   marshalUInt(&f, s_recordMagic);
+   marshalUInt(&f, s_recordVersion);
+   marshalQString(&f, versionString);
+   marshalQString(&f, key);
+
+   marshalUInt(&f, capture.inputs.count());
+
+   for (const auto &inputName : capture.inputs) {
+      marshalQString(&f, inputName);
+      marshalQByteArray(&f, buildState->fileHash(inputName));
+   }
+
+   marshalUInt(&f, capture.pages.count());
+
+   for (const auto &page : capture.pages) {
+      marshalQString(&f, page);
+   }
+
+   marshalQString(&f, result.messages);
+   marshalQString(&f, result.warnings);
+
+   result.indexCalls.marshal(&f);
+   result.searchCalls.marshal(&f);
+
+   marshalUInt(&f, result.crossReferences.count());
+
+   for (const auto &item : result.crossReferences) {
+      marshalQString(&f, definitionKey(item.first));
+      marshalQString(&f, definitionKey(item.second));
+   }
+
+   marshalUInt(&f, s_recordMagic);
+   f.close();
+
+   QDir dir;
+   dir.remove(fileName);
+
+   if (! dir.rename(tempName, fileName)) {
+      dir.remove(tempName);
+   }
+}
+
+CompoundWorkerThread::CompoundWorkerThread(CompoundQueue *queue, OutputList *outputList)
+   : m_queue(queue), m_outputList(outputList)
+{
+}
+
+CompoundWorkerThread::~CompoundWorkerThread()
+{
+   delete m_outputList;
+}
+
+void CompoundWorkerThread::run()
+{
+   Doxy_Globals::markdownSupport = Config::getBool("markdown");
+
+   {
+      // recorded here and replayed by the caller in the order of the compounds
+      CompoundQueue::Recording recording(m_queue->m_searchIndex);
+
+      int index;
+
+      while ((index = m_queue->claim()) != -1) {
+         m_queue->store(index, m_queue->process(index, *m_outputList, recording));
+      }
+   }
+
+   // code fragments in the documentation use the highlighter of this thread
+   TooltipManager::deleteInstance();
+   codeFreeScanner();
+}
@@ -0,0 +1,156 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+
+#ifndef COMPOUNDQUEUE_H
+#define COMPOUNDQUEUE_H
+
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <buildstate.h>
+#include <index.h>
+#include <outputlist.h>
+#include <searchindex.h>
+#include <util.h>
+
+class CompoundWorkerThread;
+class Definition;
+
+/** Writes the documentation of one compound, the pages of classes, files, namespaces or groups */
+typedef void (*CompoundWriteFunc)(QSharedPointer<Definition> def, OutputList &ol);
+
+/** Writes the documentation pages of compounds on a pool of compound worker threads.
+ *
+ *  Each worker calls the write function with an OutputList of its own, every compound is written
+ *  to separate files. The progress messages, warnings, cross references and the calls to the
+ *  index list and search index are recorded per compound. take() hands out the results strictly
+ *  in the order of the list and the caller applies them with apply(), so the log and the indices
+ *  are the same as for a serial run. Without workers take() writes the compound itself.
+ *
+ *  For an incremental build the result, the input files and the pages of each compound are stored
+ *  in a record in the build state directory. When the inputs did not change the pages of the
+ *  previous run are kept and the stored result is returned without writing the compound.
+ */
+class CompoundQueue
+{
+ public:
+   /** Result of the compound workers for one compound */
+   struct Result {
+      QString messages;                     // progress messages, printed by apply()
+      QString warnings;                     // warnings of the doc parser, printed by apply()
+
+      CrossReferenceList  crossReferences;
+      IndexRecorder       indexCalls;
+      SearchIndexRecorder searchCalls;
+   };
+
+   /** Installs recorders for the index list and search index of the calling thread */
+   class Recording
+   {
+    public:
+      Recording(SearchIndexIntf *searchIndex);
+      ~Recording();
+
+      QSharedPointer<IndexRecorder> indexCalls;
+      SearchIndexRecorder searchCalls;
+
+    private:
+      IndexList m_indexList;
+
+      IndexList *m_oldIndexList;
+      SearchIndexIntf *m_oldSearchIndex;
+   };
+
+   /** The workers are only started if more than one thread is requested */
+   CompoundQueue(const QList<QSharedPointer<Definition>> &list, CompoundWriteFunc writeFunc, int numThreads,
+                 OutputListFactory createOutputList);
+   ~CompoundQueue();
+
+   /** Returns the result for the compound at position \a index, waits until a worker has written it */
+   Result take(int index);
+
+   /** Applies the recorded calls of \a result on the calling thread */
+   static void apply(const Result &result);
+
+   int threadCount() const {
+      return m_workers.count();
+   }
+
+ private:
+   struct Slot {
+      Slot() : ready(false) {}
+
+      Result result;
+      bool   ready;
+   };
+
+   /** Returns the index of the next compound to write or -1 when all compounds have been claimed */
+   int claim();
+   void store(int index, const Result &result);
+
+   /** Writes the compound at position \a index or reuses its record */
+   Result process(int index, OutputList &ol, Recording &recording);
+
+   /** Reads the record in \a fileName, returns false if the compound must be written */
+   bool loadRecord(const QString &fileName, const QString &key, Result &result);
+
+   void saveRecord(const QString &fileName, const QString &key, const Result &result,
+                  const BuildState::Capture &capture);
+
+   QList<QSharedPointer<Definition>> m_list;
+   QVector<Slot> m_slots;
+
+   CompoundWriteFunc m_writeFunc;
+
+   int m_nextIndex;
+   int m_takenIndex;
+   int m_window;
+   bool m_stop;
+
+   // the search index of the caller, workers only record when it exists
+   SearchIndexIntf *m_searchIndex;
+
+   QWaitCondition m_slotReady;
+   QWaitCondition m_slotFree;
+   QMutex m_mutex;
+
+   QList<CompoundWorkerThread *> m_workers;
+
+   friend class CompoundWorkerThread;
+};
+
+/** Worker thread to write compound pages for the CompoundQueue, owns \a outputList */
+class CompoundWorkerThread : public QThread
+{
+ public:
+   CompoundWorkerThread(CompoundQueue *queue, OutputList *outputList);
+   ~CompoundWorkerThread();
+
+   void run();
+
+ private:
+   CompoundQueue *m_queue;
+   OutputList *m_outputList;
+};
+
+#endif
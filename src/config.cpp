@@ -15,7 +15,9 @@
  *
 *************************************************************************/
 
+#include <QCryptographicHash>
 #include <QDir>
+#include <QFile>
 
 #include <config.h>
 
@@ -106,6 +108,90 @@ QString Config::getString(const QString &name)
    return retval;
 }
 
+QString Config::getAsText(const QString &name)
+{
+   if (m_cfgBool.contains(name)) {
+      return m_cfgBool.value(name).value ? "1" : "0";
+
+   } else if (m_cfgInt.contains(name)) {
+      return QString::number(m_cfgInt.value(name).value);
+
+   } else if (m_cfgEnum.contains(name)) {
+      return m_cfgEnum.value(name).value;
+
+   } else if (m_cfgList.contains(name)) {
+      return m_cfgList.value(name).value.join("\n");
+
+   } else if (m_cfgString.contains(name)) {
+      return m_cfgString.value(name).value;
+
+   }
+
+   fprintf(stderr, "Warning: %s was not retrieved from any project table\n", qPrintable(name) );
+
+   return QString();
+}
+
+QByteArray Config::getSignature()
+{
+   // settings which do not change the generated pages
+   static const QStringList ignored = { "incremental-build", "entry-cache-dir", "num-parse-threads" };
+
+   // files whose contents are copied into or change the layout of the pages
+   static const QStringList files = { "layout-file", "project-logo", "html-header", "html-footer",
+         "latex-header", "latex-footer", "rtf-stylesheet", "mathjax-codefile" };
+
+   QStringList names;
+
+   names += m_cfgBool.keys();
+   names += m_cfgInt.keys();
+   names += m_cfgEnum.keys();
+   names += m_cfgList.keys();
+   names += m_cfgString.keys();
+
+   names.sort();
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   for (const auto &name : names) {
+      if (ignored.contains(name)) {
+         continue;
+      }
+
+      hash.addData(name.toUtf8());
+      hash.addData(getAsText(name).toUtf8());
+      hash.addData("\n");
+   }
+
+   QStringList fileNames;
+
+   for (const auto &name : files) {
+      fileNames.append(getString(name));
+   }
+
+   fileNames += getList("html-stylesheets");
+   fileNames += getList("latex-stylesheets");
+   fileNames += getList("tag-files");
+   fileNames += getList("cite-bib-files");
+
+   for (QString fileName : fileNames) {
+      // tag files may be followed by the location of the external documentation
+      int i = fileName.indexOf('=');
+
+      if (i != -1) {
+         fileName = fileName.left(i);
+      }
+
+      QFile f(fileName.trimmed());
+
+      if (f.open(QIODevice::ReadOnly)) {
+         hash.addData(f.readAll());
+      }
+   }
+
+   return hash.result().toHex();
+}
+
 // update project data
 void Config::setBool(const QString &name, bool data)
 {
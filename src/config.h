@@ -39,6 +39,12 @@ class Config
       static QStringList getList(const QString &name);
       static QString getString(const QString &name);
 
+      // value of an option of any type as text
+      static QString getAsText(const QString &name);
+
+      // hash of all options and the files they name which change the generated pages
+      static QByteArray getSignature();
+
       static void setBool(const QString &name, bool data);
       static void setList(const QString &name, const QStringList &data);
 
@@ -142,6 +142,10 @@ void Config::load_Defaults()
  
    m_cfgInt.insert("tab-size",                   struc_CfgInt    { 4,              DEFAULT } );
    m_cfgInt.insert("lookup-cache-size",          struc_CfgInt    { 0,              DEFAULT } );
+   m_cfgInt.insert("doc-cache-size",             struc_CfgInt    { 64,             DEFAULT } );
+   m_cfgInt.insert("num-parse-threads",          struc_CfgInt    { 0,              DEFAULT } );
+   m_cfgBool.insert("incremental-build",         struc_CfgBool   { false,          DEFAULT } );
+   m_cfgString.insert("entry-cache-dir",         struc_CfgString { QString(),      DEFAULT } );
 
    // tab 2 - build confg
    m_cfgBool.insert("extract-all",               struc_CfgBool   { false,          DEFAULT } );
@@ -310,6 +314,8 @@ void Config::load_Defaults()
    m_cfgBool.insert("external-groups",           struc_CfgBool   { true,           DEFAULT } );
    m_cfgBool.insert("external-pages",            struc_CfgBool   { true,           DEFAULT } );
    m_cfgString.insert("perl-path",               struc_CfgString { "/usr/bin/perl", DEFAULT } );
+   m_cfgInt.insert("tool-num-threads",           struc_CfgInt    { 0,              DEFAULT } );
+   m_cfgList.insert("tool-timeouts",             struc_CfgList   { QStringList(),  DEFAULT } );
 
    // tab 2 - dot
    m_cfgBool.insert("class-diagrams",            struc_CfgBool   { true,           DEFAULT } );
@@ -318,6 +324,10 @@ void Config::load_Defaults()
    m_cfgBool.insert("hide-undoc-relations",      struc_CfgBool   { true,           DEFAULT } );
    m_cfgBool.insert("have-dot",                  struc_CfgBool   { false,          DEFAULT } );
    m_cfgInt.insert("dot-num-threads",            struc_CfgInt    { 0,              DEFAULT } );
+   m_cfgInt.insert("dot-batch-size",             struc_CfgInt    { 1,              DEFAULT } );
+   m_cfgString.insert("dot-cache-dir",           struc_CfgString { QString(),      DEFAULT } );
+   m_cfgInt.insert("dot-cache-size",             struc_CfgInt    { 512,            DEFAULT } );
+   m_cfgInt.insert("dot-inline-max-nodes",       struc_CfgInt    { 0,              DEFAULT } );
    m_cfgString.insert("dot-font-name",           struc_CfgString { "Helvetica",    DEFAULT } );
    m_cfgInt.insert("dot-font-size",              struc_CfgInt    { 10,             DEFAULT } );
    m_cfgString.insert("dot-font-path",           struc_CfgString { QString(),      DEFAULT } );
@@ -388,9 +398,11 @@ void Config::load_Defaults()
    m_cfgString.insert("search-data-file",        struc_CfgString { "searchdata.xml", DEFAULT } ); 
    m_cfgString.insert("search-external-id",      struc_CfgString { QString(),      DEFAULT } ); 
    m_cfgList.insert("search-mappings",           struc_CfgList   { QStringList(),  DEFAULT } );
+   m_cfgInt.insert("search-num-threads",         struc_CfgInt    { 0,              DEFAULT } );
 
    m_cfgInt.insert("formula-fontsize",           struc_CfgInt    { 10,             DEFAULT } );
    m_cfgBool.insert("formula-transparent",       struc_CfgBool   { true,           DEFAULT } );
+   m_cfgString.insert("formula-cache-dir",       struc_CfgString { QString(),      DEFAULT } );
    m_cfgString.insert("ghostscript",             struc_CfgString { QString(),      DEFAULT } );   
    m_cfgBool.insert("use-mathjax",               struc_CfgBool   { false,          DEFAULT } );
    m_cfgEnum.insert("mathjax-format",            struc_CfgEnum   { "HTML-CSS",     DEFAULT } );
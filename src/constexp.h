@@ -25,9 +25,9 @@
 extern bool parseconstexp(const QString &fileName, int line, const QString &s);
 extern int constexpYYparse();
 extern int constexpYYdebug;
-extern QString  g_strToken;
-extern CPPValue g_resultValue;
-extern QString  g_constExpFileName;
-extern int      g_constExpLineNr;
+extern thread_local QString  g_strToken;
+extern thread_local CPPValue g_resultValue;
+extern thread_local QString  g_constExpFileName;
+extern thread_local int      g_constExpLineNr;
 
 #endif
@@ -17,6 +17,7 @@
 
 #include <QRegExp>
 #include <QCryptographicHash>
+#include <QMutex>
 
 #include <ctype.h>
 #include <stdio.h>
@@ -25,6 +26,7 @@
 
 #include <definition.h>
 
+#include <buildstate.h>
 #include <code.h>
 #include <config.h>
 #include <doxy_globals.h>
@@ -39,6 +41,9 @@
 #define START_MARKER 0x4445465B    // DEF[
 #define END_MARKER   0x4445465D    // DEF]
 
+// guards the qualified name and tooltip caches, these are filled while source files are highlighted
+static QMutex s_definitionCacheLock;
+
 class Definition_Private
 {
  public:
@@ -210,7 +215,7 @@ void Definition::addToMap(const QString &name)
 
    if (! phrase.isEmpty()) { 
       // must use a raw pointer since this method is called from a constructor                     
-      Doxy_Globals::glossary().insertMulti(phrase, this);         
+      m_symbolId = Doxy_Globals::glossary().insert(phrase, this);
       this->setPhraseName(phrase);
    }
 }
@@ -226,6 +231,7 @@ Definition::Definition(const QString &df, int dl, int dc, const QString &name, c
    m_private->init(df, name);
 
    m_isPhrase = isPhrase;
+   m_symbolId = SymbolTable::InvalidId;
 
    if (isPhrase) {
       addToMap(name);
@@ -314,6 +320,8 @@ Definition::Definition(const Definition &d)
    }
 
    m_isPhrase = d.m_isPhrase;
+   m_symbolId = SymbolTable::InvalidId;
+
    if (m_isPhrase) {
       addToMap(m_name);
    }
@@ -326,19 +334,8 @@ Definition::~Definition()
       m_private = 0;
    }
 
-   if (! Doxy_Globals::programExit)  {
-      auto iter = Doxy_Globals::glossary().find(m_phraseName);
-   
-      while (iter != Doxy_Globals::glossary().end() && iter.key() == m_phraseName)  {      
-   
-         if (iter.value() == this) {
-            iter = Doxy_Globals::glossary().erase(iter);
-   
-         }  else {
-            ++iter;
-   
-         }      
-      }
+   if (! Doxy_Globals::programExit && m_symbolId != SymbolTable::InvalidId)  {
+      Doxy_Globals::glossary().remove(m_symbolId, this);
    }
 }
 
@@ -675,6 +672,8 @@ static bool readCodeFragment(const QString &fileName, int &startLine, int &endLi
       return false;   // not a valid file name
    }
 
+   BuildState::addDependency(fileName);
+
    QByteArray tempResult;
 
    QString filter = getFileFilter(fileName, true);
@@ -891,6 +890,9 @@ void Definition::writeSourceDef(OutputList &ol, const QString &)
    QString fn = getSourceFileBase();
 
    if (! fn.isEmpty()) {
+      // line numbers change when the source file is edited
+      BuildState::addDependency(m_private->body->fileDef->getFilePath());
+
       QString refText = theTranslator->trDefinedAtLineInSourceFile();
 
       int lineMarkerPos = refText.indexOf("@0");
@@ -1342,10 +1344,14 @@ void Definition::addSourceReferences(QSharedPointer<MemberDef> md)
 
 QString Definition::qualifiedName() const
 {
-   if (! m_private->qualifiedName.isEmpty()) {     
-      return m_private->qualifiedName;
+   {
+      QMutexLocker locker(&s_definitionCacheLock);
+
+      if (! m_private->qualifiedName.isEmpty()) {
+         return m_private->qualifiedName;
+      }
    }
-   
+
    if (! m_private->outerScope) {
       if (m_private->localName == "<globalScope>") {       
          return "";
@@ -1355,14 +1361,20 @@ QString Definition::qualifiedName() const
       }
    }
 
+   // computed without holding the lock, the outer scope is resolved recursively
+   QString result;
+
    if (m_private->outerScope->name() == "<globalScope>") {
-      m_private->qualifiedName = m_private->localName;
+      result = m_private->localName;
 
    } else {
-      m_private->qualifiedName = m_private->outerScope->qualifiedName() + getLanguageSpecificSeparator(getLanguage()) + m_private->localName;
+      result = m_private->outerScope->qualifiedName() + getLanguageSpecificSeparator(getLanguage()) + m_private->localName;
    }
-   
-   return m_private->qualifiedName;
+
+   QMutexLocker locker(&s_definitionCacheLock);
+   m_private->qualifiedName = result;
+
+   return result;
 }
 
 void Definition::setOuterScope(QSharedPointer<Definition> d)
@@ -1377,6 +1389,7 @@ void Definition::setOuterScope(QSharedPointer<Definition> d)
    }
 
    if (! found) {
+      QMutexLocker locker(&s_definitionCacheLock);
       m_private->qualifiedName.resize(0); // flush cached scope name
       m_private->outerScope = d;
    }
@@ -1661,6 +1674,7 @@ QString Definition::phraseName() const
 QString Definition::documentation() const
 {
    if (m_private->details) {
+      BuildState::addDependency(m_private->details->file);
       return m_private->details->doc;
    }
 
@@ -1730,6 +1744,10 @@ QString abbreviate(const QString &s, const QString &name)
 
 QString Definition::briefDescription(bool abbr) const
 {
+   if (m_private->brief) {
+      BuildState::addDependency(m_private->brief->file);
+   }
+
    return m_private->brief ? (abbr ? abbreviate(m_private->brief->doc, displayName()) : m_private->brief->doc) : "";
 }
 
@@ -1738,9 +1756,17 @@ QString Definition::briefDescriptionAsTooltip() const
    QSharedPointer<const Definition> self = sharedFrom(this);
 
    if (m_private->brief) {
+      BuildState::addDependency(m_private->brief->file);
+
+      QString tooltip;
+
+      {
+         QMutexLocker locker(&s_definitionCacheLock);
+         tooltip = m_private->brief->tooltip;
+      }
 
-      if (m_private->brief->tooltip.isEmpty() && ! m_private->brief->doc.isEmpty()) {
-         static bool reentering = false;
+      if (tooltip.isEmpty() && ! m_private->brief->doc.isEmpty()) {
+         static thread_local bool reentering = false;
 
          if (! reentering) {
             QSharedPointer<const MemberDef> md;
@@ -1764,14 +1790,17 @@ QString Definition::briefDescriptionAsTooltip() const
             // prevent requests for tooltips while parsing a tooltip
             reentering = true; 
 
-            m_private->brief->tooltip = parseCommentAsText(scope, md, m_private->brief->doc, 
+            tooltip = parseCommentAsText(scope, md, m_private->brief->doc,
                   m_private->brief->file, m_private->brief->line);
 
             reentering = false;
+
+            QMutexLocker locker(&s_definitionCacheLock);
+            m_private->brief->tooltip = tooltip;
          }
       }
 
-      return m_private->brief->tooltip;
+      return tooltip;
    }
 
    return "";
@@ -1789,6 +1818,10 @@ QString Definition::briefFile() const
 
 QString Definition::inbodyDocumentation() const
 {
+   if (m_private->inbodyDocs) {
+      BuildState::addDependency(m_private->inbodyDocs->file);
+   }
+
    return m_private->inbodyDocs ? m_private->inbodyDocs->doc : "";
 }
 
@@ -25,6 +25,7 @@
 
 #include <doxy_shared.h>
 #include <sortedlist.h>
+#include <symboltable.h>
 #include <types.h>
 
 class Definition_Private;
@@ -380,7 +381,9 @@ class Definition : public DefinitionIntf
 
    bool m_isPhrase;
 
-   QString m_phraseName;
+   QString  m_phraseName;
+   SymbolId m_symbolId;
+
    int m_defLine;
    int m_defColumn;
 
@@ -16,23 +16,30 @@
 *************************************************************************/
 
 #include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
 
 #include <dia.h>
 
 #include <config.h>
 #include <message.h>
 #include <portable.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 static const int maxCmdLine = 40960;
 
+// output file to the id of the job writing it, a diagram used on several pages is generated once
+static QHash<QString, int> s_diaJobs;
+static QMutex s_diaJobsLock;
+
 void writeDiaGraphFromFile(const QString &inFile, const QString &outDir, const QString &outFile, DiaOutputFormat format)
 {
-   QString absOutFile = outDir + QDir::separator() +outFile;
-
-   // move to the output dir so dot can find the font file.
-   QString oldDir = QDir::currentPath();   
-   QDir::setCurrent(outDir);
+   // run dia in the output directory, the job gets its own working directory
+   QDir dir(outDir);
+   QString workDir = dir.absolutePath();
 
    QString diaExe = Config::getString("dia-path") + "dia" + portable_commandExtension();
 
@@ -50,6 +57,16 @@ void writeDiaGraphFromFile(const QString &inFile, const QString &outDir, const Q
       extension = ".eps";
    }
 
+   QMutexLocker locker(&s_diaJobsLock);
+
+   QString outputPath = dir.absoluteFilePath(outFile + extension);
+
+   if (s_diaJobs.contains(outputPath)) {
+      return;
+   }
+
+   s_diaJobs.insert(outputPath, -1);
+
    diaArgs += " -e \"";
    diaArgs += outFile;
    diaArgs += extension + "\"";
@@ -58,33 +75,37 @@ void writeDiaGraphFromFile(const QString &inFile, const QString &outDir, const Q
    diaArgs += inFile;
    diaArgs += "\"";
 
-   bool ok = true;
-   int exitCode;
+   bool toPdf = (format == DIA_EPS) && Config::getBool("latex-pdf");
 
-   portable_sysTimerStart();
+   QStringList outputs;
+   outputs.append(outputPath);
 
-   if ((exitCode = portable_system(diaExe, diaArgs, false)) != 0) {
-      portable_sysTimerStop();
-      ok = false;     
+   if (toPdf) {
+      outputs.append(dir.absoluteFilePath(outFile + ".pdf"));
    }
 
-   if (ok) {
-      portable_sysTimerStop();
-   
-      if ( (format == DIA_EPS) && (Config::getBool("latex-pdf")) ) {      
-
-         QString epstopdfArgs;
-         epstopdfArgs = QString("\"%1.eps\" --outfile=\"%2.pdf\"").arg(outFile).arg(outFile);
-   
-         portable_sysTimerStart();
-
-         if (portable_system("epstopdf", epstopdfArgs) != 0) {
-            err("Unable to run epstopdf. Check your TeX installation\n");
-         }
-         portable_sysTimerStop();
-      }
+   // skip the diagram when neither the source nor the command changed since the last run
+   QString sigFile   = dir.absoluteFilePath(outFile + ".md5");
+   QString signature = ToolExecutor::signature(dir.absoluteFilePath(inFile), diaExe + " " + diaArgs);
+
+   if (ToolExecutor::isUpToDate(sigFile, signature, outputs)) {
+      return;
    }
 
-   QDir::setCurrent(oldDir);
-}
+   // the image is not needed until the output is complete, dia runs in the background
+   ToolExecutor *executor = ToolExecutor::instance();
+
+   int id = executor->submit("dia", diaExe, diaArgs, QString("Unable to run dia on %1").arg(inFile), QList<int>(),
+                  false, workDir);
+
+   if (toPdf) {
+      QString epstopdfArgs;
+      epstopdfArgs = QString("\"%1.eps\" --outfile=\"%2.pdf\"").arg(outFile).arg(outFile);
 
+      id = executor->submit("epstopdf", "epstopdf", epstopdfArgs, "Unable to run epstopdf. Check your TeX installation",
+                  QList<int>() << id, true, workDir);
+   }
+
+   executor->storeSignature(id, sigFile, signature);
+   s_diaJobs.insert(outputPath, id);
+}
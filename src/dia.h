@@ -22,6 +22,7 @@ class QByteArray;
 
 enum DiaOutputFormat { DIA_BITMAP , DIA_EPS };
 
+/** Converts a dia file to an image, dia runs in the background and is skipped if the source did not change */
 void writeDiaGraphFromFile(const QString &inFile, const QString &outDir, const QString &outFile, DiaOutputFormat format);
 
 #endif
@@ -15,6 +15,9 @@
  *
 *************************************************************************/
 
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QList>
 
@@ -29,7 +32,7 @@
 #include <index.h>
 #include <image.h>
 #include <message.h>
-#include <portable.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 #define IMAGE_EXT ".png"
@@ -1467,20 +1470,31 @@ void ClassDiagram::writeFigure(QTextStream &output, const QString &path, const Q
       QString epstopdfArgs;
       epstopdfArgs = QString("\"%1.eps\" --outfile=\"%2.pdf\"").arg(epsBaseName).arg(epsBaseName);
 
-      portable_sysTimerStart();
+      // the pdf is not needed until the output is complete
+      ToolExecutor::instance()->submit("epstopdf", "epstopdf", epstopdfArgs, "Unable to run epstopdf. Verify your TeX installation");
+   }
+}
 
-      if (portable_system("epstopdf", epstopdfArgs) != 0) {
-         err("Unable to run epstopdf. Verify your TeX installation\n");
-         portable_sysTimerStop();
-         return;
-      }
+static QAtomicInt s_imageCount;
 
-      portable_sysTimerStop();
-   }
+// microseconds, an int overflows after about 35 minutes
+static QAtomicInteger<qint64> s_imageTime;
+
+int ClassDiagram::imageCount()
+{
+   return s_imageCount.load();
+}
+
+qint64 ClassDiagram::imageTime()
+{
+   return s_imageTime.load();
 }
 
 void ClassDiagram::writeImage(QTextStream &t, const QString &path, const QString &relPath, const QString &fName, bool generateMap) const
 {
+   QElapsedTimer timer;
+   timer.start();
+
    uint baseRows  = base->computeRows();
    uint superRows = super->computeRows();
    uint rows = baseRows + superRows - 1;
@@ -1514,6 +1528,9 @@ void ClassDiagram::writeImage(QTextStream &t, const QString &path, const QString
       f.write(buffer);
       f.close();
 
+      s_imageCount.fetchAndAddRelaxed(1);
+      s_imageTime.fetchAndAddRelaxed(timer.nsecsElapsed() / 1000);
+
    } else {
       err("Unable to open file for writing %s, error: %d\n", qPrintable(fileName), f.error());
 
@@ -34,6 +34,12 @@ class ClassDiagram
    void writeFigure(QTextStream &t, const QString &path, const QString &file) const;
    void writeImage(QTextStream &t, const QString &path, const QString &relPath, const QString &file, bool generateMap = true) const;
 
+   /** Returns the number of images written by writeImage() */
+   static int imageCount();
+
+   /** Returns the time spent drawing and encoding the images in microseconds */
+   static qint64 imageTime();
+
  private:
    TreeDiagram *base;
    TreeDiagram *super;
@@ -0,0 +1,154 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QCryptographicHash>
+#include <QMutexLocker>
+
+#include <doccache.h>
+
+#include <config.h>
+#include <docparser.h>
+#include <doxy_globals.h>
+
+// rough size of the nodes created for each character of the documentation, in bytes
+static const int bytesPerChar = 64;
+
+enum DocCacheFlags {
+   IsExample     = 1,
+   SingleLine    = 2,
+   LinkFromIndex = 4
+};
+
+uint qHash(const DocCache::Key &key, uint seed)
+{
+   uint h = qHash(key.hash, seed);
+
+   h = 31 * h + qHash(reinterpret_cast<quintptr>(key.ctx), seed);
+   h = 31 * h + qHash(reinterpret_cast<quintptr>(key.md), seed);
+   h = 31 * h + key.flags;
+
+   return h;
+}
+
+DocCache *DocCache::instance()
+{
+   static DocCache theInstance;
+   return &theInstance;
+}
+
+DocCache::DocCache()
+   : m_parses(0), m_hits(0), m_evictions(0)
+{
+   // cost is measured in kilobytes
+   int maxSize = qBound(0, Config::getInt("doc-cache-size"), 2047);
+   m_cache.setMaxCost(maxSize * 1024);
+}
+
+QSharedPointer<DocRoot> DocCache::parse(const QString &fileName, int startLine, QSharedPointer<Definition> ctx,
+                  QSharedPointer<MemberDef> md, const QString &docStr, bool indexWords, bool isExample,
+                  const QString &exampleName, bool singleLine, bool linkFromIndex)
+{
+   if (m_cache.maxCost() == 0) {
+      QSharedPointer<DocRoot> root(validatingParseDoc(fileName, startLine, ctx, md, docStr, indexWords, isExample,
+                  exampleName, singleLine, linkFromIndex));
+
+      QMutexLocker locker(&m_mutex);
+      ++m_parses;
+
+      return root;
+   }
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+   hash.addData(docStr.toUtf8());
+   hash.addData("\0", 1);
+   hash.addData(fileName.toUtf8());
+   hash.addData("\0", 1);
+   hash.addData(exampleName.toUtf8());
+
+   Key key;
+   key.hash  = hash.result();
+   key.ctx   = ctx.data();
+   key.md    = md.data();
+   key.flags = (isExample ? IsExample : 0) | (singleLine ? SingleLine : 0) | (linkFromIndex ? LinkFromIndex : 0);
+
+   // words are added to the search index while parsing, a cached tree can not be used
+   bool addsWords = indexWords && Doxy_Globals::searchIndex;
+
+   QMutexLocker locker(&m_mutex);
+
+   if (! addsWords) {
+      QSharedPointer<DocRoot> *pval = m_cache.object(key);
+
+      if (pval != nullptr) {
+         ++m_hits;
+         return *pval;
+      }
+   }
+
+   ++m_parses;
+   locker.unlock();
+
+   QSharedPointer<DocRoot> root(validatingParseDoc(fileName, startLine, ctx, md, docStr, indexWords, isExample,
+                  exampleName, singleLine, linkFromIndex));
+
+   int cost = qMax(1, docStr.length() * bytesPerChar / 1024);
+
+   locker.relock();
+
+   if (cost <= m_cache.maxCost()) {
+
+      if (m_cache.totalCost() + cost > m_cache.maxCost() && ! m_cache.contains(key)) {
+         // least recently used trees will be removed
+         ++m_evictions;
+      }
+
+      // the tree stays alive until the caller has finished with it, even when it is removed here
+      m_cache.insert(key, new QSharedPointer<DocRoot>(root), cost);
+   }
+
+   return root;
+}
+
+void DocCache::clear()
+{
+   QMutexLocker locker(&m_mutex);
+   m_cache.clear();
+}
+
+int DocCache::count() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_cache.count();
+}
+
+qint64 DocCache::parses() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_parses;
+}
+
+qint64 DocCache::hits() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_hits;
+}
+
+qint64 DocCache::evictions() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_evictions;
+}
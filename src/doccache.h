@@ -0,0 +1,85 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef DOCCACHE_H
+#define DOCCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+
+class Definition;
+class DocRoot;
+class MemberDef;
+
+/** @brief Cache of parsed documentation trees
+ *
+ *  The same brief and detailed descriptions are written on the class, file, group
+ *  and member list pages. The parsed DocRoot is kept so the generators can visit it
+ *  again instead of parsing the text for every page. The key is the hash of the text
+ *  together with the context, member and the options passed to validatingParseDoc().
+ *  The least recently used trees are removed when the estimated size of the cached
+ *  trees grows beyond doc-cache-size megabytes. All methods are thread safe.
+ */
+class DocCache
+{
+ public:
+   static DocCache *instance();
+
+   /** Returns the tree for \a docStr, the arguments are the same as for validatingParseDoc() */
+   QSharedPointer<DocRoot> parse(const QString &fileName, int startLine, QSharedPointer<Definition> ctx,
+                  QSharedPointer<MemberDef> md, const QString &docStr, bool indexWords, bool isExample,
+                  const QString &exampleName, bool singleLine, bool linkFromIndex);
+
+   void clear();
+
+   int count() const;
+
+   qint64 parses() const;
+   qint64 hits() const;
+   qint64 evictions() const;
+
+ private:
+   DocCache();
+
+   struct Key {
+      bool operator==(const Key &other) const {
+         return ctx == other.ctx && md == other.md && flags == other.flags && hash == other.hash;
+      }
+
+      QByteArray hash;
+
+      const Definition *ctx;
+      const MemberDef  *md;
+
+      uint flags;
+   };
+
+   friend uint qHash(const Key &key, uint seed);
+
+   QCache<Key, QSharedPointer<DocRoot>> m_cache;
+   mutable QMutex m_mutex;
+
+   qint64 m_parses;
+   qint64 m_hits;
+   qint64 m_evictions;
+};
+
+#endif
@@ -19,6 +19,8 @@
 #include <QFileInfo>
 #include <QStack>
 #include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRegExp>
 
 #include <stdio.h>
@@ -38,8 +40,8 @@
 #include <language.h>
 #include <message.h>
 #include <parser_md.h>
-#include <portable.h>
 #include <printdocvisitor.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 // debug off
@@ -66,9 +68,14 @@ static const QString sectionLevelToName[] = {
    "subparagraph"
 };
 
-/** Parser's context to store all global variables.
- */
-struct DocParserContext {
+/** Parser state variables during a call to validatingParseDoc */
+struct DocParserState {
+   DocParserState()
+      : inSeeBlock(false), xmlComment(false), insideHtmlLink(false), hasParamCommand(false),
+        hasReturnCommand(false), isExample(false), sectionDict(nullptr), includeFileOffset(0),
+        includeFileLength(0), token(nullptr)
+   {}
+
    QSharedPointer<Definition> scope;
    QString context;
    bool inSeeBlock;
@@ -99,115 +106,92 @@ struct DocParserContext {
    uint includeFileOffset;
    uint includeFileLength;
 
+   // only used for the saved states on the parser stack
    TokenInfo *token;
 };
 
-// Parser state variables during a call to validatingParseDoc
-static QSharedPointer<Definition> s_scope;
-static QString                 s_context;
-static bool                    s_inSeeBlock;
-static bool                    s_xmlComment;
-static bool                    s_insideHtmlLink;
-static QStack<DocNode *>       s_nodeStack;
-static QStack<DocStyleChange>  s_styleStack;
-static QStack<DocStyleChange>  s_initialStyleStack;
-
-static QList<QSharedPointer<Definition>> s_copyStack;
-  
-static QString                 s_fileName;
-static QString                 s_relPath;
+/** State owned by a DocParserContext */
+struct DocParserData : public DocParserState {
+   QStack<DocParserState> parserStack;
+   DocTokenizerContext *tokenizer;
+};
+
+// state of the context which is active on this thread
+static thread_local DocParserData *s_parser = nullptr;
+
+/** Makes a context the active one on the calling thread during its lifetime */
+class DocParserScope
+{
+ public:
+   DocParserScope(DocParserContext &ctx)
+      : m_prevParser(s_parser)
+   {
+      s_parser = ctx.m_data;
+      m_prevTokenizer = doctokenizerYYsetContext(s_parser->tokenizer);
+   }
 
-static bool                    s_hasParamCommand;
-static bool                    s_hasReturnCommand;
-static QSet<QString>           s_paramsFound;
+   ~DocParserScope() {
+      doctokenizerYYsetContext(m_prevTokenizer);
+      s_parser = m_prevParser;
+   }
 
-static QSharedPointer<MemberDef> s_memberDef;
+ private:
+   DocParserData       *m_prevParser;
+   DocTokenizerContext *m_prevTokenizer;
+};
 
-static bool                    s_isExample;
-static QString                 s_exampleName;
-static SectionDict            *s_sectionDict;
-static QString                 s_searchUrl;
+DocParserContext::DocParserContext()
+   : m_data(new DocParserData)
+{
+   m_data->tokenizer = doctokenizerYYcreateContext();
+}
 
-static QString                 s_includeFileText;
-static uint                    s_includeFileOffset;
-static uint                    s_includeFileLength;
+DocParserContext::~DocParserContext()
+{
+   doctokenizerYYdeleteContext(m_data->tokenizer);
+   delete m_data;
+}
 
-static QStack<DocParserContext> s_parserStack;
+// context used when none is passed, one for each thread
+static DocParserContext &threadParserContext()
+{
+   static thread_local DocParserContext ctx;
+   return ctx;
+}
 
 static void docParserPushContext(bool saveParamInfo = true)
 {  
    doctokenizerYYpushContext();
 
-   DocParserContext ctx;
-
-   ctx.scope              = s_scope;
-   ctx.context            = s_context;
-   ctx.inSeeBlock         = s_inSeeBlock;
-   ctx.xmlComment         = s_xmlComment;
-   ctx.insideHtmlLink     = s_insideHtmlLink;
-   ctx.nodeStack          = s_nodeStack;
-   ctx.styleStack         = s_styleStack;
-   ctx.initialStyleStack  = s_initialStyleStack;
-   ctx.copyStack          = s_copyStack;
-   ctx.fileName           = s_fileName;
-   ctx.relPath            = s_relPath;
-
-   if (saveParamInfo) {
-      ctx.hasParamCommand   = s_hasParamCommand;
-      ctx.hasReturnCommand  = s_hasReturnCommand;
-      ctx.paramsFound       = s_paramsFound;
-   }
-
-   ctx.memberDef          = s_memberDef;
-   ctx.isExample          = s_isExample;
-   ctx.exampleName        = s_exampleName;
-   ctx.sectionDict        = s_sectionDict;
-   ctx.searchUrl          = s_searchUrl;
-
-   ctx.includeFileText    = s_includeFileText;
-   ctx.includeFileOffset  = s_includeFileOffset;
-   ctx.includeFileLength  = s_includeFileLength;
-
-   ctx.token              = g_token;
+   DocParserState ctx = *s_parser;
+
+   if (! saveParamInfo) {
+      ctx.hasParamCommand  = false;
+      ctx.hasReturnCommand = false;
+      ctx.paramsFound.clear();
+   }
+
+   ctx.token = g_token;
    g_token = new TokenInfo;
 
-   s_parserStack.push(ctx);
+   s_parser->parserStack.push(ctx);
 }
 
 static void docParserPopContext(bool keepParamInfo = false)
 {
-   DocParserContext ctx = s_parserStack.pop();
-
-   s_scope               = ctx.scope;
-   s_context             = ctx.context;
-   s_inSeeBlock          = ctx.inSeeBlock;
-   s_xmlComment          = ctx.xmlComment;
-   s_insideHtmlLink      = ctx.insideHtmlLink;
-   s_nodeStack           = ctx.nodeStack;
-   s_styleStack          = ctx.styleStack;
-   s_initialStyleStack   = ctx.initialStyleStack;
-   s_copyStack           = ctx.copyStack;
-   s_fileName            = ctx.fileName;
-   s_relPath             = ctx.relPath;
-
-   if (! keepParamInfo) {
-      s_hasParamCommand     = ctx.hasParamCommand;
-      s_hasReturnCommand    = ctx.hasReturnCommand;
-      s_paramsFound         = ctx.paramsFound;
-   }
-
-   s_memberDef           = ctx.memberDef;
-   s_isExample           = ctx.isExample;
-   s_exampleName         = ctx.exampleName;
-   s_sectionDict         = ctx.sectionDict;
-   s_searchUrl           = ctx.searchUrl;
-
-   s_includeFileText     = ctx.includeFileText;
-   s_includeFileOffset   = ctx.includeFileOffset;
-   s_includeFileLength   = ctx.includeFileLength;
+   DocParserState ctx = s_parser->parserStack.pop();
+
+   if (keepParamInfo) {
+      ctx.hasParamCommand  = s_parser->hasParamCommand;
+      ctx.hasReturnCommand = s_parser->hasReturnCommand;
+      ctx.paramsFound      = s_parser->paramsFound;
+   }
 
    delete g_token;
-   g_token               = ctx.token;
+   g_token = ctx.token;
+
+   ctx.token = nullptr;
+   static_cast<DocParserState &>(*s_parser) = ctx;
   
    doctokenizerYYpopContext();   
 }
@@ -292,6 +276,10 @@ static QString findAndCopyImage(const QString &fileName, DocImage::Type type)
          }
 
          QString outputFile = outputDir + "/" + result;
+
+         // the image can be used by documentation parsed on several threads, the index is shared
+         static QMutex imageLock;
+         QMutexLocker locker(&imageLock);
                   
          if (outputFile != inputFile) { 
             // prevent copying to ourself
@@ -307,7 +295,7 @@ static QString findAndCopyImage(const QString &fileName, DocImage::Type type)
                }
 
             } else {
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unable to open image file for writing %s, error: %d\n", 
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unable to open image file for writing %s, error: %d\n", 
                         csPrintable(outputFile), inImage.error());
             }
 
@@ -317,7 +305,7 @@ static QString findAndCopyImage(const QString &fileName, DocImage::Type type)
          }
 
       } else {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unable to open image file for reading %s, error: %d", 
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unable to open image file for reading %s, error: %d", 
                         csPrintable(fileName), inImage.error() );       
       }
 
@@ -330,13 +318,8 @@ static QString findAndCopyImage(const QString &fileName, DocImage::Type type)
          QString epstopdfArgs;
          epstopdfArgs = QString("\"%1/%2.eps\" --outfile=\"%3/%4.pdf\"").arg(outputDir).arg(baseName).arg(outputDir).arg(baseName);
 
-         portable_sysTimerStart();
-
-         if (portable_system("epstopdf", epstopdfArgs) != 0) {
-            err("Problem running epstopdf, verify TeX installation\n");
-         }
-
-         portable_sysTimerStop();
+         // the pdf is not needed until the output is complete
+         ToolExecutor::instance()->submit("epstopdf", "epstopdf", epstopdfArgs, "Problem running epstopdf, verify TeX installation");
 
          return baseName;
       }
@@ -348,13 +331,13 @@ static QString findAndCopyImage(const QString &fileName, DocImage::Type type)
       text += "Possible candidates:\n";
       text += showFileDefMatches(Doxy_Globals::imageNameDict, fileName);
 
-      warn_doc_error(s_fileName, doctokenizerYYlineno, text);
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, text);
 
    } else {
       result = fileName;
 
       if (result.left(5) != "http:" && result.left(6) != "https:") {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Image file %s was not found in 'IMAGE PATH': "
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Image file %s was not found in 'IMAGE PATH': "
                         "assuming external image", qPrintable(fileName) );
       }
    }
@@ -363,7 +346,7 @@ static QString findAndCopyImage(const QString &fileName, DocImage::Type type)
 }
 
 /*! Collects the parameters found with \@param or \@retval commands
- *  in a global list s_paramsFound. If \a isParam is set to true
+ *  in a global list s_parser->paramsFound. If \a isParam is set to true
  *  and the parameter is not an actual parameter of the current
  *  member g_memberDef, then a warning is raised (unless warnings
  *  are disabled altogether).
@@ -374,18 +357,18 @@ static void checkArgumentName(const QString &name, bool isParam)
       return;
    }
 
-   if (s_memberDef == 0) {
+   if (s_parser->memberDef == 0) {
       return; 
    }
 
-   ArgumentList *al = s_memberDef->isDocsForDefinition() ? s_memberDef->argumentList() : s_memberDef->declArgumentList();
-   SrcLangExt lang = s_memberDef->getLanguage();
+   ArgumentList *al = s_parser->memberDef->isDocsForDefinition() ? s_parser->memberDef->argumentList() : s_parser->memberDef->declArgumentList();
+   SrcLangExt lang = s_parser->memberDef->getLanguage();
  
    if (al == 0) {
       return;  
    }
 
-   static QRegExp re("\\$?[a-zA-Z0-9_\\x80-\\xFF]+\\.*");
+   QRegExp re("\\$?[a-zA-Z0-9_\\x80-\\xFF]+\\.*");
    int p = 0;
    int i = 0;
    int l;
@@ -403,7 +386,7 @@ static void checkArgumentName(const QString &name, bool isParam)
       bool found = false;
     
       for (auto a : *al) {
-         QString argName = s_memberDef->isDefine() ? a.type : a.name;
+         QString argName = s_parser->memberDef->isDefine() ? a.type : a.name;
 
          if (lang == SrcLangExt_Fortran) {
             argName = argName.toLower();
@@ -416,14 +399,14 @@ static void checkArgumentName(const QString &name, bool isParam)
          }
 
          if (aName == argName) {
-            s_paramsFound.insert(aName);
+            s_parser->paramsFound.insert(aName);
             found = true;
             break;
          }
       }
 
       if (! found && isParam) {         
-         QString scope = s_memberDef->getScopeString();
+         QString scope = s_parser->memberDef->getScopeString();
 
          if (! scope.isEmpty()) {
             scope += "::";
@@ -433,10 +416,10 @@ static void checkArgumentName(const QString &name, bool isParam)
 
          QString inheritedFrom = "";
 
-         QString docFile = s_memberDef->docFile();
-         int docLine     = s_memberDef->docLine();
+         QString docFile = s_parser->memberDef->docFile();
+         int docLine     = s_parser->memberDef->docLine();
 
-         QSharedPointer<MemberDef> inheritedMd = s_memberDef->inheritsDocsFrom();
+         QSharedPointer<MemberDef> inheritedMd = s_parser->memberDef->inheritsDocsFrom();
 
          if (inheritedMd) { 
             // documentation was inherited
@@ -444,13 +427,13 @@ static void checkArgumentName(const QString &name, bool isParam)
             inheritedFrom = QString(" Inherited from member %1 at line %2 in file %3").arg(QString(inheritedMd->name())).
                                   arg(inheritedMd->docLine()).arg(QString(inheritedMd->docFile()));
   
-            docFile = s_memberDef->getDefFileName();
-            docLine = s_memberDef->getDefLine();
+            docFile = s_parser->memberDef->getDefFileName();
+            docLine = s_parser->memberDef->getDefLine();
          }
 
          QString alStr = argListToString(al);
          warn_doc_error(docFile, docLine, "Argument '%s' of command @param was not found in the argument list of %s%s%s%s",
-                        qPrintable(aName), qPrintable(scope), qPrintable(s_memberDef->name()),
+                        qPrintable(aName), qPrintable(scope), qPrintable(s_parser->memberDef->name()),
                         qPrintable(alStr), qPrintable(inheritedFrom));
       }
 
@@ -465,16 +448,16 @@ static void checkArgumentName(const QString &name, bool isParam)
  */
 static void checkUndocumentedParams()
 {
-   if (s_memberDef && s_hasParamCommand && Config::getBool("warn-doc-error")) {
-      ArgumentList *al = s_memberDef->isDocsForDefinition() ? s_memberDef->argumentList() : s_memberDef->declArgumentList();
+   if (s_parser->memberDef && s_parser->hasParamCommand && Config::getBool("warn-doc-error")) {
+      ArgumentList *al = s_parser->memberDef->isDocsForDefinition() ? s_parser->memberDef->argumentList() : s_parser->memberDef->declArgumentList();
 
-      SrcLangExt lang = s_memberDef->getLanguage();
+      SrcLangExt lang = s_parser->memberDef->getLanguage();
 
       if (al != 0) {    
          bool found = false;
         
          for (auto a : *al) { 
-            QString argName = s_memberDef->isDefine() ? a.type : a.name;
+            QString argName = s_parser->memberDef->isDefine() ? a.type : a.name;
             if (lang == SrcLangExt_Fortran) {
                argName = argName.toLower();
             }
@@ -484,10 +467,10 @@ static void checkUndocumentedParams()
                argName = argName.left(argName.length() - 3);
             }
 
-            if (s_memberDef->getLanguage() == SrcLangExt_Python && argName == "self") {
+            if (s_parser->memberDef->getLanguage() == SrcLangExt_Python && argName == "self") {
                // allow undocumented self parameter for Python
 
-            } else if (!argName.isEmpty() && ! s_paramsFound.contains(argName) && a.docs.isEmpty()) {
+            } else if (!argName.isEmpty() && ! s_parser->paramsFound.contains(argName) && a.docs.isEmpty()) {
                found = true;
                break;
             }
@@ -496,11 +479,11 @@ static void checkUndocumentedParams()
          if (found) {
             bool first = true;
 
-            QString errMsg = "The following parameters of " + s_memberDef->qualifiedName() +
+            QString errMsg = "The following parameters of " + s_parser->memberDef->qualifiedName() +
                   argListToString(al) + " are not documented:\n";
 
             for (auto a : *al) { 
-               QString argName = s_memberDef->isDefine() ? a.type : a.name;
+               QString argName = s_parser->memberDef->isDefine() ? a.type : a.name;
 
                if (lang == SrcLangExt_Fortran) {
                   argName = argName.toLower();
@@ -508,10 +491,10 @@ static void checkUndocumentedParams()
 
                argName = argName.trimmed();
 
-               if (s_memberDef->getLanguage() == SrcLangExt_Python && argName == "self") {
+               if (s_parser->memberDef->getLanguage() == SrcLangExt_Python && argName == "self") {
                   // allow undocumented self parameter for Python
 
-               } else if (!argName.isEmpty() && ! s_paramsFound.contains(argName)) {
+               } else if (!argName.isEmpty() && ! s_parser->paramsFound.contains(argName)) {
 
                   if (! first) {
                      errMsg += "\n";
@@ -525,7 +508,7 @@ static void checkUndocumentedParams()
                }
             }
 
-            warn_doc_error(s_memberDef->getDefFileName(), s_memberDef->getDefLine(), 
+            warn_doc_error(s_parser->memberDef->getDefFileName(), s_parser->memberDef->getDefLine(), 
                      csPrintable(substitute(errMsg, "%", "%%")));
             
          }
@@ -540,17 +523,17 @@ static void checkUndocumentedParams()
  */
 static void detectNoDocumentedParams()
 {
-   if (s_memberDef && Config::getBool("warn-undoc-param")) {
-      ArgumentList *al     = s_memberDef->argumentList();
-      ArgumentList *declAl = s_memberDef->declArgumentList();
+   if (s_parser->memberDef && Config::getBool("warn-undoc-param")) {
+      ArgumentList *al     = s_parser->memberDef->argumentList();
+      ArgumentList *declAl = s_parser->memberDef->declArgumentList();
 
-      QString returnType   = s_memberDef->typeString();
-      bool isPython = s_memberDef->getLanguage() == SrcLangExt_Python;
+      QString returnType   = s_parser->memberDef->typeString();
+      bool isPython = s_parser->memberDef->getLanguage() == SrcLangExt_Python;
 
-      if (! s_memberDef->hasDocumentedParams() && s_hasParamCommand) {         
-         s_memberDef->setHasDocumentedParams(true);
+      if (! s_parser->memberDef->hasDocumentedParams() && s_parser->hasParamCommand) {         
+         s_parser->memberDef->setHasDocumentedParams(true);
 
-      } else if (!s_memberDef->hasDocumentedParams()) {
+      } else if (!s_parser->memberDef->hasDocumentedParams()) {
          bool allDoc = true; // no paramater => all parameters are documented
 
          if ( al != 0 && al->count() > 0) {    
@@ -586,29 +569,29 @@ static void detectNoDocumentedParams()
          }
 
          if (allDoc) {
-            s_memberDef->setHasDocumentedParams(true);
+            s_parser->memberDef->setHasDocumentedParams(true);
          }
       }
 
-      if (! s_memberDef->hasDocumentedReturnType() && s_hasReturnCommand) {
+      if (! s_parser->memberDef->hasDocumentedReturnType() && s_parser->hasReturnCommand) {
          // docs not yet found
-         s_memberDef->setHasDocumentedReturnType(true);
+         s_parser->memberDef->setHasDocumentedReturnType(true);
 
-      } else if ( s_memberDef->hasDocumentedReturnType() || returnType.isEmpty() || 
+      } else if ( s_parser->memberDef->hasDocumentedReturnType() || returnType.isEmpty() || 
                returnType.indexOf("void") != -1 || returnType.indexOf("subroutine") != -1 ||
-               s_memberDef->isConstructor() || s_memberDef->isDestructor() ) {
+               s_parser->memberDef->isConstructor() || s_parser->memberDef->isDestructor() ) {
 
          // see if return needs to documented 
-         s_memberDef->setHasDocumentedReturnType(true);
+         s_parser->memberDef->setHasDocumentedReturnType(true);
       }
 
 
-      if ( s_memberDef->hasDocumentedReturnType() &&          
+      if ( s_parser->memberDef->hasDocumentedReturnType() &&          
                (returnType.isEmpty() || returnType.indexOf("void") != -1 || returnType.indexOf("subroutine") != -1 ||
-                s_memberDef->isConstructor() || s_memberDef->isDestructor() ))  {
+                s_parser->memberDef->isConstructor() || s_parser->memberDef->isDestructor() ))  {
 
          // see if return type is documented in a function w/o return type
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Documented empty return type");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Documented empty return type");
       }
    }
 }
@@ -737,7 +720,7 @@ static QSharedPointer<Definition> findDocsForMemberOrCompound(QString commandNam
    QSharedPointer<PageDef>      pd;
      
    // find('.') is a hack to detect files
-   bool found = getDefs(s_context.indexOf('.') == -1 ? s_context : QString(), name, args.isEmpty() ? QString() : args, 
+   bool found = getDefs(s_parser->context.indexOf('.') == -1 ? s_parser->context : QString(), name, args.isEmpty() ? QString() : args, 
                         md, cd, fd, nd, gd, false, QSharedPointer<FileDef>(), true);
    
    if (found && md) {
@@ -748,14 +731,14 @@ static QSharedPointer<Definition> findDocsForMemberOrCompound(QString commandNam
       return retval;
    }
 
-   int scopeOffset = s_context.length();
+   int scopeOffset = s_parser->context.length();
 
    do { 
       // for each scope
       QString fullName = cmdArg;
 
       if (scopeOffset > 0) {
-         fullName.prepend(s_context.left(scopeOffset) + "::");
+         fullName.prepend(s_parser->context.left(scopeOffset) + "::");
       }
 
       // try class, namespace, group, page, file reference
@@ -814,7 +797,7 @@ static QSharedPointer<Definition> findDocsForMemberOrCompound(QString commandNam
          scopeOffset = -1;
 
       } else {
-         scopeOffset = s_context.lastIndexOf("::", scopeOffset - 1);
+         scopeOffset = s_parser->context.lastIndexOf("::", scopeOffset - 1);
 
          if (scopeOffset == -1) {
             scopeOffset = 0;
@@ -834,14 +817,14 @@ static int handleStyleArgument(DocNode *parent, QList<DocNode *> &children, cons
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       return tok;
    }
 
    while ((tok = doctokenizerYYlex()) && tok != TK_WHITESPACE && tok != TK_NEWPARA && 
           tok != TK_LISTITEM && tok != TK_ENDLIST) {
 
-      static QRegExp specialChar("[.,|()\\[\\]:;\\?]");
+      QRegExp specialChar("[.,|()\\[\\]:;\\?]");
 
       if (tok == TK_WORD && g_token->name.length() == 1 && specialChar.indexIn(g_token->name) != -1) {
          // special character that ends the markup command
@@ -851,11 +834,11 @@ static int handleStyleArgument(DocNode *parent, QList<DocNode *> &children, cons
       if (!defaultHandleToken(parent, tok, children)) {
          switch (tok) {
             case TK_COMMAND:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command \\%s as the argument of a \\%s command",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command \\%s as the argument of a \\%s command",
                               qPrintable(g_token->name), qPrintable(cmdName));
                break;
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found while handling command %s",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found while handling command %s",
                               qPrintable(g_token->name), qPrintable(cmdName));
                break;
             case TK_HTMLTAG:
@@ -868,7 +851,7 @@ static int handleStyleArgument(DocNode *parent, QList<DocNode *> &children, cons
                break;
 
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s while handling command %s",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s while handling command %s",
                               qPrintable(tokToString(tok)), qPrintable(cmdName));
                break;
          }
@@ -888,9 +871,9 @@ static void handleStyleEnter(DocNode *parent, QList<DocNode *> &children, DocSty
 {
    DBG(("HandleStyleEnter\n"));
 
-   DocStyleChange *sc = new DocStyleChange(parent, s_nodeStack.count(), s, true, attribs);
+   DocStyleChange *sc = new DocStyleChange(parent, s_parser->nodeStack.count(), s, true, attribs);
    children.append(sc);
-   s_styleStack.push(*sc);
+   s_parser->styleStack.push(*sc);
 }
 
 /*! Called when a style change ends. For instance a \</b\> command is
@@ -900,27 +883,27 @@ static void handleStyleLeave(DocNode *parent, QList<DocNode *> &children, DocSty
 {
    DBG(("HandleStyleLeave\n"));
 
-   if (s_styleStack.isEmpty() || s_styleStack.top().style() != s || s_styleStack.top().position() != s_nodeStack.count()) { 
+   if (s_parser->styleStack.isEmpty() || s_parser->styleStack.top().style() != s || s_parser->styleStack.top().position() != s_parser->nodeStack.count()) { 
 
-      if (s_styleStack.isEmpty()) { 
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Found </%s> tag without matching <%s>",
+      if (s_parser->styleStack.isEmpty()) { 
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found </%s> tag without matching <%s>",
                         qPrintable(tagName), qPrintable(tagName));
 
-      } else if (s_styleStack.top().style() != s) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Found </%s> tag while expecting </%s>",
-                        qPrintable(tagName), qPrintable(s_styleStack.top().styleString()));
+      } else if (s_parser->styleStack.top().style() != s) {
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found </%s> tag while expecting </%s>",
+                        qPrintable(tagName), qPrintable(s_parser->styleStack.top().styleString()));
 
       } else {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Found </%s> at a different nesting level (%d) than expected (%d)",
-                        qPrintable(tagName), s_nodeStack.count(), s_styleStack.top().position());
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found </%s> at a different nesting level (%d) than expected (%d)",
+                        qPrintable(tagName), s_parser->nodeStack.count(), s_parser->styleStack.top().position());
       }
 
    } else { 
       // end the section
-      DocStyleChange *sc = new DocStyleChange(parent, s_nodeStack.count(), s, false);
+      DocStyleChange *sc = new DocStyleChange(parent, s_parser->nodeStack.count(), s, false);
 
       children.append(sc);
-      s_styleStack.pop();
+      s_parser->styleStack.pop();
    }
 }
 
@@ -930,28 +913,28 @@ static void handleStyleLeave(DocNode *parent, QList<DocNode *> &children, DocSty
  */
 static void handlePendingStyleCommands(DocNode *parent, QList<DocNode *> &children)
 {
-   if (! s_styleStack.isEmpty()) {
-      DocStyleChange sc = s_styleStack.top();
+   if (! s_parser->styleStack.isEmpty()) {
+      DocStyleChange sc = s_parser->styleStack.top();
 
-      while (sc.position() >= s_nodeStack.count()) {
+      while (sc.position() >= s_parser->nodeStack.count()) {
 
          // there are unclosed style modifiers in the paragraph
-         children.append(new DocStyleChange(parent, s_nodeStack.count(), sc.style(), false));
+         children.append(new DocStyleChange(parent, s_parser->nodeStack.count(), sc.style(), false));
       
-         s_initialStyleStack.push(sc);
+         s_parser->initialStyleStack.push(sc);
       
          //
-         if (s_styleStack.isEmpty()) {
+         if (s_parser->styleStack.isEmpty()) {
             break;
          }
-         s_styleStack.pop();
+         s_parser->styleStack.pop();
 
-         if (s_styleStack.isEmpty())  {
+         if (s_parser->styleStack.isEmpty())  {
             // all done 
             break;
    
          } else {
-            sc = s_styleStack.top();
+            sc = s_parser->styleStack.top();
 
          }   
       }
@@ -960,8 +943,8 @@ static void handlePendingStyleCommands(DocNode *parent, QList<DocNode *> &childr
 
 static void handleInitialStyleCommands(DocPara *parent, QList<DocNode *> &children)
 { 
-   while (! s_initialStyleStack.isEmpty()) {
-      DocStyleChange sc = s_initialStyleStack.pop();
+   while (! s_parser->initialStyleStack.isEmpty()) {
+      DocStyleChange sc = s_parser->initialStyleStack.pop();
       handleStyleEnter(parent, children, sc.style(), &sc.attribs());
    }
 }
@@ -981,7 +964,7 @@ static int handleAHref(DocNode *parent, QList<DocNode *> &children, const HtmlAt
             break; // stop looking for other tag attribs
 
          } else {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Found <a> tag with name option but without a value");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found <a> tag with name option but without a value");
          }
 
       } else if (opt.name == "href") { // <a href=url>..</a> tag
@@ -991,12 +974,12 @@ static int handleAHref(DocNode *parent, QList<DocNode *> &children, const HtmlAt
          // and remove the href attribute
          attrList.removeAt(index);
          
-         DocHRef *href = new DocHRef(parent, attrList, opt.value, s_relPath);
+         DocHRef *href = new DocHRef(parent, attrList, opt.value, s_parser->relPath);
          children.append(href);
 
-         s_insideHtmlLink = true;
+         s_parser->insideHtmlLink = true;
          retval = href->parse();
-         s_insideHtmlLink = false;
+         s_parser->insideHtmlLink = false;
 
          break;
 
@@ -1050,13 +1033,13 @@ QString DocStyleChange::styleString() const
 
 static void handleUnclosedStyleCommands()
 {
-   if (! s_initialStyleStack.isEmpty()) {
-      DocStyleChange sc = s_initialStyleStack.top();
-      s_initialStyleStack.pop();
+   if (! s_parser->initialStyleStack.isEmpty()) {
+      DocStyleChange sc = s_parser->initialStyleStack.top();
+      s_parser->initialStyleStack.pop();
 
       handleUnclosedStyleCommands();
 
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "End of comment block while expecting "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "End of comment block while expecting "
                      "command </%s>", csPrintable(sc.styleString()));
    }
 }
@@ -1081,23 +1064,23 @@ static void handleLinkedWord(DocNode *parent, QList<DocNode *> &children, bool i
    bool ambig;
    int len = g_token->name.length();
  
-   QSharedPointer<FileDef> fd = findFileDef(Doxy_Globals::inputNameDict, s_fileName, ambig);
+   QSharedPointer<FileDef> fd = findFileDef(Doxy_Globals::inputNameDict, s_parser->fileName, ambig);
 
    bool partA = false;
 
-   if (! s_insideHtmlLink) { 
+   if (! s_parser->insideHtmlLink) { 
       QString tName = g_token->name;
 
       // added 01/2016
       tName = renameNS_Aliases(tName, false);
 
-      if (resolveRef(s_context, tName, s_inSeeBlock, &compound, &member, false, fd, true)) {
+      if (resolveRef(s_parser->context, tName, s_parser->inSeeBlock, &compound, &member, false, fd, true)) {
          partA = true;
 
-      } else if ( ! s_context.isEmpty() )  {
-         // tried once with s_context now try again with "" looking for a global scope
+      } else if ( ! s_parser->context.isEmpty() )  {
+         // tried once with s_parser->context now try again with "" looking for a global scope
 
-         if (resolveRef("", tName, s_inSeeBlock, &compound, &member, true, QSharedPointer<FileDef>(), true))  {
+         if (resolveRef("", tName, s_parser->inSeeBlock, &compound, &member, true, QSharedPointer<FileDef>(), true))  {
             partA = true;
          } 
       }
@@ -1108,8 +1091,8 @@ static void handleLinkedWord(DocNode *parent, QList<DocNode *> &children, bool i
       if (member && member->isLinkable()) { 
 
          if (member->isObjCMethod()) {
-            bool localLink = s_memberDef ? member->getClassDef() == s_memberDef->getClassDef() : false;
-            name = member->objCMethodName(localLink, s_inSeeBlock); 
+            bool localLink = s_parser->memberDef ? member->getClassDef() == s_parser->memberDef->getClassDef() : false;
+            name = member->objCMethodName(localLink, s_parser->inSeeBlock); 
          }
 
          children.append(new DocLinkedWord(parent, name, member->getReference(), member->getOutputFileBase(),
@@ -1127,7 +1110,7 @@ static void handleLinkedWord(DocNode *parent, QList<DocNode *> &children, bool i
 
          }
 
-         if (s_context == g_token->name) { 
+         if (s_parser->context == g_token->name) { 
             // do not add a link to myself
             children.append(new DocWord(parent, name));
       
@@ -1147,14 +1130,14 @@ static void handleLinkedWord(DocNode *parent, QList<DocNode *> &children, bool i
          children.append(new DocWord(parent, name));
       }
 
-   } else if (! s_insideHtmlLink && len > 1 && g_token->name.at(len - 1) == ':') {
+   } else if (! s_parser->insideHtmlLink && len > 1 && g_token->name.at(len - 1) == ':') {
       // special case where matching Foo: fails to be an Obj-C reference, but Foo itself might be linkable
       g_token->name = g_token->name.left(len - 1);
 
       handleLinkedWord(parent, children, ignoreAutoLinkFlag);
       children.append(new DocWord(parent, ":"));
 
-   } else if (! s_insideHtmlLink && (cd = getClass(g_token->name + "-p"))) {
+   } else if (! s_parser->insideHtmlLink && (cd = getClass(g_token->name + "-p"))) {
       // special case: the token name is not a class, but could be a Obj-C protocol
 
       children.append(new DocLinkedWord(parent, name, cd->getReference(), cd->getOutputFileBase(), 
@@ -1164,7 +1147,7 @@ static void handleLinkedWord(DocNode *parent, QList<DocNode *> &children, bool i
       // normal non-linkable word
 
       if (g_token->name.left(1) == "#" || g_token->name.left(2) == "::") {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Explicit link request to '%s' could not be resolved",
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Explicit link request to '%s' could not be resolved",
                   csPrintable(name));
          children.append(new DocWord(parent, g_token->name));
 
@@ -1199,7 +1182,7 @@ static DocInternalRef *handleInternalRef(DocNode *parent)
    QString tokenName = g_token->name;
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(tokenName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(tokenName));
       return 0;
    }
 
@@ -1207,7 +1190,7 @@ static DocInternalRef *handleInternalRef(DocNode *parent)
    tok = doctokenizerYYlex(); // get the reference id
 
    if (tok != TK_WORD && tok != TK_LNKWORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(tokenName));
       return 0;
    }
@@ -1220,7 +1203,7 @@ static DocAnchor *handleAnchor(DocNode *parent)
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command",
                      qPrintable(g_token->name));
       return 0;
    }
@@ -1229,12 +1212,12 @@ static DocAnchor *handleAnchor(DocNode *parent)
    tok = doctokenizerYYlex();   // get the anchor id      
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
                      "argument of command %s", qPrintable(g_token->name));
       return 0;
 
    } else if (tok != TK_WORD && tok != TK_LNKWORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(g_token->name));
       return 0;
    }
@@ -1251,19 +1234,19 @@ static void handleAnchorName(DocNode *parent)
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(g_token->name));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(g_token->name));
       return;
    }
 
    tok = doctokenizerYYlex();   // get the anchor id      
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
                      "argument of command %s", qPrintable(g_token->name));
       return;
 
    } else if (tok != TK_WORD && tok != TK_LNKWORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(g_token->name));
       return;
    }
@@ -1275,7 +1258,7 @@ static void handleAnchorName(DocNode *parent)
    tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after \\anchorname command");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after \\anchorname command");
       return;
    }
 
@@ -1291,7 +1274,7 @@ static void handleAnchorName(DocNode *parent)
       sec->title = title;
 
    } else {
-     warn_doc_error(s_fileName, doctokenizerYYlineno, "Unable to find anchor %s for anchorname", qPrintable(id));
+     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unable to find anchor %s for anchorname", qPrintable(id));
 
    }    
 
@@ -1311,7 +1294,7 @@ static void handleAnchorName(DocNode *parent)
 static void defaultHandleTitleAndSize(const int cmd, DocNode *parent, QList<DocNode *> &children, 
                   QString &width, QString &height)
 {
-   s_nodeStack.push(parent);
+   s_parser->nodeStack.push(parent);
    
    // parse title
    doctokenizerYYsetStateTitle();
@@ -1332,16 +1315,16 @@ static void defaultHandleTitleAndSize(const int cmd, DocNode *parent, QList<DocN
       
          switch (tok) {
             case TK_COMMAND: 
-               warn_doc_error(s_fileName, doctokenizerYYlineno," Illegal command %s as part of a \\%s",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno," Illegal command %s as part of a \\%s",
                csPrintable(g_token->name), csPrintable(Mappers::cmdMapper->map(cmd)) );
                break;
             
             case TK_SYMBOL: 
-               warn_doc_error(s_fileName, doctokenizerYYlineno," Unsupported symbol %s found", csPrintable(g_token->name));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno," Unsupported symbol %s found", csPrintable(g_token->name));
                break;
             
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s", csPrintable(tokToString(tok)));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s", csPrintable(tokToString(tok)));
                break;
          }
       }
@@ -1362,7 +1345,7 @@ static void defaultHandleTitleAndSize(const int cmd, DocNode *parent, QList<DocN
          height = g_token->chars;
 
       } else {
-         warn_doc_error(s_fileName,doctokenizerYYlineno,"Unknown option %s after \\%s command, expected 'width' or 'height'",
+         warn_doc_error(s_parser->fileName,doctokenizerYYlineno,"Unknown option %s after \\%s command, expected 'width' or 'height'",
                   csPrintable(g_token->name), csPrintable(Mappers::cmdMapper->map(cmd)));
       }
 
@@ -1372,7 +1355,7 @@ static void defaultHandleTitleAndSize(const int cmd, DocNode *parent, QList<DocN
    doctokenizerYYsetStatePara();
 
    handlePendingStyleCommands(parent,children);
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == parent);
 }
 
@@ -1470,9 +1453,9 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                   break;
 
                case CMD_EMPHASIS: {
-                  children.append(new DocStyleChange(parent, s_nodeStack.count(), DocStyleChange::Italic, true));
+                  children.append(new DocStyleChange(parent, s_parser->nodeStack.count(), DocStyleChange::Italic, true));
                   tok = handleStyleArgument(parent, children, tokenName);
-                  children.append(new DocStyleChange(parent, s_nodeStack.count(), DocStyleChange::Italic, false));
+                  children.append(new DocStyleChange(parent, s_parser->nodeStack.count(), DocStyleChange::Italic, false));
 
                   if (tok != TK_WORD) {
                      children.append(new DocWhiteSpace(parent, " "));
@@ -1493,9 +1476,9 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                break;
 
                case CMD_BOLD: {
-                  children.append(new DocStyleChange(parent, s_nodeStack.count(), DocStyleChange::Bold, true));
+                  children.append(new DocStyleChange(parent, s_parser->nodeStack.count(), DocStyleChange::Bold, true));
                   tok = handleStyleArgument(parent, children, tokenName);
-                  children.append(new DocStyleChange(parent, s_nodeStack.count(), DocStyleChange::Bold, false));
+                  children.append(new DocStyleChange(parent, s_parser->nodeStack.count(), DocStyleChange::Bold, false));
 
                   if (tok != TK_WORD) {
                      children.append(new DocWhiteSpace(parent, " "));
@@ -1515,9 +1498,9 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                break;
 
                case CMD_CODE: {
-                  children.append(new DocStyleChange(parent, s_nodeStack.count(), DocStyleChange::Code, true));
+                  children.append(new DocStyleChange(parent, s_parser->nodeStack.count(), DocStyleChange::Code, true));
                   tok = handleStyleArgument(parent, children, tokenName);
-                  children.append(new DocStyleChange(parent, s_nodeStack.count(), DocStyleChange::Code, false));
+                  children.append(new DocStyleChange(parent, s_parser->nodeStack.count(), DocStyleChange::Code, false));
 
                   if (tok != TK_WORD) {
                      children.append(new DocWhiteSpace(parent, " "));
@@ -1539,11 +1522,11 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                case CMD_HTMLONLY: {
                   doctokenizerYYsetStateHtmlOnly();
                   tok = doctokenizerYYlex();
-                  children.append(new DocVerbatim(parent, s_context, g_token->verb, DocVerbatim::HtmlOnly,
-                                  s_isExample, s_exampleName, g_token->name == "block"));
+                  children.append(new DocVerbatim(parent, s_parser->context, g_token->verb, DocVerbatim::HtmlOnly,
+                                  s_parser->isExample, s_parser->exampleName, g_token->name == "block"));
 
                   if (tok == 0) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "Htmlonly section ended without an end marker");
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Htmlonly section ended without an end marker");
                   }
                   doctokenizerYYsetStatePara();
                }
@@ -1552,10 +1535,10 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                case CMD_MANONLY: {
                   doctokenizerYYsetStateManOnly();
                   tok = doctokenizerYYlex();
-                  children.append(new DocVerbatim(parent, s_context, g_token->verb, DocVerbatim::ManOnly, s_isExample, s_exampleName));
+                  children.append(new DocVerbatim(parent, s_parser->context, g_token->verb, DocVerbatim::ManOnly, s_parser->isExample, s_parser->exampleName));
 
                   if (tok == 0) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "Manonly section ended without an end marker");
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Manonly section ended without an end marker");
                   }
 
                   doctokenizerYYsetStatePara();
@@ -1565,10 +1548,10 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                case CMD_RTFONLY: {
                   doctokenizerYYsetStateRtfOnly();
                   tok = doctokenizerYYlex();
-                  children.append(new DocVerbatim(parent, s_context, g_token->verb, DocVerbatim::RtfOnly, s_isExample, s_exampleName));
+                  children.append(new DocVerbatim(parent, s_parser->context, g_token->verb, DocVerbatim::RtfOnly, s_parser->isExample, s_parser->exampleName));
 
                   if (tok == 0) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "Rtfonly section ended without an end marker");
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Rtfonly section ended without an end marker");
                   }
                   doctokenizerYYsetStatePara();
                }
@@ -1577,9 +1560,9 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                case CMD_LATEXONLY: {
                   doctokenizerYYsetStateLatexOnly();
                   tok = doctokenizerYYlex();
-                  children.append(new DocVerbatim(parent, s_context, g_token->verb, DocVerbatim::LatexOnly, s_isExample, s_exampleName));
+                  children.append(new DocVerbatim(parent, s_parser->context, g_token->verb, DocVerbatim::LatexOnly, s_parser->isExample, s_parser->exampleName));
                   if (tok == 0) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "Latexonly section ended without an end marker", doctokenizerYYlineno);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Latexonly section ended without an end marker", doctokenizerYYlineno);
                   }
                   doctokenizerYYsetStatePara();
                }
@@ -1588,9 +1571,9 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                case CMD_XMLONLY: {
                   doctokenizerYYsetStateXmlOnly();
                   tok = doctokenizerYYlex();
-                  children.append(new DocVerbatim(parent, s_context, g_token->verb, DocVerbatim::XmlOnly, s_isExample, s_exampleName));
+                  children.append(new DocVerbatim(parent, s_parser->context, g_token->verb, DocVerbatim::XmlOnly, s_parser->isExample, s_parser->exampleName));
                   if (tok == 0) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "Xmlonly section ended without an end marker", doctokenizerYYlineno);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Xmlonly section ended without an end marker", doctokenizerYYlineno);
                   }
                   doctokenizerYYsetStatePara();
                }
@@ -1599,9 +1582,9 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                case CMD_DBONLY: {
                   doctokenizerYYsetStateDbOnly();
                   tok = doctokenizerYYlex();
-                  children.append(new DocVerbatim(parent, s_context, g_token->verb, DocVerbatim::DocbookOnly, s_isExample, s_exampleName));
+                  children.append(new DocVerbatim(parent, s_parser->context, g_token->verb, DocVerbatim::DocbookOnly, s_parser->isExample, s_parser->exampleName));
                   if (tok == 0) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "Docbookonly section ended without an end marker", doctokenizerYYlineno);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Docbookonly section ended without an end marker", doctokenizerYYlineno);
                   }
                   doctokenizerYYsetStatePara();
                }
@@ -1643,7 +1626,7 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
                   doctokenizerYYlex();
 
                   scope = g_token->name;
-                  s_context = scope;  
+                  s_parser->context = scope;  
                 
                   doctokenizerYYsetStatePara();
                }
@@ -1657,11 +1640,11 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
          case TK_HTMLTAG: {
             switch (Mappers::htmlTagMapper->map(tokenName)) {
                case HTML_DIV:
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Found <div> tag in heading\n");
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found <div> tag in heading\n");
                   break;
 
                case HTML_PRE:
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Found <pre> tag in heading\n");
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found <pre> tag in heading\n");
                   break;
 
                case HTML_BOLD:
@@ -1756,7 +1739,7 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
             break;
 
          case TK_URL:
-            if (s_insideHtmlLink) {
+            if (s_parser->insideHtmlLink) {
                children.append(new DocWord(parent, g_token->name));
             } else {
                children.append(new DocURL(parent, g_token->name, g_token->isEMailAddr));
@@ -1796,7 +1779,7 @@ static void handleImg(DocNode *parent, QList<DocNode *> &children, const HtmlAtt
    }
 
    if (! found) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "IMG tag does not have a SRC attribute\n");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "IMG tag does not have a SRC attribute\n");
    }
 }
 
@@ -1814,7 +1797,7 @@ static int internalValidatingParseDoc(DocNode *parent, QList<DocNode *> &childre
       return retval;
    }
 
-   doctokenizerYYinit(doc, s_fileName);
+   doctokenizerYYinit(doc, s_parser->fileName);
 
    // first parse any number of paragraphs
    bool isFirst = true;
@@ -1891,12 +1874,12 @@ static void readTextFileByName(const QString &file, QString &text)
       text = fileToString(fd->getFilePath(), filterSourceFiles);
 
    } else if (ambig) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "included file name %s is ambiguous"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "included file name %s is ambiguous"
                   "Possible candidates:\n%s", csPrintable(file),
                   csPrintable(showFileDefMatches(Doxy_Globals::exampleNameDict, file)));
 
    } else {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Included file %s was not found. "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Included file %s was not found. "
                      "Check the EXAMPLE PATH in your project file.", csPrintable(file));
    }
 }
@@ -1906,18 +1889,18 @@ DocWord::DocWord(DocNode *parent, const QString &word)
 {
    m_parent = parent;
  
-   if (Doxy_Globals::searchIndex && ! s_searchUrl.isEmpty()) {
+   if (Doxy_Globals::searchIndex && ! s_parser->searchUrl.isEmpty()) {
       Doxy_Globals::searchIndex->addWord(word, false);
    }
 }
 
 DocLinkedWord::DocLinkedWord(DocNode *parent, const QString &word, const QString &ref, const QString &file,
                              const QString &anchor, const QString &tooltip) 
-   : m_word(word), m_ref(ref), m_file(file), m_relPath(s_relPath), m_anchor(anchor), m_tooltip(tooltip)
+   : m_word(word), m_ref(ref), m_file(file), m_relPath(s_parser->relPath), m_anchor(anchor), m_tooltip(tooltip)
 {
    m_parent = parent;
    
-   if (Doxy_Globals::searchIndex && !s_searchUrl.isEmpty()) {
+   if (Doxy_Globals::searchIndex && !s_parser->searchUrl.isEmpty()) {
       Doxy_Globals::searchIndex->addWord(word, false);
    }
 }
@@ -1927,7 +1910,7 @@ DocAnchor::DocAnchor(DocNode *parent, const QString &id, bool newAnchor)
    m_parent = parent;
 
    if (id.isEmpty()) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Empty anchor label");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Empty anchor label");
    }
 
    if (newAnchor) { 
@@ -1942,7 +1925,7 @@ DocAnchor::DocAnchor(DocNode *parent, const QString &id, bool newAnchor)
          m_anchor = id;
 
       } else {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Invalid cite anchor id '%s'", qPrintable(id));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Invalid cite anchor id '%s'", qPrintable(id));
          m_file   = "invalid";
          m_anchor = "invalid";
          
@@ -1956,13 +1939,13 @@ DocAnchor::DocAnchor(DocNode *parent, const QString &id, bool newAnchor)
          m_file   = sec->fileName;
          m_anchor = sec->label;
 
-         if (s_sectionDict && s_sectionDict->find(id) == 0) {           
+         if (s_parser->sectionDict && s_parser->sectionDict->find(id) == 0) {           
             // insert in dictionary
-            s_sectionDict->insert(id, sec);
+            s_parser->sectionDict->insert(id, sec);
          }
 
       } else {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Invalid anchor id '%s'", qPrintable(id));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Invalid anchor id '%s'", qPrintable(id));
          m_file   = "invalid";
          m_anchor = "invalid";
 
@@ -1973,7 +1956,7 @@ DocAnchor::DocAnchor(DocNode *parent, const QString &id, bool newAnchor)
 DocVerbatim::DocVerbatim(DocNode *parent, const QString &context, const QString &text, Type t, bool isExample,
                          const QString &exampleFile, bool isBlock, const QString &lang) 
    : m_context(context), m_text(text), m_type(t), m_isExample(isExample), m_exampleFile(exampleFile),
-     m_relPath(s_relPath), m_lang(lang), m_isBlock(isBlock)
+     m_relPath(s_parser->relPath), m_lang(lang), m_isBlock(isBlock)
 {
    m_parent = parent;
 }
@@ -1987,9 +1970,9 @@ void DocInclude::parse()
       case Include:
       case DontInclude:
          readTextFileByName(m_file, m_text);
-         s_includeFileText   = m_text;
-         s_includeFileOffset = 0;
-         s_includeFileLength = m_text.length();        
+         s_parser->includeFileText   = m_text;
+         s_parser->includeFileOffset = 0;
+         s_parser->includeFileLength = m_text.length();        
          break;
 
       case VerbInclude:  
@@ -2009,7 +1992,7 @@ void DocInclude::parse()
 
          if (! m_blockId.isEmpty() && (count = m_text.count(m_blockId)) != 2) {
 
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Block marked with %s for \\snippet should appear twice "
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Block marked with %s for \\snippet should appear twice "
                 "in file %s, found it %d times\n", qPrintable(m_blockId), qPrintable(m_file), count);
          }
          break;
@@ -2018,10 +2001,10 @@ void DocInclude::parse()
 
 void DocIncOperator::parse()
 {
-   const QChar *p = s_includeFileText.constData();
+   const QChar *p = s_parser->includeFileText.constData();
 
-   uint l = s_includeFileLength;
-   uint o = s_includeFileOffset;
+   uint l = s_parser->includeFileLength;
+   uint o = s_parser->includeFileOffset;
 
    DBG(("DocIncOperator::parse() text=%s off=%d len=%d\n", qPrintable(p), o, l));
 
@@ -2047,12 +2030,12 @@ void DocIncOperator::parse()
             o++;
          }
 
-         if (s_includeFileText.mid(so, o - so).indexOf(m_pattern) != -1) {
-            m_text = s_includeFileText.mid(so, o - so);
+         if (s_parser->includeFileText.mid(so, o - so).indexOf(m_pattern) != -1) {
+            m_text = s_parser->includeFileText.mid(so, o - so);
             DBG(("DocIncOperator::parse() Line: %s\n", qPrintable(m_text)));
          }
 
-         s_includeFileOffset = qMin(l, o + 1); // set pointer to start of new line
+         s_parser->includeFileOffset = qMin(l, o + 1); // set pointer to start of new line
          break;
 
       case SkipLine:
@@ -2075,15 +2058,15 @@ void DocIncOperator::parse()
                o++;
             }
 
-            if (s_includeFileText.mid(so, o - so).indexOf(m_pattern) != -1) {
-               m_text = s_includeFileText.mid(so, o - so);
+            if (s_parser->includeFileText.mid(so, o - so).indexOf(m_pattern) != -1) {
+               m_text = s_parser->includeFileText.mid(so, o - so);
                DBG(("DocIncOperator::parse() SkipLine: %s\n", qPrintable(m_text)));
                break;
             }
             o++; // skip new line
          }
 
-         s_includeFileOffset = qMin(l, o + 1); // set pointer to start of new line
+         s_parser->includeFileOffset = qMin(l, o + 1); // set pointer to start of new line
          break;
 
       case Skip:
@@ -2104,12 +2087,12 @@ void DocIncOperator::parse()
                }
                o++;
             }
-            if (s_includeFileText.mid(so, o - so).indexOf(m_pattern) != -1) {
+            if (s_parser->includeFileText.mid(so, o - so).indexOf(m_pattern) != -1) {
                break;
             }
             o++; // skip new line
          }
-         s_includeFileOffset = so; // set pointer to start of new line
+         s_parser->includeFileOffset = so; // set pointer to start of new line
          break;
 
       case Until:
@@ -2132,15 +2115,15 @@ void DocIncOperator::parse()
                o++;
             }
 
-            if (s_includeFileText.mid(so, o - so).indexOf(m_pattern) != -1) {
-               m_text = s_includeFileText.mid(bo, o - bo);
+            if (s_parser->includeFileText.mid(so, o - so).indexOf(m_pattern) != -1) {
+               m_text = s_parser->includeFileText.mid(bo, o - bo);
                DBG(("DocIncOperator::parse() Until: %s\n", qPrintable(m_text)));
                break;
             }
             o++; // skip new line
          }
 
-         s_includeFileOffset = qMin(l, o + 1); // set pointer to start of new line
+         s_parser->includeFileOffset = qMin(l, o + 1); // set pointer to start of new line
          break;
    }
 }
@@ -2154,29 +2137,29 @@ void DocCopy::parse(QList<DocNode *> &children)
 
    if (def) {
 
-      if (s_copyStack.indexOf(def) == -1) { // definition not parsed earlier
-         bool  hasParamCommand  = s_hasParamCommand;
-         bool  hasReturnCommand = s_hasReturnCommand;
+      if (s_parser->copyStack.indexOf(def) == -1) { // definition not parsed earlier
+         bool  hasParamCommand  = s_parser->hasParamCommand;
+         bool  hasReturnCommand = s_parser->hasReturnCommand;
 
-         QSet<QString> paramsFound  = s_paramsFound;
+         QSet<QString> paramsFound  = s_parser->paramsFound;
  
          docParserPushContext(false);
-         s_scope = def;
+         s_parser->scope = def;
 
          if (def->definitionType() == Definition::TypeMember && def->getOuterScope()) {
             if (def->getOuterScope() != Doxy_Globals::globalScope) {
-               s_context = def->getOuterScope()->name();
+               s_parser->context = def->getOuterScope()->name();
             }
 
          } else if (def != Doxy_Globals::globalScope) {
-            s_context = def->name();
+            s_parser->context = def->name();
 
          }
 
-         s_styleStack.clear();
-         s_nodeStack.clear();
-         s_paramsFound.clear();
-         s_copyStack.append(def);
+         s_parser->styleStack.clear();
+         s_parser->nodeStack.clear();
+         s_parser->paramsFound.clear();
+         s_parser->copyStack.append(def);
 
          // make sure the descriptions end with a newline, so the parser will correctly
          // handle them in all cases
@@ -2185,45 +2168,45 @@ void DocCopy::parse(QList<DocNode *> &children)
             brief += '\n';
             internalValidatingParseDoc(m_parent, children, brief);
 
-            hasParamCommand  = hasParamCommand  || s_hasParamCommand;
-            hasReturnCommand = hasReturnCommand || s_hasReturnCommand;
+            hasParamCommand  = hasParamCommand  || s_parser->hasParamCommand;
+            hasReturnCommand = hasReturnCommand || s_parser->hasReturnCommand;
                                             
-            paramsFound.unite(s_paramsFound);
+            paramsFound.unite(s_parser->paramsFound);
          }
 
          if (m_copyDetails) {
             doc += '\n';
             internalValidatingParseDoc(m_parent, children, doc);
 
-            hasParamCommand  = hasParamCommand  || s_hasParamCommand;
-            hasReturnCommand = hasReturnCommand || s_hasReturnCommand;            
+            hasParamCommand  = hasParamCommand  || s_parser->hasParamCommand;
+            hasReturnCommand = hasReturnCommand || s_parser->hasReturnCommand;            
 
-            paramsFound.unite(s_paramsFound);
+            paramsFound.unite(s_parser->paramsFound);
          }
 
-         s_copyStack.removeOne(def);
-         assert(s_styleStack.isEmpty());
-         assert(s_nodeStack.isEmpty());
+         s_parser->copyStack.removeOne(def);
+         assert(s_parser->styleStack.isEmpty());
+         assert(s_parser->nodeStack.isEmpty());
 
          docParserPopContext(true);
 
-         s_hasParamCommand  = hasParamCommand;
-         s_hasReturnCommand = hasReturnCommand;
-         s_paramsFound      = paramsFound;
+         s_parser->hasParamCommand  = hasParamCommand;
+         s_parser->hasReturnCommand = hasReturnCommand;
+         s_parser->paramsFound      = paramsFound;
 
       } else { 
          // oops, recursion
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "recursive call chain of \\copydoc commands detected at %d\n",
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "recursive call chain of \\copydoc commands detected at %d\n",
                         doctokenizerYYlineno);
       }
 
    } else {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "target %s of \\copydoc command not found", qPrintable(m_link));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "target %s of \\copydoc command not found", qPrintable(m_link));
    }
 }
 
 DocXRefItem::DocXRefItem(DocNode *parent, int id, const QString &key)
-    : m_id(id), m_key(key), m_relPath(s_relPath)
+    : m_id(id), m_key(key), m_relPath(s_parser->relPath)
 {
    m_parent = parent;
 }
@@ -2244,7 +2227,7 @@ bool DocXRefItem::parse()
          assert(item != nullptr);
 
          if (item) {
-            if (s_memberDef && ! s_memberDef->name().isEmpty() && s_memberDef->name().at(0) == '@') {
+            if (s_parser->memberDef && ! s_parser->memberDef->name().isEmpty() && s_parser->memberDef->name().at(0) == '@') {
                m_file   = "@";  // can not cross reference anonymous enum
                m_anchor = "@";
    
@@ -2270,7 +2253,7 @@ bool DocXRefItem::parse()
 }
 
 DocFormula::DocFormula(DocNode *parent, int id) 
-   : m_relPath(s_relPath)
+   : m_relPath(s_parser->relPath)
 {
    m_parent = parent;
 
@@ -2287,7 +2270,7 @@ DocFormula::DocFormula(DocNode *parent, int id)
 
    } else { 
       // wrong \form#<n> command
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Incorrect formula id %d", id);
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Incorrect formula id %d", id);
       m_id = -1;
 
    }
@@ -2297,7 +2280,7 @@ DocFormula::DocFormula(DocNode *parent, int id)
 //{
 //  int retval;
 //  DBG(("DocLanguage::parse() start\n"));
-//  s_nodeStack.push(this);
+//  s_parser->nodeStack.push(this);
 //
 //  // parse one or more paragraphs
 //  bool isFirst=true;
@@ -2313,7 +2296,7 @@ DocFormula::DocFormula(DocNode *parent, int id)
 //  if (par) par->markLast();
 //
 //  DBG(("DocLanguage::parse() end\n"));
-//  DocNode *n = s_nodeStack.pop();
+//  DocNode *n = s_parser->nodeStack.pop();
 //  assert(n==this);
 //  return retval;
 //}
@@ -2321,7 +2304,7 @@ DocFormula::DocFormula(DocNode *parent, int id)
 void DocSecRefItem::parse()
 {
    DBG(("DocSecRefItem::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    doctokenizerYYsetStateTitle();
    int tok;
@@ -2330,17 +2313,17 @@ void DocSecRefItem::parse()
       if (! defaultHandleToken(this, tok, m_children)) {
          switch (tok) {
             case TK_COMMAND:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\refitem",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\refitem",
                               qPrintable(g_token->name));
                break;
 
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
                               qPrintable(g_token->name));
                break;
 
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)) );
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)) );
                break;
          }
       }
@@ -2358,19 +2341,19 @@ void DocSecRefItem::parse()
          m_file   = sec->fileName;
          m_anchor = sec->label;
 
-         if (s_sectionDict && s_sectionDict->find(m_target) == 0) {
-            s_sectionDict->insert(m_target, sec);
+         if (s_parser->sectionDict && s_parser->sectionDict->find(m_target) == 0) {
+            s_parser->sectionDict->insert(m_target, sec);
          }
 
       } else {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "reference to unknown section %s", qPrintable(m_target));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "reference to unknown section %s", qPrintable(m_target));
       }
 
    } else {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "reference to empty target");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "reference to empty target");
    }
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocSecRefItem::parse() end\n"));
@@ -2379,7 +2362,7 @@ void DocSecRefItem::parse()
 void DocSecRefList::parse()
 {
    DBG(("DocSecRefList::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int tok = doctokenizerYYlex();
 
@@ -2395,12 +2378,12 @@ void DocSecRefList::parse()
             case CMD_SECREFITEM: {
                int tok = doctokenizerYYlex();
                if (tok != TK_WHITESPACE) {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after \\refitem command");
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after \\refitem command");
                   break;
                }
                tok = doctokenizerYYlex();
                if (tok != TK_WORD && tok != TK_LNKWORD) {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of \\refitem",
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of \\refitem",
                                  qPrintable(tokToString(tok)));
                   break;
                }
@@ -2414,7 +2397,7 @@ void DocSecRefList::parse()
             case CMD_ENDSECREFLIST:
                goto endsecreflist;
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\secreflist",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\secreflist",
                               qPrintable(g_token->name));
                goto endsecreflist;
          }
@@ -2423,7 +2406,7 @@ void DocSecRefList::parse()
          // ignore whitespace
 
       } else {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s inside section reference list",
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s inside section reference list",
                         qPrintable(tokToString(tok)));
 
          goto endsecreflist;
@@ -2433,14 +2416,14 @@ void DocSecRefList::parse()
    }
 
 endsecreflist:  
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocSecRefList::parse() end\n"));
 }
 
 DocInternalRef::DocInternalRef(DocNode *parent, const QString &ref)
-   : m_relPath(s_relPath)
+   : m_relPath(s_parser->relPath)
 {
    m_parent = parent;
    int i = ref.indexOf('#');
@@ -2457,7 +2440,7 @@ DocInternalRef::DocInternalRef(DocNode *parent, const QString &ref)
 void DocInternalRef::parse()
 {
    DBG(("DocInternalRef::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
   
    int tok;
 
@@ -2465,15 +2448,15 @@ void DocInternalRef::parse()
       if (! defaultHandleToken(this, tok, m_children)) {
          switch (tok) {
             case TK_COMMAND:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\ref",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\ref",
                               qPrintable(g_token->name));
                break;
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
                               qPrintable(g_token->name));
                break;
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
                break;
          }
       }
@@ -2481,7 +2464,7 @@ void DocInternalRef::parse()
 
    handlePendingStyleCommands(this, m_children);
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocInternalRef::parse() end\n"));
@@ -2498,7 +2481,7 @@ DocRef::DocRef(DocNode *parent, const QString &target, const QString &context)
 
    SrcLangExt lang = getLanguageFromFileName(target);
 
-   m_relPath = s_relPath;
+   m_relPath = s_parser->relPath;
 
    QSharedPointer<SectionInfo> sec = Doxy_Globals::sectionDict->find(target);
 
@@ -2511,7 +2494,7 @@ DocRef::DocRef(DocNode *parent, const QString &target, const QString &context)
       // ref to section or anchor      
 
       if (sec->dupAnchor_cnt > 0)  {
-         warn(s_fileName, doctokenizerYYlineno, "Link to ambiguous anchor '%s', "
+         warn(s_parser->fileName, doctokenizerYYlineno, "Link to ambiguous anchor '%s', "
             "using first anchor declared in %s, line %d", csPrintable(target), 
             csPrintable(sec->dupAnchor_fName), sec->lineNr);
       }
@@ -2559,8 +2542,8 @@ DocRef::DocRef(DocNode *parent, const QString &target, const QString &context)
 
             // Objective C Method
             QSharedPointer<MemberDef> member = compound.dynamicCast<MemberDef>();
-            bool localLink = s_memberDef ? member->getClassDef() == s_memberDef->getClassDef() : false;
-            m_text = member->objCMethodName(localLink, s_inSeeBlock);
+            bool localLink = s_parser->memberDef ? member->getClassDef() == s_parser->memberDef->getClassDef() : false;
+            m_text = member->objCMethodName(localLink, s_parser->inSeeBlock);
          }
 
          m_file = compound->getOutputFileBase();
@@ -2579,7 +2562,7 @@ DocRef::DocRef(DocNode *parent, const QString &target, const QString &context)
    }
 
    m_text = target;
-   warn_doc_error(s_fileName, doctokenizerYYlineno, "Unable to resolve reference to '%s' for \\ref command", 
+   warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unable to resolve reference to '%s' for \\ref command", 
                   qPrintable(target));
 }
 
@@ -2609,7 +2592,7 @@ static void flattenParagraphs(DocNode *root, QList<DocNode *> &children)
 void DocRef::parse()
 {
    DBG(("DocRef::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int tok;
 
@@ -2618,17 +2601,17 @@ void DocRef::parse()
 
          switch (tok) {
             case TK_COMMAND:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\ref",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\ref",
                               qPrintable(g_token->name));
                break;
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
                               qPrintable(g_token->name));
                break;
             case TK_HTMLTAG:
                break;
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s",
                               qPrintable(tokToString(tok)));
                break;
          }
@@ -2636,19 +2619,19 @@ void DocRef::parse()
    }
 
    if (m_children.isEmpty() && ! m_text.isEmpty()) {
-      s_insideHtmlLink = true;
+      s_parser->insideHtmlLink = true;
 
       docParserPushContext();
       internalValidatingParseDoc(this, m_children, m_text);
       docParserPopContext();
 
-      s_insideHtmlLink = false;
+      s_parser->insideHtmlLink = false;
       flattenParagraphs(this, m_children);
    }
 
    handlePendingStyleCommands(this, m_children);
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 }
 
@@ -2659,7 +2642,7 @@ DocCite::DocCite(DocNode *parent, const QString &target, const QString &)
    m_parent = parent;
    assert(! target.isEmpty());
 
-   m_relPath = s_relPath;
+   m_relPath = s_parser->relPath;
    CiteInfo *cite = Doxy_Globals::citeDict->find(target);
 
    if (numBibFiles > 0 && cite && !cite->text.isEmpty()) {
@@ -2676,14 +2659,14 @@ DocCite::DocCite(DocNode *parent, const QString &target, const QString &)
    m_text = target;
 
    if (numBibFiles == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "No bib files for the \\cite command were specified in 'CITE BIB FILES'");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "No bib files for the \\cite command were specified in 'CITE BIB FILES'");
 
    } else if (cite == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unable to resolve reference to '%s' for \\cite command", 
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unable to resolve reference to '%s' for \\cite command", 
                   csPrintable(target));
 
    } else {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "No value was specified for the \\cite command to '%s'",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "No value was specified for the \\cite command to '%s'",
                   csPrintable(target));
    }   
 }
@@ -2696,13 +2679,13 @@ DocLink::DocLink(DocNode *parent, const QString &target)
    QString anchor;
 
    m_refText = target;
-   m_relPath = s_relPath;
+   m_relPath = s_parser->relPath;
 
    if (! m_refText.isEmpty() && m_refText.at(0) == '#') {
       m_refText = m_refText.right(m_refText.length() - 1);
    }
 
-   if (resolveLink(s_context, stripKnownExtensions(target), s_inSeeBlock, &compound, anchor)) {
+   if (resolveLink(s_parser->context, stripKnownExtensions(target), s_parser->inSeeBlock, &compound, anchor)) {
       m_anchor = anchor;
 
       if (compound && compound->isLinkable()) {
@@ -2721,14 +2704,14 @@ DocLink::DocLink(DocNode *parent, const QString &target)
    }
 
    // bogus link target
-   warn_doc_error(s_fileName, doctokenizerYYlineno, "unable to resolve link to '%s' for \\link command", qPrintable(target));
+   warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "unable to resolve link to '%s' for \\link command", qPrintable(target));
 }
 
 
 QString DocLink::parse(bool isJavaLink, bool isXmlLink)
 {     
    DBG(("DocLink::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    QString result;
    int tok;
@@ -2740,22 +2723,22 @@ QString DocLink::parse(bool isJavaLink, bool isXmlLink)
                switch (Mappers::cmdMapper->map(g_token->name)) {
                   case CMD_ENDLINK:
                      if (isJavaLink) {
-                        warn_doc_error(s_fileName, doctokenizerYYlineno, "{@link.. ended with @endlink command");
+                        warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "{@link.. ended with @endlink command");
                      }
                      goto endlink;
                   default:
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\link",
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a \\link",
                                     qPrintable(g_token->name));
                      break;
                }
                break;
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
                               qPrintable(g_token->name));
                break;
             case TK_HTMLTAG:
                if (g_token->name != "see" || !isXmlLink) {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected xml/html command %s found",
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected xml/html command %s found",
                                  qPrintable(g_token->name));
                }
                goto endlink;
@@ -2785,14 +2768,14 @@ QString DocLink::parse(bool isJavaLink, bool isXmlLink)
                break;
 
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
                break;
          }
       }
    }
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while inside link command\n");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while inside link command\n");
    }
 
 endlink:
@@ -2804,7 +2787,7 @@ endlink:
 
    handlePendingStyleCommands(this, m_children);
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocLink::parse() end\n"));
@@ -2813,7 +2796,7 @@ endlink:
 }
 
 DocDotFile::DocDotFile(DocNode *parent, const QString &name, const QString &context) :
-   m_name(name), m_relPath(s_relPath), m_context(context)
+   m_name(name), m_relPath(s_parser->relPath), m_context(context)
 {
    m_parent = parent;
 }
@@ -2834,17 +2817,17 @@ void DocDotFile::parse()
       m_file = fd->getFilePath();
 
    } else if (ambig) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Included dot file name %s is ambiguous.\n"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Included dot file name %s is ambiguous.\n"
                   "Possible candidates:\n%s", csPrintable(m_name),
                   csPrintable(showFileDefMatches(Doxy_Globals::exampleNameDict, m_name)));
    } else {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Included dot file %s was not found "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Included dot file %s was not found "
                   "in any of the paths specified via DOTFILE_DIRS", csPrintable(m_name));
    }   
 }
 
 DocMscFile::DocMscFile(DocNode *parent, const QString &name, const QString &context) :
-   m_name(name), m_relPath(s_relPath), m_context(context)
+   m_name(name), m_relPath(s_parser->relPath), m_context(context)
 {
    m_parent = parent;
 }
@@ -2865,18 +2848,18 @@ void DocMscFile::parse()
       m_file = fd->getFilePath();
 
    } else if (ambig) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Included msc file name %s is ambiguous.\n"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Included msc file name %s is ambiguous.\n"
                   "Possible candidates:\n%s", csPrintable(m_name),
                   csPrintable(showFileDefMatches(Doxy_Globals::exampleNameDict, m_name)));
 
    } else {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Included msc file %s was not found "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Included msc file %s was not found "
                   "in any of the paths specified via MSCFILE DIRS", csPrintable(m_name));
    }    
 }
 
 DocDiaFile::DocDiaFile(DocNode *parent, const QString &name, const QString &context) :
-   m_name(name), m_relPath(s_relPath), m_context(context)
+   m_name(name), m_relPath(s_parser->relPath), m_context(context)
 {
    m_parent = parent;
 }
@@ -2897,18 +2880,18 @@ void DocDiaFile::parse()
       m_file = fd->getFilePath();
 
    } else if (ambig) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Included dia file name %s is ambiguous.\n"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Included dia file name %s is ambiguous.\n"
                   "Possible candidates:\n%s", qPrintable(m_name),
                   csPrintable(showFileDefMatches(Doxy_Globals::exampleNameDict, m_name)));
 
    } else {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Included dia file %s was not found "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Included dia file %s was not found "
                   "in any of the paths specified via DIAFILE DIRS", csPrintable(m_name));
    }     
 }
 
 DocImage::DocImage(DocNode *parent, const HtmlAttribList &attribs, const QString &name, Type t, const QString &url) 
-   : m_attribs(attribs), m_name(name), m_type(t), m_relPath(s_relPath), m_url(url)
+   : m_attribs(attribs), m_name(name), m_type(t), m_relPath(s_parser->relPath), m_url(url)
 {
    m_parent = parent;
 }
@@ -2921,7 +2904,7 @@ void DocImage::parse()
 int DocHtmlHeader::parse()
 {  
    DBG(("DocHtmlHeader::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;   
    int tok;
@@ -2930,7 +2913,7 @@ int DocHtmlHeader::parse()
       if (! defaultHandleToken(this, tok, m_children)) {
          switch (tok) {
             case TK_COMMAND:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a <h%d> tag",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a <h%d> tag",
                               csPrintable(g_token->name), m_level);
                break;
 
@@ -2938,37 +2921,37 @@ int DocHtmlHeader::parse()
                int tagId = Mappers::htmlTagMapper->map(g_token->name);
                if (tagId == HTML_H1 && g_token->endTag) {        // found </h1> tag
                   if (m_level != 1) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "<h%d> ended with </h1>", m_level);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "<h%d> ended with </h1>", m_level);
                   }
                   goto endheader;
 
                } else if (tagId == HTML_H2 && g_token->endTag) { // found </h2> tag
                   if (m_level != 2) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "<h%d> ended with </h2>", m_level);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "<h%d> ended with </h2>", m_level);
                   }
                   goto endheader;
 
                } else if (tagId == HTML_H3 && g_token->endTag) { // found </h3> tag
                   if (m_level != 3) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "<h%d> ended with </h3>", m_level);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "<h%d> ended with </h3>", m_level);
                   }
                   goto endheader;
 
                } else if (tagId == HTML_H4 && g_token->endTag) { // found </h4> tag
                   if (m_level != 4) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "<h%d> ended with </h4>", m_level);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "<h%d> ended with </h4>", m_level);
                   }
                   goto endheader;
 
                } else if (tagId == HTML_H5 && g_token->endTag) { // found </h5> tag
                   if (m_level != 5) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "<h%d> ended with </h5>", m_level);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "<h%d> ended with </h5>", m_level);
                   }
                   goto endheader;
 
                } else if (tagId == HTML_H6 && g_token->endTag) { // found </h6> tag
                   if (m_level != 6) {
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "<h%d> ended with </h6>", m_level);
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "<h%d> ended with </h6>", m_level);
                   }
                   goto endheader;
 
@@ -2981,7 +2964,7 @@ int DocHtmlHeader::parse()
                   m_children.append(lb);
 
                } else {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected html tag <%s%s> found within <h%d> context",
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected html tag <%s%s> found within <h%d> context",
                                  g_token->endTag ? "/" : "", csPrintable(g_token->name), m_level);
                }
 
@@ -2989,12 +2972,12 @@ int DocHtmlHeader::parse()
             break;
 
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
                               csPrintable(g_token->name));
                break;
 
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s",
                               csPrintable(tokToString(tok)));
                break;
          }
@@ -3002,14 +2985,14 @@ int DocHtmlHeader::parse()
    }
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while inside"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while inside"
                      " <h%d> tag\n", m_level);
    }
 
 endheader:
    handlePendingStyleCommands(this, m_children);
    
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlHeader::parse() end\n"));
@@ -3020,7 +3003,7 @@ endheader:
 int DocHRef::parse()
 {
    DBG(("DocHRef::parse() start\n"));  
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
    int tok;
@@ -3029,11 +3012,11 @@ int DocHRef::parse()
       if (!defaultHandleToken(this, tok, m_children)) {
          switch (tok) {
             case TK_COMMAND:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a <a>..</a> block",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a <a>..</a> block",
                               qPrintable(g_token->name));
                break;
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
                               qPrintable(g_token->name));
                break;
             case TK_HTMLTAG:
@@ -3043,27 +3026,27 @@ int DocHRef::parse()
                if (tagId == HTML_A && g_token->endTag) { // found </a> tag
                   goto endhref;
                } else {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected html tag <%s%s> found within <a href=...> context",
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected html tag <%s%s> found within <a href=...> context",
                                  g_token->endTag ? "/" : "", qPrintable(g_token->name), doctokenizerYYlineno);
                }
             }
             break;
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s",
                               qPrintable(tokToString(tok)), doctokenizerYYlineno);
                break;
          }
       }
    }
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while inside"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while inside"
                      " <a href=...> tag", doctokenizerYYlineno);
    }
 
 endhref:
    handlePendingStyleCommands(this, m_children);
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHRef::parse() end\n"));
@@ -3074,7 +3057,7 @@ endhref:
 int DocInternal::parse(int level)
 {   
    DBG(("DocInternal::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
   
    int retval = RetVal_OK;
 
@@ -3103,7 +3086,7 @@ int DocInternal::parse(int level)
       }
 
       if (retval == TK_LISTITEM) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Invalid list item found", doctokenizerYYlineno);
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Invalid list item found", doctokenizerYYlineno);
       }
 
    } while (retval != 0 &&
@@ -3131,10 +3114,10 @@ int DocInternal::parse(int level)
    }
 
    if (retval == RetVal_Internal) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "\\internal command found inside internal section");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "\\internal command found inside internal section");
    }
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocInternal::parse() end: retval=%x\n", retval));
@@ -3145,13 +3128,13 @@ int DocInternal::parse(int level)
 int DocIndexEntry::parse()
 { 
    DBG(("DocIndexEntry::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;   
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after \\addindex command");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after \\addindex command");
       goto endindexentry;
    }
 
@@ -3221,7 +3204,7 @@ int DocIndexEntry::parse()
                   m_entry += "---";
                   break;
                default:
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected symbol found as argument of \\addindex");
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected symbol found as argument of \\addindex");
                   break;
             }
          }
@@ -3280,14 +3263,14 @@ int DocIndexEntry::parse()
                   break;
 
                default:
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected command %s found as argument of \\addindex",
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected command %s found as argument of \\addindex",
                         csPrintable(g_token->name));
                   break;
             }
             break;
 
          default:
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s", csPrintable(tokToString(tok)));
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s", csPrintable(tokToString(tok)));
             break;
       }
    }
@@ -3296,7 +3279,7 @@ int DocIndexEntry::parse()
 
 endindexentry:
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocIndexEntry::parse() end retval=%x\n", retval));
@@ -3307,7 +3290,7 @@ endindexentry:
 int DocHtmlCaption::parse()
 {
    DBG(("DocHtmlCaption::parse() start\n"));
-   s_nodeStack.push(this);  
+   s_parser->nodeStack.push(this);  
 
    int retval = 0;
    int tok;
@@ -3316,12 +3299,12 @@ int DocHtmlCaption::parse()
       if (!defaultHandleToken(this, tok, m_children)) {
          switch (tok) {
             case TK_COMMAND:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a <caption> tag",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a <caption> tag",
                               qPrintable(g_token->name));
                break;
 
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
                               qPrintable(g_token->name));
                break;
 
@@ -3331,27 +3314,27 @@ int DocHtmlCaption::parse()
                   retval = RetVal_OK;
                   goto endcaption;
                } else {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected html tag <%s%s> found within <caption> context",
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected html tag <%s%s> found within <caption> context",
                                  g_token->endTag ? "/" : "", qPrintable(g_token->name));
                }
             }
             break;
 
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
                break;
          }
       }
    }
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while inside"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while inside"
                      " <caption> tag", doctokenizerYYlineno);
    }
 
 endcaption:
    handlePendingStyleCommands(this, m_children);
    
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlCaption::parse() end\n"));
@@ -3362,7 +3345,7 @@ endcaption:
 int DocHtmlCell::parse()
 {
    DBG(("DocHtmlCell::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;    
 
@@ -3408,7 +3391,7 @@ int DocHtmlCell::parse()
       par->markLast();
    }
    
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlCell::parse() end\n"));
@@ -3419,7 +3402,7 @@ int DocHtmlCell::parse()
 int DocHtmlCell::parseXml()
 {
    DBG(("DocHtmlCell::parseXml() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
    
@@ -3462,7 +3445,7 @@ int DocHtmlCell::parseXml()
       par->markLast();
    }
    
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlCell::parseXml() end\n"));
@@ -3527,7 +3510,7 @@ DocHtmlCell::Alignment DocHtmlCell::alignment() const
 int DocHtmlRow::parse()
 {  
    DBG(("DocHtmlRow::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
   
    int retval = RetVal_OK;
 
@@ -3555,7 +3538,7 @@ int DocHtmlRow::parse()
 
       } else { 
          // found some other tag
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <td> or <th> tag but "
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <td> or <th> tag but "
                         "found <%s> instead", qPrintable(g_token->name));
 
          doctokenizerYYpushBackHtmlTag(g_token->name);
@@ -3563,11 +3546,11 @@ int DocHtmlRow::parse()
       }
 
    } else if (tok == 0) { // premature end of comment
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while looking for an html description title");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while looking for an html description title");
       goto endrow;
 
    } else { // token other than html token
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <td> or <th> tag, found %s token instead ", qPrintable(tokToString(tok)));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <td> or <th> tag, found %s token instead ", qPrintable(tokToString(tok)));
       goto endrow;
 
    }
@@ -3591,7 +3574,7 @@ int DocHtmlRow::parse()
    }
 
 endrow:   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlRow::parse() end\n"));
@@ -3602,7 +3585,7 @@ endrow:
 int DocHtmlRow::parseXml(bool isHeading)
 {     
    DBG(("DocHtmlRow::parseXml() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
 
@@ -3629,7 +3612,7 @@ int DocHtmlRow::parseXml(bool isHeading)
 
       } else { 
          // found some other tag
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <term> or <description> tag, "
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <term> or <description> tag, "
                         "found <%s> instead", qPrintable(g_token->name));
 
          doctokenizerYYpushBackHtmlTag(g_token->name);
@@ -3637,12 +3620,12 @@ int DocHtmlRow::parseXml(bool isHeading)
       }
 
    } else if (tok == 0) { // premature end of comment
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while looking"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while looking"
                      " for an html description title");
       goto endrow;
 
    } else { // token other than html token
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <td> or <th> tag, found %s token instead",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <td> or <th> tag, found %s token instead",
                      qPrintable(tokToString(tok)));
       goto endrow;
    }
@@ -3663,7 +3646,7 @@ int DocHtmlRow::parseXml(bool isHeading)
    }
 
 endrow:   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlRow::parseXml() end\n"));
@@ -3674,7 +3657,7 @@ endrow:
 int DocHtmlTable::parse()
 {
    DBG(("DocHtmlTable::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
    
    int retval = RetVal_OK;
 
@@ -3699,7 +3682,7 @@ getrow:
          // found <caption> tag
 
          if (m_caption) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "table already has a caption, found another one");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "table already has a caption, found another one");
 
          } else {
             m_caption = new DocHtmlCaption(this, g_token->attribs);
@@ -3713,17 +3696,17 @@ getrow:
 
       } else { 
          // found wrong token
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <tr> or <caption> tag but "
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <tr> or <caption> tag but "
                         "found <%s%s> instead", g_token->endTag ? "/" : "", qPrintable(g_token->name));
       }
 
    } else if (tok == 0) { 
       // premature end of comment
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while looking for a <tr> or <caption> tag");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while looking for a <tr> or <caption> tag");
 
    } else { 
       // token other than html token
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <tr> tag, found %s token instead ", qPrintable(tokToString(tok)));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <tr> tag, found %s token instead ", qPrintable(tokToString(tok)));
    }
 
    // parse one or more rows
@@ -3736,7 +3719,7 @@ getrow:
 
    computeTableGrid();
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlTable::parse() end\n"));
@@ -3747,7 +3730,7 @@ getrow:
 int DocHtmlTable::parseXml()
 { 
    DBG(("DocHtmlTable::parseXml() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
  
    int retval = RetVal_OK;
 
@@ -3786,7 +3769,7 @@ int DocHtmlTable::parseXml()
 
    computeTableGrid();
    
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlTable::parseXml() end\n"));
@@ -3897,7 +3880,7 @@ void DocHtmlTable::accept(DocVisitor *v)
 int DocHtmlDescTitle::parse()
 {   
    DBG(("DocHtmlDescTitle::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = 0;
    int tok;
@@ -3917,19 +3900,19 @@ int DocHtmlDescTitle::parse()
                      int tok = doctokenizerYYlex();
 
                      if (tok != TK_WHITESPACE) {
-                        warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(g_token->name));
+                        warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(g_token->name));
 
                      } else {
                         doctokenizerYYsetStateRef();
                         tok = doctokenizerYYlex(); // get the reference id
 
                         if (tok != TK_WORD) {
-                           warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+                           warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                                           qPrintable(tokToString(tok)), qPrintable(cmdName));
 
                         } else {
                            // add the name
-                           DocRef *ref = new DocRef(this, g_token->name, s_context);
+                           DocRef *ref = new DocRef(this, g_token->name, s_parser->context);
                            m_children.append(ref);
                            ref->parse();
                         }
@@ -3945,7 +3928,7 @@ int DocHtmlDescTitle::parse()
                   case CMD_LINK: {
                      int tok = doctokenizerYYlex();
                      if (tok != TK_WHITESPACE) {
-                        warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command",
+                        warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command",
                                        qPrintable(cmdName));
 
                      } else {
@@ -3953,7 +3936,7 @@ int DocHtmlDescTitle::parse()
                         tok = doctokenizerYYlex();
 
                         if (tok != TK_WORD) {
-                           warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+                           warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                                           qPrintable(tokToString(tok)), qPrintable(cmdName));
 
                         } else {
@@ -3971,14 +3954,14 @@ int DocHtmlDescTitle::parse()
 
                   break;
                   default:
-                     warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a <dt> tag",
+                     warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a <dt> tag",
                                     qPrintable(g_token->name));
                }
             }
             break;
 
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found", qPrintable(g_token->name));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found", qPrintable(g_token->name));
                break;
 
             case TK_HTMLTAG: {
@@ -4007,27 +3990,27 @@ int DocHtmlDescTitle::parse()
                   }
 
                } else {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected html tag <%s%s> found within <dt> context",
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected html tag <%s%s> found within <dt> context",
                                  g_token->endTag ? "/" : "", qPrintable(g_token->name));
                }
             }
             break;
 
             default: 
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
                break;
          }
       }
    }
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while inside <dt> tag");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while inside <dt> tag");
    }
 
 endtitle:
    handlePendingStyleCommands(this, m_children);
    
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlDescTitle::parse() end\n"));
@@ -4038,7 +4021,7 @@ endtitle:
 int DocHtmlDescData::parse()
 {  
    DBG(("DocHtmlDescData::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
   
    m_attribs = g_token->attribs;
    int retval = 0;
@@ -4071,7 +4054,7 @@ int DocHtmlDescData::parse()
       par->markLast();
    }
    
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlDescData::parse() end\n"));
@@ -4083,7 +4066,7 @@ int DocHtmlDescData::parse()
 int DocHtmlDescList::parse()
 {
    DBG(("DocHtmlDescList::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
    
    int retval = RetVal_OK;
    int tok = doctokenizerYYlex();
@@ -4102,18 +4085,18 @@ int DocHtmlDescList::parse()
 
       } else { 
          // found some other tag
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <dt> tag, found <%s> instead", qPrintable(g_token->name));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <dt> tag, found <%s> instead", qPrintable(g_token->name));
          doctokenizerYYpushBackHtmlTag(g_token->name);
          goto enddesclist;
       }
 
    } else if (tok == 0) { // premature end of comment
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while looking"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while looking"
                      " for an html description title");
       goto enddesclist;
 
    } else { // token other than html token
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <dt> tag, found %s token instead", qPrintable(tokToString(tok)));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <dt> tag, found %s token instead", qPrintable(tokToString(tok)));
       goto enddesclist;
 
    }
@@ -4141,13 +4124,13 @@ int DocHtmlDescList::parse()
       }
    
       if (retval == 0) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while inside <dl> block");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while inside <dl> block");
       }
    }
 
 enddesclist:
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlDescList::parse() end\n"));
@@ -4158,7 +4141,7 @@ enddesclist:
 int DocHtmlListItem::parse()
 {
    DBG(("DocHtmlListItem::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = 0;
   
@@ -4191,7 +4174,7 @@ int DocHtmlListItem::parse()
       par->markLast();
    }
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlListItem::parse() end retval=%x\n", retval));
@@ -4202,7 +4185,7 @@ int DocHtmlListItem::parse()
 int DocHtmlListItem::parseXml()
 {
    DBG(("DocHtmlListItem::parseXml() start\n")); 
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = 0;
 
@@ -4244,7 +4227,7 @@ int DocHtmlListItem::parseXml()
       par->markLast();
    }
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlListItem::parseXml() end retval=%x\n", retval));
@@ -4255,7 +4238,7 @@ int DocHtmlListItem::parseXml()
 int DocHtmlList::parse()
 {
    DBG(("DocHtmlList::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
    int num = 1;
@@ -4282,7 +4265,7 @@ int DocHtmlList::parse()
          // add dummy item to obtain valid HTML
 
          m_children.append(new DocHtmlListItem(this, HtmlAttribList(), 1));
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "empty list");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "empty list");
          retval = RetVal_EndList;
          goto endlist;
 
@@ -4291,7 +4274,7 @@ int DocHtmlList::parse()
          // add dummy item to obtain valid HTML
          m_children.append(new DocHtmlListItem(this, HtmlAttribList(), 1));
 
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <li> tag,  "
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <li> tag,  "
                         "found <%s%s> instead", g_token->endTag ? "/" : "", qPrintable(g_token->name));
 
          doctokenizerYYpushBackHtmlTag(g_token->name);
@@ -4303,7 +4286,7 @@ int DocHtmlList::parse()
       // add dummy item to obtain valid HTML
 
       m_children.append(new DocHtmlListItem(this, HtmlAttribList(), 1));
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while looking"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while looking"
                      " for an html list item");
       goto endlist;
 
@@ -4312,7 +4295,7 @@ int DocHtmlList::parse()
       // add dummy item to obtain valid HTML
 
       m_children.append(new DocHtmlListItem(this, HtmlAttribList(), 1));
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <li> tag, found %s token instead",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <li> tag, found %s token instead",
                      qPrintable(tokToString(tok)));
       goto endlist;
    }
@@ -4325,12 +4308,12 @@ int DocHtmlList::parse()
    } while (retval == RetVal_ListItem);
 
    if (retval == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while inside <%cl> block",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while inside <%cl> block",
                      m_type == Unordered ? 'u' : 'o');
    }
 
 endlist:   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlList::parse() end retval=%x\n", retval));
@@ -4341,7 +4324,7 @@ endlist:
 int DocHtmlList::parseXml()
 {
    DBG(("DocHtmlList::parseXml() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
    int num = 1; 
@@ -4361,7 +4344,7 @@ int DocHtmlList::parseXml()
       if (tagId == XML_ITEM && !g_token->endTag) { // found <item> tag
          // ok, we can go on.
       } else { // found some other tag
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <item> tag, "
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <item> tag, "
                         "found <%s> instead", qPrintable(g_token->name));
 
          doctokenizerYYpushBackHtmlTag(g_token->name);
@@ -4369,12 +4352,12 @@ int DocHtmlList::parseXml()
       }
 
    } else if (tok == 0) { // premature end of comment
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while looking"
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while looking"
                      " for an html list item");
       goto endlist;
 
    } else { // token other than html token
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected <item> tag, found %s token instead",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected <item> tag, found %s token instead",
                      qPrintable(tokToString(tok)));
       goto endlist;
    }
@@ -4392,12 +4375,12 @@ int DocHtmlList::parseXml()
    } while (retval == RetVal_ListItem);
 
    if (retval == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment while inside <list type=\"%s\"> block",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment while inside <list type=\"%s\"> block",
                      m_type == Unordered ? "bullet" : "number");
    }
 
 endlist:  
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlList::parseXml() end retval=%x\n", retval));
@@ -4409,7 +4392,7 @@ endlist:
 int DocHtmlBlockQuote::parse()
 {
    DBG(("DocHtmlBlockQuote::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = 0;
 
@@ -4442,7 +4425,7 @@ int DocHtmlBlockQuote::parse()
       par->markLast();
    }
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocHtmlBlockQuote::parse() end retval=%x\n", retval));
@@ -4453,7 +4436,7 @@ int DocHtmlBlockQuote::parse()
 int DocParBlock::parse()
 {
    DBG(("DocParBlock::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = 0;
 
@@ -4485,7 +4468,7 @@ int DocParBlock::parse()
       par->markLast();
    }
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocParBlock::parse() end retval=%x\n", retval));
@@ -4495,13 +4478,13 @@ int DocParBlock::parse()
 
 int DocSimpleListItem::parse()
 {
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int rv = m_paragraph->parse();
    m_paragraph->markFirst();
    m_paragraph->markLast();
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    return rv;
@@ -4509,7 +4492,7 @@ int DocSimpleListItem::parse()
 
 int DocSimpleList::parse()
 {
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
    int rv;
 
    do {
@@ -4519,7 +4502,7 @@ int DocSimpleList::parse()
 
    } while (rv == RetVal_ListItem);
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    return (rv != TK_NEWPARA) ? rv : RetVal_OK;
@@ -4533,7 +4516,7 @@ DocAutoListItem::DocAutoListItem(DocNode *parent, int indent, int num)
 
 int DocAutoListItem::parse()
 {
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
 
@@ -4571,7 +4554,7 @@ int DocAutoListItem::parse()
       lastPar->markLast();
    }
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
   
    return retval;
@@ -4585,7 +4568,7 @@ DocAutoList::DocAutoList(DocNode *parent, int indent, bool isEnumList, int depth
 
 int DocAutoList::parse()
 {
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
    int num = 1;
@@ -4610,7 +4593,7 @@ int DocAutoList::parse()
 
    doctokenizerYYendAutoList();
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    return retval;
@@ -4619,7 +4602,7 @@ int DocAutoList::parse()
 void DocTitle::parse()
 {
    DBG(("DocTitle::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int tok;
    doctokenizerYYsetStateTitle();
@@ -4629,15 +4612,15 @@ void DocTitle::parse()
       if (! defaultHandleToken(this, tok, m_children)) {
          switch (tok) {
             case TK_COMMAND:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal command %s as part of a title section",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal command %s as part of a title section",
                               qPrintable(g_token->name));
                break;
             case TK_SYMBOL:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found",
                               qPrintable(g_token->name));
                break;
             default:
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s",
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s",
                               qPrintable(tokToString(tok)));
                break;
          }
@@ -4647,7 +4630,7 @@ void DocTitle::parse()
    doctokenizerYYsetStatePara();
    handlePendingStyleCommands(this, m_children);
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocTitle::parse() end\n"));
@@ -4688,7 +4671,7 @@ void DocSimpleSect::accept(DocVisitor *v)
 int DocSimpleSect::parse(bool userTitle, bool needsSeparator)
 {
    DBG(("DocSimpleSect::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    // handle case for user defined title
    if (userTitle) {
@@ -4723,7 +4706,7 @@ int DocSimpleSect::parse(bool userTitle, bool needsSeparator)
          
    }      
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocSimpleSect::parse() end retval=%d\n", retval));
@@ -4734,7 +4717,7 @@ int DocSimpleSect::parse(bool userTitle, bool needsSeparator)
 int DocSimpleSect::parseRcs()
 {
    DBG(("DocSimpleSect::parseRcs() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    m_docTitle = QMakeShared<DocTitle>(this);
    m_docTitle->parseFromString(g_token->name);
@@ -4744,7 +4727,7 @@ int DocSimpleSect::parseRcs()
    internalValidatingParseDoc(this, m_children, text);
    docParserPopContext(); // this will restore the old g_token
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocSimpleSect::parseRcs()\n"));
@@ -4755,7 +4738,7 @@ int DocSimpleSect::parseRcs()
 int DocSimpleSect::parseXml()
 {
    DBG(("DocSimpleSect::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
 
@@ -4792,7 +4775,7 @@ int DocSimpleSect::parseXml()
       }
    }
   
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocSimpleSect::parseXml() end retval=%d\n", retval));
@@ -4816,9 +4799,9 @@ void DocSimpleSect::appendLinkWord(const QString &word)
       p->injectToken(TK_WHITESPACE, " ");
    }
 
-   s_inSeeBlock = true;
+   s_parser->inSeeBlock = true;
    p->injectToken(TK_LNKWORD, word);
-   s_inSeeBlock = false;
+   s_parser->inSeeBlock = false;
 }
 
 QString DocSimpleSect::typeString() const
@@ -4883,7 +4866,7 @@ QString DocSimpleSect::typeString() const
 int DocParamList::parse(const QString &cmdName)
 {   
    DBG(("DocParamList::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
 
@@ -4893,7 +4876,7 @@ int DocParamList::parse(const QString &cmdName)
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       retval = 0;
       goto endparamlist;
    }
@@ -4910,17 +4893,17 @@ int DocParamList::parse(const QString &cmdName)
          if (typeSeparator != -1) {
             handleParameterType(this, m_paramTypes, g_token->name.left(typeSeparator));
             g_token->name = g_token->name.mid(typeSeparator + 1);
-            s_hasParamCommand = true;
+            s_parser->hasParamCommand = true;
             checkArgumentName(g_token->name, true);
             ((DocParamSect *)parent())->m_hasTypeSpecifier = true;
 
          } else {
-            s_hasParamCommand = true;
+            s_parser->hasParamCommand = true;
             checkArgumentName(g_token->name, true);
          }
 
       } else if (m_type == DocParamSect::RetVal) {
-         s_hasReturnCommand = true;
+         s_parser->hasReturnCommand = true;
          checkArgumentName(g_token->name, false);
       }
      
@@ -4931,13 +4914,13 @@ int DocParamList::parse(const QString &cmdName)
    doctokenizerYYsetStatePara();
 
    if (tok == 0) { /* premature end of comment block */
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
                      "argument of command %s", qPrintable(cmdName));
       retval = 0;
       goto endparamlist;
    }
    if (tok != TK_WHITESPACE) { /* premature end of comment block */
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token in comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token in comment block while parsing the "
                      "argument of command %s", qPrintable(saveCmdName));
       retval = 0;
       goto endparamlist;
@@ -4950,7 +4933,7 @@ int DocParamList::parse(const QString &cmdName)
    par->markLast();
 
 endparamlist:  
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocParamList::parse() end retval=%d\n", retval));
@@ -4961,17 +4944,17 @@ endparamlist:
 int DocParamList::parseXml(const QString &paramName)
 {  
    DBG(("DocParamList::parseXml() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
    g_token->name = paramName;
 
    if (m_type == DocParamSect::Param) {
-      s_hasParamCommand = true;
+      s_parser->hasParamCommand = true;
       checkArgumentName(g_token->name, true);
 
    } else if (m_type == DocParamSect::RetVal) {
-      s_hasReturnCommand = true;
+      s_parser->hasReturnCommand = true;
       checkArgumentName(g_token->name, false);
    }
 
@@ -5012,12 +4995,12 @@ int DocParamList::parseXml(const QString &paramName)
 
 
    if (retval == 0) { /* premature end of comment block */
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "unterminated param or exception tag");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "unterminated param or exception tag");
    } else {
       retval = RetVal_OK;
    }
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocParamList::parse() end retval=%d\n", retval));
@@ -5028,7 +5011,7 @@ int DocParamList::parseXml(const QString &paramName)
 int DocParamSect::parse(const QString &cmdName, bool xmlContext, Direction d)
 {  
    DBG(("DocParamSect::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
 
@@ -5060,7 +5043,7 @@ int DocParamSect::parse(const QString &cmdName, bool xmlContext, Direction d)
       retval = RetVal_OK;
    }
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocParamSect::parse() end retval=%d\n", retval));
@@ -5131,7 +5114,7 @@ void DocPara::handleCite()
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable("cite"));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable("cite"));
       return;
    }
 
@@ -5139,18 +5122,18 @@ void DocPara::handleCite()
    tok = doctokenizerYYlex();
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
                      "argument of command %s\n", qPrintable("cite"));
       return;
 
    } else if (tok != TK_WORD && tok != TK_LNKWORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable("cite"));
       return;
    }
 
    g_token->sectionId = g_token->name;
-   DocCite *cite = new DocCite(this, g_token->name, s_context);
+   DocCite *cite = new DocCite(this, g_token->name, s_parser->context);
    m_children.append(cite);
   
    doctokenizerYYsetStatePara();
@@ -5162,26 +5145,26 @@ void DocPara::handleSortId()
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable("sortid"));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable("sortid"));
       return;
    }
 
    tok = doctokenizerYYlex();
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
                      "argument of command %s\n", qPrintable("sortid"));
       return;
 
    } else if (tok != TK_WORD && tok != TK_LNKWORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable("sortid"));
       return;
    }
 
-   if (s_scope) {  
+   if (s_parser->scope) {  
       // save the sort id value       
-      s_scope->setSortId(g_token->name.toInt());
+      s_parser->scope->setSortId(g_token->name.toInt());
    }
   
    doctokenizerYYsetStatePara();
@@ -5215,7 +5198,7 @@ void DocPara::handleIncludeOperator(const QString &cmdName, DocIncOperator::Type
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       return;
    }
 
@@ -5224,17 +5207,17 @@ void DocPara::handleIncludeOperator(const QString &cmdName, DocIncOperator::Type
    doctokenizerYYsetStatePara();
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
                      "argument of command %s", qPrintable(cmdName));
       return;
 
    } else if (tok != TK_WORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(cmdName));
       return;
    }
 
-   DocIncOperator *op = new DocIncOperator(this, t, g_token->name, s_context, s_isExample, s_exampleName);
+   DocIncOperator *op = new DocIncOperator(this, t, g_token->name, s_parser->context, s_parser->isExample, s_parser->exampleName);
    
    DocNode *n1 = 0;
    DocNode *n2 = 0;
@@ -5270,20 +5253,20 @@ void DocPara::handleImage(const QString &cmdName)
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       return;
    }
 
    tok = doctokenizerYYlex();
 
    if (tok != TK_WORD && tok != TK_LNKWORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(cmdName));
       return;
    }
    tok = doctokenizerYYlex();
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       return;
    }
 
@@ -5299,7 +5282,7 @@ void DocPara::handleImage(const QString &cmdName)
    } else if (imgType == "rtf") {
       t = DocImage::Rtf;
    } else {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "image type %s specified as the first argument of "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "image type %s specified as the first argument of "
                      "%s is not valid", qPrintable(imgType), qPrintable(cmdName));
       return;
    }
@@ -5309,7 +5292,7 @@ void DocPara::handleImage(const QString &cmdName)
    doctokenizerYYsetStatePara();
 
    if (tok != TK_WORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(cmdName));
       return;
    }
@@ -5326,7 +5309,7 @@ void DocPara::handleFile(const QString &cmdName)
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command",
                      csPrintable(cmdName));
       return;
    }
@@ -5336,14 +5319,14 @@ void DocPara::handleFile(const QString &cmdName)
    doctokenizerYYsetStatePara();
 
    if (tok != TK_WORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      csPrintable(tokToString(tok)), csPrintable(cmdName));
       return;
    }
 
    QString name = g_token->name;
 
-   T *df = new T(this, name, s_context);
+   T *df = new T(this, name, s_parser->context);
    m_children.append(df);
    df->parse();
 }
@@ -5353,14 +5336,14 @@ void DocPara::handleLink(const QString &cmdName, bool isJavaLink)
    int tok = doctokenizerYYlex();
  
   if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       return;
    }
    doctokenizerYYsetStateLink();
    tok = doctokenizerYYlex();
 
    if (tok != TK_WORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "%s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "%s as the argument of %s",
                     qPrintable(tokToString(tok)), qPrintable(cmdName));
       return;
    }
@@ -5380,7 +5363,7 @@ void DocPara::handleRef(const QString &cmdName)
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       return;
    }
 
@@ -5389,12 +5372,12 @@ void DocPara::handleRef(const QString &cmdName)
    DocRef *ref = 0;
 
    if (tok != TK_WORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(cmdName));
       goto endref;
    }
 
-   ref = new DocRef(this, g_token->name, s_context);
+   ref = new DocRef(this, g_token->name, s_parser->context);
    m_children.append(ref);
    ref->parse();
 
@@ -5409,7 +5392,7 @@ void DocPara::handleInclude(const QString &cmdName, DocInclude::Type t)
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       return;
    }
 
@@ -5418,12 +5401,12 @@ void DocPara::handleInclude(const QString &cmdName, DocInclude::Type t)
    doctokenizerYYsetStatePara();
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
                      "argument of command %s", qPrintable(cmdName));
       return;
 
    } else if (tok != TK_WORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(cmdName));
       return;
    }
@@ -5433,7 +5416,7 @@ void DocPara::handleInclude(const QString &cmdName, DocInclude::Type t)
 
    if (t == DocInclude::Snippet) {
       if (fileName == "this") {
-         fileName = s_fileName;
+         fileName = s_parser->fileName;
       }
 
       doctokenizerYYsetStateSnippet();
@@ -5441,7 +5424,7 @@ void DocPara::handleInclude(const QString &cmdName, DocInclude::Type t)
       doctokenizerYYsetStatePara();
 
       if (tok != TK_WORD) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected block identifier, " 
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected block identifier, " 
                "found token %s instead while parsing the %s command", 
                qPrintable(tokToString(tok)), qPrintable(cmdName));
 
@@ -5450,7 +5433,7 @@ void DocPara::handleInclude(const QString &cmdName, DocInclude::Type t)
       blockId = "[" + g_token->name + "]";
    }
 
-   DocInclude *inc = new DocInclude(this, fileName, s_context, t, s_isExample, s_exampleName, blockId);
+   DocInclude *inc = new DocInclude(this, fileName, s_parser->context, t, s_parser->isExample, s_parser->exampleName, blockId);
    m_children.append(inc);
    inc->parse();
 }
@@ -5461,19 +5444,19 @@ void DocPara::handleSection(const QString &cmdName)
    int tok = doctokenizerYYlex();
 
    if (tok != TK_WHITESPACE) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Expected whitespace after %s command", qPrintable(cmdName));
       return;
    }
 
    tok = doctokenizerYYlex();
 
    if (tok == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end of comment block while parsing the "
                      "argument of command %s\n", qPrintable(cmdName));
       return;
 
    } else if (tok != TK_WORD && tok != TK_LNKWORD) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s as the argument of %s",
                      qPrintable(tokToString(tok)), qPrintable(cmdName));
       return;
    }
@@ -5512,7 +5495,7 @@ int DocPara::handleStartCode()
       lang = "." + lang;
    }
 
-   if (s_xmlComment) {
+   if (s_parser->xmlComment) {
       g_token->verb = substitute(substitute(g_token->verb,"&lt;","<"), "&gt;",">");
    }
 
@@ -5528,11 +5511,11 @@ int DocPara::handleStartCode()
       i++;
    }
 
-   m_children.append(new DocVerbatim(this, s_context, stripIndentation(g_token->verb.mid(li)), DocVerbatim::Code, s_isExample, 
-                     s_exampleName, false, lang));
+   m_children.append(new DocVerbatim(this, s_parser->context, stripIndentation(g_token->verb.mid(li)), DocVerbatim::Code, s_parser->isExample, 
+                     s_parser->exampleName, false, lang));
 
    if (retval == 0) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "code section ended without end marker");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "code section ended without end marker");
    }
 
    doctokenizerYYsetStatePara();
@@ -5541,31 +5524,31 @@ int DocPara::handleStartCode()
 
 void DocPara::handleInheritDoc()
 {
-   if (s_memberDef) { // inheriting docs from a member
-      QSharedPointer<MemberDef> reMd = s_memberDef->reimplements();
+   if (s_parser->memberDef) { // inheriting docs from a member
+      QSharedPointer<MemberDef> reMd = s_parser->memberDef->reimplements();
 
       if (reMd) { // member from which was inherited.
-         QSharedPointer<MemberDef> thisMd = s_memberDef;
+         QSharedPointer<MemberDef> thisMd = s_parser->memberDef;
          
          docParserPushContext();
-         s_scope = reMd->getOuterScope();
+         s_parser->scope = reMd->getOuterScope();
 
-         if (s_scope != Doxy_Globals::globalScope) {
-            s_context = s_scope->name();
+         if (s_parser->scope != Doxy_Globals::globalScope) {
+            s_parser->context = s_parser->scope->name();
          }
 
-         s_memberDef = reMd;
-         s_styleStack.clear();
-         s_nodeStack.clear();
-         s_copyStack.append(reMd);
+         s_parser->memberDef = reMd;
+         s_parser->styleStack.clear();
+         s_parser->nodeStack.clear();
+         s_parser->copyStack.append(reMd);
 
          internalValidatingParseDoc(this, m_children, reMd->briefDescription());
          internalValidatingParseDoc(this, m_children, reMd->documentation());
 
-         s_copyStack.removeOne(reMd);
+         s_parser->copyStack.removeOne(reMd);
 
          docParserPopContext(true);
-         s_memberDef = thisMd;
+         s_parser->memberDef = thisMd;
       }
    }
 }
@@ -5579,31 +5562,31 @@ int DocPara::handleCommand(const QString &cmdName)
 
    switch (cmdId) {
       case CMD_UNKNOWN:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Found unknown command '\\%s'", csPrintable(cmdName));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found unknown command '\\%s'", csPrintable(cmdName));
          break;
 
       case CMD_EMPHASIS:
-         m_children.append(new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Italic, true));
+         m_children.append(new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Italic, true));
          retval = handleStyleArgument(this, m_children, cmdName);
-         m_children.append(new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Italic, false));
+         m_children.append(new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Italic, false));
          if (retval != TK_WORD) {
             m_children.append(new DocWhiteSpace(this, " "));
          }
          break;
 
       case CMD_BOLD:
-         m_children.append(new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Bold, true));
+         m_children.append(new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Bold, true));
          retval = handleStyleArgument(this, m_children, cmdName);
-         m_children.append(new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Bold, false));
+         m_children.append(new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Bold, false));
          if (retval != TK_WORD) {
             m_children.append(new DocWhiteSpace(this, " "));
          }
          break;
 
       case CMD_CODE:
-         m_children.append(new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Code, true));
+         m_children.append(new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Code, true));
          retval = handleStyleArgument(this, m_children, cmdName);
-         m_children.append(new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Code, false));
+         m_children.append(new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Code, false));
          if (retval != TK_WORD) {
             m_children.append(new DocWhiteSpace(this, " "));
          }
@@ -5677,14 +5660,14 @@ int DocPara::handleCommand(const QString &cmdName)
          break;
 
       case CMD_SA:
-         s_inSeeBlock = true;
+         s_parser->inSeeBlock = true;
          retval = handleSimpleSection(DocSimpleSect::See);
-         s_inSeeBlock = false;
+         s_parser->inSeeBlock = false;
          break;
 
       case CMD_RETURN:
          retval = handleSimpleSection(DocSimpleSect::Return);
-         s_hasReturnCommand = true;
+         s_parser->hasReturnCommand = true;
          break;
 
       case CMD_AUTHOR:
@@ -5783,11 +5766,11 @@ int DocPara::handleCommand(const QString &cmdName)
       case CMD_HTMLONLY: {
          doctokenizerYYsetStateHtmlOnly();
          retval = doctokenizerYYlex();
-         m_children.append(new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::HtmlOnly, 
-                  s_isExample, s_exampleName, g_token->name == "block"));
+         m_children.append(new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::HtmlOnly, 
+                  s_parser->isExample, s_parser->exampleName, g_token->name == "block"));
 
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "htmlonly section ended without end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "htmlonly section ended without end marker");
          }
          doctokenizerYYsetStatePara();
       }
@@ -5796,9 +5779,9 @@ int DocPara::handleCommand(const QString &cmdName)
       case CMD_MANONLY: {
          doctokenizerYYsetStateManOnly();
          retval = doctokenizerYYlex();
-         m_children.append(new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::ManOnly, s_isExample, s_exampleName));
+         m_children.append(new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::ManOnly, s_parser->isExample, s_parser->exampleName));
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "manonly section ended without end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "manonly section ended without end marker");
          }
          doctokenizerYYsetStatePara();
       }
@@ -5807,9 +5790,9 @@ int DocPara::handleCommand(const QString &cmdName)
       case CMD_RTFONLY: {
          doctokenizerYYsetStateRtfOnly();
          retval = doctokenizerYYlex();
-         m_children.append(new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::RtfOnly, s_isExample, s_exampleName));
+         m_children.append(new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::RtfOnly, s_parser->isExample, s_parser->exampleName));
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "rtfonly section ended without end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "rtfonly section ended without end marker");
          }
          doctokenizerYYsetStatePara();
       }
@@ -5818,9 +5801,9 @@ int DocPara::handleCommand(const QString &cmdName)
       case CMD_LATEXONLY: {
          doctokenizerYYsetStateLatexOnly();
          retval = doctokenizerYYlex();
-         m_children.append(new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::LatexOnly, s_isExample, s_exampleName));
+         m_children.append(new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::LatexOnly, s_parser->isExample, s_parser->exampleName));
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "latexonly section ended without end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "latexonly section ended without end marker");
          }
          doctokenizerYYsetStatePara();
       }
@@ -5829,9 +5812,9 @@ int DocPara::handleCommand(const QString &cmdName)
       case CMD_XMLONLY: {
          doctokenizerYYsetStateXmlOnly();
          retval = doctokenizerYYlex();
-         m_children.append(new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::XmlOnly, s_isExample, s_exampleName));
+         m_children.append(new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::XmlOnly, s_parser->isExample, s_parser->exampleName));
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "xmlonly section ended without end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "xmlonly section ended without end marker");
          }
          doctokenizerYYsetStatePara();
       }
@@ -5840,9 +5823,9 @@ int DocPara::handleCommand(const QString &cmdName)
       case CMD_DBONLY: {
          doctokenizerYYsetStateDbOnly();
          retval = doctokenizerYYlex();
-         m_children.append(new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::DocbookOnly, s_isExample, s_exampleName));
+         m_children.append(new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::DocbookOnly, s_parser->isExample, s_parser->exampleName));
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Docbookonly section ended without end marker", doctokenizerYYlineno);
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Docbookonly section ended without end marker", doctokenizerYYlineno);
          }
          doctokenizerYYsetStatePara();
       }
@@ -5853,16 +5836,16 @@ int DocPara::handleCommand(const QString &cmdName)
          doctokenizerYYsetStateVerbatim();
          retval = doctokenizerYYlex();
 
-         m_children.append(new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::Verbatim, s_isExample, s_exampleName));
+         m_children.append(new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::Verbatim, s_parser->isExample, s_parser->exampleName));
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Verbatim section ended without an end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Verbatim section ended without an end marker");
          }
          doctokenizerYYsetStatePara();
       }
       break;
 
       case CMD_DOT: {                        
-         DocVerbatim *dv = new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::Dot, s_isExample, s_exampleName);
+         DocVerbatim *dv = new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::Dot, s_parser->isExample, s_parser->exampleName);
          doctokenizerYYsetStatePara();
 
          QString width;
@@ -5880,7 +5863,7 @@ int DocPara::handleCommand(const QString &cmdName)
          m_children.append(dv);
 
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno,"Dot section ended without an end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno,"Dot section ended without an end marker");
          }  
  
          doctokenizerYYsetStatePara();
@@ -5888,7 +5871,7 @@ int DocPara::handleCommand(const QString &cmdName)
       break;
 
       case CMD_MSC: {        
-         DocVerbatim *dv = new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::Msc, s_isExample, s_exampleName);
+         DocVerbatim *dv = new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::Msc, s_parser->isExample, s_parser->exampleName);
          doctokenizerYYsetStatePara();
 
          QString width;
@@ -5906,7 +5889,7 @@ int DocPara::handleCommand(const QString &cmdName)
          m_children.append(dv);
 
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno,"Msc section ended without an end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno,"Msc section ended without an end marker");
          }  
  
          doctokenizerYYsetStatePara();       
@@ -5921,7 +5904,7 @@ int DocPara::handleCommand(const QString &cmdName)
 
          QString plantFile(g_token->sectionId);
 
-         DocVerbatim *dv = new DocVerbatim(this, s_context, g_token->verb, DocVerbatim::PlantUML, false, s_exampleName);
+         DocVerbatim *dv = new DocVerbatim(this, s_parser->context, g_token->verb, DocVerbatim::PlantUML, false, s_parser->exampleName);
          doctokenizerYYsetStatePara();
 
          QString width;
@@ -5937,7 +5920,7 @@ int DocPara::handleCommand(const QString &cmdName)
          dv->setHeight(height);
       
          if (jarPath.isEmpty()) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Ignoring \\startuml command since 'PLANTUML JAR PATH' was not set");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Ignoring \\startuml command since 'PLANTUML JAR PATH' was not set");
             delete dv;
 
          } else { 
@@ -5945,7 +5928,7 @@ int DocPara::handleCommand(const QString &cmdName)
          }
 
          if (retval == 0) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "startuml section ended without an end marker");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "startuml section ended without an end marker");
          }
 
          doctokenizerYYsetStatePara();
@@ -5968,7 +5951,7 @@ int DocPara::handleCommand(const QString &cmdName)
       case CMD_ENDDOT:
       case CMD_ENDMSC:
       case CMD_ENDUML:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected command %s", qPrintable(g_token->name));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected command %s", qPrintable(g_token->name));
          break;
 
       case CMD_PARAM:
@@ -6014,13 +5997,13 @@ int DocPara::handleCommand(const QString &cmdName)
       case CMD_ADDINDEX: {
          QSharedPointer<Definition> temp;
 
-         if (s_scope != Doxy_Globals::globalScope) {
-            temp = s_scope;
+         if (s_parser->scope != Doxy_Globals::globalScope) {
+            temp = s_parser->scope;
          } else {
             temp = QSharedPointer<Definition>();
           }  
 
-         DocIndexEntry *ie = new DocIndexEntry(this, temp, s_memberDef);
+         DocIndexEntry *ie = new DocIndexEntry(this, temp, s_parser->memberDef);
          m_children.append(ie);
          retval = ie->parse();
       }
@@ -6120,11 +6103,11 @@ int DocPara::handleCommand(const QString &cmdName)
       break;
 
       case CMD_SECREFITEM:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected command %s", qPrintable(g_token->name));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected command %s", qPrintable(g_token->name));
          break;
 
       case CMD_ENDSECREFLIST:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected command %s", qPrintable(g_token->name));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected command %s", qPrintable(g_token->name));
          break;
 
       case CMD_FORMULA: {
@@ -6138,7 +6121,7 @@ int DocPara::handleCommand(const QString &cmdName)
       //  break;
 
       case CMD_INTERNALREF:
-         // warn_doc_error(s_fileName,doctokenizerYYlineno, "Unexpected command %s",qPrintable(g_token->name));
+         // warn_doc_error(s_parser->fileName,doctokenizerYYlineno, "Unexpected command %s",qPrintable(g_token->name));
       {
          DocInternalRef *ref = handleInternalRef(this);
          if (ref) {
@@ -6197,7 +6180,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
 
    if (g_token->emptyTag && !(tagId & XML_CmdMask) &&
          tagId != HTML_UNKNOWN && tagId != HTML_IMG && tagId != HTML_BR) {
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "HTML tags may not use the 'empty tag' XHTML syntax");
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "HTML tags may not use the 'empty tag' XHTML syntax");
    }
 
    switch (tagId) {
@@ -6217,7 +6200,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
 
       case HTML_LI:
          if (! insideUL(this) && ! insideOL(this)) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Lonely <li> tag found");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Lonely <li> tag found");
          } else {
             retval = RetVal_ListItem;
          }
@@ -6228,7 +6211,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
          break;
 
       case HTML_CODE:
-         if (/*getLanguageFromFileName(s_fileName)==SrcLangExt_CSharp ||*/ s_xmlComment)
+         if (/*getLanguageFromFileName(s_parser->fileName)==SrcLangExt_CSharp ||*/ s_parser->xmlComment)
             // for C# source or inside a <summary> or <remark> section we
             // treat <code> as an XML tag (so similar to @code)
          {
@@ -6312,7 +6295,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
          break;
 
       case HTML_CAPTION:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag <caption> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag <caption> found");
          break;
 
       case HTML_BR: {
@@ -6363,7 +6346,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
       case XML_SUMMARY:
       case XML_REMARKS:
       case XML_EXAMPLE:
-         s_xmlComment = true;
+         s_parser->xmlComment = true;
       // fall through
       case XML_VALUE:
       case XML_PARA:
@@ -6386,13 +6369,13 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
       case XML_TYPEPARAM: {
          QString paramName;
 
-         s_xmlComment = true;
+         s_parser->xmlComment = true;
 
          if (findAttribute(tagHtmlAttribs, "name", &paramName)) {
 
             if (paramName.isEmpty()) {
                if (Config::getBool("warn-undoc-param")) {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Empty 'name' attribute for <param%s> tag.",
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Empty 'name' attribute for <param%s> tag.",
                         tagId == XML_PARAM ? "" : "type");
 
                }
@@ -6402,7 +6385,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
                         tagId == XML_PARAM ? DocParamSect::Param : DocParamSect::TemplateParam,true);
             }
          } else {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Missing 'name' attribute from <param%s> tag.",
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Missing 'name' attribute from <param%s> tag.",
                         tagId == XML_PARAM ? "" : "type");
 
          }
@@ -6414,16 +6397,16 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
          QString paramName;
 
          if (findAttribute(tagHtmlAttribs, "name", &paramName)) {            
-            m_children.append(new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Italic, true));
+            m_children.append(new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Italic, true));
             m_children.append(new DocWord(this, paramName));
-            m_children.append(new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Italic, false));
+            m_children.append(new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Italic, false));
 
             if (retval != TK_WORD) {
                m_children.append(new DocWhiteSpace(this, " "));
             }
 
          } else {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Missing 'name' attribute from <param%sref> tag.", 
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Missing 'name' attribute from <param%sref> tag.", 
                   tagId == XML_PARAMREF ? "" : "type");
          }
       }
@@ -6432,14 +6415,14 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
       case XML_EXCEPTION: {
          QString exceptName;
 
-         s_xmlComment = true;
+         s_parser->xmlComment = true;
 
          if (findAttribute(tagHtmlAttribs, "cref", &exceptName)) {
             unescapeCRef(exceptName);
             retval = handleParamSection(exceptName, DocParamSect::Exception, true);
 
          } else {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Missing 'cref' attribute from <exception> tag.");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Missing 'cref' attribute from <exception> tag.");
          }
       }
 
@@ -6452,18 +6435,18 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
          } else if (insideUL(this) || insideOL(this)) {
             retval = RetVal_ListItem;
          } else {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "lonely <item> tag found");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "lonely <item> tag found");
          }
          break;
 
       case XML_RETURNS:
-         s_xmlComment = true;
+         s_parser->xmlComment = true;
          retval = handleSimpleSection(DocSimpleSect::Return, true);
-         s_hasReturnCommand = true;
+         s_parser->hasReturnCommand = true;
          break;
 
       case XML_TERM:
-         //m_children.append(new DocStyleChange(this,s_nodeStack.count(),DocStyleChange::Bold,true));
+         //m_children.append(new DocStyleChange(this,s_parser->nodeStack.count(),DocStyleChange::Bold,true));
          if (insideTable(this)) {
             retval = RetVal_TableCell;
          }
@@ -6481,12 +6464,12 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
             if (g_token->emptyTag) { 
                // <see cref="..."/> style
 
-               bool inSeeBlock = s_inSeeBlock;
+               bool inSeeBlock = s_parser->inSeeBlock;
                g_token->name   = cref;
-               s_inSeeBlock    = true;
+               s_parser->inSeeBlock    = true;
                handleLinkedWord(this, m_children, true);
 
-               s_inSeeBlock = inSeeBlock;
+               s_parser->inSeeBlock = inSeeBlock;
 
             } else { 
                // <see cref="...">...</see> style
@@ -6502,7 +6485,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
             }
 
          } else {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Missing 'cref' attribute from <see> tag.");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Missing 'cref' attribute from <see> tag.");
          }
       }
       break;
@@ -6510,7 +6493,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
       case XML_SEEALSO: {
          QString cref;
 
-         s_xmlComment = true;
+         s_parser->xmlComment = true;
 
          if (findAttribute(tagHtmlAttribs, "cref", &cref)) {
             // Look for an existing "see" section
@@ -6532,7 +6515,7 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
             ss->appendLinkWord(cref);
             retval = RetVal_OK;
          } else {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Missing 'cref' attribute from <seealso> tag.");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Missing 'cref' attribute from <seealso> tag.");
          }
       }
       break;
@@ -6560,11 +6543,11 @@ int DocPara::handleHtmlStartTag(const QString &tagName, const HtmlAttribList &ta
       case XML_INCLUDE:
       case XML_PERMISSION:
          // These tags are defined in .Net but are currently unsupported
-         s_xmlComment = true;
+         s_parser->xmlComment = true;
          break;
 
       case HTML_UNKNOWN:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported xml/html tag <%s> found", qPrintable(tagName));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported xml/html tag <%s> found", qPrintable(tagName));
          m_children.append(new DocWord(this, "<" + tagName + tagHtmlAttribs.toString() + ">"));
          break;
 
@@ -6592,7 +6575,7 @@ int DocPara::handleHtmlEndTag(const QString &tagName)
 
       case HTML_UL:
          if (!insideUL(this)) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "found </ul> tag without matching <ul>");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "found </ul> tag without matching <ul>");
          } else {
             retval = RetVal_EndList;
          }
@@ -6600,7 +6583,7 @@ int DocPara::handleHtmlEndTag(const QString &tagName)
 
       case HTML_OL:
          if (! insideOL(this)) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Found </ol> tag without matching <ol>");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found </ol> tag without matching <ol>");
          } else {
             retval = RetVal_EndList;
          }
@@ -6608,7 +6591,7 @@ int DocPara::handleHtmlEndTag(const QString &tagName)
 
       case HTML_LI:
          if (!insideLI(this)) {
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Found </li> tag without matching <li>");
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found </li> tag without matching <li>");
          } else {
             // ignore </li> tags
          }
@@ -6621,7 +6604,7 @@ int DocPara::handleHtmlEndTag(const QString &tagName)
       //case HTML_PRE:
       //  if (! insidePRE(this))
       //  {
-      //    warn_doc_error(s_fileName,doctokenizerYYlineno,"Found </pre> tag without matching <pre>");
+      //    warn_doc_error(s_parser->fileName,doctokenizerYYlineno,"Found </pre> tag without matching <pre>");
       //  }
       //  else
       //  {
@@ -6704,42 +6687,42 @@ int DocPara::handleHtmlEndTag(const QString &tagName)
          break;
 
       case HTML_CAPTION:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </caption> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </caption> found");
          break;
       case HTML_BR:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Illegal </br> tag found\n");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Illegal </br> tag found\n");
          break;
       case HTML_H1:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </h1> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </h1> found");
          break;
       case HTML_H2:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </h2> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </h2> found");
          break;
       case HTML_H3:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </h3> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </h3> found");
          break;
       case HTML_H4:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </h4> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </h4> found");
          break;
       case HTML_H5:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </h5> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </h5> found");
          break;
       case HTML_H6:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </h6> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </h6> found");
          break;
       case HTML_IMG:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </img> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </img> found");
          break;
       case HTML_HR:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected tag </hr> found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected tag </hr> found");
          break;
       case HTML_A:
-         //warn_doc_error(s_fileName,doctokenizerYYlineno,"Unexpected tag </a> found");
+         //warn_doc_error(s_parser->fileName,doctokenizerYYlineno,"Unexpected tag </a> found");
          // ignore </a> tag (can be part of <a name=...></a>
          break;
 
       case XML_TERM:
-         //m_children.append(new DocStyleChange(this,s_nodeStack.count(),DocStyleChange::Bold,false));
+         //m_children.append(new DocStyleChange(this,s_parser->nodeStack.count(),DocStyleChange::Bold,false));
          break;
 
       case XML_SUMMARY:
@@ -6772,12 +6755,12 @@ int DocPara::handleHtmlEndTag(const QString &tagName)
          // These tags are defined in .Net but are currently unsupported
          break;
       case HTML_UNKNOWN:
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported xml/html tag </%s> found", qPrintable(tagName));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported xml/html tag </%s> found", qPrintable(tagName));
          m_children.append(new DocWord(this, "</" + tagName + ">"));
          break;
       default:
          // we should not get here!
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected end tag %s\n", qPrintable(tagName));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected end tag %s\n", qPrintable(tagName));
          assert(0);
          break;
    }
@@ -6788,7 +6771,7 @@ int DocPara::handleHtmlEndTag(const QString &tagName)
 int DocPara::parse(bool skipParse, int token)
 {
    DBG(("DocPara::parse() start\n"));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    // handle style commands "inherited" from the previous paragraph
    handleInitialStyleCommands(this, m_children);
@@ -6960,11 +6943,11 @@ int DocPara::parse(bool skipParse, int token)
                   goto endparagraph;
 
                } else {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "End of list marker found with an invalid indent level");
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "End of list marker found with an invalid indent level");
                }
 
             } else {
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "End of list marker found without any preceding list items");
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "End of list marker found without any preceding list items");
             }
             break;
 
@@ -7057,7 +7040,7 @@ int DocPara::parse(bool skipParse, int token)
             } else { 
                // found an end tag
 
-               if (g_token->name == "div"  && s_styleStack.isEmpty() )  {
+               if (g_token->name == "div"  && s_parser->styleStack.isEmpty() )  {
                   // let DocRoot add the closing <div>
                   retval = RetVal_EndDiv;               
 
@@ -7085,7 +7068,7 @@ int DocPara::parse(bool skipParse, int token)
                m_children.append(new DocSymbol(this, s));
 
             } else {
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found", qPrintable(g_token->name));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found", qPrintable(g_token->name));
             }
             break;
          }
@@ -7118,7 +7101,7 @@ int DocPara::parse(bool skipParse, int token)
          break;
 
          default:
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Found unexpected token (id=%x)\n", tok);
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Found unexpected token (id=%x)\n", tok);
             break;
       }
    }
@@ -7128,8 +7111,8 @@ int DocPara::parse(bool skipParse, int token)
 endparagraph:
    handlePendingStyleCommands(this, m_children);
 
-   if (! s_nodeStack.isEmpty() ) {
-      DocNode *n = s_nodeStack.pop(); 
+   if (! s_parser->nodeStack.isEmpty() ) {
+      DocNode *n = s_parser->nodeStack.pop(); 
       assert(n == this);
    }
  
@@ -7144,7 +7127,7 @@ endparagraph:
 int DocSection::parse()
 {
    DBG(("DocSection::parse() start %s level=%d\n", qPrintable(g_token->sectionId), m_level));
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
 
    int retval = RetVal_OK;
    QSharedPointer<SectionInfo> sec;
@@ -7161,8 +7144,8 @@ int DocSection::parse()
             m_title = sec->label;
          }
 
-         if (s_sectionDict && s_sectionDict->find(m_id) == 0) {
-            s_sectionDict->insert(m_id, sec);
+         if (s_parser->sectionDict && s_parser->sectionDict->find(m_id) == 0) {
+            s_parser->sectionDict->insert(m_id, sec);
          }
       }
    }
@@ -7190,7 +7173,7 @@ int DocSection::parse()
       }
 
       if (retval == TK_LISTITEM) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Invalid list item found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Invalid list item found");
       }
 
       if (retval == RetVal_Internal) {
@@ -7253,7 +7236,7 @@ int DocSection::parse()
              ) {
       int level = (retval == RetVal_Subsubsection) ? 3 : 4;
 
-      warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected %s command found inside %s",
+      warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected %s command found inside %s",
                      csPrintable(sectionLevelToName[level]), csPrintable(sectionLevelToName[m_level]) );
 
       retval = 0; // stop parsing
@@ -7270,7 +7253,7 @@ int DocSection::parse()
                   );
 
    DBG(("DocSection::parse() end: retval=%x\n", retval));
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
    return retval;
 }
@@ -7279,7 +7262,7 @@ void DocText::parse()
 {
    DBG(("DocText::parse() start\n"));
 
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
    doctokenizerYYsetStateText();
 
    int tok;
@@ -7302,7 +7285,7 @@ void DocText::parse()
             if (s != DocSymbol::Sym_Unknown) {
                m_children.append(new DocSymbol(this, s));
             } else {
-               warn_doc_error(s_fileName, doctokenizerYYlineno, "Unsupported symbol %s found", qPrintable(g_token->name));
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unsupported symbol %s found", qPrintable(g_token->name));
             }
          }
          break;
@@ -7371,20 +7354,20 @@ void DocText::parse()
                   break;
 
                default:
-                  warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected command '%s' found", csPrintable(g_token->name));
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected command '%s' found", csPrintable(g_token->name));
                   break;
             }
             break;
 
          default:
-            warn_doc_error(s_fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
+            warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Unexpected token %s", qPrintable(tokToString(tok)));
             break;
       }
    }
 
    handleUnclosedStyleCommands();
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocText::parse() end\n"));
@@ -7394,7 +7377,7 @@ void DocRoot::parse()
 {
    DBG(("DocRoot::parse() start\n"));
 
-   s_nodeStack.push(this);
+   s_parser->nodeStack.push(this);
    doctokenizerYYsetStatePara();
 
    int retval = 0;
@@ -7418,9 +7401,9 @@ void DocRoot::parse()
             DocStyleChange *sc;
 
             if (! g_token->endTag) {
-               sc = new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Div, true, &g_token->attribs);
+               sc = new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Div, true, &g_token->attribs);
             } else {
-               sc = new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Div, false);
+               sc = new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Div, false);
             }
 
             m_children.append(sc);         
@@ -7446,7 +7429,7 @@ void DocRoot::parse()
             if (retval == RetVal_EndDiv ) {
                // time to add the closing div
 
-               DocStyleChange *sc = new DocStyleChange(this, s_nodeStack.count(), DocStyleChange::Div, false);
+               DocStyleChange *sc = new DocStyleChange(this, s_parser->nodeStack.count(), DocStyleChange::Div, false);
                m_children.append(sc); 
             }   
                  
@@ -7457,16 +7440,16 @@ void DocRoot::parse()
       }
 
       if (retval == TK_LISTITEM) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Invalid list item found");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Invalid list item found");
 
       } else if (retval == RetVal_Subsection) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "found subsection command outside of section context");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "found subsection command outside of section context");
 
       } else if (retval == RetVal_Subsubsection) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "found subsubsection command outside of subsection context");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "found subsubsection command outside of subsection context");
 
       } else if (retval == RetVal_Paragraph) {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "found paragraph command outside of subsubsection context");
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "found paragraph command outside of subsubsection context");
       }
 
       if (retval == RetVal_Internal) {
@@ -7491,14 +7474,14 @@ void DocRoot::parse()
          retval = s->parse();
 
       } else {
-         warn_doc_error(s_fileName, doctokenizerYYlineno, "Invalid section id '%s'; ignoring section", qPrintable(g_token->sectionId));
+         warn_doc_error(s_parser->fileName, doctokenizerYYlineno, "Invalid section id '%s'; ignoring section", qPrintable(g_token->sectionId));
          retval = 0;
       }
    }
 
    handleUnclosedStyleCommands();
 
-   DocNode *n = s_nodeStack.pop();
+   DocNode *n = s_parser->nodeStack.pop();
    assert(n == this);
 
    DBG(("DocRoot::parse() end\n"));
@@ -7614,9 +7597,9 @@ static QString processCopyDoc(const QString &data, uint &len)
             QSharedPointer<Definition> def = findDocsForMemberOrCompound(id, doc, brief);
  
             if (def) {        
-               if (s_copyStack.indexOf(def) == -1) { 
+               if (s_parser->copyStack.indexOf(def) == -1) { 
                   // definition not parsed earlier
-                  s_copyStack.append(def);
+                  s_parser->copyStack.append(def);
 
                   if (isBrief) {
                      uint l = brief.length();
@@ -7627,15 +7610,15 @@ static QString processCopyDoc(const QString &data, uint &len)
                      retval += processCopyDoc(doc, l);
                   }
 
-                  s_copyStack.removeOne(def);
+                  s_parser->copyStack.removeOne(def);
 
                } else {
-                  warn_doc_error(s_fileName, doctokenizerYYlineno,
+                  warn_doc_error(s_parser->fileName, doctokenizerYYlineno,
                                  "Found recursive @copy%s or @copydoc relation for argument '%s'.\n",
                                  isBrief ? "brief" : "details", qPrintable(id) );
                }
             } else {
-               warn_doc_error(s_fileName, doctokenizerYYlineno,
+               warn_doc_error(s_parser->fileName, doctokenizerYYlineno,
                               "@copy%s or @copydoc target '%s' not found", isBrief ? "brief" : "details", qPrintable(id) );
             }
 
@@ -7663,6 +7646,17 @@ DocRoot *validatingParseDoc(const QString &fileName, int startLine, QSharedPoint
                             const QString &input, bool indexWords, bool isExample, const QString &exampleName, 
                             bool singleLine, bool linkFromIndex)
 {  
+   return validatingParseDoc(threadParserContext(), fileName, startLine, ctx, md, input, indexWords, isExample,
+                  exampleName, singleLine, linkFromIndex);
+}
+
+DocRoot *validatingParseDoc(DocParserContext &parser, const QString &fileName, int startLine,
+                            QSharedPointer<Definition> ctx, QSharedPointer<MemberDef> md, const QString &input,
+                            bool indexWords, bool isExample, const QString &exampleName,
+                            bool singleLine, bool linkFromIndex)
+{  
+   DocParserScope parserScope(parser);
+
    // store parser state so we can re-enter this function if needed
 
    // bool fortranOpt = Config::getBool("optimize-fortran");
@@ -7672,67 +7666,67 @@ DocRoot *validatingParseDoc(const QString &fileName, int startLine, QSharedPoint
    if (ctx && ctx != Doxy_Globals::globalScope && (ctx->definitionType() == Definition::TypeClass ||
           ctx->definitionType() == Definition::TypeNamespace)) {
 
-      s_context = ctx->name();
+      s_parser->context = ctx->name();
 
    } else if (ctx && ctx->definitionType() == Definition::TypePage) {
       QSharedPointer<Definition> scope = ctx.dynamicCast<PageDef>()->getPageScope();
 
       if (scope && scope != Doxy_Globals::globalScope) {
-         s_context = scope->name();
+         s_parser->context = scope->name();
       }
 
    } else if (ctx && ctx->definitionType() == Definition::TypeGroup) {
       QSharedPointer<Definition> scope = ctx.dynamicCast<GroupDef>()->getGroupScope();
 
       if (scope && scope != Doxy_Globals::globalScope) {
-         s_context = scope->name();
+         s_parser->context = scope->name();
       }
 
    } else {
-      s_context = "";
+      s_parser->context = "";
    }
 
-   s_scope = ctx;
+   s_parser->scope = ctx;
 
    if (indexWords && Doxy_Globals::searchIndex) {
       if (md) {
-         s_searchUrl = md->getOutputFileBase();
+         s_parser->searchUrl = md->getOutputFileBase();
          Doxy_Globals::searchIndex->setCurrentDoc(md, md->anchor(), false);
 
       } else if (ctx) {
-         s_searchUrl = ctx->getOutputFileBase();
+         s_parser->searchUrl = ctx->getOutputFileBase();
          Doxy_Globals::searchIndex->setCurrentDoc(ctx, ctx->anchor(), false);
 
       }
 
    } else {
-      s_searchUrl = "";
+      s_parser->searchUrl = "";
    }
 
-   s_fileName = fileName;
-   s_relPath = (! linkFromIndex && ctx) ? QString(relativePathToRoot(ctx->getOutputFileBase())) : "";
+   s_parser->fileName = fileName;
+   s_parser->relPath = (! linkFromIndex && ctx) ? QString(relativePathToRoot(ctx->getOutputFileBase())) : "";
   
-   s_memberDef = md;
+   s_parser->memberDef = md;
 
-   s_nodeStack.clear();
-   s_styleStack.clear();
-   s_initialStyleStack.clear();
+   s_parser->nodeStack.clear();
+   s_parser->styleStack.clear();
+   s_parser->initialStyleStack.clear();
 
-   s_inSeeBlock        = false;
-   s_xmlComment        = false;
-   s_insideHtmlLink    = false;
-   s_includeFileText   = "";
-   s_includeFileOffset = 0;
-   s_includeFileLength = 0;
+   s_parser->inSeeBlock        = false;
+   s_parser->xmlComment        = false;
+   s_parser->insideHtmlLink    = false;
+   s_parser->includeFileText   = "";
+   s_parser->includeFileOffset = 0;
+   s_parser->includeFileLength = 0;
 
-   s_isExample   = isExample;
-   s_exampleName = exampleName;
+   s_parser->isExample   = isExample;
+   s_parser->exampleName = exampleName;
 
-   s_hasParamCommand  = false;
-   s_hasReturnCommand = false;
+   s_parser->hasParamCommand  = false;
+   s_parser->hasReturnCommand = false;
    
-   s_paramsFound.clear();
-   s_sectionDict = 0; 
+   s_parser->paramsFound.clear();
+   s_parser->sectionDict = 0; 
 
    doctokenizerYYlineno = startLine;
    uint inpLen = input.length();
@@ -7742,7 +7736,7 @@ DocRoot *validatingParseDoc(const QString &fileName, int startLine, QSharedPoint
       inpStr += '\n';
    }
 
-   doctokenizerYYinit(inpStr, s_fileName);
+   doctokenizerYYinit(inpStr, s_parser->fileName);
 
    // build abstract syntax tree
    DocRoot *root = new DocRoot(md != 0, singleLine);
@@ -7772,38 +7766,45 @@ DocRoot *validatingParseDoc(const QString &fileName, int startLine, QSharedPoint
 
 DocText *validatingParseText(const QString &input)
 {
+   return validatingParseText(threadParserContext(), input);
+}
+
+DocText *validatingParseText(DocParserContext &parser, const QString &input)
+{
+   DocParserScope parserScope(parser);
+
    // store parser state so we can re-enter this function if needed
    docParserPushContext();
  
-   s_context  = "";
-   s_fileName = "<parseText>";
-   s_relPath  = "";
-
-   s_memberDef = QSharedPointer<MemberDef>();
-
-   s_nodeStack.clear();
-   s_styleStack.clear();
-   s_initialStyleStack.clear();
-
-   s_inSeeBlock = false;
-   s_xmlComment = false;
-   s_insideHtmlLink    = false;
-   s_includeFileText   = "";
-   s_includeFileOffset = 0;
-   s_includeFileLength = 0;
-   s_isExample   = false;
-   s_exampleName = "";
-   s_hasParamCommand = false;
-   s_hasReturnCommand = false;
+   s_parser->context  = "";
+   s_parser->fileName = "<parseText>";
+   s_parser->relPath  = "";
+
+   s_parser->memberDef = QSharedPointer<MemberDef>();
+
+   s_parser->nodeStack.clear();
+   s_parser->styleStack.clear();
+   s_parser->initialStyleStack.clear();
+
+   s_parser->inSeeBlock = false;
+   s_parser->xmlComment = false;
+   s_parser->insideHtmlLink    = false;
+   s_parser->includeFileText   = "";
+   s_parser->includeFileOffset = 0;
+   s_parser->includeFileLength = 0;
+   s_parser->isExample   = false;
+   s_parser->exampleName = "";
+   s_parser->hasParamCommand = false;
+   s_parser->hasReturnCommand = false;
    
-   s_paramsFound.clear();
-   s_searchUrl = "";
+   s_parser->paramsFound.clear();
+   s_parser->searchUrl = "";
 
    DocText *txt = new DocText;
 
    if (! input.isEmpty()) {
       doctokenizerYYlineno = 1;
-      doctokenizerYYinit(input, s_fileName);
+      doctokenizerYYinit(input, s_parser->fileName);
 
       // build abstract syntax tree
       txt->parse();
@@ -7825,5 +7826,6 @@ DocText *validatingParseText(const QString &input)
 void docFindSections(const QString &input, QSharedPointer<Definition> def, 
                   QSharedPointer<MemberGroup> mg, const QString &fileName)
 {
+   DocParserScope parserScope(threadParserContext());
    doctokenizerYYFindSections(input, def, mg, fileName);
 }
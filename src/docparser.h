@@ -27,6 +27,34 @@
 #include <htmlattrib.h>
 #include <membergroup.h>
 
+struct DocParserData;
+
+/** @brief State of the documentation parser and its tokenizer
+ *
+ *  A context can only be used by one thread at a time. Threads which parse
+ *  documentation at the same time each need their own context. The functions
+ *  without a context argument use a context which belongs to the calling thread.
+ *
+ *  Copying images and updating sections found by docFindSections() are serialized.
+ *  Words are added to the document which is current in the search index, pass
+ *  indexWords as true on one thread only. The dictionaries of the project
+ *  must not change while documentation is parsed on more than one thread.
+ */
+class DocParserContext
+{
+ public:
+   DocParserContext();
+   ~DocParserContext();
+
+   DocParserContext(const DocParserContext &) = delete;
+   DocParserContext &operator=(const DocParserContext &) = delete;
+
+ private:
+   DocParserData *m_data;
+
+   friend class DocParserScope;
+};
+
 /*! Main entry point for the documentation parser.
  *  @param fileName  File in which the documentation block is found (or the
  *                   name of the example file in case isExample is true).
@@ -51,10 +79,17 @@ DocRoot *validatingParseDoc(const QString &fileName, int startLine, QSharedPoint
                   QSharedPointer<MemberDef> md, const QString &input, bool indexWords, bool isExample, 
                   const QString &exampleName = QString(), bool singleLine = false, bool linkFromIndex = false);
 
+/*! Parses the documentation using the state in \a parser, the other arguments are the same as above */
+DocRoot *validatingParseDoc(DocParserContext &parser, const QString &fileName, int startLine,
+                  QSharedPointer<Definition> context, QSharedPointer<MemberDef> md, const QString &input,
+                  bool indexWords, bool isExample, const QString &exampleName = QString(),
+                  bool singleLine = false, bool linkFromIndex = false);
+
 /*! Main entry point for parsing simple text fragments. These
  *  fragments are limited to words, whitespace and symbols.
  */
 DocText *validatingParseText(const QString &input);
+DocText *validatingParseText(DocParserContext &parser, const QString &input);
 
 /*! Searches for section and anchor commands in the input */
 void docFindSections(const QString &input, QSharedPointer<Definition> def, 
@@ -110,14 +110,22 @@ struct TokenInfo {
    ParamDir paramDir;
 };
 
-// globals
-extern TokenInfo *g_token;
-extern int doctokenizerYYlineno;
-extern FILE *doctokenizerYYin;
+// globals, one set for each thread
+extern thread_local TokenInfo *g_token;
+extern thread_local int doctokenizerYYlineno;
+
+struct DocTokenizerContext;
 
 // helper functions
 QString tokToString(int token);
 
+/** Creates the state of a scanner, each thread which parses documentation needs its own */
+DocTokenizerContext *doctokenizerYYcreateContext();
+void doctokenizerYYdeleteContext(DocTokenizerContext *ctx);
+
+/** Makes \a ctx the context used by the operations below on the calling thread, returns the previous one */
+DocTokenizerContext *doctokenizerYYsetContext(DocTokenizerContext *ctx);
+
 // operations on the scanner
 void doctokenizerYYFindSections(const QString &input, QSharedPointer<Definition> def, 
                   QSharedPointer<MemberGroup> mg, const QString &fileName);
@@ -17,8 +17,12 @@
 
 #include <QCryptographicHash>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
 
+#include <algorithm>
 #include <stdlib.h>
 
 #include <dot.h>
@@ -27,22 +31,24 @@
 #include <defargs.h>
 #include <docparser.h>
 #include <doxy_globals.h>
+#include <graphcache.h>
 #include <groupdef.h>
+#include <image.h>
 #include <language.h>
 #include <message.h>
 #include <membergroup.h>
 #include <portable.h>
 #include <sortedlist.h>
+#include <toolexecutor.h>
 #include <util.h>
 
-static QVector<int> s_newNumber;
-static int s_max_newNumber = 0;
 static QString g_dotFontPath;
 
-int DotGfxHierarchyTable::m_curNodeNumber;
-int DotInclDepGraph::m_curNodeNumber = 0;
-int DotClassGraph::m_curNodeNumber   = 0;
-int DotCallGraph::m_curNodeNumber    = 0;
+// measures when dot runs finish relative to the start of documentation generation
+static QElapsedTimer g_dotTimer;
+
+// serializes the dot runs for user supplied and inline dot files
+static QMutex s_dotFileLock;
 
 #define MAP_CMD "cmapx"
 
@@ -212,6 +218,12 @@ static EdgeProperties umlEdgeProps = {
    umlEdgeColorMap, umlArrowStyleMap, umlEdgeStyleMap
 };
 
+static const EdgeProperties *edgeProperties()
+{
+   static bool umlLook = Config::getBool("uml-look");
+   return umlLook ? &umlEdgeProps : &normalEdgeProps;
+}
+
 static QString getDotFontName()
 {
    static QString dotFontName = Config::getString("dot-font-name");
@@ -252,6 +264,11 @@ static void writeGraphHeader(QTextStream &t, const QString &title = QString())
       t << " // INTERACTIVE_SVG=YES\n";
    }
 
+   if (Config::getInt("dot-inline-max-nodes") > 0) {
+      // small graphs are rendered by DotLayout, force regeneration when this option is changed
+      t << " // INLINE_LAYOUT=" << Config::getInt("dot-inline-max-nodes") << "\n";
+   }
+
    if (Config::getBool("dot-transparent")) {
       t << "  bgcolor=\"transparent\";" << endl;
    }
@@ -394,38 +411,28 @@ static bool convertMapFile(QTextStream &t, const QString &mapName, const QString
    return true;
 }
 
-inline int reNumberNode(int number, bool doReNumbering)
+int DotNodeNumbering::number(int nodeNumber)
 {
-   if (! doReNumbering) {
-      return number;
+   auto iter = m_numbers.find(nodeNumber);
 
-   } else {
-      int s = s_newNumber.size();
-      if (number >= s) {
-         int ns = 0;
-         ns = s * 3 / 2 + 5; // new size
-         if (number >= ns) { // number still doesn't fit
-            ns = number * 3 / 2 + 5;
-         }
-
-         s_newNumber.resize(ns);
-         for (int i = s; i < ns; i++) { // clear new part of the array
-            s_newNumber[i] = 0;
-         }
-      }
-      int i = s_newNumber.at(number);
-      if (i == 0) { // not yet mapped
-         i = ++s_max_newNumber; // start from 1
-         s_newNumber[number] = i;
-      }
-      return i;
+   if (iter != m_numbers.end()) {
+      return iter.value();
    }
+
+   // numbers start from 1 in the order the nodes are written
+   int retval = m_numbers.count() + 1;
+   m_numbers.insert(nodeNumber, retval);
+
+   return retval;
 }
 
-static void resetReNumbering()
+static inline int reNumberNode(int number, DotNodeNumbering *numbering)
 {
-   s_max_newNumber = 0;
-   s_newNumber.resize(s_max_newNumber);
+   if (numbering == nullptr) {
+      return number;
+   }
+
+   return numbering->number(number);
 }
 
 static void setDotFontPath(const QString &path)
@@ -716,7 +723,8 @@ static void removeDotGraph(const QString &dotName)
 {
    static bool dotCleanUp = Config::getBool("dot-cleanup");
 
-   if (dotCleanUp) {            
+   // a pending dot run still needs the file, it is removed after the run
+   if (dotCleanUp && ! DotManager::instance()->hasRun(dotName)) {            
       QDir d;
       d.remove(dotName);
    }
@@ -730,6 +738,10 @@ static void removeDotGraph(const QString &dotName)
  */
 static bool checkAndUpdateMd5Signature(const QString &baseName, const QString &md5)
 {
+   // pages are written on several threads, only one of them may claim a graph shared by two pages
+   static QMutex md5Lock;
+   QMutexLocker locker(&md5Lock);
+
    QFile f(baseName + ".md5");
 
    if (f.open(QIODevice::ReadOnly)) {
@@ -773,7 +785,7 @@ static bool checkDeliverables(const QString &file1, const QString &file2 = QStri
 }
 
 DotRunner::DotRunner(const QString &file, const QString &path, bool checkResult, const QString &imageName)
-   : m_file(file), m_path(path), m_checkResult(checkResult), m_imageName(imageName)
+   : m_endTime(-1), m_file(file), m_path(path), m_checkResult(checkResult), m_imageName(imageName), m_cacheChecked(false)
 {
    static bool dotCleanUp = Config::getBool("dot-cleanup");
    m_cleanUp = dotCleanUp; 
@@ -781,8 +793,49 @@ DotRunner::DotRunner(const QString &file, const QString &path, bool checkResult,
 
 void DotRunner::addJob(const QString &format, const QString &output)
 {
-   QString args = "-T" + format + " -o \"" + output + "\"";   
-   m_jobs.append(args);
+   Job job;
+   job.format = format;
+   job.output = output;
+
+   m_jobs.append(job);
+}
+
+QString DotRunner::jobArgs(const Job &job)
+{
+   return "-T" + job.format + " -o \"" + job.output + "\"";
+}
+
+QString DotRunner::key() const
+{
+   return m_file + " " + batchKey();
+}
+
+QString DotRunner::batchKey() const
+{
+   QString retval;
+
+   for (const auto &job : m_jobs) {
+      retval += job.format;
+      retval += ' ';
+   }
+
+   return retval;
+}
+
+bool DotRunner::canBatch() const
+{
+   if (! m_postCmd.isEmpty()) {
+      return false;
+   }
+
+   for (const auto &job : m_jobs) {
+      // dot names the output of -O after the input file and the format, renderer variants are not supported
+      if (job.format.contains(':')) {
+         return false;
+      }
+   }
+
+   return true;
 }
 
 void DotRunner::addPostProcessing(const  QString &cmd, const  QString &args)
@@ -799,50 +852,45 @@ bool DotRunner::run()
    QString dotArgs;
      
    QString file      = m_file;
-   QString path      = m_path;
-   QString imageName = m_imageName;
    QString postCmd   = m_postCmd;
    QString postArgs  = m_postArgs;
 
    int exitCode      = 0;
-   bool checkResult  = m_checkResult;
-   bool cleanUp      = m_cleanUp;
+
+   if (fetchFromCache()) {
+      finish();
+      return true;
+   }
 
    if (multiTargets) {
       dotArgs = "\"" + file + "\"";
      
-      for (auto s : m_jobs) {
+      for (const auto &job : m_jobs) {
          dotArgs += ' ';
-         dotArgs += s;
+         dotArgs += jobArgs(job);
       }
 
-      if ((exitCode = portable_system(dotExe, dotArgs, false)) != 0) {
+      if ((exitCode = ToolExecutor::instance()->run("dot", dotExe, dotArgs, false)) != 0) {
          goto error;
       }
 
    } else {
-      for (auto s : m_jobs) {
-         dotArgs = "\"" + file + "\" " + s;
+      for (const auto &job : m_jobs) {
+         dotArgs = "\"" + file + "\" " + jobArgs(job);
 
-         if ((exitCode = portable_system(dotExe, dotArgs, false)) != 0) {
+         if ((exitCode = ToolExecutor::instance()->run("dot", dotExe, dotArgs, false)) != 0) {
             goto error;
          }
       }
    }
 
-   if (! postCmd.isEmpty() && portable_system(postCmd, postArgs) != 0) {
+   if (! postCmd.isEmpty() && ToolExecutor::instance()->run(postCmd, postCmd, postArgs) != 0) {
       err("Unable to run '%s' as a post-processing step for dot output\n", csPrintable(m_postCmd));
       return false;
    }
 
-   if (checkResult) {
-      checkDotResult(imageName);
-   }
-
-   if (cleanUp) {     
-      m_cleanupItem.file = file;
-      m_cleanupItem.path = path;
-   }
+   storeInCache();
+   finish();
 
    return true;
 
@@ -852,6 +900,153 @@ error:
    return false;
 }
 
+void DotRunner::finish()
+{
+   if (m_checkResult) {
+      checkDotResult(m_imageName);
+   }
+
+   if (m_cleanUp) {     
+      m_cleanupItem.file = m_file;
+      m_cleanupItem.path = m_path;
+   }
+
+   m_endTime.store(g_dotTimer.elapsed());
+}
+
+bool DotRunner::fetchFromCache()
+{
+   GraphCache *cache = GraphCache::instance();
+
+   // output of a post processing step is not cached
+   if (! cache->isEnabled() || ! m_postCmd.isEmpty() || m_cacheChecked) {
+      return false;
+   }
+
+   // a batch which failed runs each graph again, only look up the graph once
+   m_cacheChecked = true;
+   m_cacheKey     = cache->key(m_file);
+
+   if (m_cacheKey.isEmpty()) {
+      return false;
+   }
+
+   for (const auto &job : m_jobs) {
+      if (! cache->fetch(m_cacheKey, job.format, job.output)) {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+void DotRunner::storeInCache()
+{
+   GraphCache *cache = GraphCache::instance();
+
+   if (! cache->isEnabled() || ! m_postCmd.isEmpty() || m_cacheKey.isEmpty()) {
+      return;
+   }
+
+   for (const auto &job : m_jobs) {
+      cache->store(m_cacheKey, job.format, job.output);
+   }
+}
+
+bool DotRunner::runBatch(const QList<DotRunner *> &runners)
+{
+   static const QString dotExe    = Config::getString("dot-path");
+   static const bool multiTargets = Config::getBool("dot-multiple-targets");
+
+   QList<DotRunner *> toRun;
+
+   for (auto runner : runners) {
+      if (runner->fetchFromCache()) {
+         runner->finish();
+      } else {
+         toRun.append(runner);
+      }
+   }
+
+   if (toRun.isEmpty()) {
+      return true;
+   }
+
+   if (toRun.count() == 1) {
+      return toRun.first()->run();
+   }
+
+   // all runners of a batch have the same formats, dot writes the output for <file> to <file>.<format>
+   QString files;
+
+   for (auto runner : toRun) {
+      files += " \"" + runner->m_file + "\"";
+   }
+
+   const QList<Job> &jobs = toRun.first()->m_jobs;
+
+   QStringList dotArgList;
+
+   if (multiTargets) {
+      QString formatArgs;
+
+      for (const auto &job : jobs) {
+         formatArgs += "-T" + job.format + " ";
+      }
+
+      dotArgList.append(formatArgs + "-O" + files);
+
+   } else {
+      for (const auto &job : jobs) {
+         dotArgList.append("-T" + job.format + " -O" + files);
+      }
+   }
+
+   QDir dir;
+
+   for (const auto &dotArgs : dotArgList) {
+      if (ToolExecutor::instance()->run("dot", dotExe, dotArgs, false) != 0) {
+         // remove the output dot wrote before it failed, for all formats of the batch
+         for (auto runner : toRun) {
+            for (const auto &job : runner->m_jobs) {
+               dir.remove(runner->m_file + "." + job.format);
+            }
+         }
+
+         // run the graphs one by one, reports the graph which failed
+         bool retval = true;
+
+         for (auto runner : toRun) {
+            if (! runner->run()) {
+               retval = false;
+            }
+         }
+
+         return retval;
+      }
+   }
+
+   bool retval = true;
+
+   for (auto runner : toRun) {
+      for (const auto &job : runner->m_jobs) {
+         QString output = runner->m_file + "." + job.format;
+
+         dir.remove(job.output);
+
+         if (! dir.rename(output, job.output)) {
+            err("Unable to rename file %s to %s\n", csPrintable(output), csPrintable(job.output));
+            retval = false;
+         }
+      }
+
+      runner->storeInCache();
+      runner->finish();
+   }
+
+   return retval;
+}
+
 DotFilePatcher::DotFilePatcher(const QString &patchFile)
    : m_patchFile(patchFile)
 {
@@ -1151,110 +1346,131 @@ bool DotFilePatcher::run()
 
    return true;
 }
-void DotRunnerQueue::enqueue(DotRunner *runner)
+/** Runs a batch of dot runs on a worker of the ToolExecutor */
+class DotRunTask : public ToolTask
 {
-   QMutexLocker locker(&m_mutex);
-
-   m_queue.enqueue(runner);
-   m_bufferNotEmpty.wakeAll();
-}
+ public:
+   DotRunTask(const QList<DotRunner *> &runners)
+      : m_runners(runners)
+   {
+   }
 
-DotRunner *DotRunnerQueue::dequeue()
-{
-   QMutexLocker locker(&m_mutex);
+   int run() {
+      return DotRunner::runBatch(m_runners) ? 0 : 1;
+   }
 
-   while (m_queue.isEmpty()) {
-      // wait until something is added to the queue
-      m_bufferNotEmpty.wait(&m_mutex);
+   int count() const {
+      return m_runners.count();
    }
 
-   DotRunner *result = m_queue.dequeue();
+ private:
+   QList<DotRunner *> m_runners;
+};
 
-   return result;
+DotManager *DotManager::instance()
+{
+   // the first call may come from any of the threads writing pages
+   static DotManager *theInstance = new DotManager;
+   return theInstance;
 }
 
-uint DotRunnerQueue::count() const
+DotManager::DotManager()
+   : m_started(false), m_setPath(false)
 {
-   QMutexLocker locker(&m_mutex);
-   return m_queue.count();
-}
+   g_dotTimer.start();
+   GraphCache::instance()->open();
 
+   // the number of dot processes is limited by the ToolExecutor
+   m_background = (Config::getInt("dot-num-threads") != 1);
+}
 
-DotWorkerThread::DotWorkerThread(DotRunnerQueue *queue)
-   : m_queue(queue)
+DotManager::~DotManager()
 {
 }
 
-void DotWorkerThread::run()
+void DotManager::addRun(DotRunner *run)
 {
-   DotRunner *runner;
+   QMutexLocker locker(&m_mutex);
+
+   QString key = run->key();
+
+   if (m_runKeys.contains(key)) {
+      // same graph was emitted for a second page, the pending run produces the output
+      delete run;
+      return;
+   }
+
+   m_runKeys.insert(key);
+   m_dotFiles.insert(run->file());
 
-   while ((runner = m_queue->dequeue())) {
-      runner->run();
-      DotRunner::CleanupItem cleanup = runner->cleanup();
+   m_dotRuns.append(run);
+
+   if (m_background) {
+      // run dot while the rest of the documentation is generated
+      startRuns();
+
+      static const int batchSize = qMax(1, Config::getInt("dot-batch-size"));
+
+      if (! m_batch.isEmpty() && (m_batch.count() >= batchSize || ! run->canBatch() ||
+               run->batchKey() != m_batch.first()->batchKey())) {
+         submitBatch();
+      }
+
+      m_batch.append(run);
 
-      if (!cleanup.file.isEmpty()) {
-         m_cleanupItems.append(cleanup);
+      if (! run->canBatch()) {
+         submitBatch();
       }
    }
 }
 
-void DotWorkerThread::cleanup()
+void DotManager::submitBatch()
 {
-   for (auto ci : m_cleanupItems) {
-      QDir(ci.path).remove(ci.file);
+   if (m_batch.isEmpty()) {
+      return;
    }
-}
 
-DotManager *DotManager::m_theInstance = 0;
+   DotRunTask *task = new DotRunTask(m_batch);
+   m_tasks.append(qMakePair(ToolExecutor::instance()->submitTask(task), task));
 
-DotManager *DotManager::instance()
+   m_batch.clear();
+}
+
+bool DotManager::hasRun(const QString &dotFile) const
 {
-   if (!m_theInstance) {
-      m_theInstance = new DotManager;
-   }
-   return m_theInstance;
+   QMutexLocker locker(&m_mutex);
+   return m_dotFiles.contains(dotFile);
 }
 
-DotManager::DotManager() 
+void DotManager::startRuns()
 {
-   m_queue = new DotRunnerQueue;
+   if (m_started) {
+      return;
+   }
 
-   int i;
-   int numThreads = qMin(32, Config::getInt("dot-num-threads"));
+   m_started = true;
 
-   if (numThreads != 1) {
-      if (numThreads == 0) {
-         numThreads = qMax(2, QThread::idealThreadCount() + 1);
-      }
+   if (Config::getBool("generate-html")) {
+      setDotFontPath(Config::getString("html-output"));
+      m_setPath = true;
 
-      for (i = 0; i < numThreads; i++) {
-         DotWorkerThread *thread = new DotWorkerThread(m_queue);
-         thread->start();
+   } else if (Config::getBool("generate-latex")) {
+      setDotFontPath(Config::getString("latex-output"));
+      m_setPath = true;
 
-         if (thread->isRunning()) {
-            m_workers.append(thread);
-         } else { // no more threads available!
-            delete thread;
-         }
-      }
-      assert(m_workers.count() > 0);
+   } else if (Config::getBool("generate-rtf")) {
+      setDotFontPath(Config::getString("rtf-output"));
+      m_setPath = true;
    }
-}
-
-DotManager::~DotManager()
-{
-   delete m_queue;
-}
 
-void DotManager::addRun(DotRunner *run)
-{
-   m_dotRuns.append(run);
+   portable_sysTimerStart();
 }
 
 int DotManager::addMap(const QString &file, const QString &mapFile,
                        const QString &relPath, bool urlOnly, const QString &context, const QString &label)
 {
+   QMutexLocker locker(&m_mutex);
+
    QSharedPointer<DotFilePatcher> map = m_dotMaps.find(file);
 
    if (! map) {
@@ -1267,6 +1483,8 @@ int DotManager::addMap(const QString &file, const QString &mapFile,
 
 int DotManager::addFigure(const QString &file, const QString &baseName, const QString &figureName, bool heightCheck)
 {
+   QMutexLocker locker(&m_mutex);
+
   QSharedPointer<DotFilePatcher> map = m_dotMaps.find(file);
 
    if (! map) {
@@ -1280,6 +1498,8 @@ int DotManager::addFigure(const QString &file, const QString &baseName, const QS
 int DotManager::addSVGConversion(const QString &file, const QString &relPath,
                                  bool urlOnly, const QString &context, bool zoomable,int graphId)
 {
+   QMutexLocker locker(&m_mutex);
+
    QSharedPointer<DotFilePatcher> map = m_dotMaps.find(file);
 
    if (! map) {
@@ -1292,6 +1512,8 @@ int DotManager::addSVGConversion(const QString &file, const QString &relPath,
 
 int DotManager::addSVGObject(const QString &file, const QString &baseName, const QString &absImgName, const QString &relPath)
 {
+   QMutexLocker locker(&m_mutex);
+
    QSharedPointer<DotFilePatcher> map = m_dotMaps.find(file);
 
    if (! map) {
@@ -1308,58 +1530,76 @@ bool DotManager::run()
    uint numDotMaps = m_dotMaps.count();
 
    if (numDotRuns + numDotMaps > 1) {
-      if (m_workers.count() == 0) {
+      if (! m_background) {
          msg("Generating dot graphs in single threaded mode...\n");
 
       } else {
-         msg("Generating dot graphs using %d parallel threads...\n", qMin(numDotRuns + numDotMaps, (uint)m_workers.count()));
+         msg("Generating dot graphs using %d parallel threads...\n",
+               qMin(numDotRuns + numDotMaps, (uint)ToolExecutor::instance()->threadCount()));
       }
    }
 
    int i = 1;
-   bool setPath = false;
-
-   if (Config::getBool("generate-html")) {
-      setDotFontPath(Config::getString("html-output"));
-      setPath = true;
 
-   } else if (Config::getBool("generate-latex")) {
-      setDotFontPath(Config::getString("latex-output"));
-      setPath = true;
+   // time at which documentation generation was done
+   qint64 generationEnd = g_dotTimer.elapsed();
+   int finishedEarly    = 0;
 
-   } else if (Config::getBool("generate-rtf")) {
-      setDotFontPath(Config::getString("rtf-output"));
-      setPath = true;
+   for (auto dr : m_dotRuns) {
+      if (dr->endTime() != -1) {
+         ++finishedEarly;
+      }
    }
 
-   portable_sysTimerStart();
+   startRuns();
 
-   // fill work queue with dot operations
-   DotRunner *dr;
+   // work queue was filled while generating the documentation
    int prev = 1;
-     
-   if (m_workers.count() == 0) { // no threads to work with
+
+   if (! m_background) { // no threads to work with
+
+      const int batchSize = qMax(1, Config::getInt("dot-batch-size"));
+
+      QList<DotRunner *> batch;
 
       for (auto dr : m_dotRuns) {
          msg("Running dot for graph %d/%d\n", prev, numDotRuns);
-         dr->run();
          prev++;
+
+         if (! batch.isEmpty() && (batch.count() >= batchSize || ! dr->canBatch() ||
+                  dr->batchKey() != batch.first()->batchKey())) {
+
+            DotRunner::runBatch(batch);
+            batch.clear();
+         }
+
+         if (dr->canBatch()) {
+            batch.append(dr);
+         } else {
+            dr->run();
+         }
       }
 
-   } else { // use multiple threads to run instances of dot in parallel
-      for (auto dr : m_dotRuns) {
-         m_queue->enqueue(dr);
+      if (! batch.isEmpty()) {
+         DotRunner::runBatch(batch);
       }
 
-      // wait for the queue to become empty
-      while ((i = m_queue->count()) > 0) {
-         i = numDotRuns - i;
+   } else { // the runs were submitted to the ToolExecutor while generating the documentation
+      submitBatch();
+
+      ToolExecutor *executor = ToolExecutor::instance();
+      int done = 0;
+
+      for (const auto &item : m_tasks) {
+         executor->wait(item.first);
+
+         done += item.second->count();
+         delete item.second;
 
-         while (i >= prev) {
+         while (done >= prev) {
             msg("Running dot for graph %d/%d\n", prev, numDotRuns);
             prev++;
          }
-         portable_sleep(100);
       }
 
       while (numDotRuns >= prev) {
@@ -1367,26 +1607,50 @@ bool DotManager::run()
          prev++;
       }
 
-      // signal the workers we are done
-      for (i = 0; i < m_workers.count(); i++) {
-         m_queue->enqueue(0); // add terminator for each worker
-      }
-
-      // wait for the workers to finish
-      for (i = 0; i < m_workers.count(); i++) {
-         m_workers.at(i)->wait();
-      }
+      m_tasks.clear();
 
       // clean up dot files from main thread
-      for (i = 0; i < m_workers.count(); i++) {
-         m_workers.at(i)->cleanup();
+      for (auto dr : m_dotRuns) {
+         DotRunner::CleanupItem cleanup = dr->cleanup();
+
+         if (! cleanup.file.isEmpty()) {
+            QDir(cleanup.path).remove(cleanup.file);
+         }
       }
    }
+
    portable_sysTimerStop();
-   if (setPath) {
+
+   if (m_setPath) {
       unsetDotFontPath();
    }
 
+   if (Debug::isFlagSet(Debug::Time) && numDotRuns > 0) {
+      msg("Dot runs finished while generating documentation: %d/%d, generation ended at %.3f seconds, "
+            "last dot run ended at %.3f seconds\n", finishedEarly, numDotRuns, generationEnd / 1000.0,
+            g_dotTimer.elapsed() / 1000.0);
+   }
+
+   m_dotFiles.clear();
+
+   GraphCache *cache = GraphCache::instance();
+
+   if (cache->isEnabled()) {
+      int hits   = cache->hits();
+      int misses = cache->misses();
+
+      if (hits + misses > 0) {
+         msg("Graph cache hits: %d/%d (%d%%)\n", hits, hits + misses, 100 * hits / (hits + misses));
+      }
+
+      if (Debug::isFlagSet(Debug::Time)) {
+         Doxy_Globals::g_stats.addCounter("graph cache hits",   hits);
+         Doxy_Globals::g_stats.addCounter("graph cache misses", misses);
+      }
+
+      cache->close();
+   }
+
    // patch the output file and insert the maps and figures
    i = 1;
 
@@ -1425,8 +1689,8 @@ bool DotManager::run()
  */
 static void deleteNodes(DotNode *node, StringMap<QSharedPointer<DotNode>> *skipNodes = 0)
 {   
-   static SortedList<DotNode *> deletedNodes;
-   
+   SortedList<DotNode *> deletedNodes;
+
    node->deleteNode(deletedNodes, skipNodes); // collect nodes to be deleted.
    deletedNodes.clear(); // actually remove the nodes.
 }
@@ -1699,10 +1963,30 @@ static QString stripProtectionPrefix(const QString &s)
 
 }
 
-void DotNode::writeBox(QTextStream &t, GraphType gt, GraphOutputFormat, bool hasNonReachableChildren, bool reNumber)
+const char *DotNode::borderColor(bool hasNonReachableChildren) const
+{
+   if (m_url.isEmpty()) {
+      // non link
+      return "grey75";
+   }
+
+   return hasNonReachableChildren ? "red" : "black";
+}
+
+QString DotNode::linkUrl() const
+{
+   int anchorPos = m_url.lastIndexOf('#');
+
+   if (anchorPos == -1) {
+      return m_url + Doxy_Globals::htmlFileExtension;
+   }
+
+   return m_url.left(anchorPos) + Doxy_Globals::htmlFileExtension + m_url.right(m_url.length() - anchorPos);
+}
+
+void DotNode::writeBox(QTextStream &t, GraphType gt, GraphOutputFormat, bool hasNonReachableChildren, DotNodeNumbering *reNumber)
 {
-   const char *labCol = m_url.isEmpty() ? "grey75" :  // non link
-      ( (hasNonReachableChildren) ? "red" : "black");
+   const char *labCol = borderColor(hasNonReachableChildren);
 
    t << "  Node" << reNumberNode(m_number, reNumber) << " [label=\"";
    static bool umlLook = Config::getBool("uml-look");
@@ -1803,15 +2087,7 @@ void DotNode::writeBox(QTextStream &t, GraphType gt, GraphOutputFormat, bool has
       }
 
       if (! m_url.isEmpty()) {
-         int anchorPos = m_url.lastIndexOf('#');
-
-         if (anchorPos == -1) {
-            t << ",URL=\"" << m_url << Doxy_Globals::htmlFileExtension << "\"";
-
-         } else {
-            t << ",URL=\"" << m_url.left(anchorPos) << Doxy_Globals::htmlFileExtension
-              << m_url.right(m_url.length() - anchorPos) << "\"";
-         }
+         t << ",URL=\"" << linkUrl() << "\"";
       }
 
       if (!m_tooltip.isEmpty()) {
@@ -1823,7 +2099,7 @@ void DotNode::writeBox(QTextStream &t, GraphType gt, GraphOutputFormat, bool has
 }
 
 void DotNode::writeArrow(QTextStream &t, GraphType gt, GraphOutputFormat format, DotNode *cn, EdgeInfo *ei,
-                         bool topDown, bool pointBack, bool reNumber)
+                         bool topDown, bool pointBack, DotNodeNumbering *reNumber)
 {
    t << "  Node";
    if (topDown) {
@@ -1842,7 +2118,7 @@ void DotNode::writeArrow(QTextStream &t, GraphType gt, GraphOutputFormat format,
 
    static bool umlLook = Config::getBool("uml-look");
 
-   const EdgeProperties *eProps = umlLook ? &umlEdgeProps : &normalEdgeProps;
+   const EdgeProperties *eProps = edgeProperties();
    QString aStyle = eProps->arrowStyleMap[ei->m_color];
    bool umlUseArrow = aStyle == "odiamond";
 
@@ -1881,7 +2157,7 @@ void DotNode::writeArrow(QTextStream &t, GraphType gt, GraphOutputFormat format,
 }
 
 void DotNode::write(QTextStream &t, GraphType gt, GraphOutputFormat format, bool topDown,
-                    bool toChildren, bool backArrows, bool reNumber)
+                    bool toChildren, bool backArrows, DotNodeNumbering *reNumber)
 {
    if (m_written) {
       return;   // node already written to the output
@@ -2323,14 +2599,15 @@ void DotGfxHierarchyTable::writeGraph(QTextStream &out, const QString &path, con
          }
       }
  
+      DotNodeNumbering numbering;
+
       for (auto node : *m_rootNodes) {   
          if (node->m_subgraphId == n->m_subgraphId) {
-            node->write(md5stream, DotNode::Hierarchy, GOF_BITMAP, false, true, true, true);
+            node->write(md5stream, DotNode::Hierarchy, GOF_BITMAP, false, true, true, &numbering);
          }
       }
 
       writeGraphFooter(md5stream);
-      resetReNumbering();
 
       QString sigStr;
       sigStr = QCryptographicHash::hash(theGraph.toUtf8(), QCryptographicHash::Md5).toHex();
@@ -2351,7 +2628,6 @@ void DotGfxHierarchyTable::writeGraph(QTextStream &out, const QString &path, con
          QTextStream t(&f);
          t << theGraph;
          f.close();
-         resetReNumbering();
 
          DotRunner *dotRun = new DotRunner(dotName, d.absolutePath(), true, absImgName);
          dotRun->addJob(imgExt, absImgName);
@@ -2895,6 +3171,7 @@ void DotClassGraph::buildGraph(QSharedPointer<ClassDef> cd, DotNode *n, bool bas
 }
 
 DotClassGraph::DotClassGraph(QSharedPointer<ClassDef> cd, DotNode::GraphType t)
+   : m_curNodeNumber(0)
 {
    m_graphType = t;
 
@@ -2970,8 +3247,10 @@ DotClassGraph::~DotClassGraph()
 QString computeMd5Signature(DotNode *root, DotNode::GraphType gt, GraphOutputFormat format, bool lrRank,
                                bool renderParents, bool backArrows, const QString &title, QString &graphStr )
 {
-   bool reNumber = true;
- 
+   // node numbers are local to the graph, the signature does not depend on the order graphs are built
+   DotNodeNumbering numbering;
+   DotNodeNumbering *reNumber = &numbering;
+
    QByteArray buf;
 
    QTextStream md5stream(&buf);
@@ -3007,10 +3286,6 @@ QString computeMd5Signature(DotNode *root, DotNode::GraphType gt, GraphOutputFor
 
    QString sigStr;
    sigStr = QCryptographicHash::hash(buf, QCryptographicHash::Md5).toHex();
-  
-   if (reNumber) {
-     resetReNumbering();
-   }
 
    graphStr = buf;
   
@@ -3026,7 +3301,8 @@ static bool updateDotGraph(DotNode *root, DotNode::GraphType gt, const QString &
    QString md5 = computeMd5Signature( root, gt, format, lrRank, renderParents, backArrows, title, theGraph);
    QFile f(baseName + ".dot");
 
-   if (f.open(QIODevice::WriteOnly)) {
+   // do not rewrite a file which dot may be reading, the contents are identical
+   if (! DotManager::instance()->hasRun(f.fileName()) && f.open(QIODevice::WriteOnly)) {
       QTextStream t(&f);
       t << theGraph;
    }
@@ -3034,6 +3310,652 @@ static bool updateDotGraph(DotNode *root, DotNode::GraphType gt, const QString &
    return checkAndUpdateMd5Signature(baseName, md5); // graph needs to be regenerated
 }
 
+// spacing of graphs rendered by DotLayout, in points for svg and in pixels for png
+static const int layoutMargin   = 4;
+static const int layoutRankSep  = 36;
+static const int layoutNodeSep  = 12;
+static const int layoutHorzPad  = 6;
+static const int layoutVertPad  = 3;
+static const int layoutArrowLen = 10;
+
+// height of the font used by Image
+static const int bitmapLineHeight = 12;
+
+struct SvgColor {
+   const char *name;
+   const char *rgb;
+};
+
+// svg does not know the X11 color names used by dot
+static const SvgColor svgColors[] = {
+   { "black",        "#000000" },
+   { "white",        "#ffffff" },
+   { "red",          "#ff0000" },
+   { "grey25",       "#404040" },
+   { "grey75",       "#bfbfbf" },
+   { "midnightblue", "#191970" },
+   { "darkgreen",    "#006400" },
+   { "firebrick4",   "#8b1a1a" },
+   { "darkorchid3",  "#9a32cd" },
+   { "orange",       "#ffa500" },
+   { 0,              0         }
+};
+
+static QString svgColor(const QString &color)
+{
+   for (const SvgColor *item = svgColors; item->name != 0; ++item) {
+      if (color == item->name) {
+         return item->rgb;
+      }
+   }
+
+   return color;
+}
+
+// index in the palette of Image for an edge color
+static uchar bitmapEdgeColor(int color)
+{
+   switch (color) {
+      case EdgeInfo::Green:
+         return 5;
+
+      case EdgeInfo::Red:
+      case EdgeInfo::Orange:
+      case EdgeInfo::Orange2:
+         return 4;
+
+      case EdgeInfo::Grey:
+         return 7;
+
+      default:
+         return 6;
+   }
+}
+
+/** Splits a node label in lines, breaks the label at the same places as dot */
+static QStringList layoutLabel(const QString &label)
+{
+   QString text = convertLabel(label);
+
+   QStringList retval;
+   QString line;
+
+   for (int i = 0; i < text.length(); ++i) {
+      QChar c = text.at(i);
+
+      if (c == '\\' && i + 1 < text.length()) {
+         c = text.at(++i);
+
+         if (c == 'l' || c == 'n') {
+            retval.append(line);
+            line = QString();
+
+         } else {
+            line += c;
+         }
+
+      } else {
+         line += c;
+      }
+   }
+
+   if (! line.isEmpty() || retval.isEmpty()) {
+      retval.append(line);
+   }
+
+   return retval;
+}
+
+static bool isBitmapText(const QString &text)
+{
+   for (int i = 0; i < text.length(); ++i) {
+      ushort c = text.at(i).unicode();
+
+      if (c < 32 || c > 126) {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+static int layoutTextWidth(const QString &text, bool bitmap)
+{
+   static int fontSize = getDotFontSize();
+
+   int width = 0;
+
+   for (int i = 0; i < text.length(); ++i) {
+      ushort c = text.at(i).unicode();
+
+      if (c >= 32 && c <= 126) {
+         width += Image::stringLength(QString(text.at(i)));
+      } else {
+         width += 8;
+      }
+   }
+
+   if (! bitmap) {
+      // widths of Image are for a font size of 10
+      width = (width * fontSize + 9) / 10;
+   }
+
+   return width;
+}
+
+DotLayout::DotLayout(DotNode *root, DotNode::GraphType gt, bool lrRank, bool backArrows)
+   : m_valid(false), m_lrRank(lrRank), m_backArrows(backArrows)
+{
+   static int maxNodes = Config::getInt("dot-inline-max-nodes");
+
+   if (maxNodes <= 0 || (gt != DotNode::CallGraph && gt != DotNode::Dependency) || ! root->isVisible()) {
+      return;
+   }
+
+   QHash<DotNode *, int> nodeIndex;
+
+   LayoutNode item;
+   item.node   = root;
+   item.lines  = layoutLabel(root->m_label);
+   item.layer  = 0;
+   item.x      = 0;
+   item.y      = 0;
+   item.width  = 0;
+   item.height = 0;
+
+   nodeIndex.insert(root, 0);
+   m_nodes.append(item);
+
+   // breadth first, the layer of a node is its distance to the root
+   for (int index = 0; index < m_nodes.count(); ++index) {
+      DotNode *node = m_nodes[index].node;
+      int layer     = m_nodes[index].layer;
+
+      if (node->m_children == nullptr) {
+         continue;
+      }
+
+      for (int i = 0; i < node->m_children->count(); ++i) {
+         DotNode *child = node->m_children->at(i);
+         EdgeInfo *ei   = node->m_edgeInfo->at(i);
+
+         if (! child->isVisible()) {
+            continue;
+         }
+
+         if (! ei->m_label.isEmpty()) {
+            return;
+         }
+
+         int childIndex = nodeIndex.value(child, -1);
+
+         if (childIndex == -1) {
+            if (m_nodes.count() >= maxNodes) {
+               return;
+            }
+
+            childIndex = m_nodes.count();
+            nodeIndex.insert(child, childIndex);
+
+            item.node  = child;
+            item.lines = layoutLabel(child->m_label);
+            item.layer = layer + 1;
+
+            m_nodes.append(item);
+         }
+
+         if (m_nodes[childIndex].layer != layer + 1) {
+            // cycle or edge which skips a layer
+            return;
+         }
+
+         LayoutEdge edge;
+         edge.from     = index;
+         edge.to       = childIndex;
+         edge.edgeInfo = ei;
+
+         m_edges.append(edge);
+      }
+   }
+
+   m_valid = true;
+}
+
+void DotLayout::layout(QVector<LayoutNode> &nodes, bool bitmap, int &width, int &height) const
+{
+   static int fontSize = getDotFontSize();
+   const int lineHeight = bitmap ? bitmapLineHeight : (fontSize * 6 + 2) / 5;
+
+   nodes = m_nodes;
+   int numLayers = 0;
+
+   for (auto &item : nodes) {
+      int textWidth = 0;
+
+      for (const auto &line : item.lines) {
+         textWidth = qMax(textWidth, layoutTextWidth(line, bitmap));
+      }
+
+      item.width  = textWidth + 2 * layoutHorzPad;
+      item.height = item.lines.count() * lineHeight + 2 * layoutVertPad;
+
+      numLayers = qMax(numLayers, item.layer + 1);
+   }
+
+   QVector<QList<int>> layers(numLayers);
+
+   for (int i = 0; i < nodes.count(); ++i) {
+      layers[nodes[i].layer].append(i);
+   }
+
+   // order each layer by the mean position of the parents, avoids most crossing edges
+   QVector<double> position(nodes.count(), 0);
+
+   for (int layer = 0; layer < numLayers; ++layer) {
+      QList<int> &list = layers[layer];
+
+      if (layer > 0) {
+         QVector<double> sum(nodes.count(), 0);
+         QVector<int> count(nodes.count(), 0);
+
+         for (const auto &edge : m_edges) {
+            sum[edge.to] += position[edge.from];
+            ++count[edge.to];
+         }
+
+         std::stable_sort(list.begin(), list.end(), [&sum, &count](int a, int b) {
+            return sum[a] / qMax(1, count[a]) < sum[b] / qMax(1, count[b]);
+         });
+      }
+
+      for (int i = 0; i < list.count(); ++i) {
+         position[list[i]] = i;
+      }
+   }
+
+   // depth is the size along the rank direction, length the size across it
+   QVector<int> layerDepth(numLayers, 0);
+   QVector<int> layerLength(numLayers, 0);
+   int maxLength = 0;
+
+   for (int layer = 0; layer < numLayers; ++layer) {
+      for (int i : layers[layer]) {
+         const LayoutNode &item = nodes[i];
+
+         layerDepth[layer] = qMax(layerDepth[layer], m_lrRank ? item.width : item.height);
+
+         if (layerLength[layer] > 0) {
+            layerLength[layer] += layoutNodeSep;
+         }
+
+         layerLength[layer] += m_lrRank ? item.height : item.width;
+      }
+
+      maxLength = qMax(maxLength, layerLength[layer]);
+   }
+
+   int rankPos = layoutMargin;
+
+   for (int layer = 0; layer < numLayers; ++layer) {
+      int pos = layoutMargin + (maxLength - layerLength[layer]) / 2;
+
+      for (int i : layers[layer]) {
+         LayoutNode &item = nodes[i];
+
+         if (m_lrRank) {
+            item.x = rankPos + (layerDepth[layer] - item.width) / 2;
+            item.y = pos;
+            pos += item.height + layoutNodeSep;
+
+         } else {
+            item.x = pos;
+            item.y = rankPos + (layerDepth[layer] - item.height) / 2;
+            pos += item.width + layoutNodeSep;
+         }
+      }
+
+      rankPos += layerDepth[layer] + layoutRankSep;
+   }
+
+   int depth = rankPos - layoutRankSep + layoutMargin;
+
+   if (m_lrRank) {
+      width  = depth;
+      height = maxLength + 2 * layoutMargin;
+
+   } else {
+      width  = maxLength + 2 * layoutMargin;
+      height = depth;
+   }
+}
+
+bool DotLayout::writeMap(const QString &mapName, const QVector<LayoutNode> &nodes) const
+{
+   QFile f(mapName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s, error: %d\n", qPrintable(mapName), f.error());
+      return false;
+   }
+
+   QTextStream t(&f);
+   t << "<map id=\"" << convertToXML(nodes.first().node->label()) << "\" name=\""
+     << convertToXML(nodes.first().node->label()) << "\">" << endl;
+
+   for (int i = 0; i < nodes.count(); ++i) {
+      const LayoutNode &item = nodes[i];
+
+      if (item.node->m_isRoot || item.node->m_url.isEmpty()) {
+         continue;
+      }
+
+      QString title = item.node->m_tooltip.isEmpty() ? item.node->label() : item.node->m_tooltip;
+
+      t << "<area shape=\"rect\" id=\"node" << (i + 1) << "\" href=\"" << convertToXML(item.node->linkUrl())
+        << "\" title=\"" << convertToXML(title) << "\" alt=\"\" coords=\"" << item.x << "," << item.y << ","
+        << (item.x + item.width) << "," << (item.y + item.height) << "\"/>" << endl;
+   }
+
+   t << "</map>" << endl;
+
+   return true;
+}
+
+bool DotLayout::write(const QString &format, const QString &imgName, const QString &mapName) const
+{
+   if (! m_valid) {
+      return false;
+   }
+
+   if (format == "svg") {
+      return writeSVG(imgName, mapName);
+
+   } else if (format == "png") {
+      return writeBitmap(imgName, mapName);
+
+   }
+
+   return false;
+}
+
+bool DotLayout::writeSVG(const QString &imgName, const QString &mapName) const
+{
+   static bool dotTransparent = Config::getBool("dot-transparent");
+   static int fontSize        = getDotFontSize();
+
+   const int lineHeight = (fontSize * 6 + 2) / 5;
+
+   QVector<LayoutNode> nodes;
+   int width;
+   int height;
+
+   layout(nodes, false, width, height);
+
+   QFile f(imgName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s, error: %d\n", qPrintable(imgName), f.error());
+      return false;
+   }
+
+   QTextStream t(&f);
+
+   t << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << endl;
+   t << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"" << endl;
+   t << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">" << endl;
+
+   // the size must be on the line of the svg element, see readSVGSize()
+   t << "<svg width=\"" << width << "pt\" height=\"" << height << "pt\"" << endl;
+   t << " viewBox=\"0.00 0.00 " << width << ".00 " << height << ".00\" "
+        "xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\">" << endl;
+
+   t << "<g id=\"graph0\" class=\"graph\">" << endl;
+   t << "<title>" << convertToXML(nodes.first().node->label()) << "</title>" << endl;
+
+   if (! dotTransparent) {
+      t << "<polygon fill=\"white\" stroke=\"none\" points=\"0,0 " << width << ",0 " << width << ","
+        << height << " 0," << height << "\"/>" << endl;
+   }
+
+   const EdgeProperties *eProps = edgeProperties();
+
+   for (int i = 0; i < m_edges.count(); ++i) {
+      const LayoutEdge &edge = m_edges[i];
+      const LayoutNode &from = nodes[edge.from];
+      const LayoutNode &to   = nodes[edge.to];
+
+      // unit vector in the rank direction
+      int dx = m_lrRank ? 1 : 0;
+      int dy = m_lrRank ? 0 : 1;
+
+      int sx = m_lrRank ? from.x + from.width : from.x + from.width / 2;
+      int sy = m_lrRank ? from.y + from.height / 2 : from.y + from.height;
+      int ex = m_lrRank ? to.x : to.x + to.width / 2;
+      int ey = m_lrRank ? to.y + to.height / 2 : to.y;
+
+      // the arrow head is drawn at the parent when the arrows point back
+      int tipX = m_backArrows ? sx : ex;
+      int tipY = m_backArrows ? sy : ey;
+      int dir  = m_backArrows ? -1 : 1;
+
+      if (m_backArrows) {
+         sx += dx * layoutArrowLen;
+         sy += dy * layoutArrowLen;
+      } else {
+         ex -= dx * layoutArrowLen;
+         ey -= dy * layoutArrowLen;
+      }
+
+      int half = m_lrRank ? (ex - sx) / 2 : (ey - sy) / 2;
+
+      QString color = svgColor(eProps->edgeColorMap[edge.edgeInfo->m_color]);
+
+      t << "<g id=\"edge" << (i + 1) << "\" class=\"edge\">" << endl;
+      t << "<title>Node" << (edge.from + 1) << "&#45;&gt;Node" << (edge.to + 1) << "</title>" << endl;
+      t << "<path fill=\"none\" stroke=\"" << color << "\"";
+
+      if (qstrcmp(eProps->edgeStyleMap[edge.edgeInfo->m_style], "dashed") == 0) {
+         t << " stroke-dasharray=\"5,2\"";
+      }
+
+      t << " d=\"M" << sx << "," << sy << " C" << (sx + dx * half) << "," << (sy + dy * half) << " "
+        << (ex - dx * half) << "," << (ey - dy * half) << " " << ex << "," << ey << "\"/>" << endl;
+
+      // base of the arrow head
+      int bx = tipX - dir * dx * layoutArrowLen;
+      int by = tipY - dir * dy * layoutArrowLen;
+
+      t << "<polygon fill=\"" << color << "\" stroke=\"" << color << "\" points=\"" << tipX << "," << tipY << " "
+        << (bx + dy * 3.5) << "," << (by + dx * 3.5) << " " << (bx - dy * 3.5) << "," << (by - dx * 3.5) << " "
+        << tipX << "," << tipY << "\"/>" << endl;
+
+      t << "</g>" << endl;
+   }
+
+   for (int i = 0; i < nodes.count(); ++i) {
+      const LayoutNode &item = nodes[i];
+      DotNode *node = item.node;
+
+      bool hasLink = ! node->m_isRoot && ! node->m_url.isEmpty();
+
+      t << "<g id=\"node" << (i + 1) << "\" class=\"node\">" << endl;
+      t << "<title>Node" << (i + 1) << "</title>" << endl;
+
+      if (hasLink) {
+         QString title = node->m_tooltip.isEmpty() ? node->label() : node->m_tooltip;
+
+         // the link must be on a line of its own, see replaceRef()
+         t << "<g id=\"a_node" << (i + 1) << "\">" << endl;
+         t << "<a xlink:href=\"" << convertToXML(node->linkUrl()) << "\"" << endl;
+         t << " xlink:title=\"" << convertToXML(title) << "\">" << endl;
+      }
+
+      QString fill;
+      QString stroke;
+
+      if (node->m_isRoot) {
+         fill   = svgColor("grey75");
+         stroke = svgColor("black");
+
+      } else {
+         fill   = dotTransparent ? QString("none") : svgColor("white");
+         stroke = svgColor(node->borderColor(node->m_truncated == DotNode::Truncated));
+      }
+
+      int x2 = item.x + item.width;
+      int y2 = item.y + item.height;
+
+      t << "<polygon fill=\"" << fill << "\" stroke=\"" << stroke << "\" points=\"" << item.x << "," << item.y << " "
+        << x2 << "," << item.y << " " << x2 << "," << y2 << " " << item.x << "," << y2 << " "
+        << item.x << "," << item.y << "\"/>" << endl;
+
+      int baseLine = item.y + layoutVertPad + fontSize;
+
+      for (const auto &line : item.lines) {
+         t << "<text text-anchor=\"middle\" x=\"" << (item.x + item.width / 2) << "\" y=\"" << baseLine
+           << "\" font-family=\"" << FONTNAME << ",sans-Serif\" font-size=\"" << fontSize << ".00\">"
+           << convertToXML(line) << "</text>" << endl;
+
+         baseLine += lineHeight;
+      }
+
+      if (hasLink) {
+         t << "</a>" << endl;
+         t << "</g>" << endl;
+      }
+
+      t << "</g>" << endl;
+   }
+
+   t << "</g>" << endl;
+   t << "</svg>" << endl;
+
+   f.close();
+
+   if (! mapName.isEmpty()) {
+      return writeMap(mapName, nodes);
+   }
+
+   return true;
+}
+
+/** Draws an arrow head with its tip at \a x, \a y pointing in the direction \a dx, \a dy */
+static void drawArrowHead(Image &image, int x, int y, int dx, int dy, uchar color)
+{
+   for (int i = 0; i < 6; i++) {
+      int h = i >> 1;
+
+      if (dx != 0) {
+         image.drawVertLine(x - dx * i, y - h, y + h, color, 0xffffffff);
+      } else {
+         image.drawHorzLine(y - dy * i, x - h, x + h, color, 0xffffffff);
+      }
+   }
+}
+
+bool DotLayout::writeBitmap(const QString &imgName, const QString &mapName) const
+{
+   // the font of Image only has glyphs for printable ascii characters
+   for (const auto &item : m_nodes) {
+      for (const auto &line : item.lines) {
+         if (! isBitmapText(line)) {
+            return false;
+         }
+      }
+   }
+
+   QVector<LayoutNode> nodes;
+   int width;
+   int height;
+
+   layout(nodes, true, width, height);
+
+   Image image(width, height);
+
+   for (const auto &edge : m_edges) {
+      const LayoutNode &from = nodes[edge.from];
+      const LayoutNode &to   = nodes[edge.to];
+
+      uchar color = bitmapEdgeColor(edge.edgeInfo->m_color);
+      uint mask   = edge.edgeInfo->m_style == EdgeInfo::Dashed ? 0xf0f0f0f0 : 0xffffffff;
+
+      // edges are drawn with horizontal and vertical lines only
+      if (m_lrRank) {
+         int sx = from.x + from.width;
+         int sy = from.y + from.height / 2;
+         int ex = to.x - 1;
+         int ey = to.y + to.height / 2;
+         int mx = (sx + ex) / 2;
+
+         image.drawHorzLine(sy, sx, mx, color, mask);
+         image.drawVertLine(mx, qMin(sy, ey), qMax(sy, ey), color, mask);
+         image.drawHorzLine(ey, mx, ex, color, mask);
+
+         if (m_backArrows) {
+            drawArrowHead(image, sx, sy, -1, 0, color);
+         } else {
+            drawArrowHead(image, ex, ey, 1, 0, color);
+         }
+
+      } else {
+         int sx = from.x + from.width / 2;
+         int sy = from.y + from.height;
+         int ex = to.x + to.width / 2;
+         int ey = to.y - 1;
+         int my = (sy + ey) / 2;
+
+         image.drawVertLine(sx, sy, my, color, mask);
+         image.drawHorzLine(my, qMin(sx, ex), qMax(sx, ex), color, mask);
+         image.drawVertLine(ex, my, ey, color, mask);
+
+         if (m_backArrows) {
+            drawArrowHead(image, sx, sy, 0, -1, color);
+         } else {
+            drawArrowHead(image, ex, ey, 0, 1, color);
+         }
+      }
+   }
+
+   for (const auto &item : nodes) {
+      DotNode *node = item.node;
+      uchar border;
+
+      if (node->m_isRoot) {
+         image.fillRect(item.x, item.y, item.width, item.height, 7, 0xffffffff);
+         border = 1;
+
+      } else {
+         QString color = node->borderColor(node->m_truncated == DotNode::Truncated);
+         border = color == "red" ? 4 : color == "black" ? 1 : 7;
+      }
+
+      image.drawRect(item.x, item.y, item.width, item.height, border, 0xffffffff);
+
+      int y = item.y + layoutVertPad;
+
+      for (const auto &line : item.lines) {
+         image.writeString(item.x + (item.width - Image::stringLength(line)) / 2, y, line, 1);
+         y += bitmapLineHeight;
+      }
+   }
+
+   QFile f(imgName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s, error: %d\n", qPrintable(imgName), f.error());
+      return false;
+   }
+
+   f.write(image.convert());
+   f.close();
+
+   if (! mapName.isEmpty()) {
+      return writeMap(mapName, nodes);
+   }
+
+   return true;
+}
+
 QString DotClassGraph::diskName() const
 {
    QString result = m_diskName;
@@ -3383,6 +4305,7 @@ void DotInclDepGraph::determineTruncatedNodes(QList<DotNode *> &queue)
 
 
 DotInclDepGraph::DotInclDepGraph(QSharedPointer<FileDef> fd, bool inverse)
+   : m_curNodeNumber(0)
 {
    m_inverse = inverse;
    assert(fd != 0);
@@ -3474,16 +4397,23 @@ QString DotInclDepGraph::writeGraph(QTextStream &out, GraphOutputFormat graphFor
 
       regenerate = true;
       if (graphFormat == GOF_BITMAP) {
-         // run dot to create a bitmap image
+         DotLayout layout(m_startNode, DotNode::Dependency, false, m_inverse);
 
-         DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
-         dotRun->addJob(imgExt, absImgName);
+         if (layout.write(imgExt, absImgName, generateImageMap ? absMapName : QString())) {
+            // small graph was rendered without running dot
+            removeDotGraph(absDotName);
 
-         if (generateImageMap) {
-            dotRun->addJob(MAP_CMD, absMapName);
-         }
+         } else {
+            // run dot to create a bitmap image
+            DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
+            dotRun->addJob(imgExt, absImgName);
 
-         DotManager::instance()->addRun(dotRun);
+            if (generateImageMap) {
+               dotRun->addJob(MAP_CMD, absMapName);
+            }
+
+            DotManager::instance()->addRun(dotRun);
+         }
 
       } else if (graphFormat == GOF_EPS) {
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), false);
@@ -3673,6 +4603,7 @@ void DotCallGraph::determineTruncatedNodes(QList<DotNode *> &queue)
 }
 
 DotCallGraph::DotCallGraph(QSharedPointer<MemberDef> md, bool inverse)
+   : m_curNodeNumber(0)
 {
    m_inverse = inverse;
    m_diskName = md->getOutputFileBase() + "_" + md->anchor();
@@ -3752,16 +4683,23 @@ QString DotCallGraph::writeGraph(QTextStream &out, GraphOutputFormat graphFormat
       regenerate = true;
 
       if (graphFormat == GOF_BITMAP) {
-         // run dot to create a bitmap image
+         DotLayout layout(m_startNode, DotNode::CallGraph, true, m_inverse);
 
-         DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
-         dotRun->addJob(imgExt, absImgName);
+         if (layout.write(imgExt, absImgName, generateImageMap ? absMapName : QString())) {
+            // small graph was rendered without running dot
+            removeDotGraph(absDotName);
 
-         if (generateImageMap) {
-            dotRun->addJob(MAP_CMD, absMapName);
-         }
+         } else {
+            // run dot to create a bitmap image
+            DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
+            dotRun->addJob(imgExt, absImgName);
 
-         DotManager::instance()->addRun(dotRun);
+            if (generateImageMap) {
+               dotRun->addJob(MAP_CMD, absMapName);
+            }
+
+            DotManager::instance()->addRun(dotRun);
+         }
 
       } else if (graphFormat == GOF_EPS) {
          // run dot to create a .eps image
@@ -4118,6 +5056,9 @@ void generateGraphLegend(const QString &path)
 
 void writeDotGraphFromFile(const QString &inFile, const QString &outDir, const QString &outFile, GraphOutputFormat format)
 {
+   // the same dot file can be shown on pages written by different threads
+   QMutexLocker locker(&s_dotFileLock);
+
    QDir d(outDir);
 
    if (! d.exists()) {
@@ -4173,6 +5114,8 @@ void writeDotGraphFromFile(const QString &inFile, const QString &outDir, const Q
 void writeDotImageMapFromFile(QTextStream &t, const QString &inFile, const QString &outDir, const QString &relPath, 
                   const QString &baseName, const QString &context, int graphId)
 {
+   QMutexLocker locker(&s_dotFileLock);
+
    QDir d(outDir);
 
    if (! d.exists()) {
@@ -4438,7 +5381,7 @@ QString DotGroupCollaboration::writeGraph( QTextStream &t, GraphOutputFormat gra
 
    // write other nodes  
    for (auto pn : *m_usedNodes) {
-      pn->write(md5stream, DotNode::Inheritance, graphFormat, true, false, false, false);
+      pn->write(md5stream, DotNode::Inheritance, graphFormat, true, false, false, nullptr);
    }
 
    // write edges
@@ -4447,7 +5390,6 @@ QString DotGroupCollaboration::writeGraph( QTextStream &t, GraphOutputFormat gra
    }
 
    writeGraphFooter(md5stream);
-   resetReNumbering();
 
    QString sigStr;
    sigStr = QCryptographicHash::hash(theGraph.toUtf8(), QCryptographicHash::Md5).toHex();
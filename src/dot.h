@@ -18,13 +18,18 @@
 #ifndef DOT_H
 #define DOT_H
 
+#include <QAtomicInt>
 #include <QByteArray>
 #include <QList>
 #include <QHash>
 #include <QMutex>
+#include <QPair>
 #include <QQueue>
+#include <QSet>
+#include <QStringList>
 #include <QTextStream>
 #include <QThread>
+#include <QVector>
 #include <QWaitCondition>
 
 #include <stringmap.h>
@@ -59,6 +64,16 @@ struct EdgeInfo {
    int m_labColor;
 };
 
+/** Numbers the nodes of one graph in the order they are written */
+class DotNodeNumbering
+{
+ public:
+   int number(int nodeNumber);
+
+ private:
+   QHash<int, int> m_numbers;
+};
+
 /** A node in a dot graph */
 class DotNode
 {
@@ -81,7 +96,7 @@ class DotNode
    int findParent( DotNode *n );
 
    void write(QTextStream &t, GraphType gt, GraphOutputFormat f,
-              bool topDown, bool toChildren, bool backArrows, bool reNumber);
+              bool topDown, bool toChildren, bool backArrows, DotNodeNumbering *reNumber);
 
    int  m_subgraphId;
    void clearWriteFlag();
@@ -111,10 +126,17 @@ class DotNode
 
  private:
    void colorConnectedNodes(int curColor);
-   void writeBox(QTextStream &t, GraphType gt, GraphOutputFormat f, bool hasNonReachableChildren, bool reNumber = false);
+
+   /** Returns the color of the border of the box, red if some children are not shown */
+   const char *borderColor(bool hasNonReachableChildren) const;
+
+   /** Returns the url of the node with the html file extension */
+   QString linkUrl() const;
+
+   void writeBox(QTextStream &t, GraphType gt, GraphOutputFormat f, bool hasNonReachableChildren, DotNodeNumbering *reNumber = nullptr);
 
    void writeArrow(QTextStream &t, GraphType gt, GraphOutputFormat f, DotNode *cn,
-                   EdgeInfo *ei, bool topDown, bool pointBack = true, bool reNumber = false);
+                   EdgeInfo *ei, bool topDown, bool pointBack = true, DotNodeNumbering *reNumber = nullptr);
 
    void setDistance(int distance);
    const DotNode  *findDocNode() const; // only works for acyclic graphs!
@@ -153,6 +175,7 @@ class DotNode
    friend class DotInclDepGraph;   
    friend class DotCallGraph;
    friend class DotGroupCollaboration;
+   friend class DotLayout;
 
    friend QString computeMd5Signature(DotNode *root, GraphType gt, GraphOutputFormat f, bool lrRank, bool renderParents,
                         bool backArrows, const QString &title, QString &graphStr);
@@ -182,7 +205,7 @@ class DotGfxHierarchyTable
    QList<DotNode *>          *m_rootNodes;
    QHash<QString, DotNode *> *m_usedNodes;
 
-   static int    m_curNodeNumber;
+   int m_curNodeNumber;
    SortedList<DotNode *>  *m_rootSubgraphs;
 };
 
@@ -216,7 +239,7 @@ class DotClassGraph
    DotNode *m_startNode;
    QHash<QString, DotNode *> *m_usedNodes;
 
-   static int m_curNodeNumber;
+   int m_curNodeNumber;
    DotNode::GraphType m_graphType;
    QString m_diskName;
    bool m_lrRank;
@@ -247,7 +270,7 @@ class DotInclDepGraph
    DotNode                   *m_startNode;
    QHash<QString, DotNode *> *m_usedNodes;
 
-   static int m_curNodeNumber;
+   int m_curNodeNumber;
    QString m_diskName;
    bool    m_inverse;
 };
@@ -271,7 +294,7 @@ class DotCallGraph
 
  private:
    DotNode        *m_startNode;
-   static int      m_curNodeNumber;
+   int m_curNodeNumber;
 
    QHash<QString, DotNode *> *m_usedNodes;
 
@@ -360,6 +383,55 @@ class DotGroupCollaboration
    QList<Edge *>   m_edges;
 };
 
+/** Lays out and renders small graphs without running dot
+ *
+ *  The nodes are placed in layers by their distance to the root node. Graphs with more
+ *  than dot-inline-max-nodes nodes, edge labels, or edges which do not connect adjacent
+ *  layers are left to dot. Only call and include dependency graphs are supported.
+ */
+class DotLayout
+{
+ public:
+   DotLayout(DotNode *root, DotNode::GraphType gt, bool lrRank, bool backArrows);
+
+   /** Returns true if the graph can be rendered without dot */
+   bool isValid() const {
+      return m_valid;
+   }
+
+   /** Writes the graph as an svg image or as a png image and an optional map file */
+   bool write(const QString &format, const QString &imgName, const QString &mapName) const;
+
+ private:
+   struct LayoutNode {
+      DotNode    *node;
+      QStringList lines;
+      int         layer;
+      int         x;
+      int         y;
+      int         width;
+      int         height;
+   };
+
+   struct LayoutEdge {
+      int       from;     // index of the parent node
+      int       to;       // index of the child node
+      EdgeInfo *edgeInfo;
+   };
+
+   void layout(QVector<LayoutNode> &nodes, bool bitmap, int &width, int &height) const;
+   bool writeSVG(const QString &imgName, const QString &mapName) const;
+   bool writeBitmap(const QString &imgName, const QString &mapName) const;
+   bool writeMap(const QString &mapName, const QVector<LayoutNode> &nodes) const;
+
+   QVector<LayoutNode> m_nodes;
+   QList<LayoutEdge>   m_edges;
+
+   bool m_valid;
+   bool m_lrRank;
+   bool m_backArrows;
+};
+
 /** Helper class to run dot
  */
 class DotRunner
@@ -385,12 +457,49 @@ class DotRunner
 
    /** Runs dot for all jobs added. */
    bool run();
+
+   /** Runs dot once for all \a runners, which must return the same batchKey() */
+   static bool runBatch(const QList<DotRunner *> &runners);
+
+   /** Returns true if this run can be combined with other runs in one dot process */
+   bool canBatch() const;
+
+   /** Runs with the same batch key have the same output formats */
+   QString batchKey() const;
    CleanupItem cleanup() const {
       return m_cleanupItem;
    }
 
+   /** Returns the dot file and the jobs, runs with the same key produce the same output */
+   QString key() const;
+
+   QString file() const {
+      return m_file;
+   }
+
+   /** Time in ms since the DotManager was created at which dot finished, -1 if not run yet */
+   int endTime() const {
+      return m_endTime.load();
+   }
+
  private:
-   QList<QString> m_jobs;
+   struct Job {
+      QString format;
+      QString output;
+   };
+
+   static QString jobArgs(const Job &job);
+   void finish();
+
+   /** Copies the output of all jobs from the graph cache, returns false on a miss */
+   bool fetchFromCache();
+   void storeInCache();
+
+   QByteArray m_cacheKey;
+
+   QList<Job> m_jobs;
+
+   QAtomicInt m_endTime;
 
    QString m_imageName;
    QString m_postArgs;
@@ -400,6 +509,7 @@ class DotRunner
 
    bool m_checkResult;   
    bool m_cleanUp;
+   bool m_cacheChecked;
 
    CleanupItem m_cleanupItem;
 };
@@ -433,40 +543,20 @@ class DotFilePatcher
    QString m_patchFile;
 };
 
-/** Queue of dot jobs to run. */
-class DotRunnerQueue
-{
- public:
-   void enqueue(DotRunner *runner);
-   DotRunner *dequeue();
-   uint count() const;
-
- private:
-   QWaitCondition  m_bufferNotEmpty;
-   QQueue<DotRunner *> m_queue;
-   mutable QMutex  m_mutex;
-};
-
-/** Worker thread to execute a dot run */
-class DotWorkerThread : public QThread
-{
- public:
-   DotWorkerThread(DotRunnerQueue *queue);
-   void run();
-   void cleanup();
-
- private:
-   DotRunnerQueue *m_queue;
-   QList<DotRunner::CleanupItem> m_cleanupItems;
-};
+class DotRunTask;
 
 /** Singleton that manages dot relation actions */
 class DotManager
 {
  public:
    static DotManager *instance();
+
+   /** Adds a dot run, unless dot-num-threads is 1 the run is started on the ToolExecutor immediately */
    void addRun(DotRunner *run);
 
+   /** Returns true if a run for \a dotFile was added, the file is in use until run() returns */
+   bool hasRun(const QString &dotFile) const;
+
    int  addMap(const QString &file, const QString &mapFile, const QString &relPath, bool urlOnly,
                   const QString &context, const QString &label);
 
@@ -483,13 +573,26 @@ class DotManager
    DotManager();
    virtual ~DotManager();
 
+   void startRuns();
+
+   /** Submits the runs collected for the next batch to the ToolExecutor */
+   void submitBatch();
+
    QList<DotRunner *> m_dotRuns;
+   QList<DotRunner *> m_batch;
+   QSet<QString>      m_runKeys;
+   QSet<QString>      m_dotFiles;
+
+   bool m_background;
+   bool m_started;
+   bool m_setPath;
 
    StringMap<QSharedPointer<DotFilePatcher>> m_dotMaps;
 
-   static DotManager        *m_theInstance;
-   DotRunnerQueue           *m_queue;
-   QList<DotWorkerThread *>  m_workers;
+   // runs and maps are added by the threads which write pages
+   mutable QMutex m_mutex;
+
+   QList<QPair<int, DotRunTask *>> m_tasks;
 };
 
 
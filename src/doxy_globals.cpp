@@ -63,9 +63,9 @@ QSharedPointer<PageDef>       Doxy_Globals::mainPage;
 QSharedPointer<NamespaceDef>  Doxy_Globals::globalScope;
 
 FormulaList     *Doxy_Globals::formulaList       = 0;      // all formulas
-IndexList       *Doxy_Globals::indexList;
+thread_local IndexList       *Doxy_Globals::indexList = 0;
 ParserManager   *Doxy_Globals::parserManager     = 0;
-SearchIndexIntf *Doxy_Globals::searchIndex       = 0;
+thread_local SearchIndexIntf *Doxy_Globals::searchIndex = 0;
 Store           *Doxy_Globals::symbolStorage;
 
 OutputList      *Doxy_Globals::g_outputList      = 0;      // list of output generating objects                          
@@ -85,7 +85,7 @@ QHash<long, QSharedPointer<MemberGroupInfo>> Doxy_Globals::memGrpInfoDict;
 
 StringMap<QSharedPointer<DirRelation>>       Doxy_Globals::dirRelations;
 
-QCache<QString, LookupInfo>  *Doxy_Globals::lookupCache;
+LookupCache                  *Doxy_Globals::lookupCache;
 
 int     Doxy_Globals::subpageNestingLevel = 0;
 
@@ -101,10 +101,11 @@ bool Doxy_Globals::parseSourcesNeeded  = false;
 bool Doxy_Globals::outputToApp         = false;
 bool Doxy_Globals::userComments        = false;
 bool Doxy_Globals::generatingXmlOutput = false;
-bool Doxy_Globals::markdownSupport     = true;
-bool Doxy_Globals::suppressDocWarnings = false;
+thread_local bool Doxy_Globals::markdownSupport = true;
+thread_local bool Doxy_Globals::suppressDocWarnings = false;
 
 bool Doxy_Globals::dumpGlossary        = false;
+QStringList Doxy_Globals::selfTests;
 bool Doxy_Globals::programExit         = false;
 
 int Doxy_Globals::documentedFiles;
@@ -123,9 +124,9 @@ QSet<QString>             Doxy_Globals::g_pathsVisited;
 
 QMap<QString, QString>    Doxy_Globals::g_moduleHint;               // experimental   
 
-QHash<QString, Definition *>  &Doxy_Globals::glossary()
+SymbolTable &Doxy_Globals::glossary()
 {
-   static QHash<QString, Definition *> data;
+   static SymbolTable data;
    return data;  
 } 
 
@@ -34,6 +34,7 @@
 #include <filestorage.h>
 #include <formula.h>
 #include <groupdef.h>
+#include <lookupcache.h>
 #include <membergroup.h>
 #include <membername.h>
 #include <message.h>
@@ -42,6 +43,7 @@
 #include <reflist.h>
 #include <searchindex.h>
 #include <stringmap.h>
+#include <symboltable.h>
 
 class ParserManager;
 
@@ -50,20 +52,6 @@ enum ParserMode {
    INCLUDE_FILE
 };
 
-struct LookupInfo {
-   LookupInfo() {}
-
-   LookupInfo(QSharedPointer<ClassDef> cd, QSharedPointer<MemberDef> td, QString ts, QString rt)
-      : classDef(cd), typeDef(td), templSpec(ts), resolvedType(rt)
-   {}
-
-   QSharedPointer<ClassDef>  classDef;
-   QSharedPointer<MemberDef> typeDef;
-
-   QString templSpec;
-   QString resolvedType;
-};
-
 class StringDict : public QHash<QString, QString>
 {
  public:
@@ -100,6 +88,18 @@ class Statistics
       for (const auto &item : statList) {
          msg("%.3f seconds %s", item.elapsed, csPrintable(item.name));
       }                 
+
+      if (! counterList.isEmpty()) {
+         msg("\n");
+
+         for (const auto &item : counterList) {
+            msg("%lld %s\n", item.second, csPrintable(item.first));
+         }
+      }
+   }
+
+   void addCounter(const QString &name, qint64 value) {
+      counterList.append(qMakePair(name, value));
    }
 
  private:
@@ -112,6 +112,7 @@ class Statistics
    };
 
    QList<StatData> statList;
+   QList<QPair<QString, qint64>> counterList;
    QTime time;
 }; 
 
@@ -169,9 +170,9 @@ class Doxy_Globals
       static QSharedPointer<NamespaceDef>  globalScope;  
 
       static FormulaList              *formulaList; 
-      static IndexList                *indexList;
+      static thread_local IndexList   *indexList;      // per thread, source workers record into their own list
       static ParserManager            *parserManager;  
-      static SearchIndexIntf          *searchIndex; 
+      static thread_local SearchIndexIntf *searchIndex;  // per thread, source workers record into their own index
       static Store                    *symbolStorage;        
   
       static OutputList               *g_outputList;                 
@@ -193,7 +194,7 @@ class Doxy_Globals
 
       static StringMap<QSharedPointer<DirRelation>>       dirRelations; 
         
-      static QCache<QString, LookupInfo> *lookupCache;
+      static LookupCache *lookupCache;
 
       static int subpageNestingLevel;
              
@@ -209,10 +210,11 @@ class Doxy_Globals
       static bool insideMainPage;
       static bool parseSourcesNeeded;
       static bool generatingXmlOutput;
-      static bool markdownSupport;     
-      static bool suppressDocWarnings;
+      static thread_local bool markdownSupport;     // per thread, the markdown page parser enables it while it runs
+      static thread_local bool suppressDocWarnings; // per thread, set while a page writes its inline members
 
       static bool dumpGlossary;    
+      static QStringList selfTests;
       static bool programExit;      
 
       static int documentedFiles;
@@ -230,7 +232,7 @@ class Doxy_Globals
       static QMap<QString,  QString>   g_moduleHint;            
       static QHash<QString, FileDef>   g_usingDeclarations;  
 
-      static QHash<QString, Definition *> &glossary();
+      static SymbolTable &glossary();
 };
 
 #endif
\ No newline at end of file
@@ -30,6 +30,7 @@
 #include <cmdmapper.h>
 #include <code.h>
 #include <config.h>
+#include <doccache.h>
 #include <doxy_globals.h>
 #include <doxy_build_info.h>
 #include <entry.h>
@@ -52,6 +53,7 @@
 #include <portable.h>
 #include <pre.h>
 #include <rtfgen.h>
+#include <selftest.h>
 #include <util.h>
 
 namespace Doxy_Setup {
@@ -71,6 +73,7 @@ enum Options {
      HELP,
      OUTPUT_APP,
      DVERSION,
+     SELF_TEST,
 };
 
 static QHash<QString, int>     s_extLookup;
@@ -161,6 +164,9 @@ void shutDownDoxyPress()
 {
    finializeSearchIndexer();
 
+   // cached trees may refer to definitions which are deleted below
+   DocCache::instance()->clear();
+
    //
    Doxy_Globals::symbolStorage->close();
 
@@ -215,6 +221,7 @@ struct CommandLine parseCommandLine(QStringList argList)
    argMap.insert( "--h",       HELP            );
    argMap.insert( "--l",       BLANK_LAYOUT    );
    argMap.insert( "--m",       DEBUG_SYMBOLS   );
+   argMap.insert( "--t",       SELF_TEST       );
    argMap.insert( "--w",       BLANK_STYLE     );
    argMap.insert( "--v",       DVERSION        );
    argMap.insert( "--dt",      DATETIME        );
@@ -406,6 +413,19 @@ struct CommandLine parseCommandLine(QStringList argList)
             Doxy_Globals::dumpGlossary = true;
             break;
 
+         case SELF_TEST:
+            {
+               QString testName = getValue(iter, argList.end());
+
+               if (testName.isEmpty()) {
+                  err("Option \"-t\" is missing a test name\n");
+                  Doxy_Work::stopDoxyPress();
+               }
+
+               Doxy_Globals::selfTests.append(testName);
+            }
+            break;
+
          case OUTPUT_APP:
             setvbuf(stdout, NULL, _IONBF, 0);
             setvbuf(stderr, NULL, _IONBF, 0);
@@ -745,4 +765,9 @@ void Doxy_Setup::usage()
    printf("   --d  <level> enable one or more of the following debug levels\n");
 
    Debug::printFlags();
+
+   printf("\n");
+   printf("   --t  <test> run a self test on the project and exit, one of the following\n");
+
+   printSelfTests();
 }
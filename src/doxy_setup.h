@@ -22,6 +22,8 @@
 #include <QString>
 #include <QStringList>
 
+class ParserInterface;
+
 struct CommandLine {
   
    QString dateTimeStr;
@@ -59,6 +61,9 @@ void searchInputFiles();
 void processFiles();
 void generateOutput();
 
+ParserInterface *getParserForFile(const QString &fileName);
+QString prepareInput(const QString &fileName, const QString &input);
+
 void readFormulaRepository();
 void shutDownDoxyPress();
 
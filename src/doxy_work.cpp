@@ -15,6 +15,8 @@
  *
 *************************************************************************/
 
+#include <QCryptographicHash>
+
 #include <errno.h>
 #include <locale.h>
 #include <stdio.h>
@@ -23,16 +25,20 @@
 #include <set>
 
 #include <arguments.h>
+#include <buildstate.h>
 #include <cite.h>
 #include <cmdmapper.h>
 #include <code.h>
+#include <compoundqueue.h>
 #include <config.h>
 #include <commentcnv.h>
 #include <config.h>
 #include <declinfo.h>
 #include <defargs.h>
+#include <diagram.h>
 #include <dirdef.h>
 #include <docbookgen.h>
+#include <doccache.h>
 #include <docparser.h>
 #include <docsets.h>
 #include <dot.h>
@@ -40,6 +46,7 @@
 #include <doxy_globals.h>
 #include <eclipsehelp.h>
 #include <entry.h>
+#include <entrycache.h>
 #include <filestorage.h>
 #include <formula.h>
 #include <ftvhelp.h>
@@ -48,6 +55,7 @@
 #include <htmlgen.h>
 #include <htmlhelp.h>
 #include <index.h>
+#include <inputqueue.h>
 #include <language.h>
 #include <latexgen.h>
 #include <layout.h>
@@ -56,6 +64,7 @@
 #include <msc.h>
 #include <objcache.h>
 #include <outputlist.h>
+#include <parsequeue.h>
 #include <parser_base.h>
 #include <parser_clang.h>
 #include <parser_cstyle.h>
@@ -66,12 +75,17 @@
 #include <parser_py.h>
 #include <parser_tcl.h>
 #include <perlmodgen.h>
+#include <plantuml.h>
 #include <portable.h>
 #include <pre.h>
 #include <qhp.h>
 #include <rtfgen.h>
+#include <scannerstate.h>
+#include <selftest.h>
+#include <sourcequeue.h>
 #include <store.h>
 #include <tagreader.h>
+#include <toolexecutor.h>
 #include <util.h>
 #include <xmlgen.h>
 
@@ -249,6 +263,7 @@ namespace Doxy_Work{
    void computeMemberReferences();
    void computeMemberRelations();
    void computePageRelations(QSharedPointer<EntryNav> rootNav);
+   void computeSharedHash();
    void computeTemplateClassRelations();
 
    ClassDef::CompoundType convertToCompoundType(int section, Entry::Traits data);
@@ -354,6 +369,8 @@ namespace Doxy_Work{
    bool isVarWithConstructor(QSharedPointer<EntryNav> rootNav);
 
    void mergeCategories();
+   void mergeParsedFile(ParserInterface *parser, QSharedPointer<Entry> root, QSharedPointer<EntryNav> rootNav,
+                  QSharedPointer<FileDef> fd, QString fileName, const ParseFileQueue::Result &result);
 
    void organizeSubGroupsFiltered(QSharedPointer<EntryNav> rootNav, bool additional);
    void organizeSubGroups(QSharedPointer<EntryNav> rootNav);
@@ -361,6 +378,10 @@ namespace Doxy_Work{
    void parseFile(ParserInterface *parser, QSharedPointer<Entry> root, QSharedPointer<EntryNav> rootNav, 
                   QSharedPointer<FileDef> fd, QString fileName, enum ParserMode mode, QStringList &filesInSameTu);
 
+   void parseFile(ParserInterface *parser, QSharedPointer<Entry> root, QSharedPointer<EntryNav> rootNav, 
+                  QSharedPointer<FileDef> fd, QString fileName, enum ParserMode mode, QStringList &filesInSameTu,
+                  const QString &convBuf);
+
    void parseFiles(QSharedPointer<Entry> root, QSharedPointer<EntryNav> rootNav);
 
    void processFiles();
@@ -445,7 +466,7 @@ void processFiles()
 
    uint lookupSize = 65536 << cacheSize;
 
-   Doxy_Globals::lookupCache = new QCache<QString, LookupInfo>(lookupSize);
+   Doxy_Globals::lookupCache = new LookupCache(lookupSize);
 
 #ifdef HAS_SIGNALS
    signal(SIGINT, stopDoxyPress);
@@ -459,6 +480,17 @@ void processFiles()
    Doxy_Globals::tempB_FName = QString("doxy_tempB_%1.tmp").arg(pid);
    Doxy_Globals::tempB_FName.prepend(outputDirectory + "/");
 
+   BuildState::instance()->load(outputDirectory);
+
+   QString entryCacheDir = Config::getString("entry-cache-dir");
+
+   if (entryCacheDir.isEmpty() && BuildState::instance()->isEnabled()) {
+      // unchanged input files are not scanned again
+      entryCacheDir = BuildState::instance()->stateDir() + "/entries";
+   }
+
+   EntryCache::instance()->open(entryCacheDir);
+
    if (Doxy_Globals::symbolStorage->open(Doxy_Globals::tempA_FName) == -1) {
       err("Unable to open temporary file %s\n", csPrintable(Doxy_Globals::tempA_FName));
       stopDoxyPress();
@@ -614,6 +646,15 @@ void processFiles()
    Doxy_Globals::g_storage->close();
    Doxy_Globals::g_stats.end();
 
+   if (EntryCache::instance()->isEnabled()) {
+      msg("Entry cache used for %d of %d input files\n", EntryCache::instance()->hits(), Doxy_Globals::g_inputFiles.count());
+   }
+
+   if (BuildState::instance()->isEnabled()) {
+      msg("%d of %d input files changed since the last run\n", BuildState::instance()->changedInputs(),
+                  Doxy_Globals::g_inputFiles.count());
+   }
+
    // done with input scanning, free up the buffers used by lex (can be around 4MB)
    preFreeScanner();
    cstyleFreeParser();
@@ -899,6 +940,10 @@ void generateOutput()
       exit(0);
    }
 
+   if (! Doxy_Globals::selfTests.isEmpty()) {
+      exit(runSelfTests(Doxy_Globals::selfTests) ? 0 : 1);
+   }
+
    // move to the output directory 
    QString outputDir = Config::getString("output-dir");   
    QDir::setCurrent(outputDir);
@@ -1044,6 +1089,11 @@ void generateOutput()
       Doxy_Globals::g_stats.end();
    }
 
+   if (BuildState::instance()->isEnabled()) {
+      // after the source code, which adds the references between members
+      computeSharedHash();
+   }
+
    Doxy_Globals::g_stats.begin("Generating file documentation\n");
    generateFileDocs();
    Doxy_Globals::g_stats.end();
@@ -1089,6 +1139,11 @@ void generateOutput()
       writeIndexHierarchy(*Doxy_Globals::g_outputList);
    }
 
+   // pages are read back by the index, RTF and dot steps below
+   Doxy_Globals::g_stats.begin("Writing remaining output files\n");
+   OutputFileWriter::instance()->finish();
+   Doxy_Globals::g_stats.end();
+
    Doxy_Globals::g_stats.begin("Finalizing index pages\n");
    Doxy_Globals::indexList->finalize();
    Doxy_Globals::g_stats.end();
@@ -1168,12 +1223,39 @@ void generateOutput()
       Doxy_Globals::g_stats.end();
    }
 
+   if (PlantUMLManager::instance()->count() > 0) {
+      Doxy_Globals::g_stats.begin("Running PlantUML\n");
+      PlantUMLManager::instance()->run();
+      Doxy_Globals::g_stats.end();
+   }
+
    if (Config::getBool("have-dot")) {
       Doxy_Globals::g_stats.begin("Running dot\n");
       DotManager::instance()->run();
       Doxy_Globals::g_stats.end();
    }
 
+   if (MscManager::instance()->count() > 0) {
+      Doxy_Globals::g_stats.begin("Inserting mscgen image maps\n");
+      MscManager::instance()->run();
+      Doxy_Globals::g_stats.end();
+   }
+
+   // mscgen, dia, epstopdf and other tools whose output is only needed in the final output run in the background
+   if (ToolExecutor::instance()->pendingCount() > 0) {
+      Doxy_Globals::g_stats.begin("Waiting for external tools\n");
+
+      portable_sysTimerStart();
+      ToolExecutor::instance()->waitAll();
+      portable_sysTimerStop();
+
+      Doxy_Globals::g_stats.end();
+
+   } else {
+      // stops the worker threads
+      ToolExecutor::instance()->waitAll();
+   }
+
    if (generateHtml && Config::getBool("generate-chm") && ! Config::getString("hhc-location").isEmpty()) {
 
       Doxy_Globals::g_stats.begin("Running html help compiler\n");
@@ -1216,9 +1298,30 @@ void generateOutput()
       Doxy_Globals::g_stats.end();
    }
 
+   OutputFileWriter::instance()->finish();
+
+   if (BuildState::instance()->isEnabled()) {
+      msg("Reused the pages of %d unchanged compounds\n", BuildState::instance()->reusedCompounds());
+      msg("Skipped writing %d unchanged output files\n", BuildState::instance()->skippedOutputs());
+      BuildState::instance()->save();
+   }
+
    msg("Lookup cache used %d/%d \n", Doxy_Globals::lookupCache->count(), Doxy_Globals::lookupCache->size());
 
    if (Debug::isFlagSet(Debug::Time)) {
+      Doxy_Globals::g_stats.addCounter("lookup cache hits",      Doxy_Globals::lookupCache->hits());
+      Doxy_Globals::g_stats.addCounter("lookup cache misses",    Doxy_Globals::lookupCache->misses());
+      Doxy_Globals::g_stats.addCounter("lookup cache evictions", Doxy_Globals::lookupCache->evictions());
+
+      Doxy_Globals::g_stats.addCounter("doc cache parses",       DocCache::instance()->parses());
+      Doxy_Globals::g_stats.addCounter("doc cache hits",         DocCache::instance()->hits());
+      Doxy_Globals::g_stats.addCounter("doc cache evictions",    DocCache::instance()->evictions());
+
+      if (ClassDiagram::imageCount() > 0) {
+         Doxy_Globals::g_stats.addCounter("class diagram images",         ClassDiagram::imageCount());
+         Doxy_Globals::g_stats.addCounter("class diagram image time (ms)", ClassDiagram::imageTime() / 1000);
+      }
+
       Doxy_Globals::g_stats.print();
 
    } else {
@@ -8209,6 +8312,37 @@ void Doxy_Work::buildCompleteMemberLists()
    }
 }
 
+// reads a source file the same way FileDef::writeSource() does, called from the worker threads
+static QString readSourceFile(const QString &fileName)
+{
+   static bool filterSourceFiles = Config::getBool("filter-source-files");
+   return fileToString(fileName, filterSourceFiles, true);
+}
+
+// creates the generators for a source or compound worker, same formats as g_outputList
+static OutputList *createWorkerOutputList()
+{
+   OutputList *retval = new OutputList(true);
+
+   if (Config::getBool("generate-html")) {
+      retval->add(new HtmlGenerator);
+   }
+
+   if (Config::getBool("generate-latex")) {
+      retval->add(new LatexGenerator);
+   }
+
+   if (Config::getBool("generate-man")) {
+      retval->add(new ManGenerator);
+   }
+
+   if (Config::getBool("generate-rtf")) {
+      retval->add(new RTFGenerator);
+   }
+
+   return retval;
+}
+
 void Doxy_Work::generateSourceCode()
 {
    if (Doxy_Globals::inputNameList->count() > 0) {
@@ -8309,32 +8443,181 @@ void Doxy_Work::generateSourceCode()
          }
 
       } else {
-         // use lex and not clang      
+         // use lex and not clang, the sources are read ahead by worker threads
+         QList<QSharedPointer<FileDef>> fileList;
+         QStringList sourceList;
 
          for (auto fn : *Doxy_Globals::inputNameList) {
 
-           for (auto fd : *fn) {
-               QStringList includeFiles;
-               fd->startParsing();
+            for (auto fd : *fn) {
+               if (fd->generateSourceFile() || (! fd->isReference() && Doxy_Globals::parseSourcesNeeded)) {
+                  fileList.append(fd);
+                  sourceList.append(fd->getFilePath());
+               }
+            }
+         }
+
+         // files are highlighted by source workers, each with generators of its own. Cross references,
+         // warnings and the calls to the index and search index are applied here in the order of the files
+         InputFileQueue inputQueue(sourceList, Config::getInt("num-parse-threads"), nullptr, readSourceFile);
+         SourceFileQueue sourceQueue(fileList, &inputQueue, Config::getInt("num-parse-threads"), createWorkerOutputList);
 
-               if (fd->generateSourceFile()) {
-                  // source needs to be shown in the output
-                  msg("Generating code for file %s\n", csPrintable(fd->docName()));
+         if (sourceQueue.threadCount() > 0) {
+            msg("Generating code using %d parallel threads\n", sourceQueue.threadCount());
+         }
 
-                  fd->writeSource(*Doxy_Globals::g_outputList, false, includeFiles);
+         int index = 0;
 
-               } else if (! fd->isReference() && Doxy_Globals::parseSourcesNeeded) {
-                  // parse the sources even if we do not show it
-            
-                  msg("Parsing code for file %s\n",  csPrintable(fd->docName()));
-                  fd->parseSource(false, includeFiles);
+         for (auto fd : fileList) {
+            SourceFileQueue::Result result = sourceQueue.take(index);
+
+            QStringList includeFiles;
+            fd->startParsing();
+
+            if (fd->generateSourceFile()) {
+               // source needs to be shown in the output
+               msg("Generating code for file %s\n", csPrintable(fd->docName()));
+
+               if (result.written) {
+                  SourceFileQueue::apply(result);
+               } else {
+                  fd->writeSource(*Doxy_Globals::g_outputList, false, includeFiles, result.source);
                }
 
-               fd->finishParsing();
+            } else {
+               // parse the sources even if we do not show it
+         
+               msg("Parsing code for file %s\n",  csPrintable(fd->docName()));
+
+               if (result.written) {
+                  SourceFileQueue::apply(result);
+               } else {
+                  fd->parseSource(false, includeFiles, result.source);
+               }
+            }
+
+            fd->finishParsing();
+            ++index;
+         }
+      }
+   }
+}
+
+// writes the compounds in the order of the list, on compound workers when more than one thread is used
+static void addMemberSignature(QCryptographicHash &hash, QSharedPointer<MemberDef> md)
+{
+   hash.addData(definitionKey(md).toUtf8());
+   hash.addData(md->isLinkable() ? "1" : "0");
+   hash.addData(md->typeString().toUtf8());
+   hash.addData(md->argsString().toUtf8());
+   hash.addData(definitionKey(md->reimplements()).toUtf8());
+
+   for (auto dict : { md->getReferencesMembers(), md->getReferencedByMembers() }) {
+      if (dict) {
+         for (auto rmd : *dict) {
+            hash.addData(definitionKey(rmd).toUtf8());
+         }
+      }
+
+      hash.addData("\n");
+   }
+}
+
+// the pages of a compound link to other compounds and list their members, any change to
+// the names, links or relations of the symbols requires all compounds to be written
+void Doxy_Work::computeSharedHash()
+{
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   hash.addData(Config::getSignature());
+
+   for (const auto &fileName : Doxy_Globals::g_inputFiles) {
+      hash.addData(fileName.toUtf8());
+      hash.addData("\n");
+   }
+
+   for (auto cd : *Doxy_Globals::classSDict) {
+      hash.addData(definitionKey(cd).toUtf8());
+      hash.addData(cd->isLinkable() ? "1" : "0");
+      hash.addData(QByteArray::number(static_cast<int>(cd->compoundType())));
+
+      if (cd->baseClasses()) {
+         for (auto bcd : *cd->baseClasses()) {
+            hash.addData(definitionKey(bcd->classDef).toUtf8());
+         }
+      }
+
+      hash.addData("\n");
+   }
+
+   for (auto nd : *Doxy_Globals::namespaceSDict) {
+      hash.addData(definitionKey(nd).toUtf8());
+      hash.addData(nd->isLinkable() ? "1" : "0");
+   }
+
+   for (auto fn : *Doxy_Globals::inputNameList) {
+      for (auto fd : *fn) {
+         hash.addData(definitionKey(fd).toUtf8());
+         hash.addData(fd->isLinkable() ? "1" : "0");
+
+         if (fd->includeFileList()) {
+            for (const auto &ii : *fd->includeFileList()) {
+               hash.addData(ii.includeName.toUtf8());
             }
          }
+
+         hash.addData("\n");
+      }
+   }
+
+   for (auto gd : *Doxy_Globals::groupSDict) {
+      hash.addData(definitionKey(gd).toUtf8());
+      hash.addData(gd->groupTitle().toUtf8());
+   }
+
+   for (auto pd : *Doxy_Globals::pageSDict) {
+      hash.addData(definitionKey(pd).toUtf8());
+      hash.addData(pd->title().toUtf8());
+   }
+
+   for (auto pd : *Doxy_Globals::exampleSDict) {
+      hash.addData(definitionKey(pd).toUtf8());
+   }
+
+   for (auto mn : *Doxy_Globals::memberNameSDict) {
+      for (auto md : *mn) {
+         addMemberSignature(hash, md);
       }
    }
+
+   for (auto mn : *Doxy_Globals::functionNameSDict) {
+      for (auto md : *mn) {
+         addMemberSignature(hash, md);
+      }
+   }
+
+   BuildState::instance()->setSharedHash(hash.result().toHex());
+}
+
+static void writeCompounds(const QList<QSharedPointer<Definition>> &list, CompoundWriteFunc writeFunc)
+{
+   CompoundQueue queue(list, writeFunc, Config::getInt("num-parse-threads"), createWorkerOutputList);
+
+   if (queue.threadCount() > 0) {
+      msg("Generating docs using %d parallel threads\n", queue.threadCount());
+   }
+
+   for (int index = 0; index < list.count(); ++index) {
+      CompoundQueue::apply(queue.take(index));
+   }
+}
+
+static void writeFileDocs(QSharedPointer<Definition> def, OutputList &ol)
+{
+   QSharedPointer<FileDef> fd = def.dynamicCast<FileDef>();
+
+   msg("Generating docs for file %s\n",  csPrintable(fd->docName()));
+   fd->writeDocumentation(ol);
 }
 
 void Doxy_Work::generateFileDocs()
@@ -8344,18 +8627,20 @@ void Doxy_Work::generateFileDocs()
    }
 
    if (Doxy_Globals::inputNameList->count() > 0) {
-     
+      QList<QSharedPointer<Definition>> list;
+
       for (auto fn : *Doxy_Globals::inputNameList) {
 
          for (auto fd : *fn) {
             bool doc = fd->isLinkableInProject();
 
             if (doc) {
-               msg("Generating docs for file %s\n",  csPrintable(fd->docName()));
-               fd->writeDocumentation(*Doxy_Globals::g_outputList);
+               list.append(fd);
             }
          }
       }
+
+      writeCompounds(list, writeFileDocs);
    }
 }
 
@@ -8406,27 +8691,39 @@ void Doxy_Work::addSourceReferences()
    }
 }
 
+// writes the pages of a class and its inner classes
+static void writeClassDocs(QSharedPointer<Definition> def, OutputList &ol)
+{
+   QSharedPointer<ClassDef> cd = def.dynamicCast<ClassDef>();
+
+   // skip external references, anonymous compounds and template instances
+
+   if ( cd->isLinkableInProject() && cd->templateMaster() == 0) {
+      msg("Generating docs for compound %s\n", csPrintable(cd->name()));
+
+      cd->writeDocumentation(ol);
+      cd->writeMemberList(ol);
+   }
+
+   // even for undocumented classes, the inner classes can be documented.
+   cd->writeDocumentationForInnerClasses(ol);
+}
+
 // generate the documentation of all classes
 void Doxy_Work::generateClassList(ClassSDict &classSDict)
 {
+   QList<QSharedPointer<Definition>> list;
+
    for (auto cd : classSDict) {
             
       if (cd && (cd->getOuterScope() == 0 || // <-- should not happen, but can if we read an old tag file
                  cd->getOuterScope() == Doxy_Globals::globalScope) && ! cd->isHidden() && ! cd->isEmbeddedInOuterScope()) {
 
-         // skip external references, anonymous compounds and template instances
-
-         if ( cd->isLinkableInProject() && cd->templateMaster() == 0) {
-            msg("Generating docs for compound %s\n", csPrintable(cd->name()));    
-
-            cd->writeDocumentation(*Doxy_Globals::g_outputList);
-            cd->writeMemberList(*Doxy_Globals::g_outputList);
-         }
-
-         // even for undocumented classes, the inner classes can be documented.
-         cd->writeDocumentationForInnerClasses(*Doxy_Globals::g_outputList);
+         list.append(cd);
       }
    }
+
+   writeCompounds(list, writeClassDocs);
 }
 
 void Doxy_Work::generateClassDocs()
@@ -9130,15 +9427,26 @@ void Doxy_Work::generateExampleDocs()
    Doxy_Globals::g_outputList->enable(OutputGenerator::Man);
 }
 
+static void writeGroupDocs(QSharedPointer<Definition> def, OutputList &ol)
+{
+   QSharedPointer<GroupDef> gd = def.dynamicCast<GroupDef>();
+
+   msg("Generating docs for group %s\n", csPrintable(gd->name()) );
+   gd->writeDocumentation(ol);
+}
+
 // generate module pages
 void Doxy_Work::generateGroupDocs()
 { 
+   QList<QSharedPointer<Definition>> list;
+
    for (auto gd : *Doxy_Globals::groupSDict) {
       if (! gd->isReference()) {
-         msg("Generating docs for group %s\n", csPrintable(gd->name()) );
-         gd->writeDocumentation(*Doxy_Globals::g_outputList);
+         list.append(gd);
       }
    }
+
+   writeCompounds(list, writeGroupDocs);
 }
 
 //static void generatePackageDocs()
@@ -9156,33 +9464,52 @@ void Doxy_Work::generateGroupDocs()
 //
 //}
 
+// writes the page of a namespace, or the pages of a class in a namespace and its inner classes
+static void writeNamespaceDocs(QSharedPointer<Definition> def, OutputList &ol)
+{
+   if (def->definitionType() == Definition::TypeNamespace) {
+      QSharedPointer<NamespaceDef> nd = def.dynamicCast<NamespaceDef>();
+
+      msg("Generating docs for namespace %s\n", csPrintable(nd->name()));
+      nd->writeDocumentation(ol);
+
+      return;
+   }
+
+   QSharedPointer<ClassDef> cd = def.dynamicCast<ClassDef>();
+
+   if ( ( cd->isLinkableInProject() && cd->templateMaster() == 0) && ! cd->isHidden() && !cd->isEmbeddedInOuterScope() ) {
+        // skip external references, anonymous compounds and
+        // template instances and nested classes             
+   
+      msg("Generating docs for namespace compounds %s\n", csPrintable(cd->name()));  
+
+      cd->writeDocumentation(ol);
+      cd->writeMemberList(ol);
+   }
+
+   cd->writeDocumentationForInnerClasses(ol);
+}
+
 // generate module pages
 void Doxy_Work::generateNamespaceDocs()
 {
+   QList<QSharedPointer<Definition>> list;
+
    // for each namespace
    for (auto nd : *Doxy_Globals::namespaceSDict) {
 
       if (nd->isLinkableInProject()) {
-         msg("Generating docs for namespace %s\n", csPrintable(nd->name()));
-         nd->writeDocumentation(*Doxy_Globals::g_outputList);
+         list.append(nd);
       }
 
       // for each class in the namespace   
       for (auto cd : *nd->getClassSDict()) {
-
-         if ( ( cd->isLinkableInProject() && cd->templateMaster() == 0) && ! cd->isHidden() && !cd->isEmbeddedInOuterScope() ) {
-              // skip external references, anonymous compounds and
-              // template instances and nested classes             
-         
-            msg("Generating docs for namespace compounds %s\n", csPrintable(cd->name()));  
-
-            cd->writeDocumentation(*Doxy_Globals::g_outputList);
-            cd->writeMemberList(*Doxy_Globals::g_outputList);
-         }
-
-         cd->writeDocumentationForInnerClasses(*Doxy_Globals::g_outputList);
+         list.append(cd);
       }
    }
+
+   writeCompounds(list, writeNamespaceDocs);
 }
 
 #if defined(_WIN32)
@@ -9333,7 +9660,7 @@ void Doxy_Work::copyExtraFiles(const QString &kind)
    }
 }
 
-static ParserInterface *getParserForFile(const QString &fn)
+ParserInterface *getParserForFile(const QString &fn)
 {
    QString fileName = fn;
    QString extension;
@@ -9355,8 +9682,18 @@ static ParserInterface *getParserForFile(const QString &fn)
 void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, QSharedPointer<EntryNav> rootNav, 
                   QSharedPointer<FileDef> fd, QString fileName, enum ParserMode mode, QStringList &includedFiles)
 {   
-   static bool clangParsing = Config::getBool("clang-parsing");
-          
+   parseFile(parser, root, rootNav, fd, fileName, mode, includedFiles, prepareInput(fileName, readInputFile(fileName)));
+}
+
+// runs the preprocessor and converts the comments, called from the input pipeline thread
+QString prepareInput(const QString &fileName, const QString &input)
+{
+   // broom - not completed if clangParsing, do not preprocess
+
+   if (BuildState::instance()->isEnabled()) {
+      BuildState::instance()->updateInput(fileName, BuildState::hash(input));
+   }
+
    QString extension;
    int ei = fileName.lastIndexOf('.');
 
@@ -9365,23 +9702,18 @@ void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, Q
    } else {
       extension = ".no_extension";
    }
- 
-   QFileInfo fi(fileName);
-   QString fileContents;
 
-   // broom - not completed if clangParsing, do not preprocess
+   ParserInterface *parser = getParserForFile(fileName);
+   QString fileContents;
 
    if (Config::getBool("enable-preprocessing") && parser->needsPreprocessing(extension)) {      
       msg("Processing %s\n", csPrintable(fileName));
-
-      fileContents = readInputFile(fileName); 
-      fileContents = preprocessFile(fileName, fileContents);
+      fileContents = preprocessFile(fileName, input);
 
    } else { 
       // no preprocessing
       msg("Reading %s\n", csPrintable(fileName));
-      fileContents = readInputFile(fileName);
- 
+      fileContents = input;
    }
 
    if (! fileContents.endsWith("\n")) {
@@ -9390,8 +9722,20 @@ void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, Q
    }
    
    // convert multi-line C++ comments to C style comments
-   QString convBuf = convertCppComments(fileContents, fileName);
-   auto srcLang    = fd->getLanguage(); 
+   return convertCppComments(fileContents, fileName);
+}
+
+// convBuf is the scanner input as returned by prepareInput()
+void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, QSharedPointer<EntryNav> rootNav, 
+                  QSharedPointer<FileDef> fd, QString fileName, enum ParserMode mode, QStringList &includedFiles,
+                  const QString &convBuf)
+{   
+   static bool clangParsing = Config::getBool("clang-parsing");
+
+   // defines and include dependencies found by the preprocessor
+   applyPreprocessorResults(fileName);
+          
+   auto srcLang = fd->getLanguage();
 
    if (clangParsing && (srcLang == SrcLangExt_Cpp || srcLang == SrcLangExt_ObjC)) {   
       fd->getAllIncludeFilesRecursively(includedFiles);
@@ -9400,9 +9744,50 @@ void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, Q
       parser->parseInput(fileName, convBuf, root, mode, includedFiles, true);
 
    } else { 
-      // use lex parser
+      // use lex parser, the scanner is skipped when the same input was parsed in a previous run
+      EntryCache *entryCache = EntryCache::instance();
+
+      QByteArray cacheKey;
+
+      if (entryCache->isEnabled()) {
+         cacheKey = entryCache->key(fileName, convBuf);
+
+         if (entryCache->load(cacheKey, root)) {
+            root->createNavigationIndex(rootNav, Doxy_Globals::g_storage, fd, root);
+            return;
+         }
+      }
+
+      ScannerState::begin();
       parser->parseInput(fileName, convBuf, root, mode, includedFiles, false);
 
+      // the tree of a file which used sections, formulas or other state shared between files is not stored
+      if (entryCache->isEnabled() && ! ScannerState::usedShared()) {
+         entryCache->store(cacheKey, root);
+      }
+   }
+
+   // store the Entry tree in a file and create an index to navigate/load entries
+   root->createNavigationIndex(rootNav, Doxy_Globals::g_storage, fd, root);
+}
+
+// adds the entries a parse worker found in a file to the tree, in the same way parseFile() does
+void Doxy_Work::mergeParsedFile(ParserInterface *parser, QSharedPointer<Entry> root, QSharedPointer<EntryNav> rootNav,
+                  QSharedPointer<FileDef> fd, QString fileName, const ParseFileQueue::Result &result)
+{
+   // defines and include dependencies found by the preprocessor
+   applyPreprocessorResults(fileName);
+
+   printWarnings(result.warnings);
+
+   if (! result.cached) {
+      // the scanner sets the language of the root
+      root->lang = result.root->lang;
+      parser->finishWorkerInput();
+   }
+
+   for (auto child : result.root->children()) {
+      root->addSubEntry(child, root);
    }
 
    // store the Entry tree in a file and create an index to navigate/load entries
@@ -9490,7 +9875,23 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root, QSharedPointer<EntryNav>
       }
 
    } else  {
-      // use lex and not clang
+      // use lex and not clang, input files are read ahead by worker threads and preprocessed
+      // on a pipeline thread, in the order of g_inputFiles
+
+      // parse workers scan the files into an Entry tree per file, the trees are merged here in the
+      // order of g_inputFiles. Files which need state shared between files are scanned on this thread.
+      InputFileQueue inputQueue(Doxy_Globals::g_inputFiles, Config::getInt("num-parse-threads"), prepareInput);
+      ParseFileQueue parseQueue(Doxy_Globals::g_inputFiles, &inputQueue, Config::getInt("num-parse-threads"));
+
+      if (inputQueue.threadCount() > 0) {
+         msg("Reading input files using %d parallel threads\n", inputQueue.threadCount());
+      }
+
+      if (parseQueue.threadCount() > 0) {
+         msg("Scanning input files using %d parallel threads\n", parseQueue.threadCount());
+      }
+
+      int index = 0;
         
       for (auto fName : Doxy_Globals::g_inputFiles) { 
          QStringList includedFiles;
@@ -9501,7 +9902,15 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root, QSharedPointer<EntryNav>
          assert(fd != nullptr);
 
          ParserInterface *parser = getParserForFile(fName);        
-         parseFile(parser, root, rootNav, fd, fName, ParserMode::SOURCE_FILE, includedFiles);
+         ParseFileQueue::Result result = parseQueue.take(index);
+
+         if (result.root) {
+            mergeParsedFile(parser, root, rootNav, fd, fName, result);
+         } else {
+            parseFile(parser, root, rootNav, fd, fName, ParserMode::SOURCE_FILE, includedFiles, result.convBuf);
+         }
+
+         ++index;
       }
    }
 }
@@ -9901,7 +10310,7 @@ void Doxy_Work::dumpGlossary()
    if (f.open(QIODevice::WriteOnly)) {
       QTextStream t(&f);
 
-      for (auto item : Doxy_Globals::glossary()) {
+      for (auto item : Doxy_Globals::glossary().allDefinitions()) {
          // list of phrases
 
          QSharedPointer<Definition> def = sharedFrom(item);
@@ -28,11 +28,11 @@
 #include <section.h>
 #include <util.h>
 
-int Entry::num = 0;
+QAtomicInt Entry::num(0);
 
 Entry::Entry()
 {
-   num++;
+   num.fetchAndAddRelaxed(1);
 
    m_parent.clear();
    section  = Entry::EMPTY_SEC;
@@ -55,7 +55,7 @@ Entry::Entry()
 
 Entry::Entry(const Entry &e)
 {  
-   num++;
+   num.fetchAndAddRelaxed(1);
 
    section     = e.section;
    type        = e.type;
@@ -172,7 +172,7 @@ Entry::~Entry()
    delete tagInfo;   
    delete sli;
 
-   num--;
+   num.fetchAndAddRelaxed(-1);
 }
 
 void Entry::addSubEntry(QSharedPointer<Entry> child, QSharedPointer<Entry> self)
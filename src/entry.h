@@ -20,6 +20,7 @@
 
 #include <bitset>
 
+#include <QAtomicInt>
 #include <QString>
 #include <QFile>
 #include <QList>
@@ -298,7 +299,7 @@ class Entry
 
    Traits m_traits;
    
-   static int num;              // counts the total number of entries
+   static QAtomicInt num;       // counts the total number of entries, entries are created by several threads
 
    int  section;                // entry type (see Sections);
    int  initLines;              // define/variable initializer lines to show
@@ -0,0 +1,187 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+
+#include <entrycache.h>
+
+#include <config.h>
+#include <doxy_build_info.h>
+#include <entry.h>
+#include <filestorage.h>
+#include <marshal.h>
+#include <message.h>
+#include <parser_base.h>
+
+// increase when the layout of the cache files or the marshaled Entry changes
+static const uint s_cacheMagic   = ('D' << 24) + ('X' << 16) + ('E' << 8) + 'C';
+static const uint s_cacheVersion = 3;
+
+EntryCache *EntryCache::instance()
+{
+   static EntryCache theInstance;
+   return &theInstance;
+}
+
+EntryCache::EntryCache()
+   : m_enabled(false), m_hits(0)
+{
+}
+
+void EntryCache::open(const QString &dirName)
+{
+   m_enabled = false;
+
+   if (dirName.isEmpty()) {
+      return;
+   }
+
+   QDir dir(dirName);
+
+   if (! dir.exists() && ! dir.mkpath(dirName)) {
+      err("Unable to create entry cache directory %s\n", csPrintable(dirName));
+      return;
+   }
+
+   m_dirName = dir.absolutePath();
+   m_enabled = true;
+
+   // settings which change the result of the scanner without changing its input
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   hash.addData(QByteArray(versionString));
+
+   for (const auto &name : scannerConfigOptions()) {
+      hash.addData(name.toUtf8());
+      hash.addData(Config::getAsText(name).toUtf8());
+      hash.addData("\n");
+   }
+
+   m_configHash = hash.result();
+}
+
+QByteArray EntryCache::key(const QString &fileName, const QString &convBuf) const
+{
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   hash.addData(m_configHash);
+   hash.addData(fileName.toUtf8());
+   hash.addData(convBuf.toUtf8());
+
+   return hash.result().toHex();
+}
+
+QString EntryCache::cacheFileName(const QByteArray &key) const
+{
+   return m_dirName + "/" + QString::fromLatin1(key) + ".entry";
+}
+
+bool EntryCache::load(const QByteArray &key, QSharedPointer<Entry> root)
+{
+   FileStorage f(cacheFileName(key));
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      return false;
+   }
+
+   if (unmarshalUInt(&f) != s_cacheMagic || unmarshalUInt(&f) != s_cacheVersion ||
+         unmarshalQString(&f) != versionString || unmarshalQByteArray(&f) != key) {
+
+      // stale or written by a different version
+      return false;
+   }
+
+   uint count = unmarshalUInt(&f);
+
+   QList<QSharedPointer<Entry>> children;
+
+   for (uint i = 0; i < count; i++) {
+      children.append(unmarshalEntryTree(&f));
+   }
+
+   if (unmarshalUInt(&f) != s_cacheMagic) {
+      // truncated
+      return false;
+   }
+
+   for (auto child : children) {
+      root->addSubEntry(child, root);
+   }
+
+   m_hits.fetchAndAddRelaxed(1);
+
+   return true;
+}
+
+void EntryCache::store(const QByteArray &key, QSharedPointer<Entry> root)
+{
+   for (auto child : root->children()) {
+      if (! isCacheable(child)) {
+         return;
+      }
+   }
+
+   // write to a temporary file and rename, readers never see a partial file
+   QString fileName = cacheFileName(key);
+   QString tempName = fileName + ".tmp";
+
+   FileStorage f(tempName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s\n", csPrintable(tempName));
+      return;
+   }
+
+   marshalUInt(&f, s_cacheMagic);
+   marshalUInt(&f, s_cacheVersion);
+   marshalQString(&f, versionString);
+   marshalQByteArray(&f, key);
+
+   marshalUInt(&f, root->children().count());
+
+   for (auto child : root->children()) {
+      marshalEntryTree(&f, child);
+   }
+
+   marshalUInt(&f, s_cacheMagic);
+   f.close();
+
+   QDir dir;
+   dir.remove(fileName);
+
+   if (! dir.rename(tempName, fileName)) {
+      dir.remove(tempName);
+   }
+}
+
+bool EntryCache::isCacheable(QSharedPointer<Entry> e) const
+{
+   // anonymous scopes are numbered across files, special list items refer to global lists
+   if (e->name.contains('@') || (e->sli != nullptr && ! e->sli->isEmpty())) {
+      return false;
+   }
+
+   for (auto child : e->children()) {
+      if (! isCacheable(child)) {
+         return false;
+      }
+   }
+
+   return true;
+}
@@ -0,0 +1,79 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef ENTRYCACHE_H
+#define ENTRYCACHE_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QString>
+
+class Entry;
+
+/** @brief Persistent cache of the Entry trees produced by the scanner.
+ *
+ *  When entry-cache-dir is set, the Entry tree of every input file is stored in
+ *  this directory. The key is computed from the file name, the scanner input,
+ *  the options in scannerConfigOptions() and the version. When the same key is seen in a
+ *  later run the cached tree is used and the scanner is not run.
+ *
+ *  The preprocessor is still run on every file, the defines and include
+ *  guards it collects are shared between files. Files whose scan used state
+ *  shared between files (see ScannerState) are not stored, loading them would
+ *  lose the changes to this state or depend on the other input files.
+ *
+ *  load() and store() may be called by the parse worker threads.
+ */
+class EntryCache
+{
+ public:
+   static EntryCache *instance();
+
+   void open(const QString &dirName);
+
+   bool isEnabled() const {
+      return m_enabled;
+   }
+
+   /** Returns the cache key for the scanner input \a convBuf of \a fileName */
+   QByteArray key(const QString &fileName, const QString &convBuf) const;
+
+   /** Adds the cached children to \a root, returns false if \a key is not in the cache */
+   bool load(const QByteArray &key, QSharedPointer<Entry> root);
+
+   /** Stores the children of \a root */
+   void store(const QByteArray &key, QSharedPointer<Entry> root);
+
+   int hits() const {
+      return m_hits.load();
+   }
+
+ private:
+   EntryCache();
+
+   QString cacheFileName(const QByteArray &key) const;
+   bool isCacheable(QSharedPointer<Entry> e) const;
+
+   bool       m_enabled;
+   QAtomicInt m_hits;
+
+   QString    m_dirName;
+   QByteArray m_configHash;
+};
+
+#endif
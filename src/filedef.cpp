@@ -17,6 +17,7 @@
 
 #include <filedef.h>
 
+#include <buildstate.h>
 #include <config.h>
 #include <docparser.h>
 #include <doxy_globals.h>
@@ -587,6 +588,8 @@ void FileDef::writeDocumentation(OutputList &ol)
    QSharedPointer<FileDef> self = sharedFrom(this);
    static bool generateTreeView = Config::getBool("generate-treeview");
 
+   BuildState::addDependency(getDefFileName());
+
    QString versionTitle;
 
    if (! m_fileVersion.isEmpty()) {
@@ -816,7 +819,10 @@ void FileDef::writeQuickMemberLinks(OutputList &ol, QSharedPointer<MemberDef> cu
 }
 
 /*! Write a source listing of this file to the output */
-void FileDef::writeSource(OutputList &ol, bool sameTu, QStringList &filesInSameTu)
+/*! Write the source browser page for this file, \a sourceContents is the
+    source as read by fileToString(), when null the file is read here.
+*/
+void FileDef::writeSource(OutputList &ol, bool sameTu, QStringList &filesInSameTu, const QString &sourceContents)
 {
    QSharedPointer<FileDef> self = sharedFrom(this);
 
@@ -929,8 +935,13 @@ void FileDef::writeSource(OutputList &ol, bool sameTu, QStringList &filesInSameT
          pIntf->parseCode(devNullIntf, 0, fileToString(getFilePath(), true, true), getLanguage(), false, 0, self);
       }
 
-      pIntf->parseCode(ol, 0, fileToString(getFilePath(), filterSourceFiles, true),
-                       srcLang, false, 0, self, -1, -1, false,
+      QString source = sourceContents;
+
+      if (source.isNull()) {
+         source = fileToString(getFilePath(), filterSourceFiles, true);
+      }
+
+      pIntf->parseCode(ol, 0, source, srcLang, false, 0, self, -1, -1, false,
                        QSharedPointer<MemberDef>(), true, QSharedPointer<Definition>(), ! needs2PassParsing);
                       
       ol.endCodeFragment();
@@ -941,7 +952,7 @@ void FileDef::writeSource(OutputList &ol, bool sameTu, QStringList &filesInSameT
    ol.enableAll();
 }
 
-void FileDef::parseSource(bool sameTu, QStringList &filesInSameTu)
+void FileDef::parseSource(bool sameTu, QStringList &filesInSameTu, const QString &sourceContents)
 {
    QSharedPointer<FileDef> self  = sharedFrom(this);
    static bool filterSourceFiles = Config::getBool("filter-source-files");
@@ -967,8 +978,14 @@ void FileDef::parseSource(bool sameTu, QStringList &filesInSameTu)
       // use lex parser    
    
       ParserInterface *pIntf = Doxy_Globals::parserManager->getParser(getDefFileExtension());
+      QString source = sourceContents;
+
+      if (source.isNull()) {
+         source = fileToString(getFilePath(), filterSourceFiles, true);
+      }
+
       pIntf->resetCodeParserState();
-      pIntf->parseCode(devNullIntf, 0, fileToString(getFilePath(), filterSourceFiles, true), srcLang, false, 0, self);
+      pIntf->parseCode(devNullIntf, 0, source, srcLang, false, 0, self);
    }
 }
 
@@ -215,8 +215,8 @@ class FileDef : public Definition
    void writeTagFile(QTextStream &t);
 
    void startParsing();
-   void writeSource(OutputList &ol, bool sameTu, QStringList &filesInSameTu);
-   void parseSource(bool sameTu, QStringList &filesInSameTu);
+   void writeSource(OutputList &ol, bool sameTu, QStringList &filesInSameTu, const QString &sourceContents = QString());
+   void parseSource(bool sameTu, QStringList &filesInSameTu, const QString &sourceContents = QString());
    void finishParsing();
 
    friend void generatedFileNames();
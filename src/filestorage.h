@@ -18,27 +18,61 @@
 #ifndef FILESTORAGE_H
 #define FILESTORAGE_H
 
+#include <QDataStream>
 #include <QFile>
+#include <QHash>
+#include <QStringList>
 
 #include <assert.h>
+#include <string.h>
 #include <store.h>
 
 /** @brief Store implementation based on a file.
     Writing is linear, after that the file is re-opened for reading.
-    Reading is random (seek+read).
+    Reading is random (seek+read), when possible the file is mapped into
+    memory so reading does not require a system call.
+
+    Short strings are stored once in a string table which is appended to the
+    file when it is closed after writing and loaded when it is opened for reading.
  */
 class FileStorage : public StorageIntf
 {
  public:
-   FileStorage() : m_readOnly(false) {}
+   FileStorage() : m_readOnly(false), m_mapEnabled(true), m_data(nullptr), m_size(0), m_pos(0) {}
 
    FileStorage( const QString &name) :
-      m_readOnly(false)    {
+      m_readOnly(false), m_mapEnabled(true), m_data(nullptr), m_size(0), m_pos(0)  {
       m_file.setFileName(name);
    }
 
+   ~FileStorage() {
+      close();
+   }
+
    int read(char *buf, uint size) {
-      return m_file.read(buf, size);
+      if (m_data == nullptr) {
+         return m_file.read(buf, size);
+      }
+
+      if (size > m_size - m_pos) {
+         size = m_size - m_pos;
+      }
+
+      memcpy(buf, m_data + m_pos, size);
+      m_pos += size;
+
+      return size;
+   }
+
+   const char *view(uint size) {
+      if (m_data == nullptr || size > m_size - m_pos) {
+         return nullptr;
+      }
+
+      const char *retval = reinterpret_cast<const char *>(m_data + m_pos);
+      m_pos += size;
+
+      return retval;
    }
 
    int write(const char *buf, uint size) {
@@ -49,18 +83,62 @@ class FileStorage : public StorageIntf
    bool open( QIODevice::OpenModeFlag value)  {
       m_readOnly = (value == QIODevice::ReadOnly);
 
-      return m_file.open(value);
+      if (! m_file.open(value)) {
+         return false;
+      }
+
+      if (m_readOnly && ! readStringTable()) {
+         return false;
+      }
+
+      if (m_readOnly && m_mapEnabled && m_file.size() > 0) {
+         // falls back to reading the file if it can not be mapped
+         m_data = m_file.map(0, m_file.size());
+
+         if (m_data != nullptr) {
+            m_size = m_file.size();
+            m_pos  = 0;
+         }
+      }
+
+      return true;
    }
 
    bool seek(int64_t pos) {
-      return m_file.seek(pos);
+      if (m_data == nullptr) {
+         return m_file.seek(pos);
+      }
+
+      if (pos < 0 || pos > m_size) {
+         return false;
+      }
+
+      m_pos = pos;
+
+      return true;
    }
 
    int64_t pos() const {
-      return m_file.pos();
+      if (m_data == nullptr) {
+         return m_file.pos();
+      }
+
+      return m_pos;
    }
 
    void close() {
+      if (! m_readOnly && m_file.isOpen()) {
+         writeStringTable();
+      }
+
+      if (m_data != nullptr) {
+         m_file.unmap(m_data);
+         m_data = nullptr;
+      }
+
+      m_size = 0;
+      m_pos  = 0;
+
       m_file.close();
    }
 
@@ -68,9 +146,85 @@ class FileStorage : public StorageIntf
       m_file.setFileName(name);
    }
 
+   /** Selects if the file is mapped into memory when it is opened for reading, used by the self tests */
+   void setMapEnabled(bool enable) {
+      m_mapEnabled = enable;
+   }
+
+   bool isMapped() const {
+      return m_data != nullptr;
+   }
+
+   int stringIndex(const QString &str) {
+      assert(m_readOnly == false);
+
+      auto iter = m_stringIndex.find(str);
+
+      if (iter != m_stringIndex.end()) {
+         return iter.value();
+      }
+
+      int index = m_strings.count();
+
+      m_strings.append(str);
+      m_stringIndex.insert(str, index);
+
+      return index;
+   }
+
+   QString stringAt(uint index) {
+      return m_strings.value(index);
+   }
+
  private:
+   static const quint32 TableMagic = 0x44585354;     // DXST
+
+   void writeStringTable() {
+      qint64 tableStart = m_file.pos();
+
+      QDataStream stream(&m_file);
+      stream << m_strings << tableStart << TableMagic;
+
+      m_strings.clear();
+      m_stringIndex.clear();
+   }
+
+   bool readStringTable() {
+      m_strings.clear();
+
+      // trailer is the start of the table followed by the magic value
+      const qint64 trailerSize = sizeof(qint64) + sizeof(quint32);
+
+      if (m_file.size() < trailerSize || ! m_file.seek(m_file.size() - trailerSize)) {
+         return false;
+      }
+
+      QDataStream stream(&m_file);
+
+      qint64  tableStart;
+      quint32 magic;
+
+      stream >> tableStart >> magic;
+
+      if (magic != TableMagic || tableStart < 0 || ! m_file.seek(tableStart)) {
+         return false;
+      }
+
+      stream >> m_strings;
+
+      return m_file.seek(0);
+   }
+
    bool m_readOnly;
+   bool m_mapEnabled;
    QFile m_file;
+
+   QStringList          m_strings;
+   QHash<QString, int>  m_stringIndex;
+
+   uchar  *m_data;
+   int64_t m_size;
+   int64_t m_pos;
 };
 
 #endif
@@ -15,6 +15,7 @@
  *
 *************************************************************************/
 
+#include <QCryptographicHash>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
@@ -30,6 +31,7 @@
 #include <index.h>
 #include <message.h>
 #include <portable.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 Formula::Formula(const QString &text)
@@ -48,319 +50,473 @@ int Formula::getId()
    return number;
 }
 
-void FormulaList::generateBitmaps(const QString &path)
+static const int s_formulasPerShard = 16;
+
+/** Returns the cache key for the image of the formula \a text, depends on all options used to render it */
+static QString formulaCacheKey(const QString &text)
 {
-   int x1, y1, x2, y2;
+   QString id = text + "\n" + QString::number(Config::getInt("formula-fontsize")) + " " +
+                QString::number(Config::getBool("formula-transparent")) + " " +
+                Config::getList("latex-extra-packages").join(" ");
 
-   // store the original directory
-   QDir d(path);
- 
-   if (! d.exists()) {
-      err("Output dir %s does not exist\n", qPrintable(path));
-      Doxy_Work::stopDoxyPress();
+   return QString::fromLatin1(QCryptographicHash::hash(id.toUtf8(), QCryptographicHash::Md5).toHex());
+}
+
+static bool fetchCachedFormula(const QString &cacheDir, const QString &key, const QString &fileName)
+{
+   QString cacheName = cacheDir + "/" + key + ".png";
+
+   if (! QFileInfo(cacheName).exists()) {
+      return false;
    }
 
-   QString oldDir = QDir::currentPath();
+   return QFile::copy(cacheName, fileName);
+}
 
-   // move to the image directory
-   QDir::setCurrent(d.absolutePath());
-   QDir thisDir = QDir::current();
+static void storeCachedFormula(const QString &cacheDir, const QString &key, const QString &fileName)
+{
+   QDir dir(cacheDir);
 
-   // generate a latex file containing one formula per page.
-   QString texName = "_formulas.tex";
-   QList<int> pagesToGenerate;
-     
-   QFile f(texName);
-   bool formulaError = false;
+   QString cacheName = key + ".png";
+   QString tempName  = cacheName + ".tmp";
 
-   if (f.open(QIODevice::WriteOnly)) {
+   // other runs which share the cache never see a partial file
+   dir.remove(tempName);
+
+   if (QFile::copy(fileName, dir.absoluteFilePath(tempName))) {
+      dir.remove(cacheName);
+      dir.rename(tempName, cacheName);
+   }
+}
+
+/** Converts the pixmap written by ghostscript to the PNG image of a formula, runs after ghostscript */
+class FormulaConvertTask : public ToolTask
+{
+ public:
+   FormulaConvertTask(const QString &pnmName, const QString &pngName)
+      : m_pnmName(pnmName), m_pngName(pngName)
+   {
+   }
+
+   int run();
+
+   QString error() const {
+      return m_error;
+   }
+
+ private:
+   QString m_pnmName;
+   QString m_pngName;
+   QString m_error;
+};
+
+int FormulaConvertTask::run()
+{
+   QFile f(m_pnmName);
+
+   uint imageX = 0, imageY = 0;
+
+   // read the generated image again, to obtain the pixel data.
+   if (f.open(QIODevice::ReadOnly)) {
       QTextStream t(&f);
+      QString s;
 
-      if (Config::getBool("latex-batch-mode")) {
-         t << "\\batchmode" << endl;
+      if (! t.atEnd()) {
+         s = t.readLine();
       }
 
-      t << "\\documentclass{article}" << endl;
-      t << "\\usepackage{epsfig}" << endl; // for those who want to include images
+      if (s.length() < 2 || s.left(2) != "P6") {
+         m_error = "GhostScript produced an illegal image format\n";
+
+      } else {
+         // assume the size is after the first line that does not start with
+         // # excluding the first line of the file.
+
+         while (! t.atEnd()) {
+            s = t.readLine();
 
-      QStringList s = Config::getList("latex-extra-packages");
+            if (s.isEmpty()) {
+               break;
+            }
 
-      for (auto item : s) {
-         t << "\\usepackage{" << item << "}\n";        
+            if (s.at(0) != '#') {
+               break;
+            }
+         }
+
+         sscanf(s.toUtf8().constData(), "%d %d", &imageX, &imageY);
       }
 
-      t << "\\pagestyle{empty}" << endl;
-      t << "\\begin{document}" << endl;
+      if (imageX > 0 && imageY > 0) {
+         char *data = new char[imageX * imageY * 3]; // rgb 8:8:8 format
+         uint i, x, y, ix, iy;
+         f.read(data, imageX * imageY * 3);
+
+         Image srcImage(imageX, imageY), filteredImage(imageX, imageY), dstImage(imageX / 4, imageY / 4);
+         uchar *ps = srcImage.getData();
 
-      int page = 0;
-     
-      for (auto &formula : *this) {
-         QString resultName = QString("form_%1.png").arg(formula.getId());
+         // convert image to black (1) and white (0) index.
+         for (i = 0; i < imageX * imageY; i++) {
+            *ps++ = (data[i * 3] == 0 ? 1 : 0);
+         }
+
+         // apply a simple box filter to the image
+         static const int filterMask[] = {1, 2, 1, 2, 8, 2, 1, 2, 1};
+         for (y = 0; y < srcImage.getHeight(); y++) {
+            for (x = 0; x < srcImage.getWidth(); x++) {
+               int s = 0;
+               for (iy = 0; iy < 2; iy++) {
+                  for (ix = 0; ix < 2; ix++) {
+                     s += srcImage.getPixel(x + ix - 1, y + iy - 1) * filterMask[iy * 3 + ix];
+                  }
+               }
+               filteredImage.setPixel(x, y, s);
+            }
+         }
 
-         // only formulas for which no image exists are generated
-         QFileInfo fi(resultName);
+         // down-sample the image to 1/16th of the area using 16 gray scale colors.
+
+         for (y = 0; y < dstImage.getHeight(); y++) {
+            for (x = 0; x < dstImage.getWidth(); x++) {
+               int xp = x << 2;
+               int yp = y << 2;
+
+               int c = filteredImage.getPixel(xp + 0, yp + 0) +
+                       filteredImage.getPixel(xp + 1, yp + 0) +
+                       filteredImage.getPixel(xp + 2, yp + 0) +
+                       filteredImage.getPixel(xp + 3, yp + 0) +
+                       filteredImage.getPixel(xp + 0, yp + 1) +
+                       filteredImage.getPixel(xp + 1, yp + 1) +
+                       filteredImage.getPixel(xp + 2, yp + 1) +
+                       filteredImage.getPixel(xp + 3, yp + 1) +
+                       filteredImage.getPixel(xp + 0, yp + 2) +
+                       filteredImage.getPixel(xp + 1, yp + 2) +
+                       filteredImage.getPixel(xp + 2, yp + 2) +
+                       filteredImage.getPixel(xp + 3, yp + 2) +
+                       filteredImage.getPixel(xp + 0, yp + 3) +
+                       filteredImage.getPixel(xp + 1, yp + 3) +
+                       filteredImage.getPixel(xp + 2, yp + 3) +
+                       filteredImage.getPixel(xp + 3, yp + 3);
+
+               // here we scale and clip the color value so the
+               // resulting image has a reasonable contrast
+               dstImage.setPixel(x, y, qMin(15, (c * 15) / (16 * 10)));
+            }
+         }
+
+         // save the result as a bitmap
+         QFile fo(m_pngName);
+
+         if (fo.open(QIODevice::WriteOnly)) {
+
+            // parameter 1 is used as a temporary hack to select the right color palette
+            QByteArray buffer = dstImage.convert(1);
+
+            fo.write(buffer);
+            fo.close();
+
+         } else {
+            m_error = QString("Unable to open file for writing %1, error: %2\n").arg(m_pngName).arg(fo.error());
 
-         if (! fi.exists()) {
-            // we force a pagebreak after each formula
-            t << formula.getFormulaText() << endl << "\\pagebreak\n\n";
-            pagesToGenerate.append(page);
          }
 
-         Doxy_Globals::indexList->addImageFile(resultName);
-         page++;
+         delete[] data;
       }
 
-      t << "\\end{document}" << endl;
       f.close();
+
+   } else {
+      m_error = QString("Unable to read the image %1 written by GhostScript\n").arg(m_pnmName);
+   }
+
+   return m_error.isEmpty() ? 0 : 1;
+}
+
+FormulaRenderer::FormulaRenderer(const QList<Job> &jobs, int numShards)
+   : m_jobs(jobs)
+{
+   for (int i = 0; i < numShards; ++i) {
+      m_shardOk.append(true);
+   }
+}
+
+QString FormulaRenderer::shardName(int shard)
+{
+   return QString("_formulas_%1").arg(shard);
+}
+
+bool FormulaRenderer::run()
+{
+   static const QString latexCmd = Config::getString("latex-cmd-name").isEmpty() ? QString("latex") :
+                                   Config::getString("latex-cmd-name");
+
+   static const QString gsExe = Config::getString("ghostscript");
+
+   // scale the image so that it is four times larger than needed
+   double scaleFactor = 16.0 / 3.0;
+   int zoomFactor = Config::getInt("formula-fontsize");
+
+   if (zoomFactor < 8 || zoomFactor > 50) {
+      zoomFactor = 10;
    }
 
-   if (pagesToGenerate.count() > 0) {
-      // there are new formulas   
-      //system("latex _formulas.tex </dev/null >/dev/null");
+   scaleFactor *= zoomFactor / 10.0;
+   int resolution = (int)(scaleFactor * 72);
 
-      QString latexCmd = Config::getString("latex-cmd-name");
+   ToolExecutor *executor = ToolExecutor::instance();
+   QDir thisDir = QDir::current();
+
+   // latex run of each shard, -1 if the LaTeX file of the shard could not be written
+   QList<int> latexIds;
+
+   for (int shard = 0; shard < m_shardOk.count(); ++shard) {
+      bool hasFile = false;
 
-      if (latexCmd.isEmpty()) {
-         latexCmd = "latex";
+      for (const auto &job : m_jobs) {
+         if (job.shard == shard && job.error.isEmpty()) {
+            hasFile = true;
+            break;
+         }
       }
-      portable_sysTimerStart();
 
-      if (portable_system(latexCmd, "_formulas.tex") != 0) {
-         err("Unable to run LaTeX, verify your installation, _formulas.tex, and _formulas.log\n");
-         formulaError = true;         
+      latexIds.append(hasFile ? executor->submit("latex", latexCmd, shardName(shard) + ".tex") : -1);
+   }
+
+   struct Chain {
+      int dvipsId;
+      int gsId;
+      int convertId;
+      FormulaConvertTask *task;
+   };
+
+   QList<Chain> chains;
+
+   for (const auto &job : m_jobs) {
+      Chain chain = { -1, -1, -1, nullptr };
+
+      if (job.error.isEmpty()) {
+         QString formBase = QString("_form%1").arg(job.id);
+
+         // dvips converts the page of the formula to an encapsulated postscript
+         QString dviArgs = QString("-q -D 600 -E -n 1 -p %1 -o %2.eps %3.dvi")
+                           .arg(job.page).arg(formBase).arg(shardName(job.shard));
+
+         // ghostscript renders the eps cropped to its bounding box as a pixmap, where only black and white are used
+         QString gsArgs = QString("-q -dEPSCrop -r%1x%1 -sDEVICE=ppmraw -sOutputFile=%2.pnm -dNOPAUSE -dBATCH -- %3.eps")
+                          .arg(resolution).arg(formBase).arg(formBase);
+
+         chain.task = new FormulaConvertTask(thisDir.absoluteFilePath(formBase + ".pnm"),
+                                             thisDir.absoluteFilePath(QString("form_%1.png").arg(job.id)));
+
+         chain.dvipsId   = executor->submit("dvips", "dvips", dviArgs, QString(), QList<int>() << latexIds.at(job.shard));
+         chain.gsId      = executor->submit("ghostscript", gsExe, gsArgs, QString(), QList<int>() << chain.dvipsId);
+         chain.convertId = executor->submitTask(chain.task, QString(), QList<int>() << chain.gsId);
       }
 
-      portable_sysTimerStop();
-             
-      int pageIndex = 1;
-    
-      for (auto pageNum : pagesToGenerate) {         
-         msg("Generating image form_%d.png for formula\n", pageNum);
-         
-         QString formBase;
-         formBase = QString("_form%1").arg(pageNum);
-
-         // run dvips to convert the page with number pageIndex to an
-         // encapsulated postscript.
-
-         char dviArgs[4096];   
-         sprintf(dviArgs, "-q -D 600 -E -n 1 -p %d -o %s.eps _formulas.dvi",pageIndex, qPrintable(formBase));
-
-         portable_sysTimerStart();
-
-         if (portable_system("dvips", dviArgs) != 0) {
-            err("Unable to run dvips, check your installation\n");
-            portable_sysTimerStop();
-            return;
-         }
-         portable_sysTimerStop();
+      chains.append(chain);
+   }
+
+   for (int shard = 0; shard < latexIds.count(); ++shard) {
+      if (latexIds.at(shard) != -1 && executor->wait(latexIds.at(shard)) != 0) {
+         m_shardOk[shard] = false;
+      }
+   }
+
+   for (int i = 0; i < m_jobs.count(); ++i) {
+      Job &job    = m_jobs[i];
+      Chain chain = chains.at(i);
+
+      if (chain.task == nullptr) {
+         continue;
+      }
+
+      if (! m_shardOk.at(job.shard)) {
+         // reported for the shard, the rest of the chain was cancelled
+
+      } else if (executor->wait(chain.dvipsId) != 0) {
+         job.error = "Unable to run dvips, check your installation\n";
+
+      } else if (executor->wait(chain.gsId) != 0) {
+         job.error = QString("Unable to run GhostScript %1, verify your installation\n").arg(gsExe);
+
+      } else if (executor->wait(chain.convertId) != 0) {
+         job.error = chain.task->error();
+      }
+
+      // the task may only be deleted once it is done
+      executor->wait(chain.convertId);
+      delete chain.task;
+
+      // remove intermediate image files
+      QString formBase = QString("_form%1").arg(job.id);
 
-         // now we read the generated postscript file to extract the bounding box
-         QFileInfo fi(formBase + ".eps");
+      thisDir.remove(formBase + ".eps");
+      thisDir.remove(formBase + ".pnm");
+   }
+
+   return ! m_shardOk.contains(false);
+}
+
+void FormulaList::generateBitmaps(const QString &path)
+{
+   // store the original directory
+   QDir d(path);
  
-         if (fi.exists()) {
-            QString eps = fileToString(formBase + ".eps");
-            int i = eps.indexOf("%%BoundingBox:");
+   if (! d.exists()) {
+      err("Output dir %s does not exist\n", qPrintable(path));
+      Doxy_Work::stopDoxyPress();
+   }
 
-            if (i != -1) {
-               sscanf(eps.toUtf8().constData() + i, "%%%%BoundingBox:%d %d %d %d", &x1, &y1, &x2, &y2);
+   QString oldDir = QDir::currentPath();
 
-            } else {
-               err("Unable to extract bounding box\n");
-            }
-         }
+   // move to the image directory, latex, dvips and ghostscript are all run in this directory
+   QDir::setCurrent(d.absolutePath());
+   QDir thisDir = QDir::current();
 
-         // generate a postscript file which contains the eps
-         // and displays it in the right colors and the right bounding box
-         f.setFileName(formBase + ".ps");
-
-         if (f.open(QIODevice::WriteOnly)) {
-            QTextStream t(&f);
-
-            t << "1 1 1 setrgbcolor" << endl;  // anti-alias to white background
-            t << "newpath" << endl;
-            t << "-1 -1 moveto" << endl;
-            t << (x2 - x1 + 2) << " -1 lineto" << endl;
-            t << (x2 - x1 + 2) << " " << (y2 - y1 + 2) << " lineto" << endl;
-            t << "-1 " << (y2 - y1 + 2) << " lineto" << endl;
-            t << "closepath" << endl;
-            t << "fill" << endl;
-            t << -x1 << " " << -y1 << " translate" << endl;
-            t << "0 0 0 setrgbcolor" << endl;
-            t << "(" << formBase << ".eps) run" << endl;
-            f.close();
-         }
+   QString cacheDir = Config::getString("formula-cache-dir");
 
-         // scale the image so that it is four times larger than needed
-         // and the sizes are a multiple of four
-         double scaleFactor = 16.0 / 3.0;
-         int zoomFactor = Config::getInt("formula-fontsize");
+   if (! cacheDir.isEmpty()) {
+      QDir dir(oldDir);
+      cacheDir = dir.absoluteFilePath(cacheDir);
 
-         if (zoomFactor < 8 || zoomFactor > 50) {
-            zoomFactor = 10;
-         }
+      if (! QDir(cacheDir).exists() && ! dir.mkpath(cacheDir)) {
+         err("Unable to create formula cache directory %s\n", csPrintable(cacheDir));
+         cacheDir = QString();
+      }
+   }
 
-         scaleFactor *= zoomFactor / 10.0;
-         int gx = (((int)((x2 - x1) * scaleFactor)) + 3) & ~1;
-         int gy = (((int)((y2 - y1) * scaleFactor)) + 3) & ~1;
+   // only formulas for which no image exists are generated
+   QList<FormulaRenderer::Job> jobs;
+   int cacheHits = 0;
 
-         // run ghostscript to convert the postscript to a pixmap
-         // The pixmap is a truecolor image, where only black and white are used         
+   for (auto &formula : *this) {
+      QString resultName = QString("form_%1.png").arg(formula.getId());
+      Doxy_Globals::indexList->addImageFile(resultName);
 
-         char gsArgs[4096];
-         sprintf(gsArgs, "-q -g%dx%d -r%dx%dx -sDEVICE=ppmraw "
-                 "-sOutputFile=%s.pnm -dNOPAUSE -dBATCH -- %s.ps",
-                 gx, gy, (int)(scaleFactor * 72), (int)(scaleFactor * 72), qPrintable(formBase), qPrintable(formBase) );
+      if (QFileInfo(resultName).exists()) {
+         continue;
+      }
 
-         portable_sysTimerStart();
+      if (! cacheDir.isEmpty() && fetchCachedFormula(cacheDir, formulaCacheKey(formula.getFormulaText()), resultName)) {
+         ++cacheHits;
+         continue;
+      }
 
-         QString gsExe = Config::getString("ghostscript");   
+      FormulaRenderer::Job job;
+      job.id    = formula.getId();
+      job.text  = formula.getFormulaText();
+      job.shard = 0;
+      job.page  = 0;
 
-         if (portable_system(gsExe, gsArgs) != 0) {
-            err("Unable to run GhostScript %s %s. Verify your installation\n", qPrintable(gsExe), gsArgs);
-            portable_sysTimerStop();
+      jobs.append(job);
+   }
 
-            return;
-         }
+   if (cacheHits > 0) {
+      msg("Copied %d formula images from the cache\n", cacheHits);
+   }
 
-         portable_sysTimerStop();
-         f.setFileName(formBase + ".pnm");
+   bool formulaError = false;
+   int numShards     = 0;
 
-         uint imageX = 0, imageY = 0;
-         
-         // read the generated image again, to obtain the pixel data.
-         if (f.open(QIODevice::ReadOnly)) {
-            QTextStream t(&f);
-            QString s;
+   if (jobs.count() > 0) {
+      int numThreads = ToolExecutor::instance()->threadCount();
 
-            if (! t.atEnd()) {
-               s = t.readLine();
-            }
+      // each shard is one latex run, small shards are not worth the startup time of latex
+      numShards = qMax(1, qMin(numThreads, (jobs.count() + s_formulasPerShard - 1) / s_formulasPerShard));
 
-            if (s.length() < 2 || s.left(2) != "P6") {
-               err("GhostScript produced an illegal image format");
-
-            } else {
-               // assume the size is after the first line that does not start with
-               // # excluding the first line of the file.
-             
-               while (! t.atEnd()) {            
-                  s = t.readLine();
-                  
-                  if (s.isEmpty()) {
-                     break;
-                  }   
-
-                  if (s.at(0) != '#') {
-                     break;
-                  }
-               }
+      // generate latex files containing one formula per page
+      for (int shard = 0; shard < numShards; ++shard) {
+         // consecutive formulas are kept together
+         int first = shard * jobs.count() / numShards;
+         int last  = (shard + 1) * jobs.count() / numShards;
 
-               sscanf(s.toUtf8().constData(), "%d %d", &imageX, &imageY);
+         QFile f(FormulaRenderer::shardName(shard) + ".tex");
+
+         if (! f.open(QIODevice::WriteOnly)) {
+            // the formulas of this shard are not rendered and not stored in the cache
+            for (int i = first; i < last; ++i) {
+               jobs[i].shard = shard;
+               jobs[i].error = QString("Unable to render formula %1, unable to open file for writing %2, error: %3\n")
+                               .arg(jobs[i].id).arg(f.fileName()).arg(f.error());
             }
 
-            if (imageX > 0 && imageY > 0) {
-               //printf("Converting image...\n");
-               char *data = new char[imageX * imageY * 3]; // rgb 8:8:8 format
-               uint i, x, y, ix, iy;
-               f.read(data, imageX * imageY * 3);
+            continue;
+         }
 
-               Image srcImage(imageX, imageY), filteredImage(imageX, imageY), dstImage(imageX / 4, imageY / 4);
-               uchar *ps = srcImage.getData();
+         QTextStream t(&f);
 
-               // convert image to black (1) and white (0) index.
-               for (i = 0; i < imageX * imageY; i++) {
-                  *ps++ = (data[i * 3] == 0 ? 1 : 0);
-               }
+         if (Config::getBool("latex-batch-mode")) {
+            t << "\\batchmode" << endl;
+         }
 
-               // apply a simple box filter to the image
-               static int filterMask[] = {1, 2, 1, 2, 8, 2, 1, 2, 1};
-               for (y = 0; y < srcImage.getHeight(); y++) {
-                  for (x = 0; x < srcImage.getWidth(); x++) {
-                     int s = 0;
-                     for (iy = 0; iy < 2; iy++) {
-                        for (ix = 0; ix < 2; ix++) {
-                           s += srcImage.getPixel(x + ix - 1, y + iy - 1) * filterMask[iy * 3 + ix];
-                        }
-                     }
-                     filteredImage.setPixel(x, y, s);
-                  }
-               }
+         t << "\\documentclass{article}" << endl;
+         t << "\\usepackage{epsfig}" << endl; // for those who want to include images
 
-               // down-sample the image to 1/16th of the area using 16 gray scale colors.
-             
-               for (y = 0; y < dstImage.getHeight(); y++) {
-                  for (x = 0; x < dstImage.getWidth(); x++) {
-                     int xp = x << 2;
-                     int yp = y << 2;
-
-                     int c = filteredImage.getPixel(xp + 0, yp + 0) +
-                             filteredImage.getPixel(xp + 1, yp + 0) +
-                             filteredImage.getPixel(xp + 2, yp + 0) +
-                             filteredImage.getPixel(xp + 3, yp + 0) +
-                             filteredImage.getPixel(xp + 0, yp + 1) +
-                             filteredImage.getPixel(xp + 1, yp + 1) +
-                             filteredImage.getPixel(xp + 2, yp + 1) +
-                             filteredImage.getPixel(xp + 3, yp + 1) +
-                             filteredImage.getPixel(xp + 0, yp + 2) +
-                             filteredImage.getPixel(xp + 1, yp + 2) +
-                             filteredImage.getPixel(xp + 2, yp + 2) +
-                             filteredImage.getPixel(xp + 3, yp + 2) +
-                             filteredImage.getPixel(xp + 0, yp + 3) +
-                             filteredImage.getPixel(xp + 1, yp + 3) +
-                             filteredImage.getPixel(xp + 2, yp + 3) +
-                             filteredImage.getPixel(xp + 3, yp + 3);
-
-                     // here we scale and clip the color value so the
-                     // resulting image has a reasonable contrast
-                     dstImage.setPixel(x, y, qMin(15, (c * 15) / (16 * 10)));
-                  }
-               }
+         const QStringList packages = Config::getList("latex-extra-packages");
 
-               // save the result as a bitmap
-               QString fileName = QString("form_%1.png").arg(pageNum);                          
-              
-               QFile f(fileName);
+         for (auto item : packages) {
+            t << "\\usepackage{" << item << "}\n";
+         }
 
-               if (f.open(QIODevice::WriteOnly)) {
-               
-                  // parameter 1 is used as a temporary hack to select the right color palette
-                  QByteArray buffer = dstImage.convert(1);
- 
-                  f.write(buffer);
-                  f.close();
-   
-               } else {
-                  err("Unable to open file for writing %s, error: %d\n", qPrintable(fileName), f.error());
+         t << "\\pagestyle{empty}" << endl;
+         t << "\\begin{document}" << endl;
 
-               }            
+         int page = 1;
 
-               delete[] data;
-            }
+         for (int i = first; i < last; ++i) {
+            FormulaRenderer::Job &job = jobs[i];
+
+            job.shard = shard;
+            job.page  = page++;
 
-            f.close();
+            // we force a pagebreak after each formula
+            t << job.text << endl << "\\pagebreak\n\n";
          }
 
-         // remove intermediate image files
-         thisDir.remove(formBase + ".eps");
-         thisDir.remove(formBase + ".pnm");
-         thisDir.remove(formBase + ".ps");
+         t << "\\end{document}" << endl;
+         f.close();
+      }
+
+      if (numShards > 1) {
+         msg("Generating %d formula images using %d LaTeX runs...\n", jobs.count(), numShards);
+      }
 
-         ++pageIndex;
+      for (const auto &job : jobs) {
+         msg("Generating image form_%d.png for formula\n", job.id);
       }
 
-      // remove intermediate files produced by latex
-      thisDir.remove("_formulas.dvi");
+      FormulaRenderer renderer(jobs, numShards);
 
-      if (! formulaError) {
-         thisDir.remove("_formulas.log");   // keep file in case of errors
+      portable_sysTimerStart();
+
+      if (! renderer.run()) {
+         err("Unable to run LaTeX, verify your installation, the _formulas_*.tex files, and their log files\n");
+         formulaError = true;
+      }
+
+      portable_sysTimerStop();
+
+      for (const auto &job : renderer.jobs()) {
+         if (! job.error.isEmpty()) {
+            err("%s", csPrintable(job.error));
+
+         } else if (! cacheDir.isEmpty() && QFileInfo(QString("form_%1.png").arg(job.id)).exists()) {
+            storeCachedFormula(cacheDir, formulaCacheKey(job.text), QString("form_%1.png").arg(job.id));
+         }
       }
-      thisDir.remove("_formulas.aux");
    }
 
-   // remove the latex file itself
-   if (! formulaError) {
-      thisDir.remove("_formulas.tex");
+   // remove intermediate files produced by latex, the latex files are kept in case of errors
+   for (int shard = 0; shard < numShards; ++shard) {
+      QString shardName = FormulaRenderer::shardName(shard);
+
+      thisDir.remove(shardName + ".dvi");
+      thisDir.remove(shardName + ".aux");
+
+      if (! formulaError) {
+         thisDir.remove(shardName + ".log");
+         thisDir.remove(shardName + ".tex");
+      }
    }
 
    // write/update the formula repository so we know what text the
@@ -368,7 +524,7 @@ void FormulaList::generateBitmaps(const QString &path)
    // of the images, and to avoid forcing the user to delete all images in order
    // to let a browser refresh the images).
 
-   f.setFileName("formula.repository");
+   QFile f("formula.repository");
 
    if (f.open(QIODevice::WriteOnly)) {
       QTextStream t(&f);
@@ -20,6 +20,7 @@
 
 #include <QList>
 #include <QHash>
+#include <QString>
 
 /** Class representing a formula in the output. */
 class Formula
@@ -45,6 +46,39 @@ class FormulaList : public QList<Formula>
    void generateBitmaps(const QString &path);
 };
 
+/** Renders the images of formulas on the worker threads of the ToolExecutor.
+ *
+ *  The formulas are split in shards, each shard is a LaTeX file which is processed by one latex
+ *  run. For each formula dvips, ghostscript and the conversion to PNG are submitted as a chain
+ *  of jobs which starts as soon as the latex run of its shard is done.
+ */
+class FormulaRenderer
+{
+ public:
+   struct Job {
+      int     id;
+      int     shard;
+      int     page;
+      QString text;
+      QString error;
+   };
+
+   FormulaRenderer(const QList<Job> &jobs, int numShards);
+
+   /** Renders all jobs in the current directory, returns false if latex failed for one of the shards */
+   bool run();
+
+   const QList<Job> &jobs() const {
+      return m_jobs;
+   }
+
+   static QString shardName(int shard);
+
+ private:
+   QList<Job>  m_jobs;
+   QList<bool> m_shardOk;
+};
+
 /** Iterator for Formula objects in a FormulaList. */
 class FormulaListIterator : public QListIterator<Formula>
 {
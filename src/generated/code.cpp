@@ -195,9 +195,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int codeYYleng;
+extern thread_local int codeYYleng;
 
-extern FILE *codeYYin, *codeYYout;
+extern thread_local FILE *codeYYin, *codeYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -291,9 +291,9 @@ struct yy_buffer_state {
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -311,19 +311,19 @@ static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when codeYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int codeYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int codeYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow codeYYwrap()'s to do buffer switches
  * instead of setting up a fresh codeYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void codeYYrestart (FILE *input_file  );
 void codeYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -378,15 +378,15 @@ void codeYYfree (void *);
 
 typedef unsigned char YY_CHAR;
 
-FILE *codeYYin = (FILE *) 0, *codeYYout = (FILE *) 0;
+thread_local FILE *codeYYin = (FILE *) 0, *codeYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int codeYYlineno;
+extern thread_local int codeYYlineno;
 
-int codeYYlineno = 1;
+thread_local int codeYYlineno = 1;
 
-extern char *codeYYtext;
+extern thread_local char *codeYYtext;
 #define yytext_ptr codeYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -10525,15 +10525,15 @@ static yyconst flex_int16_t yy_chk[36433] = {
    3534, 3534
 } ;
 
-extern int codeYY_flex_debug;
-int codeYY_flex_debug = 0;
+extern thread_local int codeYY_flex_debug;
+thread_local int codeYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
+static thread_local yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
+static thread_local int yy_looking_for_trail_begin = 0;
+static thread_local int yy_full_lp;
+static thread_local int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
@@ -10550,7 +10550,7 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *codeYYtext;
+thread_local char *codeYYtext;
 
 #include <QDir>
 #include <QRegExp>
@@ -10579,79 +10579,79 @@ char *codeYYtext;
 #define SCOPEBLOCK    2
 #define INNERBLOCK    3
 
-static CodeOutputInterface *g_code;
+static thread_local CodeOutputInterface *g_code;
 
-static ClassSDict   *g_codeClassSDict = 0;
-static QString       g_curClassName;
-static QStringList   g_curClassBases;
+static thread_local ClassSDict   *g_codeClassSDict = 0;
+static thread_local QString       g_curClassName;
+static thread_local QStringList   g_curClassBases;
 
-static QString       g_parmType;
-static QString       g_parmName;
+static thread_local QString       g_parmType;
+static thread_local QString       g_parmName;
 
-static QString       g_inputString;     //!< the code fragment as text
-static int	         g_inputPosition;   //!< read offset during parsing
-static int           g_inputLines;      //!< number of line in the code fragment
-static int	         g_yyLineNr;        //!< current line number
-static int	         g_yyColNr;         //!< current column number
-static bool          g_needsTermination;
+static thread_local QString       g_inputString;     //!< the code fragment as text
+static thread_local int	         g_inputPosition;   //!< read offset during parsing
+static thread_local int           g_inputLines;      //!< number of line in the code fragment
+static thread_local int	         g_yyLineNr;        //!< current line number
+static thread_local int	         g_yyColNr;         //!< current column number
+static thread_local bool          g_needsTermination;
 
-static bool          g_exampleBlock;
-static QString       g_exampleName;
-static QString       g_exampleFile;
+static thread_local bool          g_exampleBlock;
+static thread_local QString       g_exampleName;
+static thread_local QString       g_exampleFile;
 
-static bool          g_insideTemplate = false;
-static QString       g_type;
-static QString       g_name;
-static QString       g_args;
-static QString       g_classScope;
-static QString       g_realScope;
+static thread_local bool          g_insideTemplate = false;
+static thread_local QString       g_type;
+static thread_local QString       g_name;
+static thread_local QString       g_args;
+static thread_local QString       g_classScope;
+static thread_local QString       g_realScope;
 
-static QStack<int>   g_scopeStack;     
-static int           g_anchorCount;
+static thread_local QStack<int>   g_scopeStack;     
+static thread_local int           g_anchorCount;
 
-static QSharedPointer<FileDef>  g_sourceFileDef;
+static thread_local QSharedPointer<FileDef>  g_sourceFileDef;
 
-static bool          g_lineNumbers;
+static thread_local bool          g_lineNumbers;
 
-static QSharedPointer<Definition>  g_currentDefinition;
-static QSharedPointer<MemberDef>   g_currentMemberDef;
+static thread_local QSharedPointer<Definition>  g_currentDefinition;
+static thread_local QSharedPointer<MemberDef>   g_currentMemberDef;
 
-static bool          g_includeCodeFragment;
-static QString       g_currentFontClass;
-static bool          g_searchingForBody;
-static bool          g_insideBody;
-static int           g_bodyCurlyCount;
-static QString       g_saveName;
-static QString       g_saveType;
-static QString       g_delimiter;
+static thread_local bool          g_includeCodeFragment;
+static thread_local QString       g_currentFontClass;
+static thread_local bool          g_searchingForBody;
+static thread_local bool          g_insideBody;
+static thread_local int           g_bodyCurlyCount;
+static thread_local QString       g_saveName;
+static thread_local QString       g_saveType;
+static thread_local QString       g_delimiter;
 
-static int	     g_bracketCount = 0;
-static int	     g_curlyCount   = 0;
-static int	     g_sharpCount   = 0;
-static bool      g_inFunctionTryBlock = false;
-static bool      g_inForEachExpression = false;
+static thread_local int	     g_bracketCount = 0;
+static thread_local int	     g_curlyCount   = 0;
+static thread_local int	     g_sharpCount   = 0;
+static thread_local bool      g_inFunctionTryBlock = false;
+static thread_local bool      g_inForEachExpression = false;
 
-static int       g_lastTemplCastContext;
-static int	     g_lastSpecialCContext;
-static int       g_lastStringContext;
-static int       g_lastSkipCppContext;
-static int       g_lastVerbStringContext;
-static int       g_memCallContext;
-static int	     g_lastCContext;
-static int       g_skipInlineInitContext;
+static thread_local int       g_lastTemplCastContext;
+static thread_local int	     g_lastSpecialCContext;
+static thread_local int       g_lastStringContext;
+static thread_local int       g_lastSkipCppContext;
+static thread_local int       g_lastVerbStringContext;
+static thread_local int       g_memCallContext;
+static thread_local int	     g_lastCContext;
+static thread_local int       g_skipInlineInitContext;
 
-static bool      g_insideObjC;
-static bool      g_insideJava;
-static bool      g_insideCS;
-static bool      g_insidePHP;
-static bool      g_insideProtocolList;
+static thread_local bool      g_insideObjC;
+static thread_local bool      g_insideJava;
+static thread_local bool      g_insideCS;
+static thread_local bool      g_insidePHP;
+static thread_local bool      g_insideProtocolList;
 
-static bool      g_lexInit = false;
+static thread_local bool      g_lexInit = false;
 
-static QStack<int *>   g_classScopeLengthStack;
-static QSharedPointer<Definition> g_searchCtx;
+static thread_local QStack<int *>   g_classScopeLengthStack;
+static thread_local QSharedPointer<Definition> g_searchCtx;
 
-static bool      g_collectXRefs;
+static thread_local bool      g_collectXRefs;
 
 // context for an Objective-C method call
 struct ObjCCallCtx {
@@ -10670,23 +10670,23 @@ struct ObjCCallCtx {
 };
 
 // globals for objective-C method calls
-static ObjCCallCtx *g_currentCtx = 0;
-static int g_currentCtxId = 0;
-static int g_currentNameId = 0;
-static int g_currentObjId = 0;
-static int g_currentWordId = 0;
-
-static QStack<ObjCCallCtx *>      g_contextStack;
-static QHash<long, ObjCCallCtx *> g_contextDict;
-static QHash<long, QString *>     g_nameDict;
-static QHash<long, QString *>     g_objectDict;
-static QHash<long, QString *>     g_wordDict;
-static int g_braceCount = 0;
+static thread_local ObjCCallCtx *g_currentCtx = 0;
+static thread_local int g_currentCtxId = 0;
+static thread_local int g_currentNameId = 0;
+static thread_local int g_currentObjId = 0;
+static thread_local int g_currentWordId = 0;
+
+static thread_local QStack<ObjCCallCtx *>      g_contextStack;
+static thread_local QHash<long, ObjCCallCtx *> g_contextDict;
+static thread_local QHash<long, QString *>     g_nameDict;
+static thread_local QHash<long, QString *>     g_objectDict;
+static thread_local QHash<long, QString *>     g_wordDict;
+static thread_local int g_braceCount = 0;
 
 static void saveObjCContext();
 static void restoreObjCContext();
 
-static QString g_forceTagReference;
+static thread_local QString g_forceTagReference;
 
 /*! Represents a stack of variable to class mappings as found in the
  *  code. Each scope is enclosed in pushScope() and popScope() calls.
@@ -10849,7 +10849,7 @@ void VariableContext::addVariable(const QString &type, const QString &name)
    return result;
 }
 
-static VariableContext g_theVarContext;
+static thread_local VariableContext g_theVarContext;
 
 class CallContext
 {
@@ -10919,7 +10919,7 @@ class CallContext
    QList<Ctx *> m_defList;
 };
 
-static CallContext g_theCallContext;
+static thread_local CallContext g_theCallContext;
 
 /*! add class/namespace name(s) to the scope */
 static void pushScope(const QString &s)
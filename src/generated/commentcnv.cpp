@@ -194,9 +194,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int commentcnvYYleng;
+extern thread_local int commentcnvYYleng;
 
-extern FILE *commentcnvYYin, *commentcnvYYout;
+extern thread_local FILE *commentcnvYYin, *commentcnvYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -290,9 +290,9 @@ struct yy_buffer_state {
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -310,19 +310,19 @@ static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when commentcnvYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int commentcnvYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int commentcnvYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow commentcnvYYwrap()'s to do buffer switches
  * instead of setting up a fresh commentcnvYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void commentcnvYYrestart (FILE *input_file  );
 void commentcnvYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -377,15 +377,15 @@ void commentcnvYYfree (void *);
 
 typedef unsigned char YY_CHAR;
 
-FILE *commentcnvYYin = (FILE *) 0, *commentcnvYYout = (FILE *) 0;
+thread_local FILE *commentcnvYYin = (FILE *) 0, *commentcnvYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int commentcnvYYlineno;
+extern thread_local int commentcnvYYlineno;
 
-int commentcnvYYlineno = 1;
+thread_local int commentcnvYYlineno = 1;
 
-extern char *commentcnvYYtext;
+extern thread_local char *commentcnvYYtext;
 #define yytext_ptr commentcnvYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -1005,15 +1005,15 @@ static yyconst flex_int16_t yy_chk[1600] = {
 
 } ;
 
-extern int commentcnvYY_flex_debug;
-int commentcnvYY_flex_debug = 0;
+extern thread_local int commentcnvYY_flex_debug;
+thread_local int commentcnvYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
+static thread_local yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
+static thread_local int yy_looking_for_trail_begin = 0;
+static thread_local int yy_full_lp;
+static thread_local int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
@@ -1030,7 +1030,7 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *commentcnvYYtext;
+thread_local char *commentcnvYYtext;
 
 #define YY_NEVER_INTERACTIVE 1
 
@@ -1070,40 +1070,40 @@ struct CommentCtx {
    int lineNr;
 };
 
-static QString  g_inBuf;
-static QString  g_outBuf;
-
-static int      g_inBufPos;
-static int      g_col;
-static int      g_blockHeadCol;
-static bool     g_mlBrief;
-static int      g_readLineCtx;
-static bool     g_skip;
-static QString  g_fileName;
-static int      g_lineNr;
-static int      g_condCtx;
-
-static QStack<CondCtx *>     g_condStack;
-static QStack<CommentCtx *>  g_commentStack;
-static QString               g_blockName;
-
-static int      g_lastCommentContext;
-static bool     g_inSpecialComment;
-static bool     g_inRoseComment;
-static int      g_stringContext;
-static int      g_charContext;
-static int      g_javaBlock;
-static bool     g_specialComment;
-
-static QString  g_aliasString;
-static int      g_blockCount;
-static bool     g_lastEscaped;
-static int      g_lastBlockContext;
-static bool     g_pythonDocString;
-static int      g_nestingCount;
-
-static SrcLangExt g_lang;
-static bool       isFixedForm; // For Fortran
+static thread_local QString  g_inBuf;
+static thread_local QString  g_outBuf;
+
+static thread_local int      g_inBufPos;
+static thread_local int      g_col;
+static thread_local int      g_blockHeadCol;
+static thread_local bool     g_mlBrief;
+static thread_local int      g_readLineCtx;
+static thread_local bool     g_skip;
+static thread_local QString  g_fileName;
+static thread_local int      g_lineNr;
+static thread_local int      g_condCtx;
+
+static thread_local QStack<CondCtx *>     g_condStack;
+static thread_local QStack<CommentCtx *>  g_commentStack;
+static thread_local QString               g_blockName;
+
+static thread_local int      g_lastCommentContext;
+static thread_local bool     g_inSpecialComment;
+static thread_local bool     g_inRoseComment;
+static thread_local int      g_stringContext;
+static thread_local int      g_charContext;
+static thread_local int      g_javaBlock;
+static thread_local bool     g_specialComment;
+
+static thread_local QString  g_aliasString;
+static thread_local int      g_blockCount;
+static thread_local bool     g_lastEscaped;
+static thread_local int      g_lastBlockContext;
+static thread_local bool     g_pythonDocString;
+static thread_local int      g_nestingCount;
+
+static thread_local SrcLangExt g_lang;
+static thread_local bool       isFixedForm; // For Fortran
 
 static void replaceCommentMarker(const QString &s, int len)
 {
@@ -180,9 +180,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int commentscanYYleng;
+extern thread_local int commentscanYYleng;
 
-extern FILE *commentscanYYin, *commentscanYYout;
+extern thread_local FILE *commentscanYYin, *commentscanYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -277,9 +277,9 @@ struct yy_buffer_state
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -297,19 +297,19 @@ static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when commentscanYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int commentscanYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int commentscanYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow commentscanYYwrap()'s to do buffer switches
  * instead of setting up a fresh commentscanYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void commentscanYYrestart (FILE *input_file  );
 void commentscanYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -364,15 +364,15 @@ void commentscanYYfree (void *  );
 
 typedef unsigned char YY_CHAR;
 
-FILE *commentscanYYin = (FILE *) 0, *commentscanYYout = (FILE *) 0;
+thread_local FILE *commentscanYYin = (FILE *) 0, *commentscanYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int commentscanYYlineno;
+extern thread_local int commentscanYYlineno;
 
-int commentscanYYlineno = 1;
+thread_local int commentscanYYlineno = 1;
 
-extern char *commentscanYYtext;
+extern thread_local char *commentscanYYtext;
 #define yytext_ptr commentscanYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -3103,12 +3103,12 @@ static yyconst flex_int16_t yy_chk[9669] =
      1139, 1139, 1139, 1139, 1139, 1139, 1139, 1139
     } ;
 
-extern int commentscanYY_flex_debug;
-int commentscanYY_flex_debug = 0;
+extern thread_local int commentscanYY_flex_debug;
+thread_local int commentscanYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf=0, *yy_state_ptr=0;
-static char *yy_full_match;
-static int yy_lp;
+static thread_local yy_state_type *yy_state_buf=0, *yy_state_ptr=0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
 #define REJECT \
 { \
 *yy_cp = (yy_hold_char); /* undo effects of setting up commentscanYYtext */ \
@@ -3120,7 +3120,7 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *commentscanYYtext;
+thread_local char *commentscanYYtext;
 #line 1 "commentscan.l"
 /*************************************************************************
  *
@@ -3130,7 +3130,9 @@ char *commentscanYYtext;
 *************************************************************************/
 #line 9 "commentscan.l"
 
+#include <QAtomicPointer>
 #include <QFile>
+#include <QMutex>
 #include <QStack>
 #include <QRegExp>
 #include <QVector>
@@ -3155,6 +3157,7 @@ char *commentscanYYtext;
 #include <parser_base.h>
 #include <parser_cstyle.h>
 #include <parser_md.h>
+#include <scannerstate.h>
 #include <util.h>
 
 #define YY_NO_INPUT 1
@@ -3400,16 +3403,26 @@ class DocCmdMapper
 
    /** release the singleton */
    static void freeInstance() {
-      delete s_instance;
-      s_instance = 0;
+      delete s_instance.loadAcquire();
+      s_instance.storeRelease(nullptr);
    }
 
   private:
     static DocCmdMapper *instance() {
-      if (s_instance == 0) {
-         s_instance = new DocCmdMapper;
+      DocCmdMapper *mapper = s_instance.loadAcquire();
+
+      if (mapper == nullptr) {
+         // comments can be scanned by several threads, the map is created once
+         QMutexLocker locker(&s_lock);
+         mapper = s_instance.loadAcquire();
+
+         if (mapper == nullptr) {
+            mapper = new DocCmdMapper;
+            s_instance.storeRelease(mapper);
+         }
       }
-      return s_instance;
+
+      return mapper;
    }
 
    DocCmdMapper() {
@@ -3434,10 +3447,13 @@ class DocCmdMapper
    }
 
    QHash<QString, Cmd *> m_map;
-   static DocCmdMapper *s_instance;
+
+   static QAtomicPointer<DocCmdMapper> s_instance;
+   static QMutex s_lock;
 };
 
-DocCmdMapper *DocCmdMapper::s_instance = 0;
+QAtomicPointer<DocCmdMapper> DocCmdMapper::s_instance;
+QMutex DocCmdMapper::s_lock;
     
 #define YY_NEVER_INTERACTIVE 1
 
@@ -3485,69 +3501,69 @@ void closeGroup(QSharedPointer<Entry> e, const QString &file, int line, bool fou
 void initGroupInfo(QSharedPointer<Entry> e);
 static void groupAddDocs(QSharedPointer<Entry> e);
 
-static ParserInterface *langParser;          // the language parser that is calling us
-static QString          inputString;         // input string
-static int              inputPosition;       // read pointer
-static int              prevPosition;
-static char *           s_bufferPosition;
-
-static QString          yyFileName;          // file name that is read from
-static int              yyLineNr;            // line number in the input
-static bool             inBody;              // was the comment found inside the body of a function?
-static OutputContext    inContext;           // are we inside the brief, details or xref part
-static bool             briefEndsAtDot;      // does the brief description stop at a dot?
-static QString          formulaText;         // Running text of a formula
-static QString          formulaEnv;          // environment name
-static int              formulaNewLines;     // amount of new lines in the formula
-static QString         *pOutputString;       // pointer to string to which the output is appended
-static QString          outputXRef;          // temp argument of todo/test/../xrefitem commands
-static QString          blockName;           // preformatted block name (e.g. verbatim, latexonly,...)
-static XRefKind         xrefKind;            // kind of cross-reference command
-static XRefKind         newXRefKind;         //
-static GuardType        guardType;           // kind of guard for conditional section
-static bool             enabledSectionFound;
-static QString          functionProto;       // function prototype
-
-static QStack<GuardedSection *> guards;      // tracks nested conditional sections (if,ifnot,..)
-static QSharedPointer<Entry>  current;       // working entry
-
-static bool             s_needNewEntry;
-static int              s_docBlockContext; 
-
-static QString          s_sectionLabel;
-static QString          s_sectionTitle;
-static int              s_sectionLevel;
-static QString          xrefItemKey;
-static QString          newXRefItemKey;
-static QString          xrefItemTitle;
-static QString          xrefListTitle;
-static Protection       protection;
-
-static bool             xrefAppendFlag;
-static bool             inGroupParamFound;
-static int              braceCount;
-static bool             insidePre;
-static bool             s_parseMore;
-
-static int              s_condCount;
-static int              s_commentCount;
-static QString          s_spaceBeforeCmd;
-static QString          s_spaceBeforeIf;
-static QString          s_copyDocArg;
-static QString          s_guardExpr;
-static int              s_roundCount;
-static bool             s_insideParBlock;
-
-static QStack<QSharedPointer<Grouping>> s_autoGroupStack;
-
-static int              s_memberGroupId = DOX_NOGROUP;
-static QString          s_memberGroupHeader;
-static QString          s_memberGroupDocs;
-static QString          s_memberGroupRelates;
-static QString          s_compoundName;
-
-static bool             s_internalDocs;   
-static bool             s_processInternalDocs = false;  
+static thread_local ParserInterface *langParser;          // the language parser that is calling us
+static thread_local QString          inputString;         // input string
+static thread_local int              inputPosition;       // read pointer
+static thread_local int              prevPosition;
+static thread_local char *           s_bufferPosition;
+
+static thread_local QString          yyFileName;          // file name that is read from
+static thread_local int              yyLineNr;            // line number in the input
+static thread_local bool             inBody;              // was the comment found inside the body of a function?
+static thread_local OutputContext    inContext;           // are we inside the brief, details or xref part
+static thread_local bool             briefEndsAtDot;      // does the brief description stop at a dot?
+static thread_local QString          formulaText;         // Running text of a formula
+static thread_local QString          formulaEnv;          // environment name
+static thread_local int              formulaNewLines;     // amount of new lines in the formula
+static thread_local QString         *pOutputString;       // pointer to string to which the output is appended
+static thread_local QString          outputXRef;          // temp argument of todo/test/../xrefitem commands
+static thread_local QString          blockName;           // preformatted block name (e.g. verbatim, latexonly,...)
+static thread_local XRefKind         xrefKind;            // kind of cross-reference command
+static thread_local XRefKind         newXRefKind;         //
+static thread_local GuardType        guardType;           // kind of guard for conditional section
+static thread_local bool             enabledSectionFound;
+static thread_local QString          functionProto;       // function prototype
+
+static thread_local QStack<GuardedSection *> guards;      // tracks nested conditional sections (if,ifnot,..)
+static thread_local QSharedPointer<Entry>  current;       // working entry
+
+static thread_local bool             s_needNewEntry;
+static thread_local int              s_docBlockContext; 
+
+static thread_local QString          s_sectionLabel;
+static thread_local QString          s_sectionTitle;
+static thread_local int              s_sectionLevel;
+static thread_local QString          xrefItemKey;
+static thread_local QString          newXRefItemKey;
+static thread_local QString          xrefItemTitle;
+static thread_local QString          xrefListTitle;
+static thread_local Protection       protection;
+
+static thread_local bool             xrefAppendFlag;
+static thread_local bool             inGroupParamFound;
+static thread_local int              braceCount;
+static thread_local bool             insidePre;
+static thread_local bool             s_parseMore;
+
+static thread_local int              s_condCount;
+static thread_local int              s_commentCount;
+static thread_local QString          s_spaceBeforeCmd;
+static thread_local QString          s_spaceBeforeIf;
+static thread_local QString          s_copyDocArg;
+static thread_local QString          s_guardExpr;
+static thread_local int              s_roundCount;
+static thread_local bool             s_insideParBlock;
+
+static thread_local QStack<QSharedPointer<Grouping>> s_autoGroupStack;
+
+static thread_local int              s_memberGroupId = DOX_NOGROUP;
+static thread_local QString          s_memberGroupHeader;
+static thread_local QString          s_memberGroupDocs;
+static thread_local QString          s_memberGroupRelates;
+static thread_local QString          s_compoundName;
+
+static thread_local bool             s_internalDocs;   
+static thread_local bool             s_processInternalDocs = false;  
 
 static void initParser()
 {
@@ -3631,6 +3647,11 @@ static void addXRefItem(const QString &listName, const QString &itemTitle, const
       return;
    }
 
+   if (! ScannerState::useShared()) {
+      // the file is scanned again on the main thread
+      return;
+   }
+
    auto refList = Doxy_Globals::xrefLists->find(listName);
 
    if (refList == Doxy_Globals::xrefLists->end()) {
@@ -3725,6 +3746,10 @@ static QString addFormula()
    QString formLabel;
    QString fText = formulaText.simplified();
 
+   if (! ScannerState::useShared()) {
+      return formLabel;
+   }
+
    auto f = Doxy_Globals::formulaDict->find(fText);
 
    if (f == Doxy_Globals::formulaDict->end()) {
@@ -3764,6 +3789,10 @@ static SectionInfo::SectionType sectionLevelToType(int level)
 
 static void addSection()
 {
+   if (! ScannerState::useShared()) {
+      return;
+   }
+
    QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict->find(s_sectionLabel);
 
    if (si) {
@@ -3797,7 +3826,10 @@ static void addSection()
 static void addCite()
 {
    QString text = QString::fromUtf8(commentscanYYtext);
-   Doxy_Globals::citeDict->insert(text);
+
+   if (ScannerState::useShared()) {
+      Doxy_Globals::citeDict->insert(text);
+   }
 }
 
 // strip trailing whitespace (excluding newlines) from string s
@@ -3919,6 +3951,10 @@ static inline void setOutput(OutputContext ctx)
 
 static void addAnchor(const QString &anchorName)
 {
+   if (! ScannerState::useShared()) {
+      return;
+   }
+
    QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict->find(anchorName);
 
    if (si) {
@@ -8767,6 +8803,10 @@ void openGroup(QSharedPointer<Entry> e, const QString &, int)
          // no group started yet
          static int curGroupId = 0;
 
+         if (! ScannerState::useShared()) {
+            return;
+         }
+
          QSharedPointer<MemberGroupInfo> info = QMakeShared<MemberGroupInfo>();
 
          info->header = s_memberGroupHeader.trimmed();
@@ -8786,7 +8826,11 @@ void closeGroup(QSharedPointer<Entry> e, const QString &fileName, int line, bool
    if (s_memberGroupId != DOX_NOGROUP) {
       // end of member group
 
-      QSharedPointer<MemberGroupInfo> info = Doxy_Globals::memGrpInfoDict.value(s_memberGroupId);
+      QSharedPointer<MemberGroupInfo> info;
+
+      if (ScannerState::useShared()) {
+         info = Doxy_Globals::memGrpInfoDict.value(s_memberGroupId);
+      }
 
       if (info) {
          // known group
@@ -8839,7 +8883,11 @@ static void groupAddDocs(QSharedPointer<Entry> e)
       }
 
       s_memberGroupDocs += e->doc;
-      QSharedPointer<MemberGroupInfo> info = Doxy_Globals::memGrpInfoDict.value(s_memberGroupId);
+      QSharedPointer<MemberGroupInfo> info;
+
+      if (ScannerState::useShared()) {
+         info = Doxy_Globals::memGrpInfoDict.value(s_memberGroupId);
+      }
 
       if (info) {
          info->doc = s_memberGroupDocs;
@@ -194,9 +194,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int constexpYYleng;
+extern thread_local int constexpYYleng;
 
-extern FILE *constexpYYin, *constexpYYout;
+extern thread_local FILE *constexpYYin, *constexpYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -290,9 +290,9 @@ struct yy_buffer_state {
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -310,19 +310,19 @@ static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when constexpYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int constexpYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int constexpYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow constexpYYwrap()'s to do buffer switches
  * instead of setting up a fresh constexpYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void constexpYYrestart (FILE *input_file  );
 void constexpYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -374,15 +374,15 @@ void constexpYYfree (void *);
 
 typedef unsigned char YY_CHAR;
 
-FILE *constexpYYin = (FILE *) 0, *constexpYYout = (FILE *) 0;
+thread_local FILE *constexpYYin = (FILE *) 0, *constexpYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int constexpYYlineno;
+extern thread_local int constexpYYlineno;
 
-int constexpYYlineno = 1;
+thread_local int constexpYYlineno = 1;
 
-extern char *constexpYYtext;
+extern thread_local char *constexpYYtext;
 #define yytext_ptr constexpYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -536,11 +536,11 @@ static yyconst flex_int16_t yy_chk[200] = {
 
 } ;
 
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
+static thread_local yy_state_type yy_last_accepting_state;
+static thread_local char *yy_last_accepting_cpos;
 
-extern int constexpYY_flex_debug;
-int constexpYY_flex_debug = 0;
+extern thread_local int constexpYY_flex_debug;
+thread_local int constexpYY_flex_debug = 0;
 
 /* The intent behind this definition is that it'll catch
  * any uses of REJECT which flex missed.
@@ -549,7 +549,7 @@ int constexpYY_flex_debug = 0;
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *constexpYYtext;
+thread_local char *constexpYYtext;
 
 #include "constexp.h"
 #include "cppvalue.h"
@@ -559,13 +559,13 @@ char *constexpYYtext;
 #define YY_NEVER_INTERACTIVE 1
 #define YY_NO_INPUT 1
 
-QString    g_strToken;
-CPPValue   g_resultValue;
-int        g_constExpLineNr;
-QString    g_constExpFileName;
+thread_local QString    g_strToken;
+thread_local CPPValue   g_resultValue;
+thread_local int        g_constExpLineNr;
+thread_local QString    g_constExpFileName;
 
-static QString  g_inputString;
-static int      g_inputPosition;
+static thread_local QString  g_inputString;
+static thread_local int      g_inputPosition;
 
 #undef  YY_INPUT
 #define YY_INPUT(buf,result,max_size) result=yyread(buf,max_size);
@@ -194,9 +194,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int declinfoYYleng;
+extern thread_local int declinfoYYleng;
 
-extern FILE *declinfoYYin, *declinfoYYout;
+extern thread_local FILE *declinfoYYin, *declinfoYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -290,9 +290,9 @@ struct yy_buffer_state {
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -310,19 +310,19 @@ static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when declinfoYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int declinfoYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int declinfoYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow declinfoYYwrap()'s to do buffer switches
  * instead of setting up a fresh declinfoYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void declinfoYYrestart (FILE *input_file  );
 void declinfoYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -377,15 +377,15 @@ void declinfoYYfree (void *);
 
 typedef unsigned char YY_CHAR;
 
-FILE *declinfoYYin = (FILE *) 0, *declinfoYYout = (FILE *) 0;
+thread_local FILE *declinfoYYin = (FILE *) 0, *declinfoYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int declinfoYYlineno;
+extern thread_local int declinfoYYlineno;
 
-int declinfoYYlineno = 1;
+thread_local int declinfoYYlineno = 1;
 
-extern char *declinfoYYtext;
+extern thread_local char *declinfoYYtext;
 #define yytext_ptr declinfoYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -618,15 +618,15 @@ static yyconst flex_int16_t yy_chk[377] = {
    138,  138,  138,  138,  138,  138
 } ;
 
-extern int declinfoYY_flex_debug;
-int declinfoYY_flex_debug = 0;
+extern thread_local int declinfoYY_flex_debug;
+thread_local int declinfoYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
+static thread_local yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
+static thread_local int yy_looking_for_trail_begin = 0;
+static thread_local int yy_full_lp;
+static thread_local int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
@@ -643,7 +643,7 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *declinfoYYtext;
+thread_local char *declinfoYYtext;
 
 #include <stdio.h>
 #include <assert.h>
@@ -655,21 +655,21 @@ char *declinfoYYtext;
 
 #define YY_NO_INPUT 1
 
-static QString  inputString;
-static int	    inputPosition;
-static QString  className;
-static QString  classTempList;
-static QString  funcTempList;
-static QString  s_scope;
-static QString  s_type;
-static QString  s_name;
-static QString  s_args;
-
-static int      sharpCount;
-static bool     classTempListFound;
-static bool     funcTempListFound;
-static QString  exceptionString;
-static bool     insideObjC;
+static thread_local QString  inputString;
+static thread_local int	    inputPosition;
+static thread_local QString  className;
+static thread_local QString  classTempList;
+static thread_local QString  funcTempList;
+static thread_local QString  s_scope;
+static thread_local QString  s_type;
+static thread_local QString  s_name;
+static thread_local QString  s_args;
+
+static thread_local int      sharpCount;
+static thread_local bool     classTempListFound;
+static thread_local bool     funcTempListFound;
+static thread_local QString  exceptionString;
+static thread_local bool     insideObjC;
 
 static void addType()
 {
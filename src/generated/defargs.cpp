@@ -195,9 +195,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int defargsYYleng;
+extern thread_local int defargsYYleng;
 
-extern FILE *defargsYYin, *defargsYYout;
+extern thread_local FILE *defargsYYin, *defargsYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -291,9 +291,9 @@ struct yy_buffer_state {
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -311,19 +311,19 @@ static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when defargsYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;     /* number of characters read into yy_ch_buf */
-int defargsYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;     /* number of characters read into yy_ch_buf */
+thread_local int defargsYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;       /* whether we need to initialize */
-static int yy_start = 0;   /* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;       /* whether we need to initialize */
+static thread_local int yy_start = 0;   /* start state number */
 
 /* Flag which is used to allow defargsYYwrap()'s to do buffer switches
  * instead of setting up a fresh defargsYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void defargsYYrestart (FILE *input_file  );
 void defargsYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -378,15 +378,15 @@ void defargsYYfree (void *);
 
 typedef unsigned char YY_CHAR;
 
-FILE *defargsYYin = (FILE *) 0, *defargsYYout = (FILE *) 0;
+thread_local FILE *defargsYYin = (FILE *) 0, *defargsYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int defargsYYlineno;
+extern thread_local int defargsYYlineno;
 
-int defargsYYlineno = 1;
+thread_local int defargsYYlineno = 1;
 
-extern char *defargsYYtext;
+extern thread_local char *defargsYYtext;
 #define yytext_ptr defargsYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -826,15 +826,15 @@ static yyconst flex_int16_t yy_chk[969] =
       262,  262,  262,  262,  262,  262,  262,  262
     } ;
 
-extern int defargsYY_flex_debug;
-int defargsYY_flex_debug = 0;
+extern thread_local int defargsYY_flex_debug;
+thread_local int defargsYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
+static thread_local yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
+static thread_local int yy_looking_for_trail_begin = 0;
+static thread_local int yy_full_lp;
+static thread_local int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
@@ -851,7 +851,7 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *defargsYYtext;
+thread_local char *defargsYYtext;
 
 /*! \file
  *  This scanner is used to convert a string into a list of function or
@@ -895,26 +895,26 @@ char *defargsYYtext;
 #define YY_NO_UNISTD_H 1
 
 //    state variables
-static QString          g_inputString;
-static int              g_inputPosition;
-static ArgumentList    *g_argList;
-static QString         *g_copyArgValue;
-static QString          g_curArgTypeName;
-static QString          g_curArgDefValue;
-static QString          g_curArgName;
-static QString          g_curArgDocs;
-static QString          g_curArgAttrib;
-static QString          g_curArgArray;
-static QString          g_curTypeConstraint;
-static QString          g_extraTypeChars;
-static int              g_argRoundCount;
-static int              g_argSharpCount;
-static int              g_argCurlyCount;
-static int              g_readArgContext;
-static int              g_lastDocContext;
-static char             g_lastDocChar;
-static int              g_lastExtendsContext;
-static QString          g_delimiter;
+static thread_local QString          g_inputString;
+static thread_local int              g_inputPosition;
+static thread_local ArgumentList    *g_argList;
+static thread_local QString         *g_copyArgValue;
+static thread_local QString          g_curArgTypeName;
+static thread_local QString          g_curArgDefValue;
+static thread_local QString          g_curArgName;
+static thread_local QString          g_curArgDocs;
+static thread_local QString          g_curArgAttrib;
+static thread_local QString          g_curArgArray;
+static thread_local QString          g_curTypeConstraint;
+static thread_local QString          g_extraTypeChars;
+static thread_local int              g_argRoundCount;
+static thread_local int              g_argSharpCount;
+static thread_local int              g_argCurlyCount;
+static thread_local int              g_readArgContext;
+static thread_local int              g_lastDocContext;
+static thread_local char             g_lastDocChar;
+static thread_local int              g_lastExtendsContext;
+static thread_local QString          g_delimiter;
 
 #undef   YY_INPUT
 #define  YY_INPUT(buf,result,max_size) result = yyread(buf,max_size);
@@ -194,9 +194,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int fortrancodeYYleng;
+extern thread_local int fortrancodeYYleng;
 
-extern FILE *fortrancodeYYin, *fortrancodeYYout;
+extern thread_local FILE *fortrancodeYYin, *fortrancodeYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -290,9 +290,9 @@ struct yy_buffer_state {
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -308,19 +308,19 @@ static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when fortrancodeYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int fortrancodeYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int fortrancodeYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow fortrancodeYYwrap()'s to do buffer switches
  * instead of setting up a fresh fortrancodeYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void fortrancodeYYrestart (FILE *input_file  );
 void fortrancodeYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -375,15 +375,15 @@ void fortrancodeYYfree (void *);
 
 typedef unsigned char YY_CHAR;
 
-FILE *fortrancodeYYin = (FILE *) 0, *fortrancodeYYout = (FILE *) 0;
+thread_local FILE *fortrancodeYYin = (FILE *) 0, *fortrancodeYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int fortrancodeYYlineno;
+extern thread_local int fortrancodeYYlineno;
 
-int fortrancodeYYlineno = 1;
+thread_local int fortrancodeYYlineno = 1;
 
-extern char *fortrancodeYYtext;
+extern thread_local char *fortrancodeYYtext;
 #define yytext_ptr fortrancodeYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -25861,15 +25861,15 @@ static yyconst flex_int16_t yy_chk[95105] = {
    10259, 10259, 10259, 10259
 } ;
 
-extern int fortrancodeYY_flex_debug;
-int fortrancodeYY_flex_debug = 0;
+extern thread_local int fortrancodeYY_flex_debug;
+thread_local int fortrancodeYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
+static thread_local yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
+static thread_local int yy_looking_for_trail_begin = 0;
+static thread_local int yy_full_lp;
+static thread_local int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
@@ -25886,7 +25886,7 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *fortrancodeYYtext;
+thread_local char *fortrancodeYYtext;
 
 
 /**
@@ -25931,9 +25931,9 @@ char *fortrancodeYYtext;
  * YY_FTN_REST    is used to handle end of lines and reset the column counter
  * YY_FTN_REJECT  resets the column counters when a pattern is rejected and thus rescanned.
  */
-int yy_old_start = 0;
-int yy_my_start  = 0;
-int yy_end       = 1;
+thread_local int yy_old_start = 0;
+thread_local int yy_my_start  = 0;
+thread_local int yy_end       = 1;
 #define YY_USER_ACTION {yy_old_start = yy_my_start; yy_my_start = yy_end; yy_end += fortrancodeYYleng;}
 #define YY_FTN_RESET   {yy_old_start = 0; yy_my_start = 0; yy_end = 1;}
 #define YY_FTN_REJECT  {yy_end = yy_my_start; yy_my_start = yy_old_start; REJECT;}
@@ -25969,49 +25969,49 @@ class Scope
       
 };
 
-static QString     docBlock;                     //!< contents of all lines of a documentation block
-static QString     currentModule;                //!< name of the current enclosing module
-static UseSDict    *useMembers = new UseSDict;   //!< info about used modules
-static UseEntry    *useEntry = 0;                //!< current use statement info
-static QList<Scope *> scopeStack;
+static thread_local QString     docBlock;                     //!< contents of all lines of a documentation block
+static thread_local QString     currentModule;                //!< name of the current enclosing module
+static thread_local UseSDict    *useMembers = new UseSDict;   //!< info about used modules
+static thread_local UseEntry    *useEntry = 0;                //!< current use statement info
+static thread_local QList<Scope *> scopeStack;
 
 // static QStringList *currentUseNames= new QStringList; //! contains names of used modules of current program unit
-static QString str = "";                    //!> contents of fortran string
+static thread_local QString str = "";                    //!> contents of fortran string
 
-static CodeOutputInterface *g_code;
+static thread_local CodeOutputInterface *g_code;
 
 // TODO: is this still needed? 
-static QString      g_parmType;
-static QString      g_parmName;
+static thread_local QString      g_parmType;
+static thread_local QString      g_parmName;
 
-static QString       g_inputString;     //!< the code fragment as text
-static int	         g_inputPosition;   //!< read offset during parsing
-static int           g_inputLines;      //!< number of line in the code fragment
-static int	         g_yyLineNr;        //!< current line number
-static bool          g_needsTermination;
+static thread_local QString       g_inputString;     //!< the code fragment as text
+static thread_local int	         g_inputPosition;   //!< read offset during parsing
+static thread_local int           g_inputLines;      //!< number of line in the code fragment
+static thread_local int	         g_yyLineNr;        //!< current line number
+static thread_local bool          g_needsTermination;
 
-static bool          g_collectXRefs;
-static bool          g_isFixedForm;
+static thread_local bool          g_collectXRefs;
+static thread_local bool          g_isFixedForm;
 
-static bool          g_insideBody;      //!< inside subprog/program body? => create links
-static QString       g_currentFontClass;
+static thread_local bool          g_insideBody;      //!< inside subprog/program body? => create links
+static thread_local QString       g_currentFontClass;
 
-static bool          g_exampleBlock;
-static QString       g_exampleName;
-static QString       g_exampleFile;
+static thread_local bool          g_exampleBlock;
+static thread_local QString       g_exampleName;
+static thread_local QString       g_exampleFile;
 
-static QSharedPointer<Definition> g_searchCtx;
-static QSharedPointer<FileDef>    g_sourceFileDef;
-static QSharedPointer<Definition> g_currentDefinition;
-static QSharedPointer<MemberDef>  g_currentMemberDef;
+static thread_local QSharedPointer<Definition> g_searchCtx;
+static thread_local QSharedPointer<FileDef>    g_sourceFileDef;
+static thread_local QSharedPointer<Definition> g_currentDefinition;
+static thread_local QSharedPointer<MemberDef>  g_currentMemberDef;
 
-static bool          g_includeCodeFragment;
-static char          stringStartSymbol; // single or double quote
+static thread_local bool          g_includeCodeFragment;
+static thread_local char          stringStartSymbol; // single or double quote
 
 // count in variable declaration to filter out declared from referenced names
-static int 	     bracketCount = 0;
+static thread_local int 	     bracketCount = 0;
 
-static bool      g_endComment;
+static thread_local bool      g_endComment;
 
 // simplified way to know if this is fixed form
 static bool recognizeFixedForm(const QString &contents, FortranFormat format)
@@ -26629,9 +26629,9 @@ static int input (void );
 
 #endif
 
-static int yy_start_stack_ptr = 0;
-static int yy_start_stack_depth = 0;
-static int *yy_start_stack = NULL;
+static thread_local int yy_start_stack_ptr = 0;
+static thread_local int yy_start_stack_depth = 0;
+static thread_local int *yy_start_stack = NULL;
 
 static void yy_push_state (int new_state );
 
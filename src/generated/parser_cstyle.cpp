@@ -180,9 +180,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int cstyleYYleng;
+extern thread_local int cstyleYYleng;
 
-extern FILE *cstyleYYin, *cstyleYYout;
+extern thread_local FILE *cstyleYYin, *cstyleYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -277,9 +277,9 @@ struct yy_buffer_state
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -297,19 +297,19 @@ static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when cstyleYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int cstyleYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int cstyleYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow cstyleYYwrap()'s to do buffer switches
  * instead of setting up a fresh cstyleYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void cstyleYYrestart (FILE *input_file  );
 void cstyleYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -364,15 +364,15 @@ void cstyleYYfree (void *  );
 
 typedef unsigned char YY_CHAR;
 
-FILE *cstyleYYin = (FILE *) 0, *cstyleYYout = (FILE *) 0;
+thread_local FILE *cstyleYYin = (FILE *) 0, *cstyleYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int cstyleYYlineno;
+extern thread_local int cstyleYYlineno;
 
-int cstyleYYlineno = 1;
+thread_local int cstyleYYlineno = 1;
 
-extern char *cstyleYYtext;
+extern thread_local char *cstyleYYtext;
 #define yytext_ptr cstyleYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -12149,15 +12149,15 @@ static yyconst flex_int16_t yy_chk[41846] =
      5059, 5059, 5059, 5059, 5059
     } ;
 
-extern int cstyleYY_flex_debug;
-int cstyleYY_flex_debug = 0;
+extern thread_local int cstyleYY_flex_debug;
+thread_local int cstyleYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf=0, *yy_state_ptr=0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
+static thread_local yy_state_type *yy_state_buf=0, *yy_state_ptr=0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
+static thread_local int yy_looking_for_trail_begin = 0;
+static thread_local int yy_full_lp;
+static thread_local int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
@@ -12174,7 +12174,7 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *cstyleYYtext;
+thread_local char *cstyleYYtext;
 #line 1 "parser_cstyle.l"
 /*************************************************************************
  *
@@ -12184,6 +12184,7 @@ char *cstyleYYtext;
 *************************************************************************/
 #line 9 "parser_cstyle.l"
 
+#include <QAtomicInt>
 #include <QFile>
 #include <QHash>
 #include <QStack>
@@ -12205,152 +12206,165 @@ char *cstyleYYtext;
 #include <message.h>
 #include <parser_clang.h>
 #include <parser_cstyle.h>
+#include <scannerstate.h>
 #include <util.h>
 
 #define YY_NO_INPUT 1
 #define YY_NEVER_INTERACTIVE 1
 
-static ParserInterface *s_thisParser;
-static QString          s_inputString;
-static int              s_inputPosition;
-static QFile            s_inputFile;
-
-static int              lastContext;
-static int              lastCContext;
-static int              lastDocContext;
-static int              lastCPPContext;
-static int              lastSkipSharpContext;
-static int              lastSkipRoundContext;
-static int              lastStringContext;
-static int              lastCurlyContext;
-static int              lastRoundContext;
-static int              lastSquareContext;
-static int              lastInitializerContext;
-static int              lastClassTemplSpecContext;
-static int              lastPreLineCtrlContext;
-static int              lastSkipVerbStringContext;
-static int              lastCommentInArgContext;
-static int              lastRawStringContext;
-static int              lastCSConstraint;
-static int              lastHereDocContext;
-static int              lastDefineContext;
-static int              lastAlignAsContext;
-static int              lastC11AttributeContext;
-
-static Protection       protection;
-static Protection       baseProt;
-
-static int sharpCount   = 0;
-static int roundCount   = 0;
-static int curlyCount   = 0;
-static int squareCount  = 0;
-static int padCount     = 0;
-
-static QSharedPointer<Entry> current_root;
-static QSharedPointer<Entry> global_root;
-static QSharedPointer<Entry> current;
-static QSharedPointer<Entry> previous;
-static QSharedPointer<Entry> tempEntry;
-static QSharedPointer<Entry> firstTypedefEntry;
-static QSharedPointer<Entry> memspecEntry;
-
-static int yyLineNr     = 1;
-static int yyBegLineNr  = yyLineNr;
-static int yyColNr      = 1;
-static int yyBegColNr   = yyColNr;
-static int anonCount    = 0;
-static int anonNSCount  = 0;
-
-static QString          yyFileName;
-static MethodTypes      mtype;
-static bool             gstat;
-static bool             removeSlashes;
-static Specifier        virt;
-static Specifier        baseVirt;
-
-static QString          msType, msName, msArgs;
-static bool             isTypedef;
-static int              tmpDocType;
-static QString          sectionLabel;
-static QString          sectionTitle;
-static QString          funcPtrType;
-static QString          templateStr;
-static QString          aliasName;
-static QString          baseName;
-static QString         *specName;
-static QString          formulaText;
-static bool             useOverrideCommands = false;
-
-static SrcLangExt       language;
-
-static bool             insideIDL    = false;       //!< processing IDL code?
-static bool             insideJava   = false;       //!< processing Java code?
-static bool             insideCSharp = false;       //!< processing C# code?
-static bool             insideD      = false;       //!< processing D code?
-static bool             insidePHP    = false;       //!< processing PHP code?
-static bool             insideObjC   = false;       //!< processing Objective C code?
-static bool             insideCli    = false;       //!< processing C++/CLI code?
-static bool             insideJS     = false;       //!< processing JavaScript code?
-static bool             insideCpp    = true;        //!< processing C/C++ code
-
-static bool             insideCppQuote     = false;
-static bool             insideProtocolList = false;
-
-static bool             s_clangParser = false;
-
-static int              argRoundCount;
-static int              argSharpCount;
-static int              currentArgumentContext;
-static int              lastCopyArgStringContext;
-static int              lastCopyArgContext;
-
-static QString          *copyArgString;
-static QString          fullArgString;
-static ArgumentList     *currentArgumentList;
-static QChar            lastCopyArgChar;
-
-static QString          *pCopyQuotedString;
-static QString          *pCopyRoundString;
-static QString          *pCopyCurlyString;
-static QString          *pCopyRawString;
-
-static QString          *pCopyCurlyGString;
-static QString          *pCopyRoundGString;
-static QString          *pCopyQuotedGString;
-static QString          *pCopyHereDocGString;
-static QString          *pCopyRawGString;
-static QString          *pSkipVerbString;
-static QStack<Grouping *>  autoGroupStack;
-
-static bool             insideFormula;
-static bool             insideTryBlock = false;
-static bool             insideCode;
-static bool             needsSemi;
-static int              initBracketCount;
-
-static QString          oldStyleArgType;
-static QString          docBackup;
-static QString          briefBackup;
-
-static int              s_docBlockContext;
-static QString          s_docBlock;
-static QString          s_docBlockName;
-static bool             s_docBlockInBody;
-static bool             s_docBlockAutoBrief;
-static char             s_docBlockTerm;
-
-static QString          idlAttr;
-static QString          idlProp;
-static bool             odlProp;
-
-static bool             s_lexInit = false;
-static bool             externC;
-
-static QString          s_delimiter;
-
-static int              s_column;
-static int              s_fencedSize = 0;
-static bool             s_nestedComment = 0;
+static thread_local ParserInterface *s_thisParser;
+static thread_local QString          s_inputString;
+static thread_local int              s_inputPosition;
+static thread_local QFile            s_inputFile;
+
+static thread_local int              lastContext;
+static thread_local int              lastCContext;
+static thread_local int              lastDocContext;
+static thread_local int              lastCPPContext;
+static thread_local int              lastSkipSharpContext;
+static thread_local int              lastSkipRoundContext;
+static thread_local int              lastStringContext;
+static thread_local int              lastCurlyContext;
+static thread_local int              lastRoundContext;
+static thread_local int              lastSquareContext;
+static thread_local int              lastInitializerContext;
+static thread_local int              lastClassTemplSpecContext;
+static thread_local int              lastPreLineCtrlContext;
+static thread_local int              lastSkipVerbStringContext;
+static thread_local int              lastCommentInArgContext;
+static thread_local int              lastRawStringContext;
+static thread_local int              lastCSConstraint;
+static thread_local int              lastHereDocContext;
+static thread_local int              lastDefineContext;
+static thread_local int              lastAlignAsContext;
+static thread_local int              lastC11AttributeContext;
+
+static thread_local Protection       protection;
+static thread_local Protection       baseProt;
+
+static thread_local int sharpCount   = 0;
+static thread_local int roundCount   = 0;
+static thread_local int curlyCount   = 0;
+static thread_local int squareCount  = 0;
+static thread_local int padCount     = 0;
+
+static thread_local QSharedPointer<Entry> current_root;
+static thread_local QSharedPointer<Entry> global_root;
+static thread_local QSharedPointer<Entry> current;
+static thread_local QSharedPointer<Entry> previous;
+static thread_local QSharedPointer<Entry> tempEntry;
+static thread_local QSharedPointer<Entry> firstTypedefEntry;
+static thread_local QSharedPointer<Entry> memspecEntry;
+
+static thread_local int yyLineNr     = 1;
+static thread_local int yyBegLineNr  = yyLineNr;
+static thread_local int yyColNr      = 1;
+static thread_local int yyBegColNr   = yyColNr;
+
+// shared by all threads, the names of anonymous scopes are unique over all files
+static QAtomicInt anonCount(0);
+static QAtomicInt anonNSCount(0);
+
+// returns the name of the next anonymous scope, on a parse worker the file is scanned again
+static QString nextAnonName()
+{
+   if (! ScannerState::useShared()) {
+      return QString("@0");
+   }
+
+   return QString("@%1").arg(anonCount.fetchAndAddRelaxed(1));
+}
+
+static thread_local QString          yyFileName;
+static thread_local MethodTypes      mtype;
+static thread_local bool             gstat;
+static thread_local bool             removeSlashes;
+static thread_local Specifier        virt;
+static thread_local Specifier        baseVirt;
+
+static thread_local QString          msType, msName, msArgs;
+static thread_local bool             isTypedef;
+static thread_local int              tmpDocType;
+static thread_local QString          sectionLabel;
+static thread_local QString          sectionTitle;
+static thread_local QString          funcPtrType;
+static thread_local QString          templateStr;
+static thread_local QString          aliasName;
+static thread_local QString          baseName;
+static thread_local QString         *specName;
+static thread_local QString          formulaText;
+static thread_local bool             useOverrideCommands = false;
+
+static thread_local SrcLangExt       language;
+
+static thread_local bool             insideIDL    = false;       //!< processing IDL code?
+static thread_local bool             insideJava   = false;       //!< processing Java code?
+static thread_local bool             insideCSharp = false;       //!< processing C# code?
+static thread_local bool             insideD      = false;       //!< processing D code?
+static thread_local bool             insidePHP    = false;       //!< processing PHP code?
+static thread_local bool             insideObjC   = false;       //!< processing Objective C code?
+static thread_local bool             insideCli    = false;       //!< processing C++/CLI code?
+static thread_local bool             insideJS     = false;       //!< processing JavaScript code?
+static thread_local bool             insideCpp    = true;        //!< processing C/C++ code
+
+static thread_local bool             insideCppQuote     = false;
+static thread_local bool             insideProtocolList = false;
+
+static thread_local bool             s_clangParser = false;
+
+static thread_local int              argRoundCount;
+static thread_local int              argSharpCount;
+static thread_local int              currentArgumentContext;
+static thread_local int              lastCopyArgStringContext;
+static thread_local int              lastCopyArgContext;
+
+static thread_local QString          *copyArgString;
+static thread_local QString          fullArgString;
+static thread_local ArgumentList     *currentArgumentList;
+static thread_local QChar            lastCopyArgChar;
+
+static thread_local QString          *pCopyQuotedString;
+static thread_local QString          *pCopyRoundString;
+static thread_local QString          *pCopyCurlyString;
+static thread_local QString          *pCopyRawString;
+
+static thread_local QString          *pCopyCurlyGString;
+static thread_local QString          *pCopyRoundGString;
+static thread_local QString          *pCopyQuotedGString;
+static thread_local QString          *pCopyHereDocGString;
+static thread_local QString          *pCopyRawGString;
+static thread_local QString          *pSkipVerbString;
+static thread_local QStack<Grouping *>  autoGroupStack;
+
+static thread_local bool             insideFormula;
+static thread_local bool             insideTryBlock = false;
+static thread_local bool             insideCode;
+static thread_local bool             needsSemi;
+static thread_local int              initBracketCount;
+
+static thread_local QString          oldStyleArgType;
+static thread_local QString          docBackup;
+static thread_local QString          briefBackup;
+
+static thread_local int              s_docBlockContext;
+static thread_local QString          s_docBlock;
+static thread_local QString          s_docBlockName;
+static thread_local bool             s_docBlockInBody;
+static thread_local bool             s_docBlockAutoBrief;
+static thread_local char             s_docBlockTerm;
+
+static thread_local QString          idlAttr;
+static thread_local QString          idlProp;
+static thread_local bool             odlProp;
+
+static thread_local bool             s_lexInit = false;
+static thread_local bool             externC;
+
+static thread_local QString          s_delimiter;
+
+static thread_local int              s_column;
+static thread_local int              s_fencedSize = 0;
+static thread_local bool             s_nestedComment = 0;
 
 // double declared
 static void yyunput (int c, char *buf_ptr);
@@ -12633,7 +12647,7 @@ static void splitKnRArg(QString &oldStyleArgPtr, QString &oldStyleArgName)
 
    if (oldStyleArgType.isEmpty()) {
       // new argument
-      static QRegExp re("\\([^)]*\\)");
+      static thread_local QRegExp re("\\([^)]*\\)");
 
       int bi1 = re.lastIndexIn(current->args);
       int bi2 = bi1 != -1 ? re.lastIndexIn(current->args, bi1 - 1) : -1;
@@ -15381,7 +15395,10 @@ YY_RULE_SETUP
       // TODO: namespace aliases are now treated as global entities
       // while they should be aware of the scope they are in
       QString text = QString::fromUtf8(cstyleYYtext);
-      Doxy_Globals::namespaceAliasDict.insert(aliasName, text);                
+
+      if (ScannerState::useShared()) {
+         Doxy_Globals::namespaceAliasDict.insert(aliasName, text);
+      }
    }
 	YY_BREAK
 case 136:
@@ -15440,8 +15457,10 @@ YY_RULE_SETUP
 {                 
       QString text = QString::fromUtf8(cstyleYYtext);   
       
-      Doxy_Globals::namespaceAliasDict.insert(text, 
-            removeRedundantWhiteSpace(substitute(aliasName,"\\","::")));
+      if (ScannerState::useShared()) {
+         Doxy_Globals::namespaceAliasDict.insert(text,
+               removeRedundantWhiteSpace(substitute(aliasName,"\\","::")));
+      }
 
       aliasName.resize(0);
    }
@@ -19296,7 +19315,7 @@ YY_RULE_SETUP
                   BEGIN( FindMembers ) ;
    
                } else {
-                  static QRegExp re("@[0-9]+$");
+                  static thread_local QRegExp re("@[0-9]+$");
    
                   if (! isTypedef && memspecEntry &&  re.indexIn(memspecEntry->name) == -1) {
                      // not typedef or anonymous type (see bug691071)      
@@ -19384,7 +19403,7 @@ YY_RULE_SETUP
 #line 5247 "parser_cstyle.l"
 { 
       /* typedef of anonymous type */
-      current->name = QString("@%1").arg(anonCount++);
+      current->name = nextAnonName();
 
       bool isEnum = current->m_traits.hasTrait(Entry::Virtue::Enum);
 
@@ -19489,7 +19508,7 @@ YY_RULE_SETUP
                if (p->name.at(pi)=='@') {
                   // anonymous compound inside -> insert dummy variable name         
             
-                  msName = QString("@%1").arg(anonCount++);
+                  msName = nextAnonName();
                   break;
                }
             }
@@ -21155,7 +21174,7 @@ YY_RULE_SETUP
       current->startLine   = yyBegLineNr;
       current->startColumn = yyBegColNr;
    
-      static QRegExp re("\\([^)]*[*&][^)]*\\)");       // (...*...)     
+      static thread_local QRegExp re("\\([^)]*[*&][^)]*\\)");       // (...*...)     
       
       if (text[0] !=';' || (current_root->section&Entry::COMPOUND_MASK) ) {
          int tempArg = current->name.indexOf('<');
@@ -22471,11 +22490,11 @@ YY_RULE_SETUP
 
             } else {
                // use invisible name            
-               current->name = QString("@%1").arg(anonNSCount);
+               current->name = QString("@%1").arg(ScannerState::useShared() ? anonNSCount.load() : 0);
             }
 
          } else {
-            current->name = QString("@%1").arg(anonCount++);
+            current->name = nextAnonName();
          }
       }
  
@@ -25534,7 +25553,10 @@ static void parseMain(const QString &fileName, const QString &fileBuf, QSharedPo
       parseCompounds(rt);
       s_inputFile.close();
 
-      anonNSCount++;      
+      // on a parse worker the file is counted by finishWorkerInput(), in the order of the input files
+      if (! ScannerState::isWorker()) {
+         anonNSCount.fetchAndAddRelaxed(1);
+      }
    } 
 }
 
@@ -25624,6 +25646,21 @@ void CPPLanguageParser::parseInput(const QString &fileName, const QString &fileB
    }
 }
 
+bool CPPLanguageParser::isThreadSafe() const
+{
+   return true;
+}
+
+void CPPLanguageParser::finishWorkerInput()
+{
+   anonNSCount.fetchAndAddRelaxed(1);
+}
+
+bool CPPLanguageParser::isCodeThreadSafe() const
+{
+   return true;
+}
+
 void CPPLanguageParser::parseCode(CodeOutputInterface &codeOutIntf, const QString &scopeName, const QString &input,
                   SrcLangExt lang, bool isExampleBlock, const QString &exampleName, QSharedPointer<FileDef> fileDef,
                   int startLine, int endLine, bool inlineFragment, QSharedPointer<MemberDef> memberDef,
@@ -726,6 +726,7 @@ char *tclscannerYYtext;
 
 #include <QFile>
 #include <QHash>
+#include <QMutex>
 #include <QRegExp>
 #include <QStringList>
 #include <QStack>
@@ -5374,6 +5375,10 @@ void TclLanguageParser::parseCode(CodeOutputInterface &codeOutIntf, const QStrin
       return;
    }
 
+   // the scanner state is global, code fragments on the pages written by other threads wait
+   static QMutex tclCodeLock;
+   QMutexLocker locker(&tclCodeLock);
+
    printlex(tclscannerYY_flex_debug, TRUE, __FILE__, fileDef ? qPrintable(fileDef->fileName()) : "" );
    tcl.input_string = input;
 
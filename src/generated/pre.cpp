@@ -194,9 +194,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int preYYleng;
+extern thread_local int preYYleng;
 
-extern FILE *preYYin, *preYYout;
+extern thread_local FILE *preYYin, *preYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -290,9 +290,9 @@ struct yy_buffer_state {
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -310,19 +310,19 @@ static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when preYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int preYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int preYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow preYYwrap()'s to do buffer switches
  * instead of setting up a fresh preYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void preYYrestart (FILE *input_file  );
 void preYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -377,15 +377,15 @@ void preYYfree (void *);
 
 typedef unsigned char YY_CHAR;
 
-FILE *preYYin = (FILE *) 0, *preYYout = (FILE *) 0;
+thread_local FILE *preYYin = (FILE *) 0, *preYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int preYYlineno;
+extern thread_local int preYYlineno;
 
-int preYYlineno = 1;
+thread_local int preYYlineno = 1;
 
-extern char *preYYtext;
+extern thread_local char *preYYtext;
 #define yytext_ptr preYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -2501,15 +2501,15 @@ static yyconst flex_int16_t yy_chk[6394] =
 
     } ;
 
-extern int preYY_flex_debug;
-int preYY_flex_debug = 0;
+extern thread_local int preYY_flex_debug;
+thread_local int preYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
+static thread_local yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
+static thread_local int yy_looking_for_trail_begin = 0;
+static thread_local int yy_full_lp;
+static thread_local int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
@@ -2526,12 +2526,13 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *preYYtext;
+thread_local char *preYYtext;
 
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QHash>
+#include <QMutex>
 #include <QRegExp>
 #include <QStringList>
 #include <QStack>
@@ -2655,6 +2656,8 @@ class DefineManager
          return;
       }
 
+      QMutexLocker locker(&m_mutex);
+
       DefinesPerFile *dpf = m_fileMap.value(fileName);
       if (dpf == nullptr) {        
          dpf = new DefinesPerFile;
@@ -2679,6 +2682,8 @@ class DefineManager
          return;
       }
 
+      QMutexLocker locker(&m_mutex);
+
       DefinesPerFile *dpf = m_fileMap.value(fileName);
 
       if (dpf == 0) {
@@ -2710,6 +2715,8 @@ class DefineManager
       }
       m_contextDefines.insert(def->m_name, def);
 
+      QMutexLocker locker(&m_mutex);
+
       DefinesPerFile *dpf = m_fileMap.value(fileName);
       if (dpf == 0) {
          dpf = new DefinesPerFile;
@@ -2727,6 +2734,8 @@ class DefineManager
          return;
       }
 
+      QMutexLocker locker(&m_mutex);
+
       DefinesPerFile *dpf = m_fileMap.value(fromFileName);
       if (dpf == 0) {
          dpf = new DefinesPerFile;
@@ -2761,6 +2770,7 @@ class DefineManager
          return;
       }
 
+      QMutexLocker locker(&m_mutex);
       DefinesPerFile *dpf = m_fileMap.value(fileName);
 
       if (dpf) {
@@ -2785,13 +2795,19 @@ class DefineManager
    virtual ~DefineManager() {
    }
 
+   // defines of all files preprocessed so far, shared by all threads
    QHash<QString, DefinesPerFile *> m_fileMap;
-   DefineDict m_contextDefines;
+   QMutex m_mutex;
+
+   // defines of the file each thread is preprocessing
+   static thread_local DefineDict m_contextDefines;
 };
 
 /** Singleton instance */
 DefineManager *DefineManager::theInstance = 0;
 
+thread_local DefineDict DefineManager::m_contextDefines;
+
 /** Collects all defines for a file and all files that the file includes.
  *  This function will recursively call itself for each file.
  *  @param dict The dictionary to fill with the defines. A redefine will
@@ -2828,63 +2844,112 @@ void DefineManager::DefinesPerFile::collectDefines(DefineDict &dict, QSet<QStrin
    }
 }
 
-static int                      g_yyLineNr   = 1;
-static int                      g_yyMLines   = 1;
-static int                      g_yyColNr    = 1;
-static QString                  g_yyFileName;
-static QSharedPointer<FileDef>  g_yyFileDef;
-static QSharedPointer<FileDef>  g_inputFileDef;
-static int                      g_ifcount   = 0;
-static int                      g_defArgs   = -1;
+static thread_local int                      g_yyLineNr   = 1;
+static thread_local int                      g_yyMLines   = 1;
+static thread_local int                      g_yyColNr    = 1;
+static thread_local QString                  g_yyFileName;
+static thread_local QSharedPointer<FileDef>  g_yyFileDef;
+static thread_local QSharedPointer<FileDef>  g_inputFileDef;
+static thread_local int                      g_ifcount   = 0;
+static thread_local int                      g_defArgs   = -1;
 
 static QStringList              g_pathList;
-static QStack<FileState *>      g_includeStack;
-static QHash<QString, int *>   *g_argDict;
-
-
-static QString            g_defName;
-static QString            g_defText;
-static QString            g_defLitText;
-static QString            g_defArgsStr;
-static QString            g_defExtraSpacing;
-static bool               g_defVarArgs;
-static int                g_lastCContext;
-static int                g_lastCPPContext;
-static QStack<int>        g_levelGuard;
-static QString            g_inputBuf;
-static int                g_inputBufPos;
-static QString            g_outputBuf;
-static int                g_roundCount;
-static bool               g_quoteArg;
-
-static QSharedPointer<DefineDict>   g_expandedDict;
-
-static int                g_findDefArgContext;
-static bool               g_expectGuard;
-static QString            g_guardName;
-static QString            g_lastGuardName;
-static QString            g_incName;
-static QString            g_guardExpr;
-static int                g_curlyCount;
-static bool               g_nospaces;          // add extra spaces during macro expansion
-
-static bool               g_macroExpansion;    // from the configuration
-static bool               g_expandOnlyPredef;  // from the configuration
-static int                g_commentCount;
-static bool               g_insideComment;
-static bool               g_isImported;
-static QString            g_blockName;
-static int                g_condCtx;
-static bool               g_skip;
-
-static bool               g_insideCS; // C# has simpler preprocessor
-static bool               g_isSource;
-
-static bool               g_lexInit   = false;
-static int                g_fenceSize = 0;
-static bool               g_ccomment;
-
-static QStack<QSharedPointer<CondCtx>>  g_condStack;
+static thread_local QStack<FileState *>      g_includeStack;
+static thread_local QHash<QString, int *>   *g_argDict;
+
+
+static thread_local QString            g_defName;
+static thread_local QString            g_defText;
+static thread_local QString            g_defLitText;
+static thread_local QString            g_defArgsStr;
+static thread_local QString            g_defExtraSpacing;
+static thread_local bool               g_defVarArgs;
+static thread_local int                g_lastCContext;
+static thread_local int                g_lastCPPContext;
+static thread_local QStack<int>        g_levelGuard;
+static thread_local QString            g_inputBuf;
+static thread_local int                g_inputBufPos;
+static thread_local QString            g_outputBuf;
+static thread_local int                g_roundCount;
+static thread_local bool               g_quoteArg;
+
+static thread_local QSharedPointer<DefineDict>   g_expandedDict;
+
+static thread_local int                g_findDefArgContext;
+static thread_local bool               g_expectGuard;
+static thread_local QString            g_guardName;
+static thread_local QString            g_lastGuardName;
+static thread_local QString            g_incName;
+static thread_local QString            g_guardExpr;
+static thread_local int                g_curlyCount;
+static thread_local bool               g_nospaces;          // add extra spaces during macro expansion
+
+static thread_local bool               g_macroExpansion;    // from the configuration
+static thread_local bool               g_expandOnlyPredef;  // from the configuration
+static thread_local int                g_commentCount;
+static thread_local bool               g_insideComment;
+static thread_local bool               g_isImported;
+static thread_local QString            g_blockName;
+static thread_local int                g_condCtx;
+static thread_local bool               g_skip;
+
+static thread_local bool               g_insideCS; // C# has simpler preprocessor
+static thread_local bool               g_isSource;
+
+static thread_local bool               g_lexInit   = false;
+static thread_local int                g_fenceSize = 0;
+static thread_local bool               g_ccomment;
+
+static thread_local QStack<QSharedPointer<CondCtx>>  g_condStack;
+
+// the preprocessor may run on a pipeline thread, defines and include dependencies are
+// recorded and added to the symbol tables by applyPreprocessorResults() on the main thread
+struct PreDefineInfo {
+   QString fileName;
+   int     lineNr;
+   int     colNr;
+   QString name;
+   QString args;
+   QString litText;
+
+   QSharedPointer<FileDef> inputFileDef;
+   QSharedPointer<FileDef> fileDef;
+};
+
+struct PreIncludeInfo {
+   QSharedPointer<FileDef> fileDef;        // file which gets the dependency
+   QSharedPointer<FileDef> incFileDef;
+   QString incName;
+   bool    local;
+   bool    imported;
+   bool    indirect;
+   bool    includedBy;                     // true for an included by dependency
+};
+
+struct PreFileResults {
+   QList<PreDefineInfo>  defines;
+   QList<PreIncludeInfo> includes;
+};
+
+static thread_local PreFileResults                  g_results;          // results of the file this thread preprocesses
+static QHash<QString, PreFileResults>  g_pendingResults;
+static QMutex                          g_resultsLock;
+
+static void addIncludeInfo(QSharedPointer<FileDef> fd, QSharedPointer<FileDef> incFd, const QString &incName,
+                  bool local, bool imported, bool indirect, bool includedBy)
+{
+   PreIncludeInfo info;
+
+   info.fileDef    = fd;
+   info.incFileDef = incFd;
+   info.incName    = incName;
+   info.local      = local;
+   info.imported   = imported;
+   info.indirect   = indirect;
+   info.includedBy = includedBy;
+
+   g_results.includes.append(info);
+}
 
 static void setFileName(const QString &name)
 {
@@ -2941,7 +3006,9 @@ static void setCaseDone(bool value)
    g_levelGuard.top() = value;
 }
 
+// global include guard, shared by all threads
 static QSet<QString> g_allIncludes;
+static QMutex        g_allIncludesLock;
 
 static FileState *checkAndOpenFile(const QString &fileName, bool &alreadyIncluded)
 {
@@ -2961,6 +3028,7 @@ static FileState *checkAndOpenFile(const QString &fileName, bool &alreadyInclude
 
       // global guard
       if (g_curlyCount == 0) { // not #include inside { ... }
+         QMutexLocker locker(&g_allIncludesLock);
 
          if (g_allIncludes.contains(absName)) {
             alreadyIncluded = true;           
@@ -3942,17 +4010,6 @@ void addDefine()
       return;
    }
   
-   QSharedPointer<MemberDef> md = QMakeShared<MemberDef>(g_yyFileName, g_yyLineNr - g_yyMLines, g_yyColNr,
-               "#define", g_defName, g_defArgsStr, nullptr, Public, Normal, false, Member, 
-               MemberType_Define, nullptr, nullptr);
-
-   if (! g_defArgsStr.isEmpty()) {
-      ArgumentList *argList = new ArgumentList;
-      
-      stringToArgumentList(g_defArgsStr, argList);
-      md->setArgumentList(argList);
-   }
-  
    int l = g_defLitText.indexOf('\n');
 
    if (l > 0 && g_defLitText.left(l).trimmed() == "\\") {
@@ -3972,23 +4029,19 @@ void addDefine()
 
       g_defLitText = g_defLitText.mid(l + 1, k - l - 1) + g_defLitText.trimmed();
    }
-   md->setInitializer(g_defLitText.trimmed());
- 
-   md->setFileDef(g_inputFileDef);
-   md->setDefinition("#define " + g_defName);
 
-   QSharedPointer<MemberName> mn = Doxy_Globals::functionNameSDict->find(g_defName);
+   PreDefineInfo info;
 
-   if (! mn) {
-      mn = QMakeShared<MemberName>(g_defName);
-      Doxy_Globals::functionNameSDict->insert(g_defName, mn);
-   }
+   info.fileName     = g_yyFileName;
+   info.lineNr       = g_yyLineNr - g_yyMLines;
+   info.colNr        = g_yyColNr;
+   info.name         = g_defName;
+   info.args         = g_defArgsStr;
+   info.litText      = g_defLitText.trimmed();
+   info.inputFileDef = g_inputFileDef;
+   info.fileDef      = g_yyFileDef;
 
-   mn->append(md);
-
-   if (g_yyFileDef) {
-      g_yyFileDef->insertMember(md);
-   }
+   g_results.defines.append(info);
 }
 
 static inline void outputChar(QChar c)
@@ -4106,15 +4159,15 @@ static void readIncludeFile(const QString &inc)
                temp = incFd;
             }
 
-            oldFileDef->addIncludeDependency(temp, incFileName, localInclude, g_isImported, false);
+            addIncludeInfo(oldFileDef, temp, incFileName, localInclude, g_isImported, false, false);
 
             // add included by dependency
             if (g_yyFileDef) {              
-               g_yyFileDef->addIncludedByDependency(oldFileDef, oldFileDef->docName(), localInclude, g_isImported);
+               addIncludeInfo(g_yyFileDef, oldFileDef, oldFileDef->docName(), localInclude, g_isImported, false, true);
             }
 
          } else if (g_inputFileDef) {
-            g_inputFileDef->addIncludeDependency(QSharedPointer<FileDef>(), absIncFileName, localInclude, g_isImported, true);
+            addIncludeInfo(g_inputFileDef, QSharedPointer<FileDef>(), absIncFileName, localInclude, g_isImported, true, false);
 
          }
 
@@ -4148,15 +4201,15 @@ static void readIncludeFile(const QString &inc)
             QSharedPointer<FileDef> fd = findFileDef(Doxy_Globals::inputNameDict, absIncFileName, ambig);
          
             // add include dependency to the file in which the #include was found
-            oldFileDef->addIncludeDependency(ambig ? QSharedPointer<FileDef>() : fd, incFileName, localInclude, g_isImported, false);
+            addIncludeInfo(oldFileDef, ambig ? QSharedPointer<FileDef>() : fd, incFileName, localInclude, g_isImported, false, false);
 
             // add included by dependency
             if (fd) {               
-               fd->addIncludedByDependency(oldFileDef, oldFileDef->docName(), localInclude, g_isImported);
+               addIncludeInfo(fd, oldFileDef, oldFileDef->docName(), localInclude, g_isImported, false, true);
             }
 
          } else if (g_inputFileDef) {
-            g_inputFileDef->addIncludeDependency(QSharedPointer<FileDef>(), absIncFileName, localInclude, g_isImported, true);
+            addIncludeInfo(g_inputFileDef, QSharedPointer<FileDef>(), absIncFileName, localInclude, g_isImported, true, false);
          }
 
          if (Debug::isFlagSet(Debug::Preprocessor)) {
@@ -7878,6 +7931,9 @@ void initPreprocessor()
 {   
    addSearchDir(".");
    g_expandedDict = QMakeShared<DefineDict>();
+
+   // created before any thread preprocesses a file
+   DefineManager::instance();
 }
 
 void removePreProcessor()
@@ -7904,9 +7960,17 @@ QString preprocessFile(const QString &fileName, const QString &input)
    g_outputBuf   = "";
 
    g_includeStack.clear();
+
+   if (! g_expandedDict) {
+      // first file preprocessed by this thread
+      g_expandedDict = QMakeShared<DefineDict>();
+   }
+
    g_expandedDict->clear();
    g_condStack.clear();
 
+   g_results = PreFileResults();
+
    uint orgOffset = 0;
 
    setFileName(fileName);
@@ -8105,11 +8169,76 @@ QString preprocessFile(const QString &fileName, const QString &input)
    DefineManager::instance().endContext();
    printlex(preYY_flex_debug, false, __FILE__, qPrintable(fileName));
 
+   {
+      QMutexLocker resultsLocker(&g_resultsLock);
+      PreFileResults &pending = g_pendingResults[fileName];
+
+      pending.defines.append(g_results.defines);
+      pending.includes.append(g_results.includes);
+   }
+
+   g_results = PreFileResults();
+
    return g_outputBuf;
 }
 
+void applyPreprocessorResults(const QString &fileName)
+{
+   PreFileResults results;
+
+   {
+      QMutexLocker locker(&g_resultsLock);
+      results = g_pendingResults.take(fileName);
+   }
+
+   for (const auto &info : results.defines) {
+      QSharedPointer<MemberDef> md = QMakeShared<MemberDef>(info.fileName, info.lineNr, info.colNr,
+                  "#define", info.name, info.args, nullptr, Public, Normal, false, Member,
+                  MemberType_Define, nullptr, nullptr);
+
+      if (! info.args.isEmpty()) {
+         ArgumentList *argList = new ArgumentList;
+
+         stringToArgumentList(info.args, argList);
+         md->setArgumentList(argList);
+      }
+
+      md->setInitializer(info.litText);
+      md->setFileDef(info.inputFileDef);
+      md->setDefinition("#define " + info.name);
+
+      QSharedPointer<MemberName> mn = Doxy_Globals::functionNameSDict->find(info.name);
+
+      if (! mn) {
+         mn = QMakeShared<MemberName>(info.name);
+         Doxy_Globals::functionNameSDict->insert(info.name, mn);
+      }
+
+      mn->append(md);
+
+      if (info.fileDef) {
+         info.fileDef->insertMember(md);
+      }
+   }
+
+   for (const auto &info : results.includes) {
+      if (info.includedBy) {
+         info.fileDef->addIncludedByDependency(info.incFileDef, info.incName, info.local, info.imported);
+      } else {
+         info.fileDef->addIncludeDependency(info.incFileDef, info.incName, info.local, info.imported, info.indirect);
+      }
+   }
+}
+
+void discardPreprocessorResults(const QString &fileName)
+{
+   QMutexLocker locker(&g_resultsLock);
+   g_pendingResults.remove(fileName);
+}
+
 void preFreeScanner()
 {
+   // releases the scanner of the calling thread
    if (g_lexInit) {
       preYYlex_destroy();
    }
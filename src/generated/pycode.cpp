@@ -194,9 +194,9 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int pycodeYYleng;
+extern thread_local int pycodeYYleng;
 
-extern FILE *pycodeYYin, *pycodeYYout;
+extern thread_local FILE *pycodeYYin, *pycodeYYout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -290,9 +290,9 @@ struct yy_buffer_state {
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -310,19 +310,19 @@ static YY_BUFFER_STATE *yy_buffer_stack = 0;  /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when pycodeYYtext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int pycodeYYleng;
+static thread_local char yy_hold_char;
+static thread_local int yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local int pycodeYYleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow pycodeYYwrap()'s to do buffer switches
  * instead of setting up a fresh pycodeYYin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 
 void pycodeYYrestart (FILE *input_file  );
 void pycodeYY_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
@@ -377,15 +377,15 @@ void pycodeYYfree (void *);
 
 typedef unsigned char YY_CHAR;
 
-FILE *pycodeYYin = (FILE *) 0, *pycodeYYout = (FILE *) 0;
+thread_local FILE *pycodeYYin = (FILE *) 0, *pycodeYYout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int pycodeYYlineno;
+extern thread_local int pycodeYYlineno;
 
-int pycodeYYlineno = 1;
+thread_local int pycodeYYlineno = 1;
 
-extern char *pycodeYYtext;
+extern thread_local char *pycodeYYtext;
 #define yytext_ptr pycodeYYtext
 
 static yy_state_type yy_get_previous_state (void );
@@ -1121,15 +1121,15 @@ static yyconst flex_int16_t yy_chk[1671] = {
    504,  504,  504,  504,  504,  504,  504,  504,  504,  504
 } ;
 
-extern int pycodeYY_flex_debug;
-int pycodeYY_flex_debug = 0;
+extern thread_local int pycodeYY_flex_debug;
+thread_local int pycodeYY_flex_debug = 0;
 
-static yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
+static thread_local yy_state_type *yy_state_buf = 0, *yy_state_ptr = 0;
+static thread_local char *yy_full_match;
+static thread_local int yy_lp;
+static thread_local int yy_looking_for_trail_begin = 0;
+static thread_local int yy_full_lp;
+static thread_local int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
@@ -1146,7 +1146,7 @@ goto find_rule; \
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *pycodeYYtext;
+thread_local char *pycodeYYtext;
 
 #include <QStack>
 #include <QSharedPointer>
@@ -1171,46 +1171,46 @@ char *pycodeYYtext;
 #define YY_NEVER_INTERACTIVE 1
 #define YY_NO_INPUT 1
 
-static ClassSDict     g_codeClassSDict;
-static QString        g_curClassName;
-static QStringList    g_curClassBases;
+static thread_local ClassSDict     g_codeClassSDict;
+static thread_local QString        g_curClassName;
+static thread_local QStringList    g_curClassBases;
 
-static CodeOutputInterface *g_code;
+static thread_local CodeOutputInterface *g_code;
 
-static QString       g_inputString;     //!< the code fragment as text
-static int	         g_inputPosition;   //!< read offset during parsing
-static QString       g_currentFontClass;
-static bool          g_needsTermination;
+static thread_local QString       g_inputString;     //!< the code fragment as text
+static thread_local int	         g_inputPosition;   //!< read offset during parsing
+static thread_local QString       g_currentFontClass;
+static thread_local bool          g_needsTermination;
 
-static QSharedPointer<Definition>   g_searchCtx;
+static thread_local QSharedPointer<Definition>   g_searchCtx;
 
-static bool          g_collectXRefs;
-static int           g_inputLines;      //!< number of line in the code fragment
-static int	         g_yyLineNr;        //!< current line number
+static thread_local bool          g_collectXRefs;
+static thread_local int           g_inputLines;      //!< number of line in the code fragment
+static thread_local int	         g_yyLineNr;        //!< current line number
 
-static QSharedPointer<FileDef>      g_sourceFileDef;
-static QSharedPointer<Definition>   g_currentDefinition;    
-static QSharedPointer<MemberDef>    g_currentMemberDef;   
+static thread_local QSharedPointer<FileDef>      g_sourceFileDef;
+static thread_local QSharedPointer<Definition>   g_currentDefinition;    
+static thread_local QSharedPointer<MemberDef>    g_currentMemberDef;   
 
-static bool          g_includeCodeFragment;
-static QString       g_realScope;
+static thread_local bool          g_includeCodeFragment;
+static thread_local QString       g_realScope;
 
-static int           g_bodyCurlyCount;
-static bool          g_searchingForBody;
-static QString       g_classScope;
-static int           g_paramParens;
+static thread_local int           g_bodyCurlyCount;
+static thread_local bool          g_searchingForBody;
+static thread_local QString       g_classScope;
+static thread_local int           g_paramParens;
 
-static bool          g_exampleBlock;
-static QString       g_exampleName;
-static QString       g_type;
-static QString       g_name;
+static thread_local bool          g_exampleBlock;
+static thread_local QString       g_exampleName;
+static thread_local QString       g_type;
+static thread_local QString       g_name;
 
-static bool          g_doubleStringIsDoc;
-static bool          g_doubleQuote;
-static bool          g_noSuiteFound;
-static int           g_stringContext;
+static thread_local bool          g_doubleStringIsDoc;
+static thread_local bool          g_doubleQuote;
+static thread_local bool          g_noSuiteFound;
+static thread_local int           g_stringContext;
 
-static QStack<uint>  g_indents;  //!< Tracks indentation levels for scoping in python
+static thread_local QStack<uint>  g_indents;  //!< Tracks indentation levels for scoping in python
 
 static void endFontClass();
 static void adjustScopesAndSuites(unsigned indentLength);
@@ -1322,7 +1322,7 @@ QSharedPointer<ClassDef> PyVariableContext::findVariable(const QString &name)
    return result;
 }
 
-static PyVariableContext g_theVarContext;
+static thread_local PyVariableContext g_theVarContext;
 
 class PyCallContext
 {
@@ -1386,7 +1386,7 @@ class PyCallContext
    QList<Ctx *> m_classList;
 };
 
-static PyCallContext g_theCallContext;
+static thread_local PyCallContext g_theCallContext;
 
 
 /*! counts the number of lines in the input */
@@ -1887,16 +1887,12 @@ static bool findMemberLink(CodeOutputInterface &ol, QSharedPointer<Definition> d
 static void findMemberLink(CodeOutputInterface &ol, const QString &phrase)
 {   
    if (g_currentDefinition) { 
-      auto iter = Doxy_Globals::glossary().find(phrase);
-
-      while (iter != Doxy_Globals::glossary().end() && iter.key() == phrase) {               
-         QSharedPointer<Definition> def = sharedFrom(iter.value());
+      for (auto item : Doxy_Globals::glossary().definitions(phrase)) {
+         QSharedPointer<Definition> def = sharedFrom(item);
 
          if (findMemberLink(ol, def, phrase)) {
             return;            
          }   
-
-         ++iter;      
       }
    }
    
@@ -0,0 +1,382 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSet>
+#include <QTextStream>
+
+#include <graphcache.h>
+
+#include <algorithm>
+
+#include <config.h>
+#include <message.h>
+#include <portable.h>
+
+static const QString s_indexName = "graphcache.index";
+static const QString s_lockName  = "graphcache.lock";
+
+/** Returns true if \a name is a cached graph, not the index or a file which is being written */
+static bool isCacheFile(const QString &name)
+{
+   return name != s_indexName && ! name.endsWith(".tmp");
+}
+
+/** Returns the absolute path of \a program, searches the PATH if required */
+static QString findProgram(const QString &program)
+{
+   QFileInfo fi(program);
+
+   if (fi.isAbsolute()) {
+      return program;
+   }
+
+   const QStringList pathList = portable_getenv("PATH").split(portable_pathListSeparator());
+
+   for (const auto &path : pathList) {
+      QFileInfo exe(path + "/" + program);
+
+      if (exe.exists() && exe.isFile()) {
+         return exe.absoluteFilePath();
+      }
+   }
+
+   return program;
+}
+
+GraphCache *GraphCache::instance()
+{
+   static GraphCache theInstance;
+   return &theInstance;
+}
+
+GraphCache::GraphCache()
+   : m_enabled(false), m_maxSize(0), m_useCounter(0), m_openCounter(0), m_hits(0), m_misses(0)
+{
+}
+
+void GraphCache::open()
+{
+   QMutexLocker locker(&m_mutex);
+
+   QString dirName = Config::getString("dot-cache-dir");
+
+   if (dirName.isEmpty() || ! Config::getBool("have-dot")) {
+      return;
+   }
+
+   QDir dir(dirName);
+
+   if (! dir.exists() && ! dir.mkpath(dirName)) {
+      err("Unable to create graph cache directory %s\n", csPrintable(dirName));
+      return;
+   }
+
+   m_dirName = dir.absolutePath();
+   m_maxSize = qMax(1, Config::getInt("dot-cache-size")) * 1024LL * 1024LL;
+   m_enabled = true;
+
+   // a different version of dot may produce different output
+   QFileInfo dotExe(findProgram(Config::getString("dot-path")));
+   QString dotId = dotExe.absoluteFilePath() + " " + QString::number(dotExe.size()) + " " +
+                  dotExe.lastModified().toString(Qt::ISODate);
+
+   m_dotHash = QCryptographicHash::hash(dotId.toUtf8(), QCryptographicHash::Md5);
+
+   // index lists the files in order of their last use, files not in the index are the oldest
+   for (const auto &fi : dir.entryInfoList(QDir::Files)) {
+      if (isCacheFile(fi.fileName())) {
+         CacheItem item;
+         item.lastUse = 0;
+         item.size    = fi.size();
+
+         m_items.insert(fi.fileName(), item);
+      }
+   }
+
+   for (const auto &name : readIndex()) {
+      auto iter = m_items.find(name);
+
+      if (iter != m_items.end()) {
+         iter.value().lastUse = ++m_useCounter;
+      }
+   }
+
+   // files used by this run have a larger counter
+   m_openCounter = m_useCounter;
+}
+
+QStringList GraphCache::readIndex() const
+{
+   QStringList retval;
+   QFile f(m_dirName + "/" + s_indexName);
+
+   if (f.open(QIODevice::ReadOnly)) {
+      QTextStream t(&f);
+
+      while (! t.atEnd()) {
+         retval.append(t.readLine());
+      }
+   }
+
+   return retval;
+}
+
+bool GraphCache::lockIndex() const
+{
+   // creating a directory is atomic, also when the cache is on a network drive
+   QDir dir(m_dirName);
+
+   for (int i = 0; i < 300; ++i) {
+      if (dir.mkdir(s_lockName)) {
+         return true;
+      }
+
+      QFileInfo fi(dir.filePath(s_lockName));
+
+      if (fi.exists() && fi.lastModified().secsTo(QDateTime::currentDateTime()) > 60) {
+         // left by a run which was stopped while it held the lock
+         dir.rmdir(s_lockName);
+         continue;
+      }
+
+      portable_sleep(100);
+   }
+
+   return false;
+}
+
+void GraphCache::unlockIndex() const
+{
+   QDir(m_dirName).rmdir(s_lockName);
+}
+
+void GraphCache::close()
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (! m_enabled) {
+      return;
+   }
+
+   m_enabled = false;
+
+   // other runs sharing the cache may have added or removed files and written the index since open()
+   if (! lockIndex()) {
+      err("Unable to lock graph cache directory %s, the index is not updated\n", csPrintable(m_dirName));
+      return;
+   }
+
+   QDir dir(m_dirName);
+   QHash<QString, qint64> sizes;
+
+   for (const auto &fi : dir.entryInfoList(QDir::Files)) {
+      if (isCacheFile(fi.fileName())) {
+         sizes.insert(fi.fileName(), fi.size());
+      }
+   }
+
+   // files used by this run, the least recently used first
+   QList<QPair<qint64, QString>> used;
+   QSet<QString> usedNames;
+
+   for (auto iter = m_items.begin(); iter != m_items.end(); ++iter) {
+      if (iter.value().lastUse > m_openCounter) {
+         used.append(qMakePair(iter.value().lastUse, iter.key()));
+         usedNames.insert(iter.key());
+      }
+   }
+
+   std::sort(used.begin(), used.end());
+
+   // merge with the index on disk, files which are in no index are the oldest
+   const QStringList indexed = readIndex();
+   QSet<QString> indexedNames;
+
+   for (const auto &name : indexed) {
+      indexedNames.insert(name);
+   }
+
+   QStringList order;
+
+   for (auto iter = sizes.begin(); iter != sizes.end(); ++iter) {
+      if (! indexedNames.contains(iter.key()) && ! usedNames.contains(iter.key())) {
+         order.append(iter.key());
+      }
+   }
+
+   std::sort(order.begin(), order.end());
+
+   for (const auto &name : indexed) {
+      if (sizes.contains(name) && ! usedNames.contains(name)) {
+         order.append(name);
+      }
+   }
+
+   for (const auto &item : used) {
+      if (sizes.contains(item.second)) {
+         order.append(item.second);
+      }
+   }
+
+   qint64 totalSize = 0;
+
+   for (auto size : sizes) {
+      totalSize += size;
+   }
+
+   // remove the least recently used files
+   int index = 0;
+
+   while (totalSize > m_maxSize && index < order.count()) {
+      const QString &name = order.at(index);
+
+      totalSize -= sizes.value(name);
+      dir.remove(name);
+
+      ++index;
+   }
+
+   // readers of the index never see a partial file
+   QString tempName = s_indexName + ".tmp";
+   QFile f(m_dirName + "/" + tempName);
+
+   if (f.open(QIODevice::WriteOnly)) {
+      QTextStream t(&f);
+
+      for (; index < order.count(); ++index) {
+         t << order.at(index) << "\n";
+      }
+
+      t.flush();
+      f.close();
+
+      dir.remove(s_indexName);
+
+      if (! dir.rename(tempName, s_indexName)) {
+         err("Unable to rename file %s to %s\n", csPrintable(tempName), csPrintable(s_indexName));
+      }
+
+   } else {
+      err("Unable to open file for writing %s, error: %d\n", csPrintable(f.fileName()), f.error());
+   }
+
+   unlockIndex();
+}
+
+QByteArray GraphCache::key(const QString &dotFile) const
+{
+   QFile f(dotFile);
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      return QByteArray();
+   }
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   hash.addData(m_dotHash);
+   hash.addData(f.readAll());
+
+   return hash.result().toHex();
+}
+
+QString GraphCache::fileName(const QByteArray &key, const QString &format) const
+{
+   // renderer variants like png:cairo are part of the format
+   QString ext = format;
+   ext.replace(':', '_');
+
+   return QString::fromLatin1(key) + "." + ext;
+}
+
+bool GraphCache::fetch(const QByteArray &key, const QString &format, const QString &output)
+{
+   QString name = fileName(key, format);
+
+   {
+      QMutexLocker locker(&m_mutex);
+
+      auto iter = m_items.find(name);
+
+      if (iter == m_items.end()) {
+         ++m_misses;
+         return false;
+      }
+
+      iter.value().lastUse = ++m_useCounter;
+   }
+
+   QDir().remove(output);
+
+   if (! QFile::copy(m_dirName + "/" + name, output)) {
+      QMutexLocker locker(&m_mutex);
+      ++m_misses;
+
+      return false;
+   }
+
+   QMutexLocker locker(&m_mutex);
+   ++m_hits;
+
+   return true;
+}
+
+void GraphCache::store(const QByteArray &key, const QString &format, const QString &output)
+{
+   QString name     = fileName(key, format);
+   QString tempName = m_dirName + "/" + name + ".tmp";
+
+   // copy under a temporary name, other processes sharing the cache never see a partial file
+   QDir dir(m_dirName);
+   dir.remove(tempName);
+
+   if (! QFile::copy(output, tempName)) {
+      return;
+   }
+
+   dir.remove(name);
+
+   if (! dir.rename(tempName, name)) {
+      dir.remove(tempName);
+      return;
+   }
+
+   QMutexLocker locker(&m_mutex);
+
+   CacheItem item;
+   item.lastUse = ++m_useCounter;
+   item.size    = QFileInfo(output).size();
+
+   m_items.insert(name, item);
+}
+
+int GraphCache::hits() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_hits;
+}
+
+int GraphCache::misses() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_misses;
+}
@@ -0,0 +1,97 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef GRAPHCACHE_H
+#define GRAPHCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+/** @brief Cache of rendered graphs which can be shared by several output directories and runs.
+ *
+ *  When dot-cache-dir is set the images and maps produced by dot are copied to
+ *  this directory. The key is the hash of the graph text, the output format and
+ *  the dot executable. When the same graph is rendered again the output is copied
+ *  from the cache instead of running dot. The least recently used files are removed
+ *  when the cache grows beyond dot-cache-size megabytes. All methods are thread safe.
+ *
+ *  Several runs may share the cache directory. The index is merged with the one on disk
+ *  under a lock when the cache is closed.
+ */
+class GraphCache
+{
+ public:
+   static GraphCache *instance();
+
+   void open();
+
+   /** Merges the index with the one on disk, removes the least recently used files which do not fit */
+   void close();
+
+   bool isEnabled() const {
+      return m_enabled;
+   }
+
+   /** Returns the key for the graph in \a dotFile, an empty key if the file can not be read */
+   QByteArray key(const QString &dotFile) const;
+
+   /** Copies the cached output for \a key and \a format to \a output, returns false on a miss */
+   bool fetch(const QByteArray &key, const QString &format, const QString &output);
+
+   /** Adds the file \a output, which was rendered for \a key and \a format */
+   void store(const QByteArray &key, const QString &format, const QString &output);
+
+   int hits() const;
+   int misses() const;
+
+ private:
+   GraphCache();
+
+   struct CacheItem {
+      qint64 lastUse;
+      qint64 size;
+   };
+
+   QString fileName(const QByteArray &key, const QString &format) const;
+
+   /** Returns the names in the index on disk, the least recently used first */
+   QStringList readIndex() const;
+
+   /** Locks the index against other runs, returns false if the lock was not obtained within 30 seconds */
+   bool lockIndex() const;
+   void unlockIndex() const;
+
+   bool    m_enabled;
+   QString m_dirName;
+
+   QByteArray m_dotHash;
+
+   qint64 m_maxSize;
+   qint64 m_useCounter;
+   qint64 m_openCounter;
+
+   int m_hits;
+   int m_misses;
+
+   QHash<QString, CacheItem> m_items;
+   mutable QMutex m_mutex;
+};
+
+#endif
@@ -20,6 +20,7 @@
 #include <ctype.h>
 
 #include <arguments.h>
+#include <buildstate.h>
 #include <config.h>
 #include <classdef.h>
 #include <doxy_globals.h>
@@ -1033,6 +1034,8 @@ void GroupDef::writeDocumentation(OutputList &ol)
 {
    QSharedPointer<GroupDef> self = sharedFrom(this);
 
+   BuildState::addDependency(getDefFileName());
+
    // static bool generateTreeView = Config::getBool("generate-treeview");
 
    ol.pushGeneratorState();
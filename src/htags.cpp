@@ -25,6 +25,7 @@
 #include <config.h>
 #include <message.h>
 #include <portable.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 bool Htags::useHtags = false;
@@ -99,7 +100,7 @@ bool Htags::execute(const QString &htmldir)
   
    portable_sysTimerStart();
 
-   bool result = portable_system("htags", commandLine, false) == 0;
+   bool result = ToolExecutor::instance()->run("htags", "htags", commandLine, false) == 0;
    portable_sysTimerStop();
 
    QDir::setCurrent(oldDir);
@@ -32,6 +32,7 @@
 #include <outputgen.h>
 #include <parser_base.h>
 #include <plantuml.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 static const int NUM_HTML_LIST_TYPES = 4;
@@ -138,8 +139,8 @@ static QString htmlAttribsToString(const HtmlAttribList &attribs)
    return result;
 }
 
-HtmlDocVisitor::HtmlDocVisitor(QTextStream &t, CodeOutputInterface &ci, QSharedPointer<Definition> ctx)
-   : DocVisitor(DocVisitor_Html), m_t(t), m_ci(ci), m_insidePre(false), m_hide(false), m_ctx(ctx)
+HtmlDocVisitor::HtmlDocVisitor(QTextStream &t, CodeOutputInterface &ci, QSharedPointer<Definition> ctx, const QString &fileName)
+   : DocVisitor(DocVisitor_Html), m_t(t), m_ci(ci), m_insidePre(false), m_hide(false), m_ctx(ctx), m_fileName(fileName)
 {
    if (ctx) {
       m_langExt = ctx->getDefFileExtension();
@@ -423,23 +424,11 @@ void HtmlDocVisitor::visit(DocVerbatim *s)
          break;
 
       case DocVerbatim::Dot: {
-         static int dotindex = 1;
-
          forceEndParagraph(s);
 
-         QString fileName;
-         fileName = QString("%1%2.dot").arg(Config::getString("html-output") + "/inline_dotgraph_").arg(dotindex++);
-
-         QFile file(fileName);
-
-         if (! file.open(QIODevice::WriteOnly)) {
-            err("Unable to open file for writing %s, error: %d\n", csPrintable(fileName), file.error());      
+         QString fileName = inlineGraphBaseName(Config::getString("html-output"), "inline_dotgraph_", s->text()) + ".dot";
 
-         } else {
-
-            file.write(s->text().toUtf8());
-            file.close();
-               
+         if (writeInlineGraphFile(fileName, s->text().toUtf8())) {
             m_t << "<div align=\"center\">" << endl;
    
             writeDotFile(fileName, s->relPath(), s->context());
@@ -451,8 +440,9 @@ void HtmlDocVisitor::visit(DocVerbatim *s)
             m_t << "</div>" << endl;            
    
             if (Config::getBool("dot-cleanup")) {
-               file.remove();
-            }            
+               // another page may show the same graph
+               ToolExecutor::instance()->removeWhenDone(fileName);
+            }
          }
 
          forceStartParagraph(s);
@@ -463,24 +453,13 @@ void HtmlDocVisitor::visit(DocVerbatim *s)
       case DocVerbatim::Msc: {
          forceEndParagraph(s);
 
-         static int mscindex = 1;
+         QString baseName = inlineGraphBaseName(Config::getString("html-output"), "inline_mscgraph_", s->text());
 
-         QString baseName;
-         baseName = QString("%1%2").arg(Config::getString("html-output") + "/inline_mscgraph_").arg(mscindex++);
+         QString text = "msc {";
+         text += s->text();
+         text += "}";
 
-         QFile file(baseName + ".msc");
-
-         if (! file.open(QIODevice::WriteOnly)) {       
-            err("Unable to open file for writing %s.msc error: %d\n", csPrintable(baseName), file.error()); 
-
-         } else {
-            QString text = "msc {";
-            text += s->text();
-            text += "}";
-   
-            file.write( text.toUtf8() );
-            file.close();
-   
+         if (writeInlineGraphFile(baseName + ".msc", text.toUtf8())) {
             m_t << "<div align=\"center\">" << endl;   
             writeMscFile(baseName + ".msc", s->relPath(), s->context());
 
@@ -491,7 +470,8 @@ void HtmlDocVisitor::visit(DocVerbatim *s)
             m_t << "</div>" << endl;
 
             if (Config::getBool("dot-cleanup")) {
-               file.remove();
+               // mscgen runs in the background and still needs the file
+               ToolExecutor::instance()->removeWhenDone(baseName + ".msc");
             }                      
          }
 
@@ -2242,7 +2222,7 @@ void HtmlDocVisitor::writeMscFile(const QString &fileName, const QString &relPat
    }
 
    writeMscGraphFromFile(fileName, outDir, baseName, mscFormat);
-   writeMscImageMapFromFile(m_t, fileName, outDir, relPath, baseName, context, mscFormat);
+   writeMscImageMapFromFile(m_t, fileName, outDir, relPath, baseName, context, mscFormat, m_fileName);
 }
 
 void HtmlDocVisitor::writeDiaFile(const QString &fileName, const QString &relPath, const QString &)
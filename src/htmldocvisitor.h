@@ -32,7 +32,8 @@ class MemberDef;
 class HtmlDocVisitor : public DocVisitor
 {
  public:
-   HtmlDocVisitor(QTextStream &t, CodeOutputInterface &ci, QSharedPointer<Definition> ctx);
+   /** When \a fileName is passed, it is the page written to \a t and image maps may be inserted later */
+   HtmlDocVisitor(QTextStream &t, CodeOutputInterface &ci, QSharedPointer<Definition> ctx, const QString &fileName = QString());
   
    // visitor functions for leaf nodes
 
@@ -160,6 +161,7 @@ class HtmlDocVisitor : public DocVisitor
    QSharedPointer<Definition> m_ctx;
 
    QString m_langExt;
+   QString m_fileName;
 };
 
 #endif
@@ -15,6 +15,8 @@
  *
 *************************************************************************/
 
+#include <QMutex>
+
 #include <htmlentity.h>
 #include <message.h>
 
@@ -328,6 +330,7 @@ static struct htmlEntityInfo g_htmlEntities[] = {
 static const int g_numHtmlEntities = (int)(sizeof(g_htmlEntities) / sizeof(*g_htmlEntities));
 
 HtmlEntityMapper *HtmlEntityMapper::s_instance = 0;
+static QMutex s_instanceLock;
 
 HtmlEntityMapper::HtmlEntityMapper()
 {
@@ -348,6 +351,9 @@ HtmlEntityMapper::~HtmlEntityMapper()
 /** Returns the one and only instance of the HTML entity mapper */
 HtmlEntityMapper *HtmlEntityMapper::instance()
 {
+   // called by the threads which write the pages
+   QMutexLocker locker(&s_instanceLock);
+
    if (s_instance == 0) {
       s_instance = new HtmlEntityMapper;
    }
@@ -358,6 +364,8 @@ HtmlEntityMapper *HtmlEntityMapper::instance()
 /** Deletes the one and only instance of the HTML entity mapper */
 void HtmlEntityMapper::deleteInstance()
 {
+   QMutexLocker locker(&s_instanceLock);
+
    delete s_instance;
    s_instance = 0;
 }
@@ -1990,7 +1990,7 @@ void HtmlGenerator::writeDoc(DocNode *n, QSharedPointer<Definition> ctx, QShared
 {
    assert(m_codeGen);
 
-   HtmlDocVisitor *visitor = new HtmlDocVisitor(m_textStream, *m_codeGen, ctx);
+   HtmlDocVisitor *visitor = new HtmlDocVisitor(m_textStream, *m_codeGen, ctx, m_fileName);
    n->accept(visitor);
 
    delete visitor;
@@ -18,6 +18,7 @@
 #include <QFile>
 
 #include <math.h>
+#include <string.h>
 
 #include <image.h>
 
@@ -202,7 +203,7 @@ static Color palette3[] = {
    { 0x00, 0x00, 0x00, 0xff }
 };
 
-Image::Image(int w, int h)
+static bool initPalette()
 {
    static int hue   = Config::getInt("html-colorstyle-hue");
    static int sat   = Config::getInt("html-colorstyle-sat");
@@ -229,6 +230,72 @@ Image::Image(int w, int h)
    palette[3].green = (int)(green2 * 255.0);
    palette[3].blue  = (int)(blue2  * 255.0);
 
+   return true;
+}
+
+/** Bit patterns of each row of the characters, decoded from the font data once */
+struct GlyphAtlas {
+   unsigned short rows[numChars][charHeight];
+};
+
+static GlyphAtlas buildGlyphAtlas()
+{
+   GlyphAtlas atlas;
+
+   for (int ci = 0; ci < numChars; ci++) {
+      int rowOffset = 0;
+      int cw = charWidth[ci];
+      int cp = charPos[ci];
+
+      for (int yf = 0; yf < charHeight; yf++) {
+         unsigned short bitPattern = 0;
+         int bitsLeft   = cw;
+         int byteOffset = rowOffset + (cp >> 3);
+         int bitOffset  = cp & 7;
+
+         // get the bit pattern for row yf of the character from the font data
+         while (bitsLeft > 0) {
+            int bits = 8 - bitOffset;
+            if (bits > bitsLeft) {
+               bits = bitsLeft;
+            }
+            bitPattern <<= bits;
+            bitPattern |= ((fontRaw[byteOffset] << bitOffset) & 0xff) >> (8 - bits);
+            bitsLeft -= bits;
+            bitOffset = 0;
+            byteOffset++;
+         }
+
+         atlas.rows[ci][yf] = bitPattern;
+         rowOffset += charSetWidth;
+      }
+   }
+
+   return atlas;
+}
+
+static const GlyphAtlas &glyphAtlas()
+{
+   static const GlyphAtlas atlas = buildGlyphAtlas();
+   return atlas;
+}
+
+static int glyphWidth(char c)
+{
+   if (c < ' ' || c - ' ' >= numChars) {
+      // not in the font
+      return 0;
+   }
+
+   return charWidth[c - ' '];
+}
+
+Image::Image(int w, int h)
+{
+   // the palette only depends on the configuration, set it once so images can be created on any thread
+   static bool paletteReady = initPalette();
+   (void) paletteReady;
+
    data = new uchar[w * h];
    memset(data, 0, w * h);
    width = w;
@@ -258,39 +325,32 @@ uchar Image::getPixel(int x, int y) const
 
 void Image::writeChar(int x, int y, char c, uchar fg)
 {
-   if (c >= ' ') {
-      int xf, yf, ci = c - ' ';
-      int rowOffset = 0;
-      int cw = charWidth[ci];
-      int cp = charPos[ci];
+   if (c < ' ' || c - ' ' >= numChars) {
+      return;
+   }
 
-      for (yf = 0; yf < charHeight; yf++) {
-         unsigned short bitPattern = 0;
-         int bitsLeft = cw;
-         int byteOffset = rowOffset + (cp >> 3);
-         int bitOffset  = cp & 7;
+   int ci = c - ' ';
+   int cw = charWidth[ci];
 
-         // get the bit pattern for row yf of the character from the font data
-         while (bitsLeft > 0) {
-            int bits = 8 - bitOffset;
-            if (bits > bitsLeft) {
-               bits = bitsLeft;
-            }
-            bitPattern <<= bits;
-            bitPattern |= ((fontRaw[byteOffset] << bitOffset) & 0xff) >> (8 - bits);
-            bitsLeft -= bits;
-            bitOffset = 0;
-            byteOffset++;
-         }
+   const unsigned short *rows = glyphAtlas().rows[ci];
+
+   for (int yf = 0; yf < charHeight; yf++) {
+      int yp = y + yf;
+
+      if (yp < 0 || yp >= height || rows[yf] == 0) {
+         continue;
+      }
+
+      uchar *line = data + yp * width;
+      int mask = 1 << (cw - 1);
 
-         int mask = 1 << (cw - 1);
+      // draw character row yf
+      for (int xf = 0; xf < cw; xf++, mask >>= 1) {
+         int xp = x + xf;
 
-         // draw character row yf
-         for (xf = 0; xf < cw; xf++) {
-            setPixel(x + xf, y + yf, (bitPattern & mask) ? fg : getPixel(x + xf, y + yf));
-            mask >>= 1;
+         if ((rows[yf] & mask) && xp >= 0 && xp < width) {
+            line[xp] = fg;
          }
-         rowOffset += charSetWidth;
       }
    }
 }
@@ -306,7 +366,7 @@ void Image::writeString(int x, int y, const QString &text, uchar fg)
 
       while ((c = *s++)) {
          writeChar(x, y, c, fg);
-         x += charWidth[c - ' '];
+         x += glyphWidth(c);
       }
    }
 }
@@ -323,7 +383,7 @@ uint Image::stringLength(const QString &text)
       char c;
 
       while ((c = *s++)) {
-         w += charWidth[c - ' '];
+         w += glyphWidth(c);
       }
    }
 
@@ -332,15 +392,31 @@ uint Image::stringLength(const QString &text)
 
 void Image::drawHorzLine(int y, int xs, int xe, uchar colIndex, uint mask)
 {
-   int i = 0;
-   int j = 0;
+   if (y < 0 || y >= height) {
+      return;
+   }
+
+   int xFirst = qMax(xs, 0);
+   int xLast  = qMin(xe, width - 1);
+
+   if (xFirst > xLast) {
+      return;
+   }
+
+   uchar *line = data + y * width;
+
+   if (mask == 0xffffffff) {
+      // solid line, write the whole span at once
+      memset(line + xFirst, colIndex, xLast - xFirst + 1);
+      return;
+   }
+
+   for (int x = xFirst; x <= xLast; x++) {
+      // each bit of the mask covers two pixels, the first bit only covers the first pixel
+      int i = (x - xs + 1) >> 1;
 
-   for (int x = xs; x <= xe; x++, j++) {
-      if (j & 1) {
-         i++;
-      }
       if (mask & (1 << (i & 0x1f))) {
-         setPixel(x, y, colIndex);
+         line[x] = colIndex;
       }
    }
 }
@@ -357,11 +433,18 @@ void Image::drawHorzArrow(int y, int xs, int xe, uchar colIndex, uint mask)
 
 void Image::drawVertLine(int x, int ys, int ye, uchar colIndex, uint mask)
 {
-   int i = 0;
+   if (x < 0 || x >= width) {
+      return;
+   }
 
-   for (int y = ys; y <= ye; y++, i++) {
-      if (mask & (1 << (i & 0x1f))) {
-         setPixel(x, y, colIndex);
+   int yFirst = qMax(ys, 0);
+   int yLast  = qMin(ye, height - 1);
+
+   uchar *p = data + yFirst * width + x;
+
+   for (int y = yFirst; y <= yLast; y++, p += width) {
+      if (mask & (1 << ((y - ys) & 0x1f))) {
+         *p = colIndex;
       }
    }
 }
@@ -386,13 +469,29 @@ void Image::drawRect(int x, int y, int w, int h, uchar colIndex, uint mask)
 
 void Image::fillRect(int x, int y, int lwidth, int lheight, uchar colIndex, uint mask)
 {
-   int xp, yp, xi, yi;
+   int xFirst = qMax(x, 0);
+   int xLast  = qMin(x + lwidth, width) - 1;
+   int yFirst = qMax(y, 0);
+   int yLast  = qMin(y + lheight, height) - 1;
+
+   if (xFirst > xLast) {
+      return;
+   }
+
+   for (int yp = yFirst; yp <= yLast; yp++)  {
+      uchar *line = data + yp * width;
+
+      if (mask == 0xffffffff) {
+         // solid fill, write the whole span of the row at once
+         memset(line + xFirst, colIndex, xLast - xFirst + 1);
+         continue;
+      }
 
-   for (yp = y, yi = 0; yp < y + lheight; yp++, yi++)  {
+      int yi = yp - y;
 
-      for (xp = x, xi = 0; xp < x + lwidth; xp++, xi++) {
-         if (mask & (1 << ((xi + yi) & 0x1f))) {
-            setPixel(xp, yp, colIndex);
+      for (int xp = xFirst; xp <= xLast; xp++) {
+         if (mask & (1 << ((xp - x + yi) & 0x1f))) {
+            line[xp] = colIndex;
          }
       }
    }
@@ -425,7 +524,33 @@ QByteArray Image::convert(int mode)
    encoder.infoPng.color.colorType = 3;
    encoder.infoRaw.color.colorType = 3;
 
-   LodePNG_encode(&encoder, &buffer, &bufferSize, data, width, height);
+   // the palette has at most 16 colors, storing two pixels per byte halves the data the encoder has to compress
+   size_t numPixels = (size_t)width * height;
+   QByteArray packed((int)((numPixels + 1) / 2), '\0');
+
+   uchar *pp   = (uchar *)packed.data();
+   bool isPacked = true;
+
+   for (size_t i = 0; i < numPixels; i++) {
+      uchar value = data[i];
+
+      if (value >= 16) {
+         isPacked = false;
+         break;
+      }
+
+      pp[i >> 1] |= (i & 1) ? value : (value << 4);
+   }
+
+   if (isPacked) {
+      encoder.infoPng.color.bitDepth = 4;
+      encoder.infoRaw.color.bitDepth = 4;
+
+      LodePNG_encode(&encoder, &buffer, &bufferSize, pp, width, height);
+
+   } else {
+      LodePNG_encode(&encoder, &buffer, &bufferSize, data, width, height);
+   }
 
    QByteArray retval = QByteArray( (const char *)buffer, bufferSize);
    
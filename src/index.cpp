@@ -33,6 +33,7 @@
 #include <htmlgen.h>
 #include <language.h>
 #include <layout.h>
+#include <marshal.h>
 #include <message.h>
 #include <outputlist.h>
 #include <sortedlist.h>
@@ -161,6 +162,171 @@ static LetterToIndexMap<MemberIndexList>   g_namespaceIndexLetterUsed[NMHL_Total
 
 const int maxItemsBeforeQuickIndex = MAX_ITEMS_BEFORE_QUICK_INDEX;
 
+void IndexRecorder::addCall(CallType type, const QString &name)
+{
+   Call call;
+
+   call.type          = type;
+   call.isDir         = false;
+   call.addToNavIndex = false;
+   call.category      = DirType::None;
+   call.name          = name;
+
+   m_calls.append(call);
+}
+
+void IndexRecorder::incContentsDepth()
+{
+   addCall(IncContentsDepth);
+}
+
+void IndexRecorder::decContentsDepth()
+{
+   addCall(DecContentsDepth);
+}
+
+void IndexRecorder::addContentsItem(bool isDir, const QString &name, const QString &ref, const QString &file,
+                  const QString &anchor, bool addToNavIndex, QSharedPointer<Definition> def, DirType category)
+{
+   addCall(ContentsItem, name);
+
+   Call &call = m_calls.last();
+
+   call.isDir         = isDir;
+   call.ref           = ref;
+   call.file          = file;
+   call.anchor        = anchor;
+   call.addToNavIndex = addToNavIndex;
+   call.def           = def;
+   call.category      = category;
+}
+
+void IndexRecorder::addIndexItem(QSharedPointer<Definition> context, QSharedPointer<MemberDef> md,
+                  const QString &sectionAnchor, const QString &title)
+{
+   addCall(IndexItem, title);
+
+   Call &call = m_calls.last();
+
+   call.def    = context;
+   call.md     = md;
+   call.anchor = sectionAnchor;
+}
+
+void IndexRecorder::addIndexFile(const QString &name)
+{
+   addCall(IndexFile, name);
+}
+
+void IndexRecorder::addImageFile(const QString &name)
+{
+   addCall(ImageFile, name);
+}
+
+void IndexRecorder::addStyleSheetFile(const QString &name)
+{
+   addCall(StyleSheetFile, name);
+}
+
+void IndexRecorder::replay(IndexIntf *intf) const
+{
+   for (const auto &call : m_calls) {
+
+      switch (call.type) {
+         case IncContentsDepth:
+            intf->incContentsDepth();
+            break;
+
+         case DecContentsDepth:
+            intf->decContentsDepth();
+            break;
+
+         case ContentsItem:
+            intf->addContentsItem(call.isDir, call.name, call.ref, call.file, call.anchor, call.addToNavIndex,
+                  call.def, call.category);
+            break;
+
+         case IndexItem:
+            intf->addIndexItem(call.def, call.md, call.anchor, call.name);
+            break;
+
+         case IndexFile:
+            intf->addIndexFile(call.name);
+            break;
+
+         case ImageFile:
+            intf->addImageFile(call.name);
+            break;
+
+         case StyleSheetFile:
+            intf->addStyleSheetFile(call.name);
+            break;
+      }
+   }
+}
+
+void IndexRecorder::marshal(StorageIntf *s) const
+{
+   marshalUInt(s, m_calls.count());
+
+   for (const auto &call : m_calls) {
+      marshalInt(s, call.type);
+      marshalBool(s, call.isDir);
+      marshalBool(s, call.addToNavIndex);
+      marshalInt(s, static_cast<int>(call.category));
+
+      marshalQString(s, call.name);
+      marshalQString(s, call.ref);
+      marshalQString(s, call.file);
+      marshalQString(s, call.anchor);
+
+      marshalQString(s, definitionKey(call.def));
+      marshalQString(s, definitionKey(call.md));
+   }
+}
+
+bool IndexRecorder::unmarshal(StorageIntf *s)
+{
+   uint count = unmarshalUInt(s);
+
+   for (uint i = 0; i < count; i++) {
+      Call call;
+
+      call.type          = static_cast<CallType>(unmarshalInt(s));
+      call.isDir         = unmarshalBool(s);
+      call.addToNavIndex = unmarshalBool(s);
+      call.category      = static_cast<DirType>(unmarshalInt(s));
+
+      call.name   = unmarshalQString(s);
+      call.ref    = unmarshalQString(s);
+      call.file   = unmarshalQString(s);
+      call.anchor = unmarshalQString(s);
+
+      QString defKey = unmarshalQString(s);
+      QString mdKey  = unmarshalQString(s);
+
+      if (! defKey.isEmpty()) {
+         call.def = findDefinitionByKey(defKey);
+
+         if (call.def == nullptr) {
+            return false;
+         }
+      }
+
+      if (! mdKey.isEmpty()) {
+         call.md = findDefinitionByKey(mdKey).dynamicCast<MemberDef>();
+
+         if (call.md == nullptr) {
+            return false;
+         }
+      }
+
+      m_calls.append(call);
+   }
+
+   return true;
+}
+
 static void startQuickIndexList(OutputList &ol, bool letterTabs = false)
 {
    bool fancyTabs = true;
@@ -22,6 +22,7 @@
 #include <QList>
 #include <QString>
 #include <QSharedPointer>
+#include <QVector>
 
 enum class DirType {
    None,
@@ -32,6 +33,7 @@ enum class DirType {
 class Definition;
 class MemberDef;
 class OutputList;
+class StorageIntf;
 
 /** \brief Abstract interface for index generators. */
 class IndexIntf
@@ -164,6 +166,67 @@ class IndexList : public IndexIntf
 };
 
 
+/** \brief Records the calls made to an index.
+ *
+ *  Used by worker threads which generate pages, the caller repeats the recorded calls on the
+ *  real index in the order of the pages. This keeps the index identical to a serial run.
+ */
+class IndexRecorder : public IndexIntf
+{
+ public:
+   void initialize() override {}
+   void finalize() override {}
+
+   void incContentsDepth() override;
+   void decContentsDepth() override;
+
+   void addContentsItem(bool isDir, const QString &name, const QString &ref, const QString &file,
+            const QString &anchor, bool addToNavIndex, QSharedPointer<Definition> def, DirType category) override;
+
+   void addIndexItem(QSharedPointer<Definition> context, QSharedPointer<MemberDef> md,
+            const QString &sectionAnchor, const QString &title) override;
+
+   void addIndexFile(const QString &name) override;
+   void addImageFile(const QString &name) override;
+   void addStyleSheetFile(const QString &name) override;
+
+   /** Repeats the recorded calls on \a intf */
+   void replay(IndexIntf *intf) const;
+
+   /** Writes the recorded calls, definitions are stored as their definitionKey() */
+   void marshal(StorageIntf *s) const;
+
+   /** Reads calls written by marshal(), returns false if a definition no longer exists */
+   bool unmarshal(StorageIntf *s);
+
+   void clear() {
+      m_calls.clear();
+   }
+
+ private:
+   enum CallType { IncContentsDepth, DecContentsDepth, ContentsItem, IndexItem, IndexFile, ImageFile, StyleSheetFile };
+
+   struct Call {
+      CallType type;
+
+      bool isDir;
+      bool addToNavIndex;
+      DirType category;
+
+      QString name;
+      QString ref;
+      QString file;
+      QString anchor;
+
+      QSharedPointer<Definition> def;
+      QSharedPointer<MemberDef> md;
+   };
+
+   void addCall(CallType type, const QString &name = QString());
+
+   QVector<Call> m_calls;
+};
+
 enum IndexSections {
    isTitlePageStart,
    isTitlePageAuthor,
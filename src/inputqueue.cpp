@@ -0,0 +1,234 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QMutexLocker>
+
+#include <inputqueue.h>
+
+#include <util.h>
+
+InputFileQueue::InputFileQueue(const QStringList &fileList, int numThreads, InputPrepareFunc prepare, InputReadFunc read)
+   : m_fileList(fileList), m_slots(fileList.count()), m_nextIndex(0), m_takenIndex(0), m_stop(false),
+     m_read(read), m_prepare(prepare), m_prepareThread(nullptr)
+{
+   if (m_read == nullptr) {
+      m_read = readInputFile;
+   }
+
+   numThreads = qMin(32, numThreads);
+
+   if (numThreads == 0) {
+      numThreads = qMax(2, QThread::idealThreadCount());
+   }
+
+   // limit how far the readers may run ahead of the parser, keeps memory bounded
+   m_window = 4 * numThreads;
+
+   if (numThreads > 1 && fileList.count() > 1) {
+
+      if (m_prepare != nullptr) {
+         // one thread is used to run the prepare function
+         m_prepareThread = new InputPrepareThread(this);
+         m_prepareThread->start();
+
+         if (m_prepareThread->isRunning()) {
+            --numThreads;
+
+         } else {
+            delete m_prepareThread;
+            m_prepareThread = nullptr;
+         }
+      }
+
+      for (int i = 0; i < numThreads; i++) {
+         InputReaderThread *thread = new InputReaderThread(this);
+         thread->start();
+
+         if (thread->isRunning()) {
+            m_workers.append(thread);
+         } else {
+            // no more threads available
+            delete thread;
+         }
+      }
+
+      if (m_workers.isEmpty() && m_prepareThread != nullptr) {
+         // the prepare thread would wait forever
+         {
+            QMutexLocker locker(&m_mutex);
+
+            m_stop = true;
+            m_slotReady.wakeAll();
+         }
+
+         m_prepareThread->wait();
+         delete m_prepareThread;
+
+         m_prepareThread = nullptr;
+         m_stop = false;
+      }
+   }
+}
+
+InputFileQueue::~InputFileQueue()
+{
+   {
+      QMutexLocker locker(&m_mutex);
+
+      m_stop = true;
+      m_slotFree.wakeAll();
+      m_slotReady.wakeAll();
+   }
+
+   for (auto thread : m_workers) {
+      thread->wait();
+      delete thread;
+   }
+
+   if (m_prepareThread != nullptr) {
+      m_prepareThread->wait();
+      delete m_prepareThread;
+   }
+}
+
+QString InputFileQueue::take(int index)
+{
+   if (m_workers.isEmpty()) {
+      // single threaded mode
+      QString retval = m_read(m_fileList.at(index));
+
+      if (m_prepare != nullptr) {
+         retval = m_prepare(m_fileList.at(index), retval);
+      }
+
+      return retval;
+   }
+
+   QMutexLocker locker(&m_mutex);
+
+   if (m_prepareThread != nullptr) {
+      while (! m_slots[index].prepared) {
+         m_slotReady.wait(&m_mutex);
+      }
+
+   } else {
+      while (! m_slots[index].ready) {
+         m_slotReady.wait(&m_mutex);
+      }
+   }
+
+   QString retval;
+   qSwap(retval, m_slots[index].contents);
+
+   if (index >= m_takenIndex) {
+      m_takenIndex = index + 1;
+      m_slotFree.wakeAll();
+   }
+
+   locker.unlock();
+
+   if (m_prepare != nullptr && m_prepareThread == nullptr) {
+      retval = m_prepare(m_fileList.at(index), retval);
+   }
+
+   return retval;
+}
+
+int InputFileQueue::claim()
+{
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_stop && m_nextIndex < m_fileList.count() && m_nextIndex >= m_takenIndex + m_window) {
+      // wait for the parser to catch up
+      m_slotFree.wait(&m_mutex);
+   }
+
+   if (m_stop || m_nextIndex >= m_fileList.count()) {
+      return -1;
+   }
+
+   return m_nextIndex++;
+}
+
+void InputFileQueue::store(int index, const QString &contents)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_slots[index].contents = contents;
+   m_slots[index].ready    = true;
+
+   m_slotReady.wakeAll();
+}
+
+bool InputFileQueue::waitForRead(int index, QString &contents)
+{
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_stop && ! m_slots[index].ready) {
+      m_slotReady.wait(&m_mutex);
+   }
+
+   if (m_stop) {
+      return false;
+   }
+
+   qSwap(contents, m_slots[index].contents);
+
+   return true;
+}
+
+void InputFileQueue::storePrepared(int index, const QString &contents)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_slots[index].contents = contents;
+   m_slots[index].prepared = true;
+
+   m_slotReady.wakeAll();
+}
+
+InputPrepareThread::InputPrepareThread(InputFileQueue *queue)
+   : m_queue(queue)
+{
+}
+
+void InputPrepareThread::run()
+{
+   for (int index = 0; index < m_queue->m_fileList.count(); ++index) {
+      QString contents;
+
+      if (! m_queue->waitForRead(index, contents)) {
+         break;
+      }
+
+      m_queue->storePrepared(index, m_queue->m_prepare(m_queue->m_fileList.at(index), contents));
+   }
+}
+
+InputReaderThread::InputReaderThread(InputFileQueue *queue)
+   : m_queue(queue)
+{
+}
+
+void InputReaderThread::run()
+{
+   int index;
+
+   while ((index = m_queue->claim()) != -1) {
+      m_queue->store(index, m_queue->m_read(m_queue->m_fileList.at(index)));
+   }
+}
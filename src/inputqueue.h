@@ -0,0 +1,131 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+class InputPrepareThread;
+class InputReaderThread;
+
+/** Reads the contents of an input file, defaults to readInputFile() */
+typedef QString (*InputReadFunc)(const QString &fileName);
+
+/** Converts the raw contents of an input file into the buffer passed to the scanner */
+typedef QString (*InputPrepareFunc)(const QString &fileName, const QString &contents);
+
+/** Reads input files ahead of the parser using a pool of worker threads.
+ *
+ *  Files are read, filtered and transcoded concurrently. When a prepare
+ *  function is passed, one additional thread runs it on each file in the
+ *  order of the file list, the preprocessor and comment converter keep state
+ *  across files and can only run on one thread at a time. The results are
+ *  handed out by take() strictly in the order of the file list. This keeps
+ *  the Entry tree identical to a serial run.
+ *
+ *  Only reading and preparing are done ahead. The files are scanned by the caller or by
+ *  the workers of a ParseFileQueue or SourceFileQueue, which may call take() from several
+ *  threads when no prepare function is passed or hasPrepareThread() returns true.
+ */
+class InputFileQueue
+{
+ public:
+   InputFileQueue(const QStringList &fileList, int numThreads, InputPrepareFunc prepare = nullptr,
+                  InputReadFunc read = nullptr);
+   ~InputFileQueue();
+
+   /** Returns the contents of the file at position \a index, waits until a worker has read it */
+   QString take(int index);
+
+   int threadCount() const {
+      return m_workers.count() + (m_prepareThread ? 1 : 0);
+   }
+
+   /** Returns true if the prepare function runs on its own thread, in the order of the file list */
+   bool hasPrepareThread() const {
+      return m_prepareThread != nullptr;
+   }
+
+ private:
+   struct Slot {
+      Slot() : ready(false), prepared(false) {}
+
+      QString contents;
+      bool    ready;
+      bool    prepared;
+   };
+
+   /** Returns the index of the next file to read or -1 when all files have been claimed */
+   int claim();
+   void store(int index, const QString &contents);
+
+   /** Returns the raw contents of the file at position \a index or false if the queue was stopped */
+   bool waitForRead(int index, QString &contents);
+   void storePrepared(int index, const QString &contents);
+
+   QStringList   m_fileList;
+   QVector<Slot> m_slots;
+
+   int m_nextIndex;
+   int m_takenIndex;
+   int m_window;
+   bool m_stop;
+
+   InputReadFunc    m_read;
+   InputPrepareFunc m_prepare;
+
+   QWaitCondition m_slotReady;
+   QWaitCondition m_slotFree;
+   mutable QMutex m_mutex;
+
+   QList<InputReaderThread *> m_workers;
+   InputPrepareThread *m_prepareThread;
+
+   friend class InputPrepareThread;
+   friend class InputReaderThread;
+};
+
+/** Thread which runs the prepare function of the InputFileQueue in file order */
+class InputPrepareThread : public QThread
+{
+ public:
+   InputPrepareThread(InputFileQueue *queue);
+   void run();
+
+ private:
+   InputFileQueue *m_queue;
+};
+
+/** Worker thread to read input files for the InputFileQueue */
+class InputReaderThread : public QThread
+{
+ public:
+   InputReaderThread(InputFileQueue *queue);
+   void run();
+
+ private:
+   InputFileQueue *m_queue;
+};
+
+#endif
@@ -33,6 +33,7 @@
 #include <outputgen.h>
 #include <parser_base.h>
 #include <plantuml.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 static QString escapeLabelName(const QString &str)
@@ -413,56 +414,34 @@ void LatexDocVisitor::visit(DocVerbatim *s)
          break;
 
       case DocVerbatim::Dot: {
-         static int dotindex = 1;
+         QString fileName = inlineGraphBaseName(Config::getString("latex-output"), "inline_dotgraph_", s->text()) + ".dot";
 
-         QString latexOutput = Config::getString("latex-output") + "/inline_dotgraph_";        
-         QString fileName = QString("%1%2.dot").arg(latexOutput).arg(dotindex++);
-
-         QFile file(fileName);
-
-         if (! file.open(QIODevice::WriteOnly)) {
-            err("Unable to open file %s for writing, error: %d\n", csPrintable(fileName), file.error()); 
- 
-         } else {
-
-            file.write( s->text().toUtf8() );
-            file.close();
-       
+         if (writeInlineGraphFile(fileName, s->text().toUtf8())) {
             startDotFile(fileName, s->width(), s->height(), s->hasCaption());
             visitCaption(this, s->children());
             endDotFile(s->hasCaption());
 
             if (Config::getBool("dot-cleanup")) {
-               file.remove();
+               // another page may show the same graph
+               ToolExecutor::instance()->removeWhenDone(fileName);
             }
-         } 
+         }
       }
       break;
 
       case DocVerbatim::Msc: {
-         static int mscindex = 1;
+         QString baseName = inlineGraphBaseName(Config::getString("latex-output"), "inline_mscgraph_", s->text());
 
-         QString latexOutput = Config::getString("latex-output") + "/inline_mscgraph_";
-         QString baseName = QString("%1%2").arg(latexOutput).arg(mscindex++);
+         QString text = "msc {";
+         text += s->text();
+         text += "}";
 
-         QFile file(baseName + ".msc");
-
-         if (! file.open(QIODevice::WriteOnly)) {
-            err("Unable to open file %s.msc for writing, error: %d\n", qPrintable(baseName), file.error()); 
-
-         } else {
-
-            QString text = "msc {";
-            text += s->text();
-            text += "}";
-   
-            file.write( text.toUtf8() );
-            file.close();
-   
+         if (writeInlineGraphFile(baseName + ".msc", text.toUtf8())) {
             writeMscFile(baseName, s);
    
             if (Config::getBool("dot-cleanup")) {
-               file.remove();
+               // mscgen runs in the background and still needs the file
+               ToolExecutor::instance()->removeWhenDone(baseName + ".msc");
             }
          }
       }
@@ -0,0 +1,141 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QMutexLocker>
+
+#include <lookupcache.h>
+
+LookupCache::LookupCache(int maxCost)
+{
+   int shardCost = qMax(1, maxCost / NumShards);
+
+   for (auto &shard : m_shards) {
+      shard.cache = new QCache<LookupKey, LookupInfo>(shardCost);
+   }
+}
+
+LookupCache::~LookupCache()
+{
+   for (auto &shard : m_shards) {
+      delete shard.cache;
+   }
+}
+
+bool LookupCache::find(const LookupKey &key, LookupInfo &info)
+{
+   Shard &shard = shardFor(key);
+   QMutexLocker locker(&shard.mutex);
+
+   LookupInfo *pval = shard.cache->object(key);
+
+   if (pval == nullptr) {
+      ++shard.misses;
+      return false;
+   }
+
+   ++shard.hits;
+   info = *pval;
+
+   return true;
+}
+
+void LookupCache::insert(const LookupKey &key, const LookupInfo &info)
+{
+   Shard &shard = shardFor(key);
+   QMutexLocker locker(&shard.mutex);
+
+   LookupInfo *pval = shard.cache->object(key);
+
+   if (pval != nullptr) {
+      *pval = info;
+      return;
+   }
+
+   if (shard.cache->count() >= shard.cache->maxCost()) {
+      // least recently used entry will be removed
+      ++shard.evictions;
+   }
+
+   shard.cache->insert(key, new LookupInfo(info));
+}
+
+void LookupCache::clear()
+{
+   for (auto &shard : m_shards) {
+      QMutexLocker locker(&shard.mutex);
+      shard.cache->clear();
+   }
+}
+
+int LookupCache::count() const
+{
+   int retval = 0;
+
+   for (auto &shard : m_shards) {
+      QMutexLocker locker(&shard.mutex);
+      retval += shard.cache->count();
+   }
+
+   return retval;
+}
+
+int LookupCache::size() const
+{
+   int retval = 0;
+
+   for (auto &shard : m_shards) {
+      retval += shard.cache->maxCost();
+   }
+
+   return retval;
+}
+
+qint64 LookupCache::hits() const
+{
+   qint64 retval = 0;
+
+   for (auto &shard : m_shards) {
+      QMutexLocker locker(&shard.mutex);
+      retval += shard.hits;
+   }
+
+   return retval;
+}
+
+qint64 LookupCache::misses() const
+{
+   qint64 retval = 0;
+
+   for (auto &shard : m_shards) {
+      QMutexLocker locker(&shard.mutex);
+      retval += shard.misses;
+   }
+
+   return retval;
+}
+
+qint64 LookupCache::evictions() const
+{
+   qint64 retval = 0;
+
+   for (auto &shard : m_shards) {
+      QMutexLocker locker(&shard.mutex);
+      retval += shard.evictions;
+   }
+
+   return retval;
+}
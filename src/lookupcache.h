@@ -0,0 +1,123 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef LOOKUPCACHE_H
+#define LOOKUPCACHE_H
+
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include <symboltable.h>
+
+class ClassDef;
+class Definition;
+class FileDef;
+class MemberDef;
+
+struct LookupInfo {
+   LookupInfo() {}
+
+   LookupInfo(QSharedPointer<ClassDef> cd, QSharedPointer<MemberDef> td, QString ts, QString rt)
+      : classDef(cd), typeDef(td), templSpec(ts), resolvedType(rt)
+   {}
+
+   QSharedPointer<ClassDef>  classDef;
+   QSharedPointer<MemberDef> typeDef;
+
+   QString templSpec;
+   QString resolvedType;
+};
+
+/** Key of a class lookup, the file scope is only set when it contains using statements */
+struct LookupKey {
+   LookupKey(const Definition *s, SymbolId n, const QString &e, const FileDef *f)
+      : scope(s), fileScope(f), name(n), explicitScopePart(e)
+   {}
+
+   bool operator==(const LookupKey &other) const {
+      return name == other.name && scope == other.scope && fileScope == other.fileScope &&
+             explicitScopePart == other.explicitScopePart;
+   }
+
+   const Definition *scope;
+   const FileDef    *fileScope;
+
+   SymbolId name;
+   QString  explicitScopePart;
+};
+
+inline uint qHash(const LookupKey &key, uint seed = 0)
+{
+   uint h = qHash(key.name, seed);
+
+   h = 31 * h + qHash(key.explicitScopePart, seed);
+   h = 31 * h + qHash(reinterpret_cast<quintptr>(key.scope), seed);
+   h = 31 * h + qHash(reinterpret_cast<quintptr>(key.fileScope), seed);
+
+   return h;
+}
+
+/** @brief Cache for the results of getResolvedClass()
+ *
+ *  The cache is split in shards, each with its own lock, so lookups from
+ *  different threads rarely wait for each other. Values are returned by copy.
+ */
+class LookupCache
+{
+ public:
+   LookupCache(int maxCost);
+   ~LookupCache();
+
+   /** Returns true if \a key was found, the result is copied to \a info */
+   bool find(const LookupKey &key, LookupInfo &info);
+
+   void insert(const LookupKey &key, const LookupInfo &info);
+   void clear();
+
+   int count() const;
+   int size() const;
+
+   qint64 hits() const;
+   qint64 misses() const;
+   qint64 evictions() const;
+
+ private:
+   static const int NumShards = 16;
+
+   struct Shard {
+      Shard() : cache(nullptr), hits(0), misses(0), evictions(0) {}
+
+      QCache<LookupKey, LookupInfo> *cache;
+      mutable QMutex mutex;
+
+      qint64 hits;
+      qint64 misses;
+      qint64 evictions;
+   };
+
+   Shard &shardFor(const LookupKey &key) {
+      return m_shards[qHash(key) % NumShards];
+   }
+
+   Shard m_shards[NumShards];
+};
+
+#endif
@@ -27,24 +27,28 @@
 
 #define HEADER ('D'<<24)+('O'<<16)+('X'<<8)+'!'
 
+// strings up to this length are written to the string table of the store
+static const int MAX_INTERN_LENGTH = 128;
+
 void marshalInt(StorageIntf *s, int v)
 {
-   uchar b[4];
-   b[0] = ((uint)v) >> 24;
-   b[1] = (((uint)v) >> 16) & 0xff;
-   b[2] = (((uint)v) >> 8) & 0xff;
-   b[3] = v & 0xff;
-   s->write((const char *)b, 4);
+   // zigzag encoding, small negative values are stored in a few bytes
+   marshalUInt(s, (((uint)v) << 1) ^ (uint)(v >> 31));
 }
 
 void marshalUInt(StorageIntf *s, uint v)
 {
-   uchar b[4];
-   b[0] = v >> 24;
-   b[1] = (v >> 16) & 0xff;
-   b[2] = (v >> 8) & 0xff;
-   b[3] = v & 0xff;
-   s->write((const char *)b, 4);
+   // variable length, 7 bits per byte, high bit is set when more bytes follow
+   uchar b[5];
+   int len = 0;
+
+   while (v >= 0x80) {
+      b[len++] = (v & 0x7f) | 0x80;
+      v >>= 7;
+   }
+
+   b[len++] = v;
+   s->write((const char *)b, len);
 }
 
 void marshalTraits(StorageIntf *s, Entry::Traits v)
@@ -70,10 +74,20 @@ void marshalQByteArray(StorageIntf *s, const QByteArray &str)
 
 void marshalQString(StorageIntf *s, const QString &str)
 {
+   // lowest bit of the tag selects between an index in the string table and an inline string
+   if (str.length() <= MAX_INTERN_LENGTH) {
+      int index = s->stringIndex(str);
+
+      if (index != -1) {
+         marshalUInt(s, (((uint)index) << 1) | 1);
+         return;
+      }
+   }
+
    QByteArray temp = str.toUtf8();
 
    uint len = temp.length();
-   marshalUInt(s, len);
+   marshalUInt(s, len << 1);
 
    if (len > 0) {
       s->write(temp.constData(), len);
@@ -185,6 +199,19 @@ void marshalBriefInfo(StorageIntf *s, BriefInfo *briefInfo)
    }
 }
 
+void marshalTagInfo(StorageIntf *s, TagInfo *tagInfo)
+{
+   if (tagInfo == nullptr) {
+      marshalUInt(s, NULL_LIST);
+
+   } else {
+      marshalUInt(s, 1);
+      marshalQString(s, tagInfo->tagName);
+      marshalQString(s, tagInfo->fileName);
+      marshalQString(s, tagInfo->anchor);
+   }
+}
+
 void marshalEntry(StorageIntf *s, QSharedPointer<Entry> e)
 {
    marshalUInt(s, HEADER);
@@ -230,6 +257,11 @@ void marshalEntry(StorageIntf *s, QSharedPointer<Entry> e)
    marshalQString(s, e->m_write);
    marshalQString(s, e->m_reset);
    marshalQString(s, e->m_notify);
+   marshalQString(s, e->m_revision);
+   marshalQString(s, e->m_designable);
+   marshalQString(s, e->m_scriptable);
+   marshalQString(s, e->m_stored);
+   marshalQString(s, e->m_user);
 
    marshalQString(s, e->inside);
    marshalQString(s, e->exception);
@@ -244,12 +276,14 @@ void marshalEntry(StorageIntf *s, QSharedPointer<Entry> e)
    marshalSectionInfoList(s, e->anchors);
    marshalQString(s,         e->fileName);
    marshalInt(s,             e->startLine);
+   marshalInt(s,             e->startColumn);
    marshalItemInfoList(s,    e->sli);
    marshalInt(s,             e->lang);
    marshalBool(s,            e->hidden);
    marshalBool(s,            e->artificial);
    marshalInt(s,             e->groupDocType);
    marshalQString(s,         e->id);
+   marshalTagInfo(s,         e->tagInfo);
 }
 
 void marshalEntryTree(StorageIntf *s, QSharedPointer<Entry> e)
@@ -262,20 +296,40 @@ void marshalEntryTree(StorageIntf *s, QSharedPointer<Entry> e)
    }
 }
 
+static uchar unmarshalByte(StorageIntf *s)
+{
+   const char *b = s->view(1);
+
+   if (b != nullptr) {
+      return *b;
+   }
+
+   char result = 0;
+   s->read(&result, 1);
+
+   return result;
+}
+
 int unmarshalInt(StorageIntf *s)
 {
-   uchar b[4];
-   s->read((char *)b, 4);
-   int result = (int)((((uint)b[0]) << 24) + ((uint)b[1] << 16) + ((uint)b[2] << 8) + (uint)b[3]);
+   uint v = unmarshalUInt(s);
+   int result = (int)(v >> 1) ^ -(int)(v & 1);
 
    return result;
 }
 
 uint unmarshalUInt(StorageIntf *s)
 {
-   uchar b[4];
-   s->read((char *)b, 4);
-   uint result = (((uint)b[0]) << 24) + ((uint)b[1] << 16) + ((uint)b[2] << 8) + (uint)b[3];
+   uint result = 0;
+
+   for (int shift = 0; shift < 35; shift += 7) {
+      uchar b = unmarshalByte(s);
+      result |= ((uint)(b & 0x7f)) << shift;
+
+      if ((b & 0x80) == 0) {
+         break;
+      }
+   }
 
    return result;
 }
@@ -300,6 +354,14 @@ QByteArray unmarshalQByteArray(StorageIntf *s)
 {
    uint len = unmarshalUInt(s);
 
+   if (len > 0) {
+      const char *data = s->view(len);
+
+      if (data != nullptr) {
+         return QByteArray(data, len);
+      }
+   }
+
    QByteArray result;
    result.resize(len);
 
@@ -312,7 +374,22 @@ QByteArray unmarshalQByteArray(StorageIntf *s)
 
 QString unmarshalQString(StorageIntf *s)
 {
-   uint len = unmarshalUInt(s);
+   uint tag = unmarshalUInt(s);
+
+   if (tag & 1) {
+      return s->stringAt(tag >> 1);
+   }
+
+   uint len = tag >> 1;
+
+   if (len > 0) {
+      // build the string directly from the mapped file
+      const char *data = s->view(len);
+
+      if (data != nullptr) {
+         return QString::fromUtf8(data, len);
+      }
+   }
 
    QByteArray result;
    result.resize(len);
@@ -467,6 +544,23 @@ BriefInfo *unmarshalBriefInfo(StorageIntf *s)
    return result;
 }
 
+TagInfo *unmarshalTagInfo(StorageIntf *s)
+{
+   uint count = unmarshalUInt(s);
+
+   if (count == NULL_LIST) {
+      return nullptr;
+   }
+
+   TagInfo *result = new TagInfo;
+
+   result->tagName  = unmarshalQString(s);
+   result->fileName = unmarshalQString(s);
+   result->anchor   = unmarshalQString(s);
+
+   return result;
+}
+
 QSharedPointer<Entry> unmarshalEntry(StorageIntf *s)
 {
    QSharedPointer<Entry> e = QMakeShared<Entry>();
@@ -515,6 +609,11 @@ QSharedPointer<Entry> unmarshalEntry(StorageIntf *s)
    e->m_write          = unmarshalQString(s);
    e->m_reset          = unmarshalQString(s);
    e->m_notify         = unmarshalQString(s);
+   e->m_revision       = unmarshalQString(s);
+   e->m_designable     = unmarshalQString(s);
+   e->m_scriptable     = unmarshalQString(s);
+   e->m_stored         = unmarshalQString(s);
+   e->m_user           = unmarshalQString(s);
 
    e->inside           = unmarshalQString(s);
    e->exception        = unmarshalQString(s);
@@ -533,6 +632,7 @@ QSharedPointer<Entry> unmarshalEntry(StorageIntf *s)
 
    e->fileName         = unmarshalQString(s);
    e->startLine        = unmarshalInt(s);
+   e->startColumn      = unmarshalInt(s);
    e->sli              = unmarshalItemInfoList(s);
    e->lang             = static_cast<SrcLangExt>(unmarshalInt(s));
    e->hidden           = unmarshalBool(s);
@@ -540,6 +640,9 @@ QSharedPointer<Entry> unmarshalEntry(StorageIntf *s)
    e->groupDocType     = static_cast<Entry::GroupDocType>(unmarshalInt(s));
    e->id               = unmarshalQString(s);
 
+   delete e->tagInfo;
+   e->tagInfo          = unmarshalTagInfo(s);
+
    return e;
 }
 
@@ -34,6 +34,7 @@ struct BriefInfo;
 struct Grouping;
 struct SectionInfo;
 struct ListItemInfo;
+struct TagInfo;
 
 #define NULL_LIST 0xffffffff
 
@@ -56,6 +57,7 @@ void marshalSectionInfoList(StorageIntf *s, QList<SectionInfo> *anchors);
 void marshalItemInfoList(StorageIntf *s,    QList<ListItemInfo> *sli);
 
 void marshalBriefInfo(StorageIntf *s,       BriefInfo *briefInfo);
+void marshalTagInfo(StorageIntf *s,         TagInfo *tagInfo);
 void marshalEntry(StorageIntf *s,           QSharedPointer<Entry> e);
 void marshalEntryTree(StorageIntf *s,       QSharedPointer<Entry> e);
 
@@ -77,6 +79,7 @@ QList<SectionInfo>   *unmarshalSectionInfoList(StorageIntf *s);
 QList<ListItemInfo>  *unmarshalItemInfoList(StorageIntf *s);
 
 BriefInfo            *unmarshalBriefInfo(StorageIntf *s);
+TagInfo              *unmarshalTagInfo(StorageIntf *s);
 
 QSharedPointer<Entry> unmarshalEntry(StorageIntf *s);
 QSharedPointer<Entry> unmarshalEntryTree(StorageIntf *s);
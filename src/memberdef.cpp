@@ -15,6 +15,7 @@
  *
 *************************************************************************/
 
+#include <QMutex>
 #include <QRegExp>
 
 #include <stdio.h>
@@ -23,6 +24,7 @@
 #include <memberdef.h>
 
 #include <arguments.h>
+#include <buildstate.h>
 #include <code.h>
 #include <config.h>
 #include <defargs.h>
@@ -39,7 +41,10 @@
 #include <objcache.h>
 #include <util.h>
 
-int MemberDef::s_indentLevel = 0;
+thread_local int MemberDef::s_indentLevel = 0;
+
+// guards the typedef and anonymous type caches, these are filled while source files are highlighted
+static QMutex s_typeCacheLock;
 
 static QString addTemplateNames(const QString &s, const QString  &n, const QString  &t)
 {
@@ -1110,63 +1115,51 @@ QString MemberDef::anchor() const
    return result;
 }
 
-void MemberDef::computeLinkableInProject() const
+uchar MemberDef::computeLinkableInProject() const
 {
    static bool extractStatic  = Config::getBool("extract-static");
 
-   // linkable
-   m_isLinkableCached = 2;
-
    if (isHidden()) {
-      m_isLinkableCached = 1;
-      return;
+      return 1;
    }
 
    if (m_impl->templateMaster) {
-      m_isLinkableCached = m_impl->templateMaster->isLinkableInProject() ? 2 : 1;
-      return;
+      return m_impl->templateMaster->isLinkableInProject() ? 2 : 1;
    }
 
    if (name().isEmpty() || name().at(0) == '@') {
-      m_isLinkableCached = 1; // not a valid or a dummy name
-      return;
+      return 1; // not a valid or a dummy name
    }
    if (! hasDocumentation() && ! isReference()) {
-      m_isLinkableCached = 1; // no documentation
-      return;
+      return 1; // no documentation
    }
 
    if (m_impl->group && !m_impl->group->isLinkableInProject()) {
-      m_isLinkableCached = 1; // group but group not linkable
-      return;
+      return 1; // group but group not linkable
    }
 
    if (! m_impl->group && m_impl->classDef && ! m_impl->classDef->isLinkableInProject()) {
-      m_isLinkableCached = 1; // in class but class not linkable
-      return;
+      return 1; // in class but class not linkable
    }
 
    if (! m_impl->group && m_impl->nspace && ! m_impl->related && !m_impl->nspace->isLinkableInProject()) {
-      m_isLinkableCached = 1; // in namespace but namespace not linkable
-      return;
+      return 1; // in namespace but namespace not linkable
    }
 
   if (! m_impl->group && !m_impl->nspace && ! m_impl->related && !m_impl->classDef &&
          m_impl->fileDef && !m_impl->fileDef->isLinkableInProject()) {
 
-      m_isLinkableCached = 1; // in file (and not in namespace) but file not linkable
-      return;
+      return 1; // in file (and not in namespace) but file not linkable
    }
    if (! protectionLevelVisible(m_impl->prot) && m_impl->mtype != MemberType_Friend) {
-      m_isLinkableCached = 1; // hidden due to protection
-      return;
+      return 1; // hidden due to protection
    }
 
    if (m_impl->stat && m_impl->classDef == 0 && !extractStatic) {
-      m_isLinkableCached = 1; // hidden due to staticness
-      return;   }
+      return 1; // hidden due to staticness
+   }
 
-   return; // linkable!
+   return 2; // linkable!
 }
 
 void MemberDef::setDocumentation(const QString &d, const QString &docFile, int docLine, bool stripWhiteSpace)
@@ -1195,12 +1188,17 @@ void MemberDef::setHidden(bool b)
 
 bool MemberDef::isLinkableInProject() const
 {
-   if (m_isLinkableCached == 0) {
-      computeLinkableInProject();
+   // the cached value is stored once, source files are highlighted on several threads
+   uchar linkable = m_isLinkableCached;
+
+   if (linkable == 0) {
+      linkable = computeLinkableInProject();
+      m_isLinkableCached = linkable;
    }
-   assert(m_isLinkableCached > 0);
 
-   return m_isLinkableCached == 2;
+   assert(linkable > 0);
+
+   return linkable == 2;
 }
 
 bool MemberDef::isLinkable() const
@@ -1280,8 +1278,12 @@ void MemberDef::writeLink(OutputList &ol, QSharedPointer<ClassDef> cd, QSharedPo
  */
 QSharedPointer<ClassDef> MemberDef::getClassDefOfAnonymousType()
 {
-   if (m_impl->cachedAnonymousType) {
-      return m_impl->cachedAnonymousType;
+   {
+      QMutexLocker locker(&s_typeCacheLock);
+
+      if (m_impl->cachedAnonymousType) {
+         return m_impl->cachedAnonymousType;
+      }
    }
 
    QString cname;
@@ -1297,7 +1299,7 @@ QSharedPointer<ClassDef> MemberDef::getClassDefOfAnonymousType()
    QString ltype(m_impl->type);
    ltype = stripPrefix(ltype, "friend ");
 
-   static QRegExp r("@[0-9]+");
+   static thread_local QRegExp r("@[0-9]+");
    int l;
 
    int i = r.indexIn(ltype, 0);
@@ -1339,7 +1341,10 @@ QSharedPointer<ClassDef> MemberDef::getClassDefOfAnonymousType()
       }
    }
 
-   m_impl->cachedAnonymousType = annoClassDef;
+   {
+      QMutexLocker locker(&s_typeCacheLock);
+      m_impl->cachedAnonymousType = annoClassDef;
+   }
 
    return annoClassDef;
 }
@@ -1425,6 +1430,8 @@ void MemberDef::writeDeclaration(OutputList &ol, QSharedPointer<ClassDef> cd, QS
                   QSharedPointer<FileDef> fd, QSharedPointer<GroupDef> gd, bool inGroup,
                   QSharedPointer<ClassDef> inheritedFrom, const QString &inheritId)
 {
+   BuildState::addDependency(getDefFileName());
+
    // hide enum value since they appear already as part of the enum, unless they are explicitly grouped
 
    if (! inGroup && m_impl->mtype == MemberType_EnumValue) {
@@ -1540,7 +1547,7 @@ void MemberDef::writeDeclaration(OutputList &ol, QSharedPointer<ClassDef> cd, QS
    // strip `friend' keyword from ltype
    ltype = stripPrefix(ltype, "friend ");
 
-   static QRegExp r("@[0-9]+");
+   static thread_local QRegExp r("@[0-9]+");
 
    bool endAnonScopeNeeded = false;
    int l;
@@ -2386,7 +2393,7 @@ void MemberDef::_writeReimplementedBy(OutputList &ol)
             reimplInLine = theTranslator->trReimplementedInList(count);
          }
 
-         static QRegExp marker("@[0-9]+");
+         static thread_local QRegExp marker("@[0-9]+");
          int index = 0, newIndex, matchLen;
 
          // now replace all markers in reimplInLine with links to the classes
@@ -2585,7 +2592,7 @@ QString MemberDef::displayDefinition() const
       }
    }
 
-   static QRegExp r("@[0-9]+");
+   static thread_local QRegExp r("@[0-9]+");
    int l;
    int i = r.indexIn(ldef, 0);
    l = r.matchedLength();
@@ -2716,6 +2723,8 @@ void MemberDef::writeDocumentation(QSharedPointer<MemberList> ml, OutputList &ol
 {
    QSharedPointer<MemberDef> self = sharedFrom(this);
 
+   BuildState::addDependency(getDefFileName());
+
    // if this member is in a group find the real scope name
    bool hasParameterList = false;
    bool inFile  = container->definitionType() == Definition::TypeFile;
@@ -2801,7 +2810,7 @@ void MemberDef::writeDocumentation(QSharedPointer<MemberList> ml, OutputList &ol
 
    int i = 0;
    int l;
-   static QRegExp r("@[0-9]+");
+   static thread_local QRegExp r("@[0-9]+");
 
    ol.pushGeneratorState();
 
@@ -3141,11 +3150,14 @@ void MemberDef::writeDocumentation(QSharedPointer<MemberList> ml, OutputList &ol
 
       ol.startCodeFragment();
 
-      if (m_impl->initializer.startsWith("=")) {
-         m_impl->initializer = m_impl->initializer.mid(1).trimmed();
+      // the member is shared by the pages written on other threads, strip a copy
+      QString initializer = m_impl->initializer;
+
+      if (initializer.startsWith("=")) {
+         initializer = initializer.mid(1).trimmed();
       }
 
-      pIntf->parseCode(ol, qPrintable(scopeName), m_impl->initializer, lang, false, 0, getFileDef(),
+      pIntf->parseCode(ol, qPrintable(scopeName), initializer, lang, false, 0, getFileDef(),
                        -1, -1, true, self, false, self);
 
       ol.endCodeFragment();
@@ -3296,7 +3308,7 @@ static QString simplifyTypeForTable(const QString &s)
       ts = ts.left(ts.length() - 2);
    }
 
-   static QRegExp re("[A-Z_a-z0-9]+::");
+   static thread_local QRegExp re("[A-Z_a-z0-9]+::");
    int i, l;
 
    while ((i = re.indexIn(ts, 0)) != -1) {
@@ -3385,6 +3397,8 @@ void MemberDef::writeMemberDocSimple(OutputList &ol, QSharedPointer<Definition>
    QSharedPointer<MemberDef> self       = sharedFrom(this);
    QSharedPointer<Definition> scopeDef  = getOuterScope();
 
+   BuildState::addDependency(getDefFileName());
+
    QString doxyName  = name();
    QString doxyArgs  = argsString();
    QString memAnchor = anchor();
@@ -3981,54 +3995,52 @@ void MemberDef::writeTagFile(QTextStream &tagFile)
    tagFile << "    </member>" << endl;
 }
 
-void MemberDef::computeIsConstructor() const
+uchar MemberDef::computeIsConstructor() const
 {
-   m_isConstructorCached = 1;
-
    if (m_impl->classDef) {
       if (m_impl->isDMember) { // for D
-         m_isConstructorCached = name() == "this" ? 2 : 1;
-         return;
+         return name() == "this" ? 2 : 1;
 
       } else if (getLanguage() == SrcLangExt_PHP) { // for PHP
-         m_isConstructorCached = name() == "__construct" ? 2 : 1;
-         return;
+         return name() == "__construct" ? 2 : 1;
 
       } else if (name() == "__init__" &&
                  getLanguage() == SrcLangExt_Python) { // for Python
-         m_isConstructorCached = 2; // true
-         return;
+         return 2; // true
 
       } else if (getLanguage() == SrcLangExt_Tcl) { // for Tcl
-         m_isConstructorCached = name() == "constructor" ? 2 : 1;
-         return;
+         return name() == "constructor" ? 2 : 1;
 
       } else { // for other languages
          QString locName = m_impl->classDef->localName();
          int i = locName.indexOf('<');
 
          if (i == -1) { // not a template class
-            m_isConstructorCached = name() == locName ? 2 : 1;
+            return name() == locName ? 2 : 1;
          } else {
-            m_isConstructorCached = name() == locName.left(i) ? 2 : 1;
+            return name() == locName.left(i) ? 2 : 1;
          }
-
-         return;
       }
    }
+
+   return 1;
 }
 
 bool MemberDef::isConstructor() const
 {
-   if (m_isConstructorCached == 0) {
-      computeIsConstructor();
+   uchar isConstructor = m_isConstructorCached;
+
+   if (isConstructor == 0) {
+      isConstructor = computeIsConstructor();
+      m_isConstructorCached = isConstructor;
    }
-   assert(m_isConstructorCached > 0);
 
-   return m_isConstructorCached == 2;
+   assert(isConstructor > 0);
+
+   return isConstructor == 2;
 }
 
-void MemberDef::computeIsDestructor() const
+uchar MemberDef::computeIsDestructor() const
 {
    bool isDestructor;
 
@@ -4050,18 +4062,21 @@ void MemberDef::computeIsDestructor() const
        // The ! is for C++/CLI
    }
 
-   m_isDestructorCached = isDestructor ? 2 : 1;
+   return isDestructor ? 2 : 1;
 }
 
 bool MemberDef::isDestructor() const
 {
-   if (m_isDestructorCached == 0) {
-      computeIsDestructor();
+   uchar isDestructor = m_isDestructorCached;
+
+   if (isDestructor == 0) {
+      isDestructor = computeIsDestructor();
+      m_isDestructorCached = isDestructor;
    }
 
-   assert(m_isDestructorCached > 0);
+   assert(isDestructor > 0);
 
-   return m_isDestructorCached == 2;
+   return isDestructor == 2;
 }
 
 void MemberDef::writeEnumDeclaration(OutputList &typeDecl, QSharedPointer<ClassDef> cd,
@@ -4940,21 +4955,25 @@ QSharedPointer<MemberDef> MemberDef::templateMaster() const
 
 bool MemberDef::isTypedefValCached() const
 {
+   QMutexLocker locker(&s_typeCacheLock);
    return m_impl->isTypedefValCached;
 }
 
 QSharedPointer<ClassDef> MemberDef::getCachedTypedefVal() const
 {
+   QMutexLocker locker(&s_typeCacheLock);
    return m_impl->cachedTypedefValue;
 }
 
 QString MemberDef::getCachedTypedefTemplSpec() const
 {
+   QMutexLocker locker(&s_typeCacheLock);
    return m_impl->cachedTypedefTemplSpec;
 }
 
 QString MemberDef::getCachedResolvedTypedef() const
 {
+   QMutexLocker locker(&s_typeCacheLock);
    return m_impl->cachedResolvedType;
 }
 
@@ -5157,6 +5176,7 @@ void MemberDef::setGroupAlias(QSharedPointer<MemberDef> md)
 
 void MemberDef::invalidateTypedefValCache()
 {
+   QMutexLocker locker(&s_typeCacheLock);
    m_impl->isTypedefValCached = false;
 }
 
@@ -5203,6 +5223,8 @@ QString MemberDef::enumBaseType() const
 
 void MemberDef::cacheTypedefVal(QSharedPointer<ClassDef> val, const QString &templSpec, const QString &resolvedType)
 {
+   QMutexLocker locker(&s_typeCacheLock);
+
    m_impl->isTypedefValCached = true;
    m_impl->cachedTypedefValue = val;
    m_impl->cachedTypedefTemplSpec = templSpec;
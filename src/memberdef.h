@@ -426,9 +426,9 @@ class MemberDef : public Definition
    void saveToDisk() const;
    void makeResident() const;
 
-   void computeLinkableInProject() const;
-   void computeIsConstructor() const;
-   void computeIsDestructor() const;
+   uchar computeLinkableInProject() const;
+   uchar computeIsConstructor() const;
+   uchar computeIsDestructor() const;
 
    void _writeGroupInclude(OutputList &ol, bool inGroup);
    void _writeCallGraph(OutputList &ol);
@@ -445,7 +445,8 @@ class MemberDef : public Definition
    void _writeTagData(const DefType);
    void _addToSearchIndex();
 
-   static int s_indentLevel;
+   // nesting of anonymous types, per thread since pages are written on several threads
+   static thread_local int s_indentLevel;
     
    void writeLink(OutputList &ol, QSharedPointer<ClassDef> cd, QSharedPointer<NamespaceDef> nd, 
                   QSharedPointer<FileDef> fd, QSharedPointer<GroupDef> gd, bool onlyText = false);
@@ -42,8 +42,6 @@ MemberGroup::MemberGroup(QSharedPointer<Definition> parent, int id, const QStrin
    doc             = d;
    
    inSameSection   = true;
-   m_numDecMembers = -1;
-   m_numDocMembers = -1;
    
    m_docFile       = docFile;
    m_docLine       = docLine;
@@ -160,21 +158,15 @@ void MemberGroup::addToDeclarationSection()
 
 int MemberGroup::countDecMembers(QSharedPointer<GroupDef> gd)
 {
-   if (m_numDecMembers == -1) { 
-      /* number of member not cached */
-      memberList->countDecMembers(gd);
-      m_numDecMembers = memberList->numDecMembers();
-   }
-   return m_numDecMembers;
+   // the member list caches the count
+   memberList->countDecMembers(gd);
+   return memberList->numDecMembers();
 }
 
 int MemberGroup::countDocMembers()
 {
-   if (m_numDocMembers == -1) {
-      memberList->countDocMembers();
-      m_numDocMembers = memberList->numDocMembers();
-   }
-   return m_numDocMembers;
+   memberList->countDocMembers();
+   return memberList->numDocMembers();
 }
 
 int MemberGroup::countInheritableMembers(QSharedPointer<ClassDef> inheritedFrom) const
@@ -137,8 +137,6 @@ class MemberGroup : public EnableSharedFromThis
    QSharedPointer<Definition> m_parent;
   
    bool inSameSection;
-   int  m_numDecMembers;
-   int  m_numDocMembers; 
 
    QList<ListItemInfo> *m_xrefListItems;
 };
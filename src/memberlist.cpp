@@ -15,6 +15,7 @@
  *
 *************************************************************************/
 
+#include <QMutex>
 #include <QRegExp>
 
 #include <memberlist.h>
@@ -111,19 +112,32 @@ int MemberList::countInheritableMembers(QSharedPointer<ClassDef> inheritedFrom)
    return count;
 }
 
+// the lists of base classes are counted by every page which shows inherited members
+static QMutex s_countLock;
+
 /*! Count the number of members in this list that are visible in
  *  the declaration part of a compound's documentation page.
  */
 void MemberList::countDecMembers(bool countEnumValues, QSharedPointer<GroupDef> gd)
 {
-   if (m_numDecMembers != -1) {
-      return;
+   {
+      QMutexLocker locker(&s_countLock);
+
+      if (m_numDecMembers != -1) {
+         return;
+      }
    }
 
-   //printf("----- countDecMembers count=%d ----\n",count());
-   m_varCnt  = m_funcCnt = m_enumCnt = m_enumValCnt = 0;
-   m_typeCnt = m_protoCnt = m_defCnt = m_friendCnt = 0;
-   m_numDecMembers = 0;
+   // counted without the lock, the member groups count their own lists
+   int varCnt        = 0;
+   int funcCnt       = 0;
+   int enumCnt       = 0;
+   int enumValCnt    = 0;
+   int typeCnt       = 0;
+   int protoCnt      = 0;
+   int defCnt        = 0;
+   int friendCnt     = 0;
+   int numDecMembers = 0;
 
    for (auto md : *this) {
       
@@ -132,7 +146,7 @@ void MemberList::countDecMembers(bool countEnumValues, QSharedPointer<GroupDef>
             case MemberType_Variable:    // fall through
             case MemberType_Event:       // fall through
             case MemberType_Property:
-               m_varCnt++, m_numDecMembers++;
+               varCnt++, numDecMembers++;
                break;
 
             // apparently necessary to get this to show up in declarations section?
@@ -143,21 +157,21 @@ void MemberList::countDecMembers(bool countEnumValues, QSharedPointer<GroupDef>
             case MemberType_DCOP:        // fall through
             case MemberType_Slot:
                if (!md->isRelated() || md->getClassDef()) {
-                  m_funcCnt++, m_numDecMembers++;
+                  funcCnt++, numDecMembers++;
                }
                break;
 
             case MemberType_Enumeration:
-               m_enumCnt++, m_numDecMembers++;
+               enumCnt++, numDecMembers++;
                break;
 
             case MemberType_EnumValue:
                if (countEnumValues) {
-                  m_enumValCnt++, m_numDecMembers++;
+                  enumValCnt++, numDecMembers++;
                }
                break;
             case MemberType_Typedef:
-               m_typeCnt++, m_numDecMembers++;
+               typeCnt++, numDecMembers++;
                break;
 
             //case MemberType_Prototype:   m_protoCnt++,m_numDecMembers++; break;
@@ -165,12 +179,12 @@ void MemberList::countDecMembers(bool countEnumValues, QSharedPointer<GroupDef>
             case MemberType_Define:
                if (Config::getBool("extract-all") || ! md->argsString().isEmpty() ||
                       ! md->initializer().isEmpty() || md->hasDocumentation()) {
-                  m_defCnt++, m_numDecMembers++;
+                  defCnt++, numDecMembers++;
                }
                break;
 
             case MemberType_Friend:
-               m_friendCnt++, m_numDecMembers++;
+               friendCnt++, numDecMembers++;
                break;
 
             default:
@@ -183,35 +197,53 @@ void MemberList::countDecMembers(bool countEnumValues, QSharedPointer<GroupDef>
       for (auto &mg : *memberGroupList) {
          mg.countDecMembers(gd);
 
-         m_varCnt        += mg.varCount();
-         m_funcCnt       += mg.funcCount();
-         m_enumCnt       += mg.enumCount();
-         m_enumValCnt    += mg.enumValueCount();
-         m_typeCnt       += mg.typedefCount();
-         m_protoCnt      += mg.protoCount();
-         m_defCnt        += mg.defineCount();
-         m_friendCnt     += mg.friendCount();
-         m_numDecMembers += mg.numDecMembers();
+         varCnt        += mg.varCount();
+         funcCnt       += mg.funcCount();
+         enumCnt       += mg.enumCount();
+         enumValCnt    += mg.enumValueCount();
+         typeCnt       += mg.typedefCount();
+         protoCnt      += mg.protoCount();
+         defCnt        += mg.defineCount();
+         friendCnt     += mg.friendCount();
+         numDecMembers += mg.numDecMembers();
       }
    }
-   
+
+   QMutexLocker locker(&s_countLock);
+
+   if (m_numDecMembers == -1) {
+      m_varCnt     = varCnt;
+      m_funcCnt    = funcCnt;
+      m_enumCnt    = enumCnt;
+      m_enumValCnt = enumValCnt;
+      m_typeCnt    = typeCnt;
+      m_protoCnt   = protoCnt;
+      m_defCnt     = defCnt;
+      m_friendCnt  = friendCnt;
+
+      m_numDecMembers = numDecMembers;
+   }
 }
 
 void MemberList::countDocMembers(bool countEnumValues)
 {
-   if (m_numDocMembers != -1) {
-      return;   // used cached value
+   {
+      QMutexLocker locker(&s_countLock);
+
+      if (m_numDocMembers != -1) {
+         return;   // used cached value
+      }
    }
 
-   m_numDocMembers = 0;
-  
+   int numDocMembers = 0;
+
    for (auto md : *this) {
 
       if (md->isDetailedSectionVisible(m_inGroup, m_inFile)) {       
          // do not count enum values, since they do not produce entries of their own
 
          if (countEnumValues || md->memberType() != MemberType_EnumValue) {
-            m_numDocMembers++;
+            numDocMembers++;
          }
       }
    }
@@ -219,9 +251,15 @@ void MemberList::countDocMembers(bool countEnumValues)
    if (memberGroupList) {     
       for (auto &mg : *memberGroupList) {
          mg.countDocMembers();
-         m_numDocMembers += mg.numDocMembers();
+         numDocMembers += mg.numDocMembers();
       }
-   }   
+   }
+
+   QMutexLocker locker(&s_countLock);
+
+   if (m_numDocMembers == -1) {
+      m_numDocMembers = numDocMembers;
+   }
 }
 
 bool MemberList::declVisible() const
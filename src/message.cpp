@@ -125,6 +125,12 @@ void Debug::print(DebugMask mask, int data, const QString &fmt, ...)
 static QString outputFormat;
 static FILE *warnFile = stderr;
 
+// warnings of the calling thread are held back in this buffer, see captureWarnings()
+static thread_local QString *s_warnBuffer = nullptr;
+
+// progress messages of the calling thread, see captureMessages()
+static thread_local QString *s_msgBuffer = nullptr;
+
 void initWarningFormat()
 {
    outputFormat = Config::getString("warn-format");
@@ -145,6 +151,30 @@ void initWarningFormat()
    }
 }
  
+void captureWarnings(QString *buffer)
+{
+   s_warnBuffer = buffer;
+}
+
+void printWarnings(const QString &text)
+{
+   QByteArray data = text.toUtf8();
+   fwrite(data.constData(), 1, data.length(), warnFile);
+}
+
+void captureMessages(QString *buffer)
+{
+   s_msgBuffer = buffer;
+}
+
+void printMessages(const QString &text)
+{
+   if (! Config::getBool("quiet")) {
+      QByteArray data = text.toUtf8();
+      fwrite(data.constData(), 1, data.length(), stdout);
+   }
+}
+
 static void format_warn(const QString &file, int line, const QString &text)
 {
    QString fileSubst = file;
@@ -177,6 +207,11 @@ static void format_warn(const QString &file, int line, const QString &text)
    msgText = substitute(msgText, "$version", versionSubst) + "\n";
    
    // print resulting message
+   if (s_warnBuffer != nullptr) {
+      s_warnBuffer->append(msgText);
+      return;
+   }
+
    fwrite(msgText.toUtf8().constData(), 1, msgText.length(), warnFile);
 }
 
@@ -212,7 +247,18 @@ void err(const QString &fmt, ...)
    va_start(args, fmt);
 
    QString temp = "Error: ";   
-   vfprintf(warnFile, (temp + fmt).toUtf8().constData(), args);
+
+   if (s_warnBuffer != nullptr) {
+      const int bufSize = 40960;
+
+      QByteArray text(bufSize, '\0');
+      vsnprintf(text.data(), bufSize, (temp + fmt).toUtf8().constData(), args);
+
+      s_warnBuffer->append(QString::fromUtf8(text.constData()));
+
+   } else {
+      vfprintf(warnFile, (temp + fmt).toUtf8().constData(), args);
+   }
 
    va_end(args);
 }
@@ -224,7 +270,18 @@ void msg(const QString &fmt, ...)
       va_list args;
       va_start(args, fmt);
 
-      vfprintf(stdout, fmt.toUtf8().constData(), args);
+      if (s_msgBuffer != nullptr) {
+         const int bufSize = 40960;
+
+         QByteArray text(bufSize, '\0');
+         vsnprintf(text.data(), bufSize, fmt.toUtf8().constData(), args);
+
+         s_msgBuffer->append(QString::fromUtf8(text.constData()));
+
+      } else {
+         vfprintf(stdout, fmt.toUtf8().constData(), args);
+      }
+
       va_end(args);
    }
 }
@@ -66,6 +66,22 @@ void warnMsg(const QString &fmt, ...);
 
 void initWarningFormat();
 
+/** Appends the warnings and errors of the calling thread to \a buffer instead of writing them,
+ *  passing a null pointer writes them again. Used by the parse worker threads.
+ */
+void captureWarnings(QString *buffer);
+
+/** Writes warnings which were held back by captureWarnings() */
+void printWarnings(const QString &text);
+
+/** Appends the progress messages of the calling thread to \a buffer instead of printing them,
+ *  passing a null pointer prints them again. Used by the compound worker threads.
+ */
+void captureMessages(QString *buffer);
+
+/** Prints messages which were held back by captureMessages() */
+void printMessages(const QString &text);
+
 void printlex(int dbg, bool enter, const QString &lexName, const QString &fileName);
 
 void warn(const QString &file, int line, const QString &fmt, ...);
@@ -16,6 +16,9 @@
 *************************************************************************/
 
 #include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QTextStream>
 
 #include <config.h>
@@ -24,10 +27,16 @@
 #include <message.h>
 #include <msc.h>
 #include <portable.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 static const int maxCmdLine = 40960;
 
+// output file to the id of the job writing it, a diagram used on several pages is generated once
+static QHash<QString, int> s_mscJobs;
+static QMutex s_mscJobsLock;
+static QMutex s_mscMapLock;
+
 static bool convertMapFile(QTextStream &t, const QString &mapName, const QString &relPath, const QString &context)
 {
    QFile f(mapName);
@@ -101,12 +110,11 @@ static bool convertMapFile(QTextStream &t, const QString &mapName, const QString
 
 void writeMscGraphFromFile(const QString &inFile, const QString &outDir, const QString &outFile, MscOutputFormat format)
 {
-   QString absOutFile = outDir + "/" + outFile; 
- 
-   // move to output dir so dot can find the font file
-   QString oldDir = QDir::currentPath(); 
-   QDir::setCurrent(outDir);
-   
+   // mscgen runs in the output directory so it can find the font file, pages are written on several
+   // threads so the current directory of the process is not changed
+   QDir dir(outDir);
+   QString workDir = dir.absolutePath();
+
    QString mscExe = Config::getString("mscgen-path") + "mscgen" + portable_commandExtension();
 
    QString mscArgs;
@@ -129,10 +137,19 @@ void writeMscGraphFromFile(const QString &inFile, const QString &outDir, const Q
          break;
 
       default:
-         QDir::setCurrent(oldDir);
          return;
    }
 
+   QMutexLocker locker(&s_mscJobsLock);
+
+   QString outputPath = dir.absoluteFilePath(outFile + extension);
+
+   if (s_mscJobs.contains(outputPath)) {
+      return;
+   }
+
+   s_mscJobs.insert(outputPath, -1);
+
    mscArgs += " -i \"";
    mscArgs += inFile;
 
@@ -140,65 +157,70 @@ void writeMscGraphFromFile(const QString &inFile, const QString &outDir, const Q
    mscArgs += outFile;
    mscArgs += extension + "\"";
 
-   int exitCode;
-   
-   portable_sysTimerStart();
-   if ((exitCode = portable_system(mscExe, mscArgs, false)) != 0) {
-      portable_sysTimerStop();
-     
-      QDir::setCurrent(oldDir);
+   bool toPdf = (format == MSC_EPS) && Config::getBool("latex-pdf");
+
+   QStringList outputs;
+   outputs.append(outputPath);
+
+   if (toPdf) {
+      outputs.append(dir.absoluteFilePath(outFile + ".pdf"));
+   }
+
+   // skip the diagram when neither the source nor the command changed since the last run
+   QString sigFile   = dir.absoluteFilePath(outFile + ".md5");
+   QString signature = ToolExecutor::signature(dir.absoluteFilePath(inFile), mscExe + " " + mscArgs);
+
+   if (ToolExecutor::isUpToDate(sigFile, signature, outputs)) {
       return;
    }
 
-   portable_sysTimerStop();
+   // the image is not needed until the output is complete, mscgen runs in the background
+   ToolExecutor *executor = ToolExecutor::instance();
 
-   if ( (format == MSC_EPS) && (Config::getBool("latex-pdf")) ) {
+   int id = executor->submit("mscgen", mscExe, mscArgs, QString("Unable to run mscgen on %1").arg(inFile),
+                  QList<int>(), false, workDir);
 
+   if (toPdf) {
       QString epstopdfArgs;
       epstopdfArgs = QString("\"%1.eps\" --outfile=\"%2.pdf\"").arg(outFile).arg(outFile);
 
-      portable_sysTimerStart();
-      if (portable_system("epstopdf", epstopdfArgs) != 0) {
-         err("Unable to run epstopdf. Verify your TeX installation\n");
-      }
-
-      portable_sysTimerStop();
+      id = executor->submit("epstopdf", "epstopdf", epstopdfArgs, "Unable to run epstopdf. Verify your TeX installation",
+                  QList<int>() << id, true, workDir);
    }
 
-   QDir::setCurrent(oldDir);
+   executor->storeSignature(id, sigFile, signature);
+   s_mscJobs.insert(outputPath, id);
 }
 
 QString getMscImageMapFromFile(const QString &inFile, const QString &outDir, const QString &relPath, const QString &context)
 {
    QString result;
 
+   QDir dir(outDir);
    QString outFile = inFile + ".map";
-   
-   // move to the output directory so dot can find the font file
-   QString oldDir = QDir::currentPath();
-   QDir::setCurrent(outDir);
-  
+
    QString mscExe  = Config::getString("mscgen-path") + "mscgen" + portable_commandExtension();
    QString mscArgs = "-T ismap -i \"" + inFile + "\" -o \"" + outFile + "\"";
 
+   // pages with the same diagram would write the same map file
+   QMutexLocker locker(&s_mscMapLock);
+
    portable_sysTimerStart();
-   int exitCode = portable_system(mscExe, mscArgs, false);
+   int exitCode = ToolExecutor::instance()->run("mscgen", mscExe, mscArgs, false, dir.absolutePath());
    portable_sysTimerStop();
 
    if (exitCode == 0) {         
       QTextStream tmpout(&result);
    
-      convertMapFile(tmpout, outFile, relPath, context);
-      QDir().remove(outFile); 
+      convertMapFile(tmpout, dir.absoluteFilePath(outFile), relPath, context);
+      dir.remove(outFile);
    }
-  
-   QDir::setCurrent(oldDir);
 
    return result;
 }
 
 void writeMscImageMapFromFile(QTextStream &t, const QString &inFile, const QString &outDir, const QString &relPath, 
-                  const QString &baseName, const QString &context, MscOutputFormat format)
+                  const QString &baseName, const QString &context, MscOutputFormat format, const QString &patchFile)
 {
    QString mapName = baseName + ".map";
   
@@ -221,7 +243,166 @@ void writeMscImageMapFromFile(QTextStream &t, const QString &inFile, const QStri
    t << "\" alt=\""
      << baseName << "\" border=\"0\" usemap=\"#" << mapName << "\"/>" << endl;
 
-   QString imap = getMscImageMapFromFile(inFile, outDir, relPath, context);
-   t << "<map name=\"" << mapName << "\" id=\"" << mapName << "\">" << imap << "</map>" << endl;
+   if (patchFile.isEmpty()) {
+      QString imap = getMscImageMapFromFile(inFile, outDir, relPath, context);
+      t << "<map name=\"" << mapName << "\" id=\"" << mapName << "\">" << imap << "</map>" << endl;
+
+   } else {
+      // the map is inserted into the page by MscManager::run() after mscgen has finished
+      int mapId = MscManager::instance()->addMap(patchFile, inFile, outDir, baseName, relPath, context);
+
+      t << "<map name=\"" << mapName << "\" id=\"" << mapName << "\">" << endl;
+      t << "<!-- MSCMAP " << mapId << " -->" << endl;
+      t << "</map>" << endl;
+   }
+}
+
+MscManager *MscManager::instance()
+{
+   static MscManager manager;
+   return &manager;
+}
+
+int MscManager::addMap(const QString &patchFile, const QString &inFile, const QString &outDir, const QString &baseName,
+                  const QString &relPath, const QString &context)
+{
+   QMutexLocker locker(&m_mutex);
+
+   QDir dir(outDir);
+
+   QString mscExe  = Config::getString("mscgen-path") + "mscgen" + portable_commandExtension();
+   QString mscArgs = "-T ismap -i \"" + inFile + "\" -o \"" + baseName + ".map\"";
+
+   Map map;
+   map.mapFile = dir.absoluteFilePath(baseName + ".map");
+   map.relPath = relPath;
+   map.context = context;
+   map.jobId   = -1;
+
+   // the map file is kept to detect if the diagram changed
+   QString sigFile   = map.mapFile + ".md5";
+   QString signature = ToolExecutor::signature(dir.absoluteFilePath(inFile), mscExe + " " + mscArgs);
+
+   if (m_mapJobs.contains(map.mapFile)) {
+      // the same diagram on another page, use the pending job
+      map.jobId = m_mapJobs.value(map.mapFile);
+
+   } else if (! ToolExecutor::isUpToDate(sigFile, signature, QStringList() << map.mapFile)) {
+      ToolExecutor *executor = ToolExecutor::instance();
+
+      map.jobId = executor->submit("mscgen", mscExe, mscArgs, QString(), QList<int>(), false, dir.absolutePath());
+      executor->storeSignature(map.jobId, sigFile, signature);
+   }
+
+   m_mapJobs.insert(map.mapFile, map.jobId);
+
+   QList<Map> &maps = m_maps[patchFile];
+   maps.append(map);
+
+   return maps.count() - 1;
+}
+
+int MscManager::count() const
+{
+   return m_maps.count();
+}
+
+bool MscManager::run()
+{
+   bool retval = true;
+
+   // wait for mscgen, a map which could not be generated is left empty as before
+   for (auto &maps : m_maps) {
+      for (auto &map : maps) {
+         if (map.jobId != -1 && ToolExecutor::instance()->wait(map.jobId) != 0) {
+            map.mapFile = QString();
+         }
+      }
+   }
+
+   int i = 1;
+
+   for (auto iter = m_maps.begin(); iter != m_maps.end(); ++iter) {
+      msg("Patching output file %d/%d\n", i, m_maps.count());
+
+      if (! patchFile(iter.key(), iter.value())) {
+         retval = false;
+      }
+
+      ++i;
+   }
+
+   m_maps.clear();
+   m_mapJobs.clear();
+
+   return retval;
 }
 
+bool MscManager::patchFile(const QString &fileName, const QList<Map> &maps)
+{
+   QFile f(fileName);
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      err("Unable to open file for updating %s, error: %d\n", csPrintable(fileName), f.error());
+      return false;
+   }
+
+   QString contents = QString::fromUtf8(f.readAll());
+   f.close();
+
+   QString result;
+   QTextStream t(&result);
+
+   const QString marker = "<!-- MSCMAP ";
+
+   int pos = 0;
+   int i;
+
+   while ((i = contents.indexOf(marker, pos)) != -1) {
+      t << contents.mid(pos, i - pos);
+
+      int e = contents.indexOf("-->", i);
+
+      bool ok   = false;
+      int mapId = -1;
+
+      if (e != -1) {
+         mapId = contents.mid(i + marker.length(), e - i - marker.length()).trimmed().toInt(&ok);
+      }
+
+      if (! ok || mapId < 0 || mapId >= maps.count()) {
+         err("Invalid MSCMAP id found in file %s\n", csPrintable(fileName));
+
+         t << marker;
+         pos = i + marker.length();
+
+         continue;
+      }
+
+      const Map &map = maps.at(mapId);
+
+      if (! map.mapFile.isEmpty()) {
+         convertMapFile(t, map.mapFile, map.relPath, map.context);
+      }
+
+      // skip the marker and the line break which follows it
+      pos = e + 3;
+
+      if (pos < contents.length() && contents.at(pos) == '\n') {
+         ++pos;
+      }
+   }
+
+   t << contents.mid(pos);
+   t.flush();
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for updating %s, error: %d\n", csPrintable(fileName), f.error());
+      return false;
+   }
+
+   f.write(result.toUtf8());
+   f.close();
+
+   return true;
+}
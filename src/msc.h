@@ -19,17 +19,60 @@
 #define MSC_H
 
 #include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
 #include <QTextStream>
 
 
 enum MscOutputFormat { MSC_BITMAP , MSC_EPS, MSC_SVG };
 
+/** Converts an msc file to an image, mscgen runs in the background and is skipped if the source did not change */
 void writeMscGraphFromFile(const QString &inFile, const QString &outDir, const QString &outFile, MscOutputFormat format);
 
 QString getMscImageMapFromFile(const QString &nFile, const QString &outDir, const QString &relPath, const QString &contxt);
 
+/** Writes the image and its map, when \a patchFile is not empty the map is inserted into this file by MscManager::run() */
 void writeMscImageMapFromFile(QTextStream &t, const QString &inFile, const QString &outDir, const QString &relPath,
-                  const QString &baseName, const QString &context, MscOutputFormat format );
+                  const QString &baseName, const QString &context, MscOutputFormat format, const QString &patchFile = QString());
+
+/** Generates the image maps of msc diagrams in the background and inserts them into the HTML pages */
+class MscManager
+{
+ public:
+   static MscManager *instance();
+
+   /** Adds a map for \a inFile to \a patchFile, returns the id used in the <!-- MSCMAP id --> marker */
+   int addMap(const QString &patchFile, const QString &inFile, const QString &outDir, const QString &baseName,
+                  const QString &relPath, const QString &context);
+
+   /** Number of files which need to be patched */
+   int count() const;
+
+   /** Waits for mscgen and inserts the maps, the pages must be written */
+   bool run();
+
+ private:
+   struct Map {
+      QString mapFile;
+      QString relPath;
+      QString context;
+      int     jobId;
+   };
+
+   MscManager() {}
+
+   bool patchFile(const QString &fileName, const QList<Map> &maps);
+
+   QMap<QString, QList<Map>> m_maps;
+
+   // map file to the id of the mscgen job writing it, -1 when the map is up to date
+   QHash<QString, int> m_mapJobs;
+
+   QMutex m_mutex;
+};
 
 #endif
 
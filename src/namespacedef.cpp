@@ -17,6 +17,7 @@
 
 #include <namespacedef.h>
 
+#include <buildstate.h>
 #include <config.h>
 #include <classdef.h>
 #include <docparser.h>
@@ -534,6 +535,8 @@ void NamespaceDef::writeDocumentation(OutputList &ol)
    QSharedPointer<NamespaceDef> self = sharedFrom(this);
    static bool generateTreeView = Config::getBool("generate-treeview");
 
+   BuildState::addDependency(getDefFileName());
+
    // static bool outputJava = Config::getBool("optimize-java");
    // static bool fortranOpt = Config::_getBool("optimize-fortran");
 
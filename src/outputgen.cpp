@@ -20,41 +20,44 @@
 #include <stdlib.h>
 #include <cassert>
 
+#include <buildstate.h>
 #include <doxy_globals.h>
 #include <outputgen.h>
 #include <message.h>
 
 OutputGenerator::OutputGenerator()
 {
-   m_filePtr = nullptr;
-   active    = true;   
+   active = true;   
 }
 
 OutputGenerator::~OutputGenerator()
 {
-   delete m_filePtr;   
 }
 
 void OutputGenerator::startPlainFile(const QString &name)
 {
    m_fileName = m_dir + "/" + name;
-   m_filePtr  = new QFile(m_fileName);
 
-   if (! m_filePtr->open(QIODevice::WriteOnly)) {   
-      err("Unable to open file for writing %s, error: %d\n", qPrintable(m_fileName), m_filePtr->error());
-      Doxy_Work::stopDoxyPress();
-   }
+   // the file is only opened by the OutputFileWriter, an incremental build may not need to write it
+   BuildState::addPage(m_fileName);
+
+   // page is generated in memory and written by the OutputFileWriter
+   m_fileBuffer.setData(QByteArray());
+   m_fileBuffer.open(QIODevice::WriteOnly);
 
-   m_textStream.setDevice(m_filePtr);
+   m_textStream.setDevice(&m_fileBuffer);
 }
 
 void OutputGenerator::endPlainFile()
 {
+   m_textStream.flush();
    m_textStream.setDevice(0);
 
-   delete m_filePtr;
+   m_fileBuffer.close();
+
+   OutputFileWriter::instance()->write(m_fileName, m_fileBuffer.data());
+   m_fileBuffer.setData(QByteArray());
 
-   m_filePtr  = nullptr;
    m_fileName = "";
 }
 
@@ -76,3 +79,94 @@ void OutputGenerator::popGeneratorState()
    }  
 }
 
+// limits the memory used by pages waiting to be written
+static const int s_maxPendingFiles = 64;
+
+OutputFileWriter *OutputFileWriter::instance()
+{
+   // pages are queued from several threads when source files are written in parallel
+   static OutputFileWriter *theInstance = new OutputFileWriter;
+   return theInstance;
+}
+
+OutputFileWriter::OutputFileWriter()
+{
+}
+
+void OutputFileWriter::write(const QString &fileName, const QByteArray &data)
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (! isRunning()) {
+      start();
+   }
+
+   while (m_queue.count() >= s_maxPendingFiles) {
+      m_notFull.wait(&m_mutex);
+   }
+
+   Job job;
+   job.fileName = fileName;
+   job.data     = data;
+
+   m_queue.enqueue(job);
+   m_notEmpty.wakeAll();
+}
+
+void OutputFileWriter::finish()
+{
+   {
+      QMutexLocker locker(&m_mutex);
+
+      if (! isRunning()) {
+         return;
+      }
+
+      // add terminator, an empty file name
+      Job job;
+
+      m_queue.enqueue(job);
+      m_notEmpty.wakeAll();
+   }
+
+   wait();
+}
+
+void OutputFileWriter::run()
+{
+   while (true) {
+      Job job;
+
+      {
+         QMutexLocker locker(&m_mutex);
+
+         while (m_queue.isEmpty()) {
+            // wait until something is added to the queue
+            m_notEmpty.wait(&m_mutex);
+         }
+
+         job = m_queue.dequeue();
+         m_notFull.wakeAll();
+      }
+
+      if (job.fileName.isEmpty()) {
+         break;
+      }
+
+      if (! BuildState::instance()->updateOutput(job.fileName, job.data)) {
+         // contents are identical to the last run, keep the existing file
+         continue;
+      }
+
+      QFile f(job.fileName);
+
+      if (! f.open(QIODevice::WriteOnly)) {
+         err("Unable to open file for writing %s, error: %d\n", qPrintable(job.fileName), f.error());
+         Doxy_Work::stopDoxyPress();
+      }
+
+      if (f.write(job.data) != job.data.size()) {
+         err("Unable to write file %s, error: %d\n", qPrintable(job.fileName), f.error());
+      }
+   }
+}
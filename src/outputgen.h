@@ -18,9 +18,15 @@
 #ifndef OUTPUTGEN_H
 #define OUTPUTGEN_H
 
+#include <QBuffer>
+#include <QByteArray>
 #include <QFile>
+#include <QMutex>
+#include <QQueue>
 #include <QStack>
 #include <QTextStream>
+#include <QThread>
+#include <QWaitCondition>
 
 #include <index.h>
 #include <section.h>
@@ -294,6 +300,40 @@ class BaseOutputDocInterface : public CodeOutputInterface
    virtual void endSubsubsection() = 0;
 };
 
+/** Writes finished output files on a background thread.
+ *
+ *  Pages are generated into memory and handed to this thread when complete,
+ *  so generating the next page overlaps with writing the previous one.
+ *  Files are written in the order they were queued, pages may be queued from several threads.
+ */
+class OutputFileWriter : public QThread
+{
+ public:
+   static OutputFileWriter *instance();
+
+   /** Queues \a data to be written to the file \a fileName */
+   void write(const QString &fileName, const QByteArray &data);
+
+   /** Waits until all queued files have been written */
+   void finish();
+
+   void run();
+
+ private:
+   OutputFileWriter();
+
+   struct Job {
+      QString    fileName;
+      QByteArray data;
+   };
+
+   QQueue<Job>     m_queue;
+
+   QWaitCondition  m_notEmpty;
+   QWaitCondition  m_notFull;
+   QMutex          m_mutex;
+};
+
 /** Abstract output generator.
  *
  *  Subclass this class to add support for a new output format
@@ -467,7 +507,7 @@ class OutputGenerator : public BaseOutputDocInterface
  protected:
    QTextStream m_textStream;
 
-   QFile   *m_filePtr;
+   QBuffer  m_fileBuffer;
    QString  m_fileName;
    QString  m_dir;
    bool     active;
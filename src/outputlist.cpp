@@ -19,6 +19,7 @@
 
 #include <config.h>
 #include <definition.h>
+#include <doccache.h>
 #include <docparser.h>
 #include <message.h>
 #include <outputgen.h>
@@ -29,6 +30,8 @@ OutputList::OutputList(bool)
 
 OutputList::~OutputList()
 {
+   // the list owns the generators, source workers create and delete a list of their own
+   qDeleteAll(m_outputs);
 }
 
 void OutputList::add(OutputGenerator *og)
@@ -117,16 +120,13 @@ bool OutputList::generateDoc(const QString &fileName, int startLine, QSharedPoin
       return true;   // no output formats enabled
    }
 
-   DocRoot *root = 0;
-   root = validatingParseDoc(fileName, startLine, ctx, md, docStr, indexWords, isExample, 
-                  exampleName, singleLine, linkFromIndex);
+   // the same documentation is written on several pages, the parsed tree is shared
+   QSharedPointer<DocRoot> root = DocCache::instance()->parse(fileName, startLine, ctx, md, docStr, indexWords,
+                  isExample, exampleName, singleLine, linkFromIndex);
 
-   writeDoc(root, ctx, md);
+   writeDoc(root.data(), ctx, md);
 
-   bool isEmpty = root->isEmpty();
-   delete root;
-
-   return isEmpty;
+   return root->isEmpty();
 }
 
 void OutputList::writeDoc(DocRoot *root, QSharedPointer<Definition> ctx, QSharedPointer<MemberDef> md)
@@ -796,4 +796,7 @@ class OutputList : public OutputDocInterface
    QList<OutputGenerator *> m_outputs;
 };
 
+/** Creates an output list with its own generators, one list is used by each worker thread which writes pages */
+typedef OutputList *(*OutputListFactory)();
+
 #endif
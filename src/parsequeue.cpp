@@ -0,0 +1,209 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+
+#include <QMutexLocker>
+
+#include <parsequeue.h>
+
+#include <config.h>
+#include <doxy_globals.h>
+#include <doxy_setup.h>
+#include <entry.h>
+#include <entrycache.h>
+#include <inputqueue.h>
+#include <message.h>
+#include <parser_base.h>
+#include <parser_cstyle.h>
+#include <scannerstate.h>
+
+ParseFileQueue::ParseFileQueue(const QStringList &fileList, InputFileQueue *inputQueue, int numThreads)
+   : m_fileList(fileList), m_slots(fileList.count()), m_nextIndex(0), m_takenIndex(0), m_stop(false),
+     m_inputQueue(inputQueue)
+{
+   numThreads = qMin(32, numThreads);
+
+   if (numThreads == 0) {
+      numThreads = qMax(2, QThread::idealThreadCount());
+   }
+
+   // limit how far the workers may run ahead of the merge, keeps memory bounded
+   m_window = 4 * numThreads;
+
+   // the preprocessor depends on the order of the files, it must not run on the workers
+   if (numThreads > 1 && fileList.count() > 1 && m_inputQueue->hasPrepareThread()) {
+
+      for (int i = 0; i < numThreads; i++) {
+         ParseWorkerThread *thread = new ParseWorkerThread(this);
+         thread->start();
+
+         if (thread->isRunning()) {
+            m_workers.append(thread);
+         } else {
+            // no more threads available
+            delete thread;
+         }
+      }
+   }
+}
+
+ParseFileQueue::~ParseFileQueue()
+{
+   {
+      QMutexLocker locker(&m_mutex);
+
+      m_stop = true;
+      m_slotFree.wakeAll();
+   }
+
+   for (auto thread : m_workers) {
+      thread->wait();
+      delete thread;
+   }
+}
+
+ParseFileQueue::Result ParseFileQueue::take(int index)
+{
+   if (m_workers.isEmpty()) {
+      // single threaded mode, the caller scans every file
+      Result retval;
+      retval.convBuf = m_inputQueue->take(index);
+
+      return retval;
+   }
+
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_slots[index].ready) {
+      m_slotReady.wait(&m_mutex);
+   }
+
+   Result retval;
+   qSwap(retval, m_slots[index].result);
+
+   if (index >= m_takenIndex) {
+      m_takenIndex = index + 1;
+      m_slotFree.wakeAll();
+   }
+
+   return retval;
+}
+
+int ParseFileQueue::claim()
+{
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_stop && m_nextIndex < m_fileList.count() && m_nextIndex >= m_takenIndex + m_window) {
+      // wait for the merge to catch up
+      m_slotFree.wait(&m_mutex);
+   }
+
+   if (m_stop || m_nextIndex >= m_fileList.count()) {
+      return -1;
+   }
+
+   return m_nextIndex++;
+}
+
+void ParseFileQueue::store(int index, const Result &result)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_slots[index].result = result;
+   m_slots[index].ready  = true;
+
+   m_slotReady.wakeAll();
+}
+
+ParseFileQueue::Result ParseFileQueue::scan(int index)
+{
+   const QString &fileName = m_fileList.at(index);
+
+   Result retval;
+   QString convBuf = m_inputQueue->take(index);
+
+   ParserInterface *parser = getParserForFile(fileName);
+
+   if (! parser->isThreadSafe()) {
+      retval.convBuf = convBuf;
+      return retval;
+   }
+
+   QSharedPointer<Entry> root = QMakeShared<Entry>();
+
+   // the scanner is skipped when the same input was parsed in a previous run
+   EntryCache *entryCache = EntryCache::instance();
+
+   QByteArray cacheKey;
+
+   if (entryCache->isEnabled()) {
+      cacheKey = entryCache->key(fileName, convBuf);
+
+      if (entryCache->load(cacheKey, root)) {
+         retval.root   = root;
+         retval.cached = true;
+
+         return retval;
+      }
+   }
+
+   QStringList includedFiles;
+
+   ScannerState::begin();
+   captureWarnings(&retval.warnings);
+
+   parser->parseInput(fileName, convBuf, root, ParserMode::SOURCE_FILE, includedFiles, false);
+
+   captureWarnings(nullptr);
+
+   if (ScannerState::usedShared()) {
+      // the scan skipped the shared state, the caller scans the file again in order
+      retval.convBuf = convBuf;
+      retval.warnings.clear();
+
+      return retval;
+   }
+
+   if (entryCache->isEnabled()) {
+      entryCache->store(cacheKey, root);
+   }
+
+   retval.root = root;
+
+   return retval;
+}
+
+ParseWorkerThread::ParseWorkerThread(ParseFileQueue *queue)
+   : m_queue(queue)
+{
+}
+
+void ParseWorkerThread::run()
+{
+   // scanners on this thread skip the state shared between files
+   ScannerState::setWorker(true);
+   Doxy_Globals::markdownSupport = Config::getBool("markdown");
+
+   int index;
+
+   while ((index = m_queue->claim()) != -1) {
+      m_queue->store(index, m_queue->scan(index));
+   }
+
+   // the scanner state of this thread
+   cstyleFreeParser();
+}
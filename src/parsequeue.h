@@ -0,0 +1,116 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+
+#ifndef PARSEQUEUE_H
+#define PARSEQUEUE_H
+
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+class Entry;
+class InputFileQueue;
+class ParseWorkerThread;
+
+/** Scans input files on a pool of parse worker threads.
+ *
+ *  The workers take the prepared input of each file from an InputFileQueue and scan it
+ *  into an Entry tree of its own, when the parser of the file is thread safe. The results
+ *  are handed out by take() strictly in the order of the file list and the caller merges
+ *  them into the tree of all files.
+ *
+ *  A worker never touches the state the scanners share between files (see ScannerState).
+ *  When a file needs this state, or its parser is not thread safe, only the input is
+ *  returned and the caller scans the file in order on its own thread. This keeps the
+ *  Entry tree identical to a serial run.
+ */
+class ParseFileQueue
+{
+ public:
+   /** Result of the parse workers for one input file */
+   struct Result {
+      Result() : cached(false) {}
+
+      QString convBuf;                 // scanner input, only set when the caller has to scan the file
+      QSharedPointer<Entry> root;      // entries of the file, null when the caller has to scan the file
+      QString warnings;                // warnings of the scan, printed by the caller when the entries are merged
+      bool    cached;                  // true if the entries were loaded from the entry cache
+   };
+
+   /** The workers are only started if \a inputQueue prepares the files on its own thread */
+   ParseFileQueue(const QStringList &fileList, InputFileQueue *inputQueue, int numThreads);
+   ~ParseFileQueue();
+
+   /** Returns the result for the file at position \a index, waits until a worker has scanned it */
+   Result take(int index);
+
+   int threadCount() const {
+      return m_workers.count();
+   }
+
+ private:
+   struct Slot {
+      Slot() : ready(false) {}
+
+      Result result;
+      bool   ready;
+   };
+
+   /** Returns the index of the next file to scan or -1 when all files have been claimed */
+   int claim();
+   void store(int index, const Result &result);
+
+   /** Scans the file at position \a index, called on a parse worker thread */
+   Result scan(int index);
+
+   QStringList   m_fileList;
+   QVector<Slot> m_slots;
+
+   int m_nextIndex;
+   int m_takenIndex;
+   int m_window;
+   bool m_stop;
+
+   InputFileQueue *m_inputQueue;
+
+   QWaitCondition m_slotReady;
+   QWaitCondition m_slotFree;
+   QMutex m_mutex;
+
+   QList<ParseWorkerThread *> m_workers;
+
+   friend class ParseWorkerThread;
+};
+
+/** Worker thread to scan input files for the ParseFileQueue */
+class ParseWorkerThread : public QThread
+{
+ public:
+   ParseWorkerThread(ParseFileQueue *queue);
+   void run();
+
+ private:
+   ParseFileQueue *m_queue;
+};
+
+#endif
@@ -30,6 +30,31 @@ class CodeOutputInterface;
 class MemberDef;
 class Definition;
 
+/** Returns the project options which change the Entry tree built by the language scanners,
+ *  the comment scanner and the markdown parser. The entry cache adds their values to the key.
+ *  Add the option here when a scanner starts reading it.
+ */
+inline QStringList scannerConfigOptions()
+{
+   static const QStringList list = {
+      // preprocessor and comment converter
+      "aliases", "enable-preprocessing", "include-path", "multiline-cpp-brief", "predefined-macros",
+
+      // language scanners
+      "cpp-cli-support", "extract-anon-namespaces", "group-nested-compounds", "hide-in-body-docs",
+      "idl-support", "javadoc-auto-brief", "language-mapping", "qt-auto-brief", "tab-size",
+      "tcl-subst", "use-typedef-name",
+
+      // comment scanner and markdown
+      "enabled-sections", "internal-docs", "markdown", "mdfile-mainpage", "output-language",
+
+      // defaults set by Entry::reset()
+      "dot-call", "dot-called-by"
+   };
+
+   return list;
+}
+
 /** \brief Abstract interface for programming language parsers.
  *
  *  By implementing the methods of this interface you can add a new language parser to DoxyPress. 
@@ -64,6 +89,27 @@ class ParserInterface
     */
    virtual bool needsPreprocessing(const QString &extension) = 0;
 
+   /** Returns true if parseInput() can run on a parse worker thread. The parser keeps its
+    *  state per thread and skips state shared between files when ScannerState::useShared()
+    *  returns false.
+    */
+   virtual bool isThreadSafe() const {
+      return false;
+   }
+
+   /** Called on the main thread, in the order of the input files, for each file which
+    *  parseInput() scanned on a parse worker thread.
+    */
+   virtual void finishWorkerInput() {
+   }
+
+   /** Returns true if parseCode() can run on several threads at once. The code parser keeps
+    *  its state per thread and all calls which change shared state are recorded by the caller.
+    */
+   virtual bool isCodeThreadSafe() const {
+      return false;
+   }
+
    /** Parses a source file or fragment with the goal to produce
     *  highlighted and cross-referenced output.
     *  @param[in] codeOutIntf Abstract interface for writing the result.
@@ -37,6 +37,10 @@ class CPPLanguageParser : public ParserInterface
 
    bool needsPreprocessing(const QString &extension) override;
 
+   bool isThreadSafe() const override;
+   void finishWorkerInput() override;
+   bool isCodeThreadSafe() const override;
+
    void parseCode(CodeOutputInterface &codeOutIntf, const QString &scopeName, const QString &input, SrcLangExt lang,
                   bool isExampleBlock, const QString &exampleName = QString(), 
                   QSharedPointer<FileDef> fileDef = QSharedPointer<FileDef>(),
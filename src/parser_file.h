@@ -34,6 +34,10 @@ class FileParser : public ParserInterface
       return false;
    }
 
+   bool isCodeThreadSafe() const override {
+      return true;
+   }
+
    void parseCode(CodeOutputInterface &codeOutIntf, const QString &scopeName, const QString &input, SrcLangExt lang,
                   bool isExampleBlock, const QString &exampleName = QString(), 
                   QSharedPointer<FileDef> fileDef = QSharedPointer<FileDef>(),
@@ -37,6 +37,10 @@ class FortranLanguageParser : public ParserInterface
 
    bool needsPreprocessing(const QString &extension) override;
 
+   bool isCodeThreadSafe() const override {
+      return true;
+   }
+
    void parseCode(CodeOutputInterface &codeOutIntf, const QString &scopeName, const QString &input, SrcLangExt lang,
                   bool isExampleBlock, const QString &exampleName = QString(), 
                   QSharedPointer<FileDef> fileDef = QSharedPointer<FileDef>(),
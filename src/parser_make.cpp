@@ -20,10 +20,11 @@
 #include <doxy_globals.h>
 #include <outputgen.h>
 
-static CodeOutputInterface     *g_code;
-static QString                 g_currentFontClass;
-static QSharedPointer<FileDef> g_sourceFileDef;
-static int                     g_yyLineNr;
+// per thread, code fragments are highlighted by the threads which write the pages
+static thread_local CodeOutputInterface     *g_code;
+static thread_local QString                 g_currentFontClass;
+static thread_local QSharedPointer<FileDef> g_sourceFileDef;
+static thread_local int                     g_yyLineNr;
 
 void MakeFileParser::parseCode(CodeOutputInterface &codeOutIntf, const QString &scopeName, const QString &input, 
          SrcLangExt xx, bool isExampleBlock, const QString &exampleName, QSharedPointer<FileDef> fileDef, int startLine, int endLine, 
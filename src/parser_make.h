@@ -38,6 +38,10 @@ class MakeFileParser : public ParserInterface
    
       bool needsPreprocessing(const QString &extension);
 
+      bool isCodeThreadSafe() const override {
+         return true;
+      }
+
       void parseCode(CodeOutputInterface &codeOutIntf, const QString &scopeName, const QString &input, SrcLangExt lang,
                   bool isExampleBlock, const QString &exampleName = QString(), 
                   QSharedPointer<FileDef> fileDef = QSharedPointer<FileDef>(),
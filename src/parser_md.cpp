@@ -29,6 +29,7 @@
 #include <doxy_globals.h>
 #include <entry.h>
 #include <message.h>
+#include <scannerstate.h>
 #include <util.h>
 
 struct LinkRef {
@@ -39,10 +40,10 @@ struct LinkRef {
 
 enum Alignment { AlignNone, AlignLeft, AlignCenter, AlignRight };
 
-static QHash<QString, LinkRef> g_linkRefs;
-static QSharedPointer<Entry>   g_current;
-static QString  g_fileName;
-static int      g_lineNr;
+static thread_local QHash<QString, LinkRef> g_linkRefs;
+static thread_local QSharedPointer<Entry>   g_current;
+static thread_local QString  g_fileName;
+static thread_local int      g_lineNr;
 
 // In case a markdown page starts with a level1 header, that header is used as a title of 
 // of the page, in effect making it a level0 header. So the level of all other sections 
@@ -1529,7 +1530,7 @@ static int isHRuler(const QString &data, int size)
 
 static QString extractTitleId(QString &title)
 {   
-   static QRegExp r2("\\{#[a-z_A-Z][a-z_A-Z0-9\\-]*\\}");
+   static thread_local QRegExp r2("\\{#[a-z_A-Z][a-z_A-Z0-9\\-]*\\}");
 
    int l = 0;
    int i = r2.indexIn(title);
@@ -2087,26 +2088,29 @@ void writeOneLineHeaderOrRuler(QString &out, const QString &data, int size)
          out += header;
          out += "\n";
 
-         QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict->find(id);
+         // on a parse worker the file is scanned again on the main thread
+         if (ScannerState::useShared()) {
+            QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict->find(id);
 
-         if (si) {
-            if (si->lineNr != -1) {
-               warn(g_fileName, g_lineNr, "Multiple use of section label '%s', (first occurrence: %s, line %d)", 
-                   qPrintable(header), csPrintable(si->fileName), si->lineNr);
+            if (si) {
+               if (si->lineNr != -1) {
+                  warn(g_fileName, g_lineNr, "Multiple use of section label '%s', (first occurrence: %s, line %d)", 
+                      qPrintable(header), csPrintable(si->fileName), si->lineNr);
+
+               } else {
+                  warn(g_fileName, g_lineNr, "Multiple use of section label '%s', (first occurrence: %s)", 
+                       qPrintable(header), csPrintable(si->fileName));
+               }
 
             } else {
-               warn(g_fileName, g_lineNr, "Multiple use of section label '%s', (first occurrence: %s)", 
-                    qPrintable(header), csPrintable(si->fileName));
-            }
+               si = QSharedPointer<SectionInfo> (new SectionInfo(g_fileName, g_lineNr, id, header, type, level));
 
-         } else {
-            si = QSharedPointer<SectionInfo> (new SectionInfo(g_fileName, g_lineNr, id, header, type, level));
+               if (g_current) {
+                  g_current->anchors->append(*si);
+               }
 
-            if (g_current) {
-               g_current->anchors->append(*si);
+               Doxy_Globals::sectionDict->insert(id, si);
             }
-
-            Doxy_Globals::sectionDict->insert(id, si);
          }
 
       } else {
@@ -2499,27 +2503,30 @@ static QString processBlocks(const QString &str, int indent)
                   out += header;
                   out += "\n\n";
 
-                  QSharedPointer<SectionInfo> si (Doxy_Globals::sectionDict->find(id));
+                  // on a parse worker the file is scanned again on the main thread
+                  if (ScannerState::useShared()) {
+                     QSharedPointer<SectionInfo> si (Doxy_Globals::sectionDict->find(id));
+
+                     if (si) {
+                        if (si->lineNr != -1) {
+                           warn(g_fileName, g_lineNr, "multiple use of section label '%s', (first occurrence: %s, line %d)", 
+                                qPrintable(header), qPrintable(si->fileName), si->lineNr);
 
-                  if (si) {
-                     if (si->lineNr != -1) {
-                        warn(g_fileName, g_lineNr, "multiple use of section label '%s', (first occurrence: %s, line %d)", 
-                             qPrintable(header), qPrintable(si->fileName), si->lineNr);
+                        } else {
+                           warn(g_fileName, g_lineNr, "multiple use of section label '%s', (first occurrence: %s)", 
+                                qPrintable(header), qPrintable(si->fileName));
+                        }
 
                      } else {
-                        warn(g_fileName, g_lineNr, "multiple use of section label '%s', (first occurrence: %s)", 
-                             qPrintable(header), qPrintable(si->fileName));
-                     }
+                        si = QSharedPointer<SectionInfo> (new SectionInfo(g_fileName, g_lineNr, id, header, 
+                                             level == 1 ? SectionInfo::Section : SectionInfo::Subsection, level));
 
-                  } else {
-                     si = QSharedPointer<SectionInfo> (new SectionInfo(g_fileName, g_lineNr, id, header, 
-                                          level == 1 ? SectionInfo::Section : SectionInfo::Subsection, level));
+                        if (g_current) {
+                           g_current->anchors->append(*si); 
+                        }
 
-                     if (g_current) {
-                        g_current->anchors->append(*si); 
+                        Doxy_Globals::sectionDict->insert(id, si);
                      }
-
-                     Doxy_Globals::sectionDict->insert(id, si);
                   }
 
                } else {
@@ -15,24 +15,29 @@
  *
 *************************************************************************/
 
+#include <QCryptographicHash>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
 
 #include <plantuml.h>
 
 #include <config.h>
 #include <portable.h>
 #include <message.h>
+#include <toolexecutor.h>
+#include <util.h>
 
 static const int maxCmdLine = 40960;
 
 QString writePlantUMLSource(const QString &outDir, const QString &fileName, const QString &content)
 {
    QString baseName;
-   static int umlindex = 1;
 
    if (fileName.isEmpty()) { 
-      // generate name
-      baseName = outDir + "/inline_umlgraph_" + QString::number(umlindex++);
+      // generate name, pages are written in any order so the name is taken from the contents
+      baseName = inlineGraphBaseName(outDir, "inline_umlgraph_", content);
 
    } else { 
       // user specified name
@@ -46,23 +51,214 @@ QString writePlantUMLSource(const QString &outDir, const QString &fileName, cons
       baseName.prepend(outDir + "/");
    }
 
-   QFile file(baseName + ".pu");
-
-   if (! file.open(QIODevice::WriteOnly)) {
-      err("Unable to open file for writing %s, error: %d\n", qPrintable(baseName), file.error());
-   }
-
    QString text = "@startuml";
    text += content;
    text += "@enduml\n";
 
-   file.write(text.toUtf8());
-   file.close();
+   writeInlineGraphFile(baseName + ".pu", text.toUtf8());
 
    return baseName;
 }
 
+static QString outputExtension(PlantUMLOutputFormat format)
+{
+   switch (format) {
+      case PUML_BITMAP:
+         return ".png";
+
+      case PUML_EPS:
+         return ".eps";
+
+      case PUML_SVG:
+         return ".svg";
+   }
+
+   return QString();
+}
+
+static bool outputExists(const QString &fileName)
+{
+   QFileInfo fi(fileName);
+   return fi.exists() && fi.size() > 0;
+}
+
 void generatePlantUMLOutput(const QString &baseName, const QString &outDir, PlantUMLOutputFormat format)
+{
+   PlantUMLManager::instance()->insert(baseName, outDir, format);
+}
+
+PlantUMLManager *PlantUMLManager::instance()
+{
+   static PlantUMLManager theInstance;
+   return &theInstance;
+}
+
+PlantUMLManager::PlantUMLManager()
+{
+}
+
+void PlantUMLManager::insert(const QString &baseName, const QString &outDir, PlantUMLOutputFormat format)
+{
+   QMutexLocker locker(&m_mutex);
+
+   for (const auto &item : m_jobs) {
+      if (item.baseName == baseName && item.outDir == outDir && item.format == format) {
+         // same diagram used more than once
+         return;
+      }
+   }
+
+   QFile f(baseName + ".pu");
+   QByteArray contents;
+
+   if (f.open(QIODevice::ReadOnly)) {
+      contents = f.readAll();
+      f.close();
+   }
+
+   QString extension  = outputExtension(format);
+   QString outputName = outDir + "/" + baseName.mid(baseName.lastIndexOf('/') + 1);
+
+   Job job;
+   job.baseName  = baseName;
+   job.outDir    = outDir;
+   job.format    = format;
+   job.signature = QString::fromLatin1(QCryptographicHash::hash(extension.toUtf8() + contents, QCryptographicHash::Md5).toHex());
+
+   // included files are not part of the signature, diagrams which include other files are always generated
+   bool unchanged = ! contents.isEmpty() && ! contents.contains("!include") && outputExists(outputName + extension);
+
+   if (unchanged && format == PUML_EPS && Config::getBool("latex-pdf")) {
+      unchanged = outputExists(outputName + ".pdf");
+   }
+
+   if (unchanged) {
+      QFile sigFile(baseName + ".md5");
+
+      if (sigFile.open(QIODevice::ReadOnly)) {
+         unchanged = (QString::fromLatin1(sigFile.readAll()) == job.signature);
+      } else {
+         unchanged = false;
+      }
+   }
+
+   if (unchanged) {
+      if (Config::getBool("dot-cleanup")) {
+         // the same diagram may still be added by another page
+         ToolExecutor::instance()->removeWhenDone(f.fileName());
+      }
+
+      return;
+   }
+
+   m_jobs.append(job);
+}
+
+void PlantUMLManager::run()
+{
+   if (m_jobs.isEmpty()) {
+      return;
+   }
+
+   int numThreads = ToolExecutor::instance()->threadCount();
+
+   // group the files by output directory and format, each group needs its own command line
+   QMap<QString, QList<Job>> groups;
+
+   for (const auto &job : m_jobs) {
+      groups[QString::number(job.format) + job.outDir].append(job);
+   }
+
+   for (const auto &list : groups) {
+      int batchSize = (list.count() + numThreads - 1) / numThreads;
+
+      Batch batch;
+      int length = 0;
+
+      for (const auto &job : list) {
+         if (! batch.jobs.isEmpty() && (batch.jobs.count() >= batchSize || length + job.baseName.length() > maxCmdLine / 2)) {
+            m_batches.append(batch);
+
+            batch.jobs.clear();
+            length = 0;
+         }
+
+         batch.outDir = job.outDir;
+         batch.format = job.format;
+         batch.jobs.append(job);
+
+         length += job.baseName.length() + 6;
+      }
+
+      m_batches.append(batch);
+   }
+
+   // remove the images of the previous run, an image left by a failed run must not be taken as output
+   for (const auto &job : m_jobs) {
+      QString outputName = job.outDir + "/" + job.baseName.mid(job.baseName.lastIndexOf('/') + 1);
+
+      QFile::remove(outputName + outputExtension(job.format));
+      QFile::remove(job.baseName + ".md5");
+
+      if (job.format == PUML_EPS) {
+         QFile::remove(outputName + ".pdf");
+      }
+   }
+
+   msg("Running PlantUML on %d files using %d parallel processes\n", m_jobs.count(), qMin(numThreads, m_batches.count()));
+
+   portable_sysTimerStart();
+
+   // all batches run at the same time, the ToolExecutor limits the number of processes
+   for (auto &batch : m_batches) {
+      submitBatch(batch);
+   }
+
+   for (auto &batch : m_batches) {
+      finishBatch(batch);
+   }
+
+   portable_sysTimerStop();
+
+   // verify the output of each file, a signature is only written for images generated by a batch without errors
+   static const bool dotCleanUp = Config::getBool("dot-cleanup");
+
+   for (const auto &batch : m_batches) {
+      for (const auto &error : batch.errors) {
+         err("%s", csPrintable(error));
+      }
+
+      for (const auto &job : batch.jobs) {
+         QString outputName = job.outDir + "/" + job.baseName.mid(job.baseName.lastIndexOf('/') + 1) +
+                              outputExtension(job.format);
+
+         if (! outputExists(outputName)) {
+            err("PlantUML did not generate %s from %s.pu\n", csPrintable(outputName), csPrintable(job.baseName));
+            continue;
+         }
+
+         if (! batch.errors.isEmpty()) {
+            continue;
+         }
+
+         QFile sigFile(job.baseName + ".md5");
+
+         if (sigFile.open(QIODevice::WriteOnly)) {
+            sigFile.write(job.signature.toLatin1());
+            sigFile.close();
+         }
+
+         if (dotCleanUp) {
+            QFile(job.baseName + ".pu").remove();
+         }
+      }
+   }
+
+   m_jobs.clear();
+   m_batches.clear();
+}
+
+void PlantUMLManager::submitBatch(Batch &batch)
 {
    static QString plantumlJarPath         = Config::getString("plantuml-jar-path"); 
    static QStringList pumlIncludePathList = Config::getList("plantuml-inc-path");
@@ -78,60 +274,63 @@ void generatePlantUMLOutput(const QString &baseName, const QString &outDir, Plan
    
    pumlArgs += "-Djava.awt.headless=true -jar \"" + plantumlJarPath + "plantuml.jar\" ";
    pumlArgs += "-o \"";
-   pumlArgs += outDir;
+   pumlArgs += batch.outDir;
    pumlArgs += "\" ";
 
-   QString extension;
-
-   switch (format) {
+   switch (batch.format) {
       case PUML_BITMAP:
          pumlArgs += "-tpng";
-         extension = ".png";
          break;
 
       case PUML_EPS:
          pumlArgs += "-teps";
-         extension = ".eps";
          break;
 
       case PUML_SVG:
          pumlArgs += "-tsvg";
-         extension = ".svg";
          break;
    }
 
-   pumlArgs += " \"";
-   pumlArgs += baseName;
-   pumlArgs += ".pu\" ";
-   pumlArgs += "-charset UTF-8 ";
+   for (const auto &job : batch.jobs) {
+      pumlArgs += " \"";
+      pumlArgs += job.baseName;
+      pumlArgs += ".pu\"";
+   }
 
-   int exitCode;
-   
-   msg("Running PlantUML on generated file %s.pu\n", qPrintable(baseName));
-   portable_sysTimerStart();
+   pumlArgs += " -charset UTF-8 ";
+
+   ToolExecutor *executor = ToolExecutor::instance();
 
-   if ((exitCode = portable_system(pumlExe, pumlArgs, true)) != 0) {
-      err("Unable to run PlantUML, verify the command 'java -jar \"%splantuml.jar\" -h' works from "
-         "the command line. Exit code: %d\n", qPrintable(plantumlJarPath), exitCode);
+   batch.pumlId = executor->submit("plantuml", pumlExe, pumlArgs);
 
-   } else if (Config::getBool("dot-cleanup")) {
-      QFile(baseName + ".pu").remove();
+   if (batch.format == PUML_EPS && Config::getBool("latex-pdf")) {
 
+      // the conversions of the files run in parallel once PlantUML is done
+      for (const auto &job : batch.jobs) {
+         QString epstopdfArgs = QString("\"%1.eps\" --outfile=\"%2.pdf\"").arg(job.baseName).arg(job.baseName);
+         batch.epstopdfIds.append(executor->submit("epstopdf", "epstopdf", epstopdfArgs, QString(), QList<int>() << batch.pumlId));
+      }
    }
+}
 
-   portable_sysTimerStop();
-   if ( (format == PUML_EPS) && (Config::getBool("latex-pdf")) ) {
+void PlantUMLManager::finishBatch(Batch &batch)
+{
+   static QString plantumlJarPath = Config::getString("plantuml-jar-path");
 
-      QString epstopdfArgs;
-      epstopdfArgs = QString("\"%1.eps\" --outfile=\"%2.pdf\"").arg(baseName).arg(baseName);
+   ToolExecutor *executor = ToolExecutor::instance();
+   int exitCode;
 
-      portable_sysTimerStart();
+   if ((exitCode = executor->wait(batch.pumlId)) != 0) {
+      batch.errors.append(QString("Unable to run PlantUML, verify the command 'java -jar \"%1plantuml.jar\" -h' works from "
+                                  "the command line. Exit code: %2\n").arg(plantumlJarPath).arg(exitCode));
 
-      if ((exitCode = portable_system("epstopdf", epstopdfArgs)) != 0) {
-         err("Unable to run epstopdf, verify your TeX installation, exit code: %d\n", exitCode);
-      }
+      // the conversions were skipped
+      batch.epstopdfIds.clear();
+   }
 
-      portable_sysTimerStop();
+   for (auto id : batch.epstopdfIds) {
+      if ((exitCode = executor->wait(id)) != 0) {
+         batch.errors.append(QString("Unable to run epstopdf, verify your TeX installation, exit code: %1\n").arg(exitCode));
+      }
    }
 }
-
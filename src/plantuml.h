@@ -18,6 +18,12 @@
 #ifndef PLANTUML_H
 #define PLANTUML_H
 
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
 class QByteArray;
 
 /** Plant UML output image formats */
@@ -32,11 +38,69 @@ enum PlantUMLOutputFormat { PUML_BITMAP, PUML_EPS, PUML_SVG };
 QString writePlantUMLSource(const QString &outDir, const QString &fileName, const QString &content);
 
 /** Convert a PlantUML file to an image.
+ *  The file is added to the PlantUMLManager, the image is generated when PlantUMLManager::run() is called.
  *  @param[in] baseName the name of the generated file (as returned by writePlantUMLSource())
  *  @param[in] outDir   the directory to write the resulting image into.
  *  @param[in] format   the image format to generate.
  */
 void generatePlantUMLOutput(const QString &baseName, const QString &outDir, PlantUMLOutputFormat format);
 
+/** Collects the PlantUML files to convert and runs PlantUML for many files at once
+ *
+ *  Starting java for each diagram is slow. The files are grouped by output directory and
+ *  format, each group is split over several java processes which run in parallel on the
+ *  ToolExecutor. Files which did not change since the last run, and whose image still
+ *  exists, are skipped.
+ */
+class PlantUMLManager
+{
+ public:
+   static PlantUMLManager *instance();
+
+   void insert(const QString &baseName, const QString &outDir, PlantUMLOutputFormat format);
+
+   /** Converts all files which were added */
+   void run();
+
+   int count() const {
+      return m_jobs.count();
+   }
+
+ private:
+   struct Job {
+      QString baseName;
+      QString outDir;
+      QString signature;
+
+      PlantUMLOutputFormat format;
+   };
+
+   struct Batch {
+      QString outDir;
+      PlantUMLOutputFormat format;
+
+      QList<Job>  jobs;
+      QStringList errors;
+
+      // jobs of the ToolExecutor, epstopdf depends on the PlantUML run
+      int        pumlId;
+      QList<int> epstopdfIds;
+   };
+
+   PlantUMLManager();
+
+   /** Submits PlantUML and the conversions of the batch without waiting for them */
+   void submitBatch(Batch &batch);
+
+   /** Waits for the jobs of the batch and collects the errors */
+   void finishBatch(Batch &batch);
+
+   // insert() is called by the threads which write the pages
+   QMutex m_mutex;
+
+   QList<Job>   m_jobs;
+   QList<Batch> m_batches;
+};
+
 #endif
 
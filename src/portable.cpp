@@ -18,6 +18,8 @@
 #include <QDateTime>
 #include <QDir>
 #include <QFSFileEngine>
+#include <QMutex>
+#include <QMutexLocker>
 #include <qglobal.h>
 
 #include <stdlib.h>
@@ -36,6 +38,9 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
 
 extern char **environ;
 
@@ -47,6 +52,11 @@ extern char **environ;
 static double g_sysElapsedTime;
 static QTime  g_time;
 
+#ifdef HAVE_FORK
+// pipes are created and processes are forked under this lock, a child must not inherit the pipe of another job
+static QMutex s_forkMutex;
+#endif
+
 int portable_system(const QString &command, const QString &args, bool commandHasConsole)
 {
    QString fullCmd = command.trimmed();
@@ -68,7 +78,9 @@ int portable_system(const QString &command, const QString &args, bool commandHas
    int pid;
    int status = 0;
 
+   QMutexLocker forkLocker(&s_forkMutex);
    pid = fork();
+   forkLocker.unlock();
 
    if (pid == -1) {
       perror("fork error");
@@ -154,6 +166,234 @@ int portable_system(const QString &command, const QString &args, bool commandHas
 
 }
 
+int portable_systemCapture(const QString &command, const QString &args, const QString &workDir, int timeout,
+                  QString &errorOutput, bool commandHasConsole)
+{
+   QString fullCmd = command.trimmed();
+
+   if (fullCmd.isEmpty()) {
+      return 1;
+   }
+
+   if (fullCmd.at(0) != '"' && fullCmd.contains(' ')) {
+      // add quotes around command as it contains spaces and is not quoted already
+      fullCmd = "\"" + fullCmd + "\"";
+   }
+
+   fullCmd += " " + args;
+
+
+#ifdef HAVE_FORK
+
+   (void) commandHasConsole;
+
+   // memory must not be allocated in the child, another thread may hold the lock of the allocator
+   QByteArray tempCmd = fullCmd.toUtf8();
+   QByteArray tempDir = workDir.toUtf8();
+
+   const char *argv[4];
+
+   argv[0] = "sh";
+   argv[1] = "-c";
+   argv[2] = tempCmd.constData();
+   argv[3] = 0;
+
+   int errPipe[2];
+   int pid;
+   int status = 0;
+
+   QMutexLocker forkLocker(&s_forkMutex);
+
+   if (pipe(errPipe) == -1) {
+      perror("pipe error");
+      return -1;
+   }
+
+   fcntl(errPipe[0], F_SETFD, FD_CLOEXEC);
+   fcntl(errPipe[1], F_SETFD, FD_CLOEXEC);
+
+   pid = fork();
+
+   if (pid == -1) {
+      perror("fork error");
+
+      close(errPipe[0]);
+      close(errPipe[1]);
+
+      return -1;
+   }
+
+   if (pid == 0) {
+      // own process group, on a timeout the shell and the tool are stopped together
+      setpgid(0, 0);
+
+      if (! tempDir.isEmpty() && chdir(tempDir.constData()) != 0) {
+         _exit(127);
+      }
+
+      dup2(errPipe[1], 2);
+
+      execve("/bin/sh", (char *const *)argv, environ);
+      _exit(127);
+   }
+
+   setpgid(pid, pid);
+   close(errPipe[1]);
+
+   forkLocker.unlock();
+
+   QByteArray errorData;
+   QTime timer;
+   timer.start();
+
+   bool timedOut = false;
+
+   while (true) {
+      int pollTime = -1;
+
+      if (timeout > 0) {
+         pollTime = qMax(0, timeout - timer.elapsed());
+      }
+
+      struct pollfd pfd;
+      pfd.fd      = errPipe[0];
+      pfd.events  = POLLIN;
+      pfd.revents = 0;
+
+      int rc = poll(&pfd, 1, pollTime);
+
+      if (rc == -1) {
+         if (errno == EINTR) {
+            continue;
+         }
+
+         break;
+      }
+
+      if (rc == 0) {
+         // the tool did not finish in time
+         kill(-pid, SIGKILL);
+         timedOut = true;
+         break;
+      }
+
+      char buffer[4096];
+      ssize_t len = read(errPipe[0], buffer, sizeof(buffer));
+
+      if (len > 0) {
+         errorData.append(buffer, len);
+
+      } else if (len == 0 || errno != EINTR) {
+         // end of file, the tool closed stderr
+         break;
+      }
+   }
+
+   close(errPipe[0]);
+
+   int retval;
+
+   while (true) {
+      // the tool can close stderr and keep running, the deadline applies until it exits
+      int options = (timeout > 0 && ! timedOut) ? WNOHANG : 0;
+      int rc      = waitpid(pid, &status, options);
+
+      if (rc == -1) {
+         if (errno != EINTR) {
+            retval = -1;
+            break;
+         }
+
+      } else if (rc == 0) {
+         int remaining = timeout - timer.elapsed();
+
+         if (remaining <= 0) {
+            kill(-pid, SIGKILL);
+            timedOut = true;
+
+         } else {
+            usleep(qMin(remaining, 10) * 1000);
+         }
+
+      } else {
+         if (WIFEXITED(status)) {
+            retval = WEXITSTATUS(status);
+         } else {
+            retval = status;
+         }
+
+         break;
+      }
+   }
+
+   errorOutput = QString::fromUtf8(errorData);
+
+   if (timedOut) {
+      errorOutput += QString("Command did not finish within %1 seconds and was stopped\n").arg(timeout / 1000);
+      retval = -1;
+   }
+
+   return retval;
+
+
+#else
+   // Windows, the output of the tool is not captured
+
+   errorOutput = QString();
+
+   if (commandHasConsole) {
+      // console tools use system() as in portable_system(), the timeout is not applied
+      if (! workDir.isEmpty()) {
+         fullCmd = "cd /d \"" + QDir::toNativeSeparators(workDir) + "\" && " + fullCmd;
+      }
+
+      return system(fullCmd.toUtf8());
+   }
+
+   CoInitializeEx(NULL, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
+
+   SHELLEXECUTEINFOW sInfo = {
+      sizeof(SHELLEXECUTEINFOW),
+      SEE_MASK_NOCLOSEPROCESS | SEE_MASK_FLAG_NO_UI,
+      NULL,                                                         /* window handle */
+      NULL,                                                         /* action to perform: open */
+      (LPCWSTR)command.utf16(),                                     /* file to execute */
+      (LPCWSTR)args.utf16(),                                        /* argument list */
+      workDir.isEmpty() ? NULL : (LPCWSTR)workDir.utf16(),          /* working directory */
+      SW_HIDE,                                                      /* minimize on start-up */
+      0,                                                            /* application instance handle */
+      NULL,                                                         /* ignored: id list */
+      NULL,                                                         /* ignored: class name */
+      NULL,                                                         /* ignored: key class */
+      0,                                                            /* ignored: hot key */
+      NULL,                                                         /* ignored: icon */
+      NULL                                                          /* resulting application handle */
+   };
+
+   if (! ShellExecuteExW(&sInfo)) {
+      return -1;
+
+   } else if (sInfo.hProcess) {
+      DWORD exitCode;
+
+      if (WaitForSingleObject(sInfo.hProcess, timeout > 0 ? timeout : INFINITE) == WAIT_TIMEOUT) {
+         TerminateProcess(sInfo.hProcess, 1);
+         errorOutput = QString("Command did not finish within %1 seconds and was stopped\n").arg(timeout / 1000);
+         exitCode = -1;
+
+      } else if (! GetExitCodeProcess(sInfo.hProcess, &exitCode)) {
+         exitCode = -1;
+      }
+
+      CloseHandle(sInfo.hProcess);
+      return exitCode;
+   }
+
+   return 0;
+#endif
+
+}
+
 uint portable_pid()
 {
    uint pid;
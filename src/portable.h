@@ -35,6 +35,14 @@ typedef off_t portable_off_t;
  */
 
 int            portable_system(const QString &command, const QString &args, bool commandHasConsole = true);
+
+/** Runs a command in \a workDir, stderr of the command is returned in \a errorOutput.
+ *  The command is stopped after \a timeout ms, no timeout is used when \a timeout is 0.
+ *  On Windows stderr is not captured and a command with a console runs through system() without a timeout.
+ */
+int            portable_systemCapture(const QString &command, const QString &args, const QString &workDir, int timeout,
+                  QString &errorOutput, bool commandHasConsole = true);
+
 uint           portable_pid();
 QString        portable_getenv(const QString &variable);
 void           portable_setenv(const QString &variable, const QString &value);
@@ -22,6 +22,8 @@ void initPreprocessor();
 void removePreProcessor();
 void addSearchDir(const QString &dir);
 QString preprocessFile(const QString &fileName, const QString &input);
+void applyPreprocessorResults(const QString &fileName);
+void discardPreprocessorResults(const QString &fileName);
 void preFreeScanner();
 
 #endif
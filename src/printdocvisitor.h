@@ -18,6 +18,11 @@
 #ifndef PRINTDOCVISITOR_H
 #define PRINTDOCVISITOR_H
 
+#include <QByteArray>
+
+#include <stdarg.h>
+#include <stdio.h>
+
 #include <docvisitor.h>
 #include <htmlentity.h>
 
@@ -26,25 +31,29 @@ class PrintDocVisitor : public DocVisitor
 {
  public:
    PrintDocVisitor() : DocVisitor(DocVisitor_Other), m_indent(0),
-      m_needsEnter(false), m_insidePre(false) {}
+      m_needsEnter(false), m_insidePre(false), m_output(nullptr) {}
+
+   /** Appends the output to \a output instead of writing it to stdout */
+   PrintDocVisitor(QByteArray *output) : DocVisitor(DocVisitor_Other), m_indent(0),
+      m_needsEnter(false), m_insidePre(false), m_output(output) {}
 
    void visit(DocWord *w) {
       indent_leaf();
-      printf("%s", qPrintable(w->word()));
+      print("%s", qPrintable(w->word()));
    }
 
    void visit(DocLinkedWord *w) {
       indent_leaf();
-      printf("%s", qPrintable(w->word()));
+      print("%s", qPrintable(w->word()));
    }
 
    void visit(DocWhiteSpace *w) {
       indent_leaf();
 
       if (m_insidePre) {
-         printf("%s", qPrintable(w->chars()));
+         print("%s", qPrintable(w->chars()));
       } else {
-         printf(" ");
+         print(" ");
       }
    }
 
@@ -53,24 +62,24 @@ class PrintDocVisitor : public DocVisitor
       QString res = HtmlEntityMapper::instance()->utf8(s->symbol(), true);
 
       if (! res.isEmpty()) {
-         printf("%s", qPrintable(res));
+         print("%s", qPrintable(res));
       } else {
-         printf("Print: Unsupported HTML-entity found: %s\n", qPrintable(HtmlEntityMapper::instance()->html(s->symbol(), true)) );
+         print("Print: Unsupported HTML-entity found: %s\n", qPrintable(HtmlEntityMapper::instance()->html(s->symbol(), true)) );
       }
    }
    void visit(DocURL *u) {
       indent_leaf();
-      printf("%s", qPrintable(u->url()));
+      print("%s", qPrintable(u->url()));
    }
 
    void visit(DocLineBreak *) {
       indent_leaf();
-      printf("<br/>");
+      print("<br/>");
    }
 
    void visit(DocHorRuler *) {
       indent_leaf();
-      printf("<hr/>");
+      print("<hr/>");
    }
 
    void visit(DocStyleChange *s) {
@@ -79,75 +88,75 @@ class PrintDocVisitor : public DocVisitor
       switch (s->style()) {
          case DocStyleChange::Bold:
             if (s->enable()) {
-               printf("<bold>");
+               print("<bold>");
             } else {
-               printf("</bold>");
+               print("</bold>");
             }
             break;
 
          case DocStyleChange::Italic:
             if (s->enable()) {
-               printf("<italic>");
+               print("<italic>");
             } else {
-               printf("</italic>");
+               print("</italic>");
             }
             break;
 
          case DocStyleChange::Code:
             if (s->enable()) {
-               printf("<code>");
+               print("<code>");
             } else {
-               printf("</code>");
+               print("</code>");
             }
             break;
          case DocStyleChange::Subscript:
             if (s->enable()) {
-               printf("<sub>");
+               print("<sub>");
             } else {
-               printf("</sub>");
+               print("</sub>");
             }
             break;
          case DocStyleChange::Superscript:
             if (s->enable()) {
-               printf("<sup>");
+               print("<sup>");
             } else {
-               printf("</sup>");
+               print("</sup>");
             }
             break;
          case DocStyleChange::Center:
             if (s->enable()) {
-               printf("<center>");
+               print("<center>");
             } else {
-               printf("</center>");
+               print("</center>");
             }
             break;
          case DocStyleChange::Small:
             if (s->enable()) {
-               printf("<small>");
+               print("<small>");
             } else {
-               printf("</small>");
+               print("</small>");
             }
             break;
          case DocStyleChange::Preformatted:
             if (s->enable()) {
-               printf("<pre>");
+               print("<pre>");
             } else {
-               printf("</pre>");
+               print("</pre>");
             }
             break;
 
          case DocStyleChange::Div:
             if (s->enable()) {
-               printf("<div>");
+               print("<div>");
             } else {
-               printf("</div>");
+               print("</div>");
             }
             break;
          case DocStyleChange::Span:
             if (s->enable()) {
-               printf("<span>");
+               print("<span>");
             } else {
-               printf("</span>");
+               print("</span>");
             }
             break;
       }
@@ -158,153 +167,153 @@ class PrintDocVisitor : public DocVisitor
 
       switch (s->type()) {
          case DocVerbatim::Code:
-            printf("<code>");
+            print("<code>");
             break;
          case DocVerbatim::Verbatim:
-            printf("<verbatim>");
+            print("<verbatim>");
             break;
          case DocVerbatim::HtmlOnly:
-            printf("<htmlonly>");
+            print("<htmlonly>");
             break;
          case DocVerbatim::RtfOnly:
-            printf("<rtfonly>");
+            print("<rtfonly>");
             break;
          case DocVerbatim::ManOnly:
-            printf("<manonly>");
+            print("<manonly>");
             break;
          case DocVerbatim::LatexOnly:
-            printf("<latexonly>");
+            print("<latexonly>");
             break;
          case DocVerbatim::XmlOnly:
-            printf("<xmlonly>");
+            print("<xmlonly>");
             break;
          case DocVerbatim::DocbookOnly:
-            printf("<docbookonly>");
+            print("<docbookonly>");
             break;
          case DocVerbatim::Dot:
-            printf("<dot>");
+            print("<dot>");
             break;
          case DocVerbatim::Msc:
-            printf("<msc>");
+            print("<msc>");
             break;
          case DocVerbatim::PlantUML:
-            printf("<plantuml>");
+            print("<plantuml>");
             break;
       }
 
-      printf("%s", qPrintable(s->text()));
+      print("%s", qPrintable(s->text()));
 
       switch (s->type()) {
          case DocVerbatim::Code:
-            printf("</code>");
+            print("</code>");
             break;
          case DocVerbatim::Verbatim:
-            printf("</verbatim>");
+            print("</verbatim>");
             break;
          case DocVerbatim::HtmlOnly:
-            printf("</htmlonly>");
+            print("</htmlonly>");
             break;
          case DocVerbatim::RtfOnly:
-            printf("</rtfonly>");
+            print("</rtfonly>");
             break;
          case DocVerbatim::ManOnly:
-            printf("</manonly>");
+            print("</manonly>");
             break;
          case DocVerbatim::LatexOnly:
-            printf("</latexonly>");
+            print("</latexonly>");
             break;
          case DocVerbatim::XmlOnly:
-            printf("</xmlonly>");
+            print("</xmlonly>");
             break;
          case DocVerbatim::DocbookOnly:
-            printf("</docbookonly>");
+            print("</docbookonly>");
             break;
          case DocVerbatim::Dot:
-            printf("</dot>");
+            print("</dot>");
             break;
          case DocVerbatim::Msc:
-            printf("</msc>");
+            print("</msc>");
             break;
          case DocVerbatim::PlantUML:
-            printf("</plantuml>");
+            print("</plantuml>");
             break;
       }
    }
 
    void visit(DocAnchor *a) {
       indent_leaf();
-      printf("<anchor name=\"%s\"/>", qPrintable(a->anchor()));
+      print("<anchor name=\"%s\"/>", qPrintable(a->anchor()));
    }
 
    void visit(DocInclude *inc) {
       indent_leaf();
-      printf("<include file=\"%s\" type=\"", qPrintable(inc->file()));
+      print("<include file=\"%s\" type=\"", qPrintable(inc->file()));
 
       switch (inc->type()) {
          case DocInclude::Include:
-            printf("include");
+            print("include");
             break;
          case DocInclude::IncWithLines:
-            printf("incwithlines");
+            print("incwithlines");
             break;
          case DocInclude::DontInclude:
-            printf("dontinclude");
+            print("dontinclude");
             break;
          case DocInclude::HtmlInclude:
-            printf("htmlinclude");
+            print("htmlinclude");
             break;
          case DocInclude::LatexInclude:
-            printf("latexinclude");
+            print("latexinclude");
             break;
          case DocInclude::VerbInclude:
-            printf("verbinclude");
+            print("verbinclude");
             break;
          case DocInclude::Snippet:
-            printf("snippet");
+            print("snippet");
             break;
       }
-      printf("\"/>");
+      print("\"/>");
    }
 
    void visit(DocIncOperator *op) {
       indent_leaf();
-      printf("<incoperator pattern=\"%s\" type=\"", qPrintable(op->pattern()));
+      print("<incoperator pattern=\"%s\" type=\"", qPrintable(op->pattern()));
 
       switch (op->type()) {
          case DocIncOperator::Line:
-            printf("line");
+            print("line");
             break;
          case DocIncOperator::Skip:
-            printf("skip");
+            print("skip");
             break;
          case DocIncOperator::SkipLine:
-            printf("skipline");
+            print("skipline");
             break;
          case DocIncOperator::Until:
-            printf("until");
+            print("until");
             break;
       }
-      printf("\"/>");
+      print("\"/>");
    }
 
    void visit(DocFormula *f) {
       indent_leaf();
-      printf("<formula name=%s text=%s/>", qPrintable(f->name()), qPrintable(f->text()));
+      print("<formula name=%s text=%s/>", qPrintable(f->name()), qPrintable(f->text()));
    }
 
    void visit(DocIndexEntry *i) {
       indent_leaf();
-      printf("<indexentry>%s</indexentry\n", qPrintable(i->entry()));
+      print("<indexentry>%s</indexentry\n", qPrintable(i->entry()));
    }
 
    void visit(DocSimpleSectSep *) {
       indent_leaf();
-      printf("<simplesectsep/>");
+      print("<simplesectsep/>");
    }
 
    void visit(DocCite *cite) {
       indent_leaf();
-      printf("<cite ref=\"%s\" file=\"%s\" anchor=\"%s\" text=\"%s\"/>\n",
+      print("<cite ref=\"%s\" file=\"%s\" anchor=\"%s\" text=\"%s\"/>\n",
              qPrintable(cite->ref()), qPrintable(cite->file()), qPrintable(cite->anchor()), qPrintable(cite->text()) );
    }
 
@@ -312,336 +321,336 @@ class PrintDocVisitor : public DocVisitor
    void visitPre(DocAutoList *l) {
       indent_pre();
       if (l->isEnumList()) {
-         printf("<ol>\n");
+         print("<ol>\n");
       } else {
-         printf("<ul>\n");
+         print("<ul>\n");
       }
    }
    void visitPost(DocAutoList *l) {
       indent_post();
       if (l->isEnumList()) {
-         printf("</ol>\n");
+         print("</ol>\n");
       } else {
-         printf("</ul>\n");
+         print("</ul>\n");
       }
    }
    void visitPre(DocAutoListItem *) {
       indent_pre();
-      printf("<li>\n");
+      print("<li>\n");
    }
    void visitPost(DocAutoListItem *) {
       indent_post();
-      printf("</li>\n");
+      print("</li>\n");
    }
 
    void visitPre(DocPara *) {
       indent_pre();
-      printf("<para>\n");
+      print("<para>\n");
    }
 
    void visitPost(DocPara *) {
       indent_post();
-      printf("</para>\n");
+      print("</para>\n");
    }
 
    void visitPre(DocRoot *) {
       indent_pre();
-      printf("<root>\n");
+      print("<root>\n");
    }
 
    void visitPost(DocRoot *) {
       indent_post();
-      printf("</root>\n");
+      print("</root>\n");
    }
    void visitPre(DocSimpleSect *s) {
       indent_pre();
-      printf("<simplesect type=");
+      print("<simplesect type=");
 
       switch (s->type()) {
          case DocSimpleSect::See:
-            printf("see");
+            print("see");
             break;
          case DocSimpleSect::Return:
-            printf("return");
+            print("return");
             break;
          case DocSimpleSect::Author:
-            printf("author");
+            print("author");
             break;
          case DocSimpleSect::Authors:
-            printf("authors");
+            print("authors");
             break;
          case DocSimpleSect::Version:
-            printf("version");
+            print("version");
             break;
          case DocSimpleSect::Since:
-            printf("since");
+            print("since");
             break;
          case DocSimpleSect::Date:
-            printf("date");
+            print("date");
             break;
          case DocSimpleSect::Note:
-            printf("note");
+            print("note");
             break;
          case DocSimpleSect::Warning:
-            printf("warning");
+            print("warning");
             break;
          case DocSimpleSect::Pre:
-            printf("pre");
+            print("pre");
             break;
          case DocSimpleSect::Post:
-            printf("post");
+            print("post");
             break;
          case DocSimpleSect::Copyright:
-            printf("copyright");
+            print("copyright");
             break;
          case DocSimpleSect::Invar:
-            printf("invar");
+            print("invar");
             break;
          case DocSimpleSect::Remark:
-            printf("remark");
+            print("remark");
             break;
          case DocSimpleSect::Attention:
-            printf("attention");
+            print("attention");
             break;
          case DocSimpleSect::User:
-            printf("user");
+            print("user");
             break;
          case DocSimpleSect::Rcs:
-            printf("rcs");
+            print("rcs");
             break;
          case DocSimpleSect::Unknown:
-            printf("unknown");
+            print("unknown");
             break;
       }
-      printf(">\n");
+      print(">\n");
    }
 
    void visitPost(DocSimpleSect *) {
       indent_post();
-      printf("</simplesect>\n");
+      print("</simplesect>\n");
    }
    void visitPre(DocTitle *) {
       indent_pre();
-      printf("<title>\n");
+      print("<title>\n");
    }
    void visitPost(DocTitle *) {
       indent_post();
-      printf("</title>\n");
+      print("</title>\n");
    }
    void visitPre(DocSimpleList *) {
       indent_pre();
-      printf("<ul>\n");
+      print("<ul>\n");
    }
    void visitPost(DocSimpleList *) {
       indent_post();
-      printf("</ul>\n");
+      print("</ul>\n");
    }
    void visitPre(DocSimpleListItem *) {
       indent_pre();
-      printf("<li>\n");
+      print("<li>\n");
    }
    void visitPost(DocSimpleListItem *) {
       indent_post();
-      printf("</li>\n");
+      print("</li>\n");
    }
 
    void visitPre(DocSection *s) {
       indent_pre();
-      printf("<sect%d>\n", s->level());
+      print("<sect%d>\n", s->level());
    }
 
    void visitPost(DocSection *s) {
       indent_post();
-      printf("</sect%d>\n", s->level());
+      print("</sect%d>\n", s->level());
    }
 
    void visitPre(DocHtmlList *s) {
       indent_pre();
       if (s->type() == DocHtmlList::Ordered) {
-         printf("<ol>\n");
+         print("<ol>\n");
       } else {
-         printf("<ul>\n");
+         print("<ul>\n");
       }
    }
 
    void visitPost(DocHtmlList *s) {
       indent_post();
       if (s->type() == DocHtmlList::Ordered) {
-         printf("</ol>\n");
+         print("</ol>\n");
       } else {
-         printf("</ul>\n");
+         print("</ul>\n");
       }
    }
    void visitPre(DocHtmlListItem *) {
       indent_pre();
-      printf("<li>\n");
+      print("<li>\n");
    }
    void visitPost(DocHtmlListItem *) {
       indent_post();
-      printf("</li>\n");
+      print("</li>\n");
    }
 
    //void visitPre(DocHtmlPre *)
    //{
    //  indent_pre();
-   //  printf("<pre>\n");
+   //  print("<pre>\n");
    //  m_insidePre=true;
    //}
    //void visitPost(DocHtmlPre *)
    //{
    //  m_insidePre=false;
    //  indent_post();
-   //  printf("</pre>\n");
+   //  print("</pre>\n");
    //}
 
    void visitPre(DocHtmlDescList *) {
       indent_pre();
-      printf("<dl>\n");
+      print("<dl>\n");
    }
    void visitPost(DocHtmlDescList *) {
       indent_post();
-      printf("</dl>\n");
+      print("</dl>\n");
    }
    void visitPre(DocHtmlDescTitle *) {
       indent_pre();
-      printf("<dt>\n");
+      print("<dt>\n");
    }
    void visitPost(DocHtmlDescTitle *) {
       indent_post();
-      printf("</dt>\n");
+      print("</dt>\n");
    }
    void visitPre(DocHtmlDescData *) {
       indent_pre();
-      printf("<dd>\n");
+      print("<dd>\n");
    }
    void visitPost(DocHtmlDescData *) {
       indent_post();
-      printf("</dd>\n");
+      print("</dd>\n");
    }
    void visitPre(DocHtmlTable *t) {
       indent_pre();
 
-      printf("<table rows=\"%d\" cols=\"%d\">\n", t->numRows(), t->numColumns());
+      print("<table rows=\"%d\" cols=\"%d\">\n", t->numRows(), t->numColumns());
    }
 
    void visitPost(DocHtmlTable *) {
       indent_post();
-      printf("</table>\n");
+      print("</table>\n");
    }
    void visitPre(DocHtmlRow *) {
       indent_pre();
-      printf("<tr>\n");
+      print("<tr>\n");
    }
    void visitPost(DocHtmlRow *) {
       indent_post();
-      printf("</tr>\n");
+      print("</tr>\n");
    }
    void visitPre(DocHtmlCell *c) {
       indent_pre();
-      printf("<t%c>\n", c->isHeading() ? 'h' : 'd');
+      print("<t%c>\n", c->isHeading() ? 'h' : 'd');
    }
    void visitPost(DocHtmlCell *c) {
       indent_post();
-      printf("</t%c>\n", c->isHeading() ? 'h' : 'd');
+      print("</t%c>\n", c->isHeading() ? 'h' : 'd');
    }
    void visitPre(DocHtmlCaption *) {
       indent_pre();
-      printf("<caption>\n");
+      print("<caption>\n");
    }
    void visitPost(DocHtmlCaption *) {
       indent_post();
-      printf("</caption>\n");
+      print("</caption>\n");
    }
    void visitPre(DocInternal *) {
       indent_pre();
-      printf("<internal>\n");
+      print("<internal>\n");
    }
    void visitPost(DocInternal *) {
       indent_post();
-      printf("</internal>\n");
+      print("</internal>\n");
    }
    void visitPre(DocHRef *href) {
       indent_pre();
-      printf("<a url=\"%s\">\n", qPrintable(href->url()));
+      print("<a url=\"%s\">\n", qPrintable(href->url()));
    }
    void visitPost(DocHRef *) {
       indent_post();
-      printf("</a>\n");
+      print("</a>\n");
    }
    void visitPre(DocHtmlHeader *header) {
       indent_pre();
-      printf("<h%d>\n", header->level());
+      print("<h%d>\n", header->level());
    }
    void visitPost(DocHtmlHeader *header) {
       indent_post();
-      printf("</h%d>\n", header->level());
+      print("</h%d>\n", header->level());
    }
    void visitPre(DocImage *img) {
       indent_pre();
-      printf("<image src=\"%s\" type=\"", qPrintable(img->name()));
+      print("<image src=\"%s\" type=\"", qPrintable(img->name()));
 
       switch (img->type()) {
          case DocImage::Html:
-            printf("html");
+            print("html");
             break;
          case DocImage::Latex:
-            printf("latex");
+            print("latex");
             break;
          case DocImage::Rtf:
-            printf("rtf");
+            print("rtf");
             break;
          case DocImage::DocBook:
-            printf("docbook");
+            print("docbook");
             break;
       }
 
-      printf("\" width=%s height=%s>\n", qPrintable(img->width()), qPrintable(img->height()));
+      print("\" width=%s height=%s>\n", qPrintable(img->width()), qPrintable(img->height()));
    }
 
    void visitPost(DocImage *) {
       indent_post();
-      printf("</image>\n");
+      print("</image>\n");
    }
 
    void visitPre(DocDotFile *df) {
       indent_pre();
-      printf("<dotfile src=\"%s\">\n", qPrintable(df->name()));
+      print("<dotfile src=\"%s\">\n", qPrintable(df->name()));
    }
    void visitPost(DocDotFile *) {
       indent_post();
-      printf("</dotfile>\n");
+      print("</dotfile>\n");
    }
    void visitPre(DocMscFile *df) {
       indent_pre();
-      printf("<mscfile src=\"%s\">\n", qPrintable(df->name()));
+      print("<mscfile src=\"%s\">\n", qPrintable(df->name()));
    }
    void visitPost(DocMscFile *) {
       indent_post();
-      printf("</mscfile>\n");
+      print("</mscfile>\n");
    }
    void visitPre(DocDiaFile *df) {
       indent_pre();
-      printf("<diafile src=\"%s\">\n", qPrintable(df->name()));
+      print("<diafile src=\"%s\">\n", qPrintable(df->name()));
    }
    void visitPost(DocDiaFile *) {
       indent_post();
-      printf("</diafile>\n");
+      print("</diafile>\n");
    }
 
    void visitPre(DocLink *lnk) {
       indent_pre();
-      printf("<link ref=\"%s\" file=\"%s\" anchor=\"%s\">\n",
+      print("<link ref=\"%s\" file=\"%s\" anchor=\"%s\">\n",
              qPrintable(lnk->ref()), qPrintable(lnk->file()), qPrintable(lnk->anchor()));
    }
 
    void visitPost(DocLink *) {
       indent_post();
-      printf("</link>\n");
+      print("</link>\n");
    }
 
    void visitPre(DocRef *ref) {
       indent_pre();
-      printf("<ref ref=\"%s\" file=\"%s\" "
+      print("<ref ref=\"%s\" file=\"%s\" "
              "anchor=\"%s\" targetTitle=\"%s\""
              " hasLinkText=\"%s\" refToAnchor=\"%s\" refToSection=\"%s\">\n",
              qPrintable(ref->ref()), qPrintable(ref->file()), qPrintable(ref->anchor()),
@@ -650,26 +659,26 @@ class PrintDocVisitor : public DocVisitor
    }
    void visitPost(DocRef *) {
       indent_post();
-      printf("</ref>\n");
+      print("</ref>\n");
    }
    void visitPre(DocSecRefItem *ref) {
       indent_pre();
-      printf("<secrefitem target=\"%s\">\n", qPrintable(ref->target()));
+      print("<secrefitem target=\"%s\">\n", qPrintable(ref->target()));
    }
 
    void visitPost(DocSecRefItem *) {
       indent_post();
-      printf("</secrefitem>\n");
+      print("</secrefitem>\n");
    }
 
    void visitPre(DocSecRefList *) {
       indent_pre();
-      printf("<secreflist>\n");
+      print("<secreflist>\n");
    }
 
    void visitPost(DocSecRefList *) {
       indent_post();
-      printf("</secreflist>\n");
+      print("</secreflist>\n");
    }
   
    void visitPre(DocParamList *pl) {
@@ -677,10 +686,10 @@ class PrintDocVisitor : public DocVisitor
         
       DocNode *param;
 
-      printf("<parameters>");
+      print("<parameters>");
      
       for (auto param : pl->parameters()) { 
-         printf("<param>");
+         print("<param>");
 
          if (param->kind() == DocNode::Kind_Word) {
             visit((DocWord *)param);
@@ -688,113 +697,138 @@ class PrintDocVisitor : public DocVisitor
             visit((DocLinkedWord *)param);
          }
 
-         printf("</param>");
+         print("</param>");
       }
 
-      printf("\n");
+      print("\n");
    }
 
    void visitPost(DocParamList *) {
       indent_post();
-      printf("</parameters>\n");
+      print("</parameters>\n");
    }
 
    void visitPre(DocParamSect *ps) {
       indent_pre();
-      printf("<paramsect type=");
+      print("<paramsect type=");
 
       switch (ps->type()) {
          case DocParamSect::Param:
-            printf("param");
+            print("param");
             break;
          case DocParamSect::RetVal:
-            printf("retval");
+            print("retval");
             break;
          case DocParamSect::Exception:
-            printf("exception");
+            print("exception");
             break;
          case DocParamSect::TemplateParam:
-            printf("templateparam");
+            print("templateparam");
             break;
          case DocParamSect::Unknown:
-            printf("unknown");
+            print("unknown");
             break;
       }
-      printf(">\n");
+      print(">\n");
    }
 
    void visitPost(DocParamSect *) {
       indent_post();
-      printf("</paramsect>\n");
+      print("</paramsect>\n");
    }
 
    void visitPre(DocXRefItem *x) {
       indent_pre();
-      printf("<xrefitem file=\"%s\" anchor=\"%s\" title=\"%s\"/>\n",
+      print("<xrefitem file=\"%s\" anchor=\"%s\" title=\"%s\"/>\n",
              qPrintable(x->file()), qPrintable(x->anchor()), qPrintable(x->title()));
    }
 
    void visitPost(DocXRefItem *) {
       indent_post();
-      printf("<xrefitem/>\n");
+      print("<xrefitem/>\n");
    }
 
    void visitPre(DocInternalRef *r) {
       indent_pre();
-      printf("<internalref file=%s anchor=%s>\n", qPrintable(r->file()), qPrintable(r->anchor()));
+      print("<internalref file=%s anchor=%s>\n", qPrintable(r->file()), qPrintable(r->anchor()));
    }
 
    void visitPost(DocInternalRef *) {
       indent_post();
-      printf("</internalref>\n");
+      print("</internalref>\n");
    }
    void visitPre(DocCopy *c) {
       indent_pre();
-      printf("<copy link=\"%s\">\n", qPrintable(c->link()));
+      print("<copy link=\"%s\">\n", qPrintable(c->link()));
    }
    void visitPost(DocCopy *) {
       indent_post();
-      printf("</copy>\n");
+      print("</copy>\n");
    }
    void visitPre(DocText *) {
       indent_pre();
-      printf("<text>\n");
+      print("<text>\n");
    }
 
    void visitPost(DocText *) {
       indent_post();
-      printf("</text>\n");
+      print("</text>\n");
    }
 
    void visitPre(DocHtmlBlockQuote *) {
       indent_pre();
-      printf("<blockquote>\n");
+      print("<blockquote>\n");
    }
    
    void visitPost(DocHtmlBlockQuote *) {
       indent_post();
-      printf("</blockquote>\n");
+      print("</blockquote>\n");
    }
   
    void visitPre(DocParBlock *) {
       indent_pre();
-      printf("<parblock>\n");
+      print("<parblock>\n");
    }
    void visitPost(DocParBlock *) {
       indent_post();
-      printf("</parblock>\n");
+      print("</parblock>\n");
    }
 
  private:
    // helper functions
 
+   void print(const char *format, ...) {
+      va_list args;
+      va_start(args, format);
+
+      if (m_output == nullptr) {
+         vprintf(format, args);
+
+      } else {
+         va_list argsCopy;
+         va_copy(argsCopy, args);
+
+         int len = vsnprintf(nullptr, 0, format, argsCopy);
+         va_end(argsCopy);
+
+         if (len > 0) {
+            QByteArray text(len + 1, '\0');
+            vsnprintf(text.data(), len + 1, format, args);
+
+            m_output->append(text.constData(), len);
+         }
+      }
+
+      va_end(args);
+   }
+
    void indent() {
       if (m_needsEnter) {
-         printf("\n");
+         print("\n");
       }
 
       for (int i = 0; i < m_indent; i++) {
-         printf(" ");
+         print(" ");
       }
 
       m_needsEnter = false;
@@ -821,6 +855,8 @@ class PrintDocVisitor : public DocVisitor
    int m_indent;
    bool m_needsEnter;
    bool m_insidePre;
+
+   QByteArray *m_output;
 };
 
 #endif
@@ -33,6 +33,7 @@
 #include <parser_base.h>
 #include <plantuml.h>
 #include <rtfstyle.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 // #define DBG_RTF(x) m_t << x
@@ -344,18 +345,8 @@ void RTFDocVisitor::visit(DocVerbatim *s)
          break;
 
       case DocVerbatim::Dot: {
-         static int dotindex = 1;
-
-         QString fileName;     
-         fileName = QString("%1%2.dot").arg(Config::getString("rtf-output") + "/inline_dotgraph_").arg(dotindex++);
-
-         QFile file(fileName);
-         if (! file.open(QIODevice::WriteOnly)) {
-            err("Unable to open file for writing %s, error: %d\n", qPrintable(fileName), file.error());            
-         }
-
-         file.write( s->text().toUtf8() );
-         file.close();
+         QString fileName = inlineGraphBaseName(Config::getString("rtf-output"), "inline_dotgraph_", s->text()) + ".dot";
+         writeInlineGraphFile(fileName, s->text().toUtf8());
 
          m_t << "\\par{\\qc "; // center picture
          writeDotFile(fileName);
@@ -363,27 +354,20 @@ void RTFDocVisitor::visit(DocVerbatim *s)
          m_t << "} ";
 
          if (Config::getBool("dot-cleanup")) {
-            file.remove();
+            // another page may show the same graph
+            ToolExecutor::instance()->removeWhenDone(fileName);
          }
       }
       break;
 
       case DocVerbatim::Msc: {
-         static int mscindex = 1;
-
-         QString baseName = QString("%1%2.msc").arg(Config::getString("rtf-output") + "/inline_mscgraph_").arg(mscindex++);
-                         
-         QFile file(baseName);
-         if (! file.open(QIODevice::WriteOnly)) {
-            err("Unable to open file for writing %s, error: %d\n", qPrintable(baseName), file.error());
-         }
+         QString baseName = inlineGraphBaseName(Config::getString("rtf-output"), "inline_mscgraph_", s->text()) + ".msc";
 
          QString text = "msc {";
          text += s->text();
          text += "}";
 
-         file.write( text.toUtf8() );
-         file.close();
+         writeInlineGraphFile(baseName, text.toUtf8());
 
          m_t << "\\par{\\qc "; // center picture
          writeMscFile(baseName);
@@ -391,7 +375,8 @@ void RTFDocVisitor::visit(DocVerbatim *s)
          m_t << "} ";
 
          if (Config::getBool("dot-cleanup")) {
-            file.remove();
+            // mscgen runs in the background and still needs the file
+            ToolExecutor::instance()->removeWhenDone(baseName);
          }
       }
       break;
@@ -2081,14 +2081,12 @@ bool isLeadBytes(int c)
 }
 
 
-// note: function is not reentrant!
 static void encodeForOutput(QTextStream &t_stream, const QString &text)
 {
    if (text.isEmpty()) {
       return;
    }
       
-   static QByteArray enc;
    QString outputEncoding = QString("CP%1").arg(theTranslator->trRTFansicp());
       
    QTextCodec *outCodec = QTextCodec::codecForName(outputEncoding.toUtf8());
@@ -2099,7 +2097,7 @@ static void encodeForOutput(QTextStream &t_stream, const QString &text)
    }
 
    QString temp = text;
-   enc = outCodec->fromUnicode(temp);
+   QByteArray enc = outCodec->fromUnicode(temp);
   
    uint i;
    bool multiByte = false;
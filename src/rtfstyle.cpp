@@ -26,7 +26,7 @@
 #include <doxy_globals.h>
 #include <message.h>
 
-RTFListItemInfo rtf_listItemInfo[rtf_maxIndentLevels];
+thread_local RTFListItemInfo rtf_listItemInfo[rtf_maxIndentLevels];
 
 QString rtf_title;
 QString rtf_subject;
@@ -42,7 +42,8 @@ struct RTFListItemInfo {
 
 const int rtf_maxIndentLevels = 10;
 
-extern RTFListItemInfo rtf_listItemInfo[rtf_maxIndentLevels];
+// list state of the RTF page being written, each thread writes its own pages
+extern thread_local RTFListItemInfo rtf_listItemInfo[rtf_maxIndentLevels];
 
 struct Rtf_Style_Default {
    QString name;
@@ -0,0 +1,48 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+
+#include <scannerstate.h>
+
+static thread_local bool s_usedShared = false;
+static thread_local bool s_worker     = false;
+
+void ScannerState::begin()
+{
+   s_usedShared = false;
+}
+
+bool ScannerState::usedShared()
+{
+   return s_usedShared;
+}
+
+bool ScannerState::useShared()
+{
+   s_usedShared = true;
+   return ! s_worker;
+}
+
+bool ScannerState::isWorker()
+{
+   return s_worker;
+}
+
+void ScannerState::setWorker(bool worker)
+{
+   s_worker = worker;
+}
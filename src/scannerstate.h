@@ -0,0 +1,54 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+
+#ifndef SCANNERSTATE_H
+#define SCANNERSTATE_H
+
+/** @brief Tracks the use of state which the scanners share between input files.
+ *
+ *  Sections, formulas, citations, member groups, special lists, namespace aliases and the
+ *  numbering of anonymous scopes are collected across all input files. The scanners call
+ *  useShared() each time they read or change one of them. The entry cache only stores the
+ *  Entry tree of a file which did not use this state, the cached tree would depend on the
+ *  other input files.
+ *
+ *  The state is kept per thread. On a parse worker thread the scanners must not touch the
+ *  shared state, useShared() returns false and the file is scanned again on the main thread.
+ */
+class ScannerState
+{
+ public:
+   /** Starts tracking the scan of an input file on the current thread */
+   static void begin();
+
+   /** Returns true if the scan started by begin() used the shared state */
+   static bool usedShared();
+
+   /** Called by a scanner before it reads or changes the shared state, returns false if the
+    *  scanner must skip the access because it runs on a parse worker thread
+    */
+   static bool useShared();
+
+   /** Returns true if the current thread is a parse worker */
+   static bool isWorker();
+
+   /** Marks the current thread as a parse worker */
+   static void setWorker(bool worker);
+};
+
+#endif
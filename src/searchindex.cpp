@@ -16,9 +16,11 @@
 *************************************************************************/
 
 #include <QFile>
-#include <QRegExp>
+#include <QMap>
+#include <QMutexLocker>
 #include <QTextStream>
 
+#include <algorithm>
 #include <ctype.h>
 #include <assert.h>
 
@@ -28,8 +30,10 @@
 #include <doxy_globals.h>
 #include <doxy_build_info.h>
 #include <language.h>
+#include <marshal.h>
 #include <message.h>
 #include <resourcemgr.h>
+#include <toolexecutor.h>
 #include <util.h>
 
 IndexWord::IndexWord(const QString &word) : m_word(word)
@@ -38,18 +42,43 @@ IndexWord::IndexWord(const QString &word) : m_word(word)
 
 void IndexWord::addUrlIndex(int idx, bool hiPriority)
 {  
-   QSharedPointer<URLInfo> ui = m_urls.value(idx);
-
-   if (! ui) {     
-      ui = QMakeShared<URLInfo>(idx, 0);
-      m_urls.insert(idx, ui);
+   // words are mostly added for the current document, only the last entry is checked
+   if (m_urls.isEmpty() || m_urls.last().urlIdx != idx) {
+      m_urls.append(URLInfo(idx, 0));
    }
 
-   ui->freq += 2;
+   URLInfo &ui = m_urls.last();
+   ui.freq += 2;
 
    if (hiPriority) {
-      ui->freq |= 1;   // mark as high priority document
+      ui.freq |= 1;   // mark as high priority document
+   }
+}
+
+void IndexWord::sortUrls()
+{
+   std::stable_sort(m_urls.begin(), m_urls.end(), [](const URLInfo &a, const URLInfo &b) {
+      return a.urlIdx < b.urlIdx;
+   });
+
+   int count = 0;
+
+   for (int i = 0; i < m_urls.count(); i++) {
+      const URLInfo &ui = m_urls.at(i);
+
+      if (count > 0 && m_urls.at(count - 1).urlIdx == ui.urlIdx) {
+         // same url was added again after another document
+         URLInfo &prev = m_urls[count - 1];
+         prev.freq = ((prev.freq & ~1) + (ui.freq & ~1)) | ((prev.freq | ui.freq) & 1);
+
+      } else {
+         m_urls[count] = ui;
+         ++count;
+
+      }
    }
+
+   m_urls.resize(count);
 }
 
 SearchIndex::SearchIndex() : SearchIndexIntf(Internal), m_urlIndex(-1)
@@ -159,10 +188,10 @@ void SearchIndex::setCurrentDoc(QSharedPointer<Definition> ctx, const QString &a
       ++m_urlIndex;
 
       m_url2IdMap.insert(baseUrl, m_urlIndex);
-      m_urls.insert(m_urlIndex, QSharedPointer<URL>(new URL(name, url)));
+      m_urls.append(URL(name, url));
 
    } else {
-      m_urls.insert(*pIndex, QSharedPointer<URL>(new URL(name, url)));
+      m_urls[*pIndex] = URL(name, url);
    }
 
 }
@@ -180,72 +209,148 @@ static int charsToIndex(const QString &word)
    return c1 * 256 + c2;
 }
 
-void SearchIndex::addWord(const QString &word, bool hiPriority, bool recurse)
+void SearchIndex::addWordPart(const QString &word, bool hiPriority)
 {
-   if (word.isEmpty()) {
-      return;
-   }
+   auto iter = m_wordIndex.constFind(word);
+   int index;
 
-   static QRegExp nextPart("[_a-z:][A-Z]");
+   if (iter == m_wordIndex.constEnd()) {
+      index = m_words.count();
 
-   QString wStr = word.toLower();   
-   QSharedPointer<IndexWord> w = m_words.value(wStr);
+      m_wordIndex.insert(word, index);
+      m_words.append(IndexWord(word));
 
-   if (! w) {
-      int idx = charsToIndex(wStr);
-     
-      if (idx < 0) {
-         return;
-      }
+   } else {
+      index = iter.value();
 
-      w = QMakeShared<IndexWord>(wStr);     
-      m_words.insert(wStr, w);
    }
 
-   w->addUrlIndex(m_urlIndex, hiPriority);
+   m_words[index].addUrlIndex(m_urlIndex, hiPriority);
+}
 
-   int i;
-   bool found = false;
+// returns the position of the first match of [_a-z:][A-Z] in word, -1 if there is none
+static int nextWordPart(const QString &word, int from)
+{
+   const QChar *data = word.constData();
+   int len = word.length();
 
-   if (! recurse) { 
-      // the first time we check if we can strip the prefix
-      i = getPrefixIndex(word);
+   for (int i = from; i + 1 < len; i++) {
+      ushort c1 = data[i].unicode();
+      ushort c2 = data[i + 1].unicode();
 
-      if (i > 0) {
-         addWord(word.mid(i), hiPriority, true);
-         found = true;
+      if ((c1 == '_' || c1 == ':' || (c1 >= 'a' && c1 <= 'z')) && c2 >= 'A' && c2 <= 'Z') {
+         return i;
       }
    }
 
-   if (! found) { 
-      // no prefix stripped
-      i = nextPart.indexIn(word);
-
-      if (i >= 1) {       
-         addWord(word.mid(i+1), hiPriority, true);
-      }
-   }
+   return -1;
 }
 
 void SearchIndex::addWord(const QString &word, bool hiPriority)
 {
-   addWord(word, hiPriority, false);
+   // the word is added, followed by the word without its prefix or the remaining parts of a camel case word
+   QString lower = word.toLower();
+
+   // lower case of a part is the same as part of the lower case word unless the conversion changed the length
+   bool sameLength = (lower.length() == word.length());
+
+   int pos = 0;
+
+   while (true) {
+      int len = word.length() - pos;
+
+      if (len < 2) {
+         return;
+      }
+
+      addWordPart(sameLength ? lower.mid(pos) : word.mid(pos).toLower(), hiPriority);
+
+      int next = -1;
+
+      if (pos == 0) {
+         // the first time we check if we can strip the prefix
+         int i = getPrefixIndex(word);
+
+         if (i > 0) {
+            next = i;
+         }
+      }
+
+      if (next < 0) {
+         // no prefix stripped
+         int i = nextWordPart(word, pos);
+
+         if (i > pos) {
+            next = i + 1;
+         }
+      }
+
+      if (next < 0) {
+         return;
+      }
+
+      pos = next;
+   }
 }
 
-static void writeInt(QFile &f, int index)
+/** Writes the search index through a buffer, keeps track of the position in the file */
+class SearchIndexWriter
 {
-   f.putChar(((uint)index) >> 24);
-   f.putChar((((uint)index) >> 16) & 0xff);
-   f.putChar((((uint)index) >> 8) & 0xff);
-   f.putChar(((uint)index) & 0xff);
-}
+ public:
+   SearchIndexWriter(QFile &file)
+      : m_file(file), m_pos(0)
+   {
+      m_buffer.reserve(BufferSize);
+   }
 
-static void writeString(QFile &file, const QString &str)
-{  
-   file.write(str.toUtf8());
-   file.putChar(0);
-}
+   ~SearchIndexWriter() {
+      flush();
+   }
+
+   int pos() const {
+      return m_pos;
+   }
+
+   void putChar(char c) {
+      m_buffer.append(c);
+      ++m_pos;
+
+      if (m_buffer.size() >= BufferSize) {
+         flush();
+      }
+   }
+
+   // all multi-byte values are stored in big endian format
+   void writeInt(int index) {
+      putChar(((uint)index) >> 24);
+      putChar((((uint)index) >> 16) & 0xff);
+      putChar((((uint)index) >> 8) & 0xff);
+      putChar(((uint)index) & 0xff);
+   }
 
+   void writeString(const QString &str) {
+      QByteArray data = str.toUtf8();
+
+      m_buffer.append(data);
+      m_pos += data.size();
+
+      putChar(0);
+   }
+
+   void flush() {
+      if (! m_buffer.isEmpty()) {
+         m_file.write(m_buffer);
+         m_buffer.clear();
+      }
+   }
+
+ private:
+   static const int BufferSize = 1024 * 1024;
+
+   QFile &m_file;
+   QByteArray m_buffer;
+   int m_pos;
+};
 
 // file format: (all multi-byte values are stored in big endian format)
 //   4 byte header
@@ -261,75 +366,116 @@ static void writeString(QFile &file, const QString &str)
 void SearchIndex::write(const QString &fileName)
 {
    static const int numIndexEntries = 256 * 256;
-    
-   QMap<QString, int> wordStatOffsets;  
-   QMap<QString, int> urlOffsets;
-   QMap<int, int> wordOffsets;
-    
+
    QFile f(fileName);
 
-   if (f.open(QIODevice::WriteOnly)) {
-      // write header
-      f.putChar('D');
-      f.putChar('O');
-      f.putChar('X');
-      f.putChar('S');
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s, error: %d\n", csPrintable(fileName), f.error());
+      return;
+   }
+
+   // sort the words once, words with the same first two characters end up next to each other
+   QVector<int> order(m_words.count());
+
+   for (int i = 0; i < order.count(); i++) {
+      order[i] = i;
+   }
+
+   std::sort(order.begin(), order.end(), [this](int a, int b) {
+      return m_words.at(a).word() < m_words.at(b).word();
+   });
+
+   QVector<int> urlOffsets(m_urls.count());
+   QVector<int> wordStatOffsets(m_words.count());
+   QVector<int> wordOffsets(numIndexEntries, 0);
 
-      f.seek((numIndexEntries * 4) + 4);
+   {
+      SearchIndexWriter writer(f);
+
+      // write header
+      writer.putChar('D');
+      writer.putChar('O');
+      writer.putChar('X');
+      writer.putChar('S');
 
-      // write urls     
-      for (auto item : m_urls) {
+      // space for the index, written at the end
+      for (int i = 0; i < numIndexEntries; i++) {
+         writer.writeInt(0);
+      }
 
+      // write urls
+      for (int i = 0; i < m_urls.count(); i++) {
          // save the offset of this url
-         urlOffsets.insert(item->name, f.pos());
+         urlOffsets[i] = writer.pos();
 
-         writeString(f, item->name);
-         writeString(f, item->url);
+         writer.writeString(m_urls.at(i).name);
+         writer.writeString(m_urls.at(i).url);
       }
 
-      // write word statistics                    
-      for (auto item1 : m_words) {            
+      // write word statistics
+      for (int i : order) {
+         IndexWord &word = m_words[i];
+         word.sortUrls();
+
+         // words added before the first document was set have no url
+         const QVector<URLInfo> &urls = word.urls();
+         int first = 0;
+
+         while (first < urls.count() && urls.at(first).urlIdx < 0) {
+            ++first;
+         }
 
          // save the offset of this stats entry
-         wordStatOffsets.insert(item1->word(), f.pos() );
-
-         int numUrls = item1->urls().count();
-         writeInt(f, numUrls);
-        
-         for (auto item2 : item1->urls() ) {
-            writeInt(f, urlOffsets.value(m_urls.value(item2->urlIdx)->name));
-            writeInt(f, item2->freq);
+         wordStatOffsets[i] = writer.pos();
+         writer.writeInt(urls.count() - first);
+
+         for (int j = first; j < urls.count(); j++) {
+            writer.writeInt(urlOffsets.at(urls.at(j).urlIdx));
+            writer.writeInt(urls.at(j).freq);
          }
-      }                                   
+      }
 
       int lastIndex = -1;
 
-      for (auto item : m_words) {
-         int currentIndex = charsToIndex(item->word());
-         
+      for (int i : order) {
+         const QString &word = m_words.at(i).word();
+         int currentIndex = charsToIndex(word);
+
          if (lastIndex != currentIndex) {
 
             if (lastIndex != -1) {
-               f.putChar(0); 
+               writer.putChar(0);
             }
 
-            lastIndex = currentIndex;   
-            wordOffsets.insert(currentIndex, f.pos());
+            lastIndex = currentIndex;
+
+            if (currentIndex < numIndexEntries) {
+               wordOffsets[currentIndex] = writer.pos();
+            }
          }
 
-         writeString(f, item->word());
-         writeInt(f, wordStatOffsets[item->word()]);        
+         writer.writeString(word);
+         writer.writeInt(wordStatOffsets.at(i));
       }
-       
-      f.putChar(0);  
-     
-      // write index
-      f.seek(4);
 
-      for (int i = 0; i < numIndexEntries; i++) {
-         writeInt(f, wordOffsets.value(i));
-      }  
+      writer.putChar(0);
+   }
+
+   // write index
+   QByteArray index;
+   index.reserve(numIndexEntries * 4);
+
+   for (int i = 0; i < numIndexEntries; i++) {
+      uint value = wordOffsets.at(i);
+
+      index.append(char(value >> 24));
+      index.append(char((value >> 16) & 0xff));
+      index.append(char((value >> 8) & 0xff));
+      index.append(char(value & 0xff));
    }
+
+   f.seek(4);
+   f.write(index);
 }
 
 // the following part is for writing an external search index
@@ -489,6 +635,80 @@ void SearchIndexExternal::write(const QString &fileName)
    }
 }
 
+void SearchIndexRecorder::setCurrentDoc(QSharedPointer<Definition> ctx, const QString &anchor, bool isSourceFile)
+{
+   if (ctx == nullptr) {
+      return;
+   }
+
+   Call call;
+
+   call.ctx  = ctx;
+   call.text = anchor;
+   call.flag = isSourceFile;
+
+   m_calls.append(call);
+}
+
+void SearchIndexRecorder::addWord(const QString &word, bool hiPriority)
+{
+   Call call;
+
+   call.text = word;
+   call.flag = hiPriority;
+
+   m_calls.append(call);
+}
+
+void SearchIndexRecorder::replay(SearchIndexIntf *intf) const
+{
+   for (const auto &call : m_calls) {
+
+      if (call.ctx) {
+         intf->setCurrentDoc(call.ctx, call.text, call.flag);
+      } else {
+         intf->addWord(call.text, call.flag);
+      }
+   }
+}
+
+void SearchIndexRecorder::marshal(StorageIntf *s) const
+{
+   marshalUInt(s, m_calls.count());
+
+   for (const auto &call : m_calls) {
+      marshalQString(s, definitionKey(call.ctx));
+      marshalQString(s, call.text);
+      marshalBool(s, call.flag);
+   }
+}
+
+bool SearchIndexRecorder::unmarshal(StorageIntf *s)
+{
+   uint count = unmarshalUInt(s);
+
+   for (uint i = 0; i < count; i++) {
+      Call call;
+
+      QString ctxKey = unmarshalQString(s);
+
+      call.text = unmarshalQString(s);
+      call.flag = unmarshalBool(s);
+
+      if (! ctxKey.isEmpty()) {
+         call.ctx = findDefinitionByKey(ctxKey);
+
+         if (call.ctx == nullptr) {
+            return false;
+         }
+      }
+
+      m_calls.append(call);
+   }
+
+   return true;
+}
+
 // the following part is for the javascript based search engine
 
 #define SEARCH_INDEX_ALL         0
@@ -674,6 +894,385 @@ class SearchIndexCategoryMapping
    QString categoryLabel[NUM_SEARCH_INDICES];
 };
 
+// format of an entry in the data file
+// searchData[] = array of items
+// searchData[x][0] = id
+// searchData[x][1] = [ name + child1 + child2 + .. ]
+// searchData[x][1][0] = name as shown
+// searchData[x][1][y+1] = info for child y
+// searchData[x][1][y+1][0] = url
+// searchData[x][1][y+1][1] = 1 => target="_parent"
+// searchData[x][1][y+1][2] = scope
+static QString searchDataEntry(QSharedPointer<SearchDefinitionList> dl)
+{
+   static bool extLinksInWindow = Config::getBool("external-links-in-window");
+
+   QString retval;
+   QTextStream ti(&retval);
+
+   QSharedPointer<Definition> d = dl->first();
+
+   QString dispName = d->localName();
+
+   if (d->definitionType() == Definition::TypeGroup) {
+      dispName = d.dynamicCast<GroupDef>()->groupTitle();
+
+   } else if (d->definitionType() == Definition::TypePage) {
+      dispName = d.dynamicCast<PageDef>()->title();
+
+   }
+
+   ti << "  ['" << searchId(dispName) << "',['"
+      << convertToXML(dispName) << "',[";
+
+   if (dl->count() == 1) { 
+      // item with a unique name
+      QSharedPointer<MemberDef> md;
+
+      bool isMemberDef = d->definitionType() == Definition::TypeMember;
+      if (isMemberDef) {
+         md = d.dynamicCast<MemberDef>();
+      }
+
+      QString anchor = d->anchor();
+
+      ti << "'" << externalRef("../", d->getReference(), true)
+         << d->getOutputFileBase() << Doxy_Globals::htmlFileExtension;
+      if (!anchor.isEmpty()) {
+         ti << "#" << anchor;
+      }
+      ti << "',";
+
+      if (!extLinksInWindow || d->getReference().isEmpty()) {
+         ti << "1,";
+      } else {
+         ti << "0,";
+      }
+
+      if (d->getOuterScope() != Doxy_Globals::globalScope) {
+         ti << "'" << convertToXML(d->getOuterScope()->name()) << "'";
+
+      } else if (md) {
+         QSharedPointer<FileDef> fd = md->getBodyDef();
+
+         if (fd == 0) {
+            fd = md->getFileDef();
+         }
+         if (fd) {
+            ti << "'" << convertToXML(fd->localName()) << "'";
+         }
+
+      } else {
+         ti << "''";
+      }
+
+      ti << "]]";
+
+   } else { 
+      // multiple items with the same name
+      bool overloadedFunction = false;
+      int childCount = 0;
+
+      QSharedPointer<Definition> next;
+      QSharedPointer<Definition> prevScope;  
+
+      auto nextIter = dl->begin();   
+
+      for (auto d : *dl)  {               
+         QSharedPointer<Definition> scope = d->getOuterScope();
+
+         if (nextIter != dl->end()) {  
+            ++nextIter;   
+         }
+
+         if (nextIter == dl->end()) {  
+            next = QSharedPointer<Definition>();
+
+         } else {
+            next = *nextIter;
+
+         }
+      
+         QSharedPointer<Definition> nextScope;
+         QSharedPointer<MemberDef>  md;
+
+         bool isMemberDef = d->definitionType() == Definition::TypeMember;
+
+         if (isMemberDef) {
+            md = d.dynamicCast<MemberDef>();
+         }
+
+         if (next) {
+            nextScope = next->getOuterScope();
+         }
+
+         QString anchor = d->anchor();
+
+         if (childCount > 0) {
+            ti << "],[";
+         }
+         ti << "'" << externalRef("../", d->getReference(), true)
+            << d->getOutputFileBase() << Doxy_Globals::htmlFileExtension;
+
+         if (!anchor.isEmpty()) {
+            ti << "#" << anchor;
+         }
+         ti << "',";
+
+         if (! extLinksInWindow || d->getReference().isEmpty()) {
+            ti << "1,";
+         } else {
+            ti << "0,";
+         }
+
+         bool found = false;
+         overloadedFunction = ((prevScope != 0 && scope == prevScope) || (scope && scope == nextScope)) 
+                                 && md && (md->isFunction() || md->isSlot());
+
+         QString prefix;
+
+         if (md) {
+            prefix = convertToXML(md->localName());
+         }
+
+         if (overloadedFunction) {
+            // overloaded member function
+            prefix += convertToXML(md->argsString());
+            // show argument list to disambiguate overloaded functions
+
+         } else if (md) {
+            // unique member function
+            prefix += "()"; // only to show it is a function
+         }
+
+         QString name;
+         if (d->definitionType() == Definition::TypeClass) {
+
+            name  = convertToXML(d.dynamicCast<ClassDef>()->displayName());
+            found = true;
+
+         } else if (d->definitionType() == Definition::TypeNamespace) {
+
+            name  = convertToXML(d.dynamicCast<NamespaceDef>()->displayName());
+            found = true;
+
+         } else if (scope == 0 || scope == Doxy_Globals::globalScope) { 
+            // in global scope
+
+            if (md) {
+               QSharedPointer<FileDef> fd = md->getBodyDef();
+
+               if (fd == 0) {
+                  fd = md->getFileDef();
+               }
+
+               if (fd) {
+                  if (! prefix.isEmpty()) {
+                     prefix += ":&#160;";
+                  }
+                  name = prefix + convertToXML(fd->localName());
+                  found = true;
+               }
+            }
+
+         } else if (md && (md->getClassDef() || md->getNamespaceDef())) {
+            // member in class or namespace scope
+         
+            SrcLangExt lang = md->getLanguage();
+            name = convertToXML(d->getOuterScope()->qualifiedName())
+                   + getLanguageSpecificSeparator(lang) + prefix;
+
+            found = true;
+
+         } else if (scope) {
+            // some thing else? -> show scope
+
+            name = prefix + convertToXML(scope->name());
+            found = true;
+         }
+
+         if (! found) { 
+            // fallback
+            name = prefix + "(" + theTranslator->trGlobalNamespace() + ")";
+         }
+
+         ti << "'" << name << "'";
+
+         prevScope = scope;
+         childCount++;
+
+      }
+
+      ti << "]]";
+   }
+
+   ti << "]";
+   ti.flush();
+
+   return retval;
+}
+
+// letters with more entries are split in shards
+static const int s_maxEntriesPerBucket = 2000;
+
+// limits the memory used by buckets waiting to be written
+static const int s_maxPendingBuckets = 64;
+
+/** Writes one bucket of the SearchBucketQueue */
+class SearchBucketTask : public ToolTask
+{
+ public:
+   SearchBucketTask(SearchBucketQueue *queue, const SearchBucketQueue::Bucket &bucket)
+      : m_queue(queue), m_bucket(bucket)
+   {
+   }
+
+   int run() {
+      m_queue->writeBucket(m_bucket);
+      return 0;
+   }
+
+ private:
+   SearchBucketQueue *m_queue;
+   SearchBucketQueue::Bucket m_bucket;
+};
+
+SearchBucketQueue::SearchBucketQueue(const QString &searchDirName, bool background)
+   : m_searchDirName(searchDirName), m_background(background)
+{
+   // translations are looked up once, the workers only format and write
+   m_loading   = theTranslator->trLoading();
+   m_searching = theTranslator->trSearching();
+   m_noMatches = theTranslator->trNoMatches();
+}
+
+SearchBucketQueue::~SearchBucketQueue()
+{
+   finish();
+}
+
+void SearchBucketQueue::add(const Bucket &bucket)
+{
+   if (! m_background) {
+      // single threaded mode
+      writeBucket(bucket);
+      return;
+   }
+
+   while (m_pending.count() >= s_maxPendingBuckets) {
+      waitForOldest();
+   }
+
+   SearchBucketTask *task = new SearchBucketTask(this, bucket);
+   m_pending.enqueue(qMakePair(ToolExecutor::instance()->submitTask(task), task));
+}
+
+void SearchBucketQueue::waitForOldest()
+{
+   QPair<int, SearchBucketTask *> item = m_pending.dequeue();
+
+   ToolExecutor::instance()->wait(item.first);
+   delete item.second;
+}
+
+void SearchBucketQueue::finish()
+{
+   while (! m_pending.isEmpty()) {
+      waitForOldest();
+   }
+
+   // errors are reported from the main thread
+   for (const auto &fileName : m_errors) {
+      err("Unable to open file for writing %s\n", qPrintable(fileName));
+   }
+
+   m_errors.clear();
+}
+
+void SearchBucketQueue::writeBucket(const Bucket &bucket)
+{
+   QString page;
+   QTextStream t(&page);
+
+   t << "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\""
+     " \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">" << endl;
+   t << "<html><head><title></title>" << endl;
+   t << "<meta http-equiv=\"Content-Type\" content=\"text/xhtml;charset=UTF-8\"/>" << endl;
+   t << "<meta name=\"generator\" content=\"DoxyPress " << versionString << "\"/>" << endl;
+   t << "<link rel=\"stylesheet\" type=\"text/css\" href=\"search.css\"/>" << endl;
+
+   if (bucket.numShards > 0) {
+      // the shards append their entries to searchData
+      t << "<script type=\"text/javascript\">var searchData=[];</script>" << endl;
+
+      for (int q = 0; q < bucket.numShards; q++) {
+         t << "<script type=\"text/javascript\" src=\"" << bucket.baseName << "_" << q << ".js\"></script>" << endl;
+      }
+
+   } else {
+      if (bucket.isShard) {
+         t << "<script type=\"text/javascript\">var searchData=[];</script>" << endl;
+      }
+
+      t << "<script type=\"text/javascript\" src=\"" << bucket.baseName << ".js\"></script>" << endl;
+   }
+
+   t << "<script type=\"text/javascript\" src=\"search.js\"></script>" << endl;
+   t << "</head>" << endl;
+   t << "<body class=\"SRPage\">" << endl;
+   t << "<div id=\"SRIndex\">" << endl;
+   t << "<div class=\"SRStatus\" id=\"Loading\">" << m_loading << "</div>" << endl;
+   t << "<div id=\"SRResults\"></div>" << endl; // here the results will be inserted
+   t << "<script type=\"text/javascript\"><!--" << endl;
+   t << "createResults();" << endl; // this function will insert the results
+   t << "--></script>" << endl;
+
+   t << "<div class=\"SRStatus\" id=\"Searching\">" << m_searching << "</div>" << endl;
+   t << "<div class=\"SRStatus\" id=\"NoMatches\">" << m_noMatches << "</div>" << endl;
+
+   t << "<script type=\"text/javascript\"><!--" << endl;
+   t << "document.getElementById(\"Loading\").style.display=\"none\";" << endl;
+   t << "document.getElementById(\"NoMatches\").style.display=\"none\";" << endl;
+   t << "var searchResults = new SearchResults(\"searchResults\");" << endl;
+   t << "searchResults.Search();" << endl;
+   t << "--></script>" << endl;
+   t << "</div>" << endl; // SRIndex
+   t << "</body>" << endl;
+   t << "</html>" << endl;
+   t.flush();
+
+   QString fileName = m_searchDirName + "/" + bucket.baseName + ".html";
+   QFile outFile(fileName);
+
+   bool ok = outFile.open(QIODevice::WriteOnly) && outFile.write(page.toUtf8()) != -1;
+
+   if (ok && bucket.numShards == 0) {
+      QString data;
+
+      if (bucket.isShard) {
+         data = "searchData=searchData.concat(\n[\n";
+      } else {
+         data = "var searchData=\n[\n";
+      }
+
+      if (! bucket.entries.isEmpty()) {
+         data += bucket.entries.join(",\n") + "\n";
+      }
+
+      data += bucket.isShard ? "]);\n" : "];\n";
+
+      fileName = m_searchDirName + "/" + bucket.baseName + ".js";
+      QFile dataOutFile(fileName);
+
+      ok = dataOutFile.open(QIODevice::WriteOnly) && dataOutFile.write(data.toUtf8()) != -1;
+   }
+
+   if (! ok) {
+      QMutexLocker locker(&m_mutex);
+      m_errors.append(fileName);
+   }
+}
+
 void writeJavascriptSearchIndex()
 {
    if (! Config::getBool("generate-html")) {
@@ -804,84 +1403,39 @@ void writeJavascriptSearchIndex()
    // write index files
    QString searchDirName = Config::getString("html-output") + "/search";
 
-   for (int i = 0; i < NUM_SEARCH_INDICES; i++) { 
-      // for each index    
+   // a value of 1 writes the files from the main thread, otherwise the workers of the ToolExecutor are used
+   bool background = (Config::getInt("search-num-threads") != 1);
+
+   // second characters of the shards for each letter which is split
+   QMap<int, QString> searchIndexShards[NUM_SEARCH_INDICES];
+
+   SearchBucketQueue queue(searchDirName, background);
+
+   for (int i = 0; i < NUM_SEARCH_INDICES; i++) {
+      // for each index
       int p = 0;
-      
-      for (auto sl : g_searchIndexSymbols[i]) {   
+
+      for (auto sl : g_searchIndexSymbols[i]) {
          // for each letter
-         QString baseName = QString("%1_%2").arg(g_searchIndexName[i]).arg(p);
-
-         QString fileName     = searchDirName + "/" + baseName + ".html";
-         QString dataFileName = searchDirName + "/" + baseName + ".js";
-
-         QFile outFile(fileName);
-         QFile dataOutFile(dataFileName);
-
-         if (outFile.open(QIODevice::WriteOnly) && dataOutFile.open(QIODevice::WriteOnly)) {
-            {
-               QTextStream t(&outFile);
-
-               t << "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\""
-                 " \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">" << endl;
-               t << "<html><head><title></title>" << endl;
-               t << "<meta http-equiv=\"Content-Type\" content=\"text/xhtml;charset=UTF-8\"/>" << endl;
-               t << "<meta name=\"generator\" content=\"DoxyPress " << versionString << "\"/>" << endl;
-               t << "<link rel=\"stylesheet\" type=\"text/css\" href=\"search.css\"/>" << endl;
-               t << "<script type=\"text/javascript\" src=\"" << baseName << ".js\"></script>" << endl;
-               t << "<script type=\"text/javascript\" src=\"search.js\"></script>" << endl;
-               t << "</head>" << endl;
-               t << "<body class=\"SRPage\">" << endl;
-               t << "<div id=\"SRIndex\">" << endl;
-               t << "<div class=\"SRStatus\" id=\"Loading\">" << theTranslator->trLoading() << "</div>" << endl;
-               t << "<div id=\"SRResults\"></div>" << endl; // here the results will be inserted
-               t << "<script type=\"text/javascript\"><!--" << endl;
-               t << "createResults();" << endl; // this function will insert the results
-               t << "--></script>" << endl;
-
-               t << "<div class=\"SRStatus\" id=\"Searching\">"
-                 << theTranslator->trSearching() << "</div>" << endl;
-
-               t << "<div class=\"SRStatus\" id=\"NoMatches\">"
-                 << theTranslator->trNoMatches() << "</div>" << endl;
-
-               t << "<script type=\"text/javascript\"><!--" << endl;
-               t << "document.getElementById(\"Loading\").style.display=\"none\";" << endl;
-               t << "document.getElementById(\"NoMatches\").style.display=\"none\";" << endl;
-               t << "var searchResults = new SearchResults(\"searchResults\");" << endl;
-               t << "searchResults.Search();" << endl;
-               t << "--></script>" << endl;
-               t << "</div>" << endl; // SRIndex
-               t << "</body>" << endl;
-               t << "</html>" << endl;
-            }
+         SearchBucketQueue::Bucket bucket;
+         bucket.baseName = QString("%1_%2").arg(g_searchIndexName[i]).arg(p);
 
-            QTextStream ti(&dataOutFile);
+         if (sl->count() <= s_maxEntriesPerBucket) {
 
-            ti << "var searchData=" << endl;
-            // format
-            // searchData[] = array of items
-            // searchData[x][0] = id
-            // searchData[x][1] = [ name + child1 + child2 + .. ]
-            // searchData[x][1][0] = name as shown
-            // searchData[x][1][y+1] = info for child y
-            // searchData[x][1][y+1][0] = url
-            // searchData[x][1][y+1][1] = 1 => target="_parent"
-            // searchData[x][1][y+1][2] = scope
+            for (auto dl : *sl) {
+               bucket.entries.append(searchDataEntry(dl));
+            }
 
-            ti << "[" << endl;
+            queue.add(bucket);
 
-            bool firstEntry = true;           
-            int itemCount   = 0;
-         
-            for (auto dl : *sl) { 
-               QSharedPointer<Definition> d = dl->first();
-               
-               if (! firstEntry) {
-                  ti << "," << endl;
-               }
-               firstEntry = false;
+         } else {
+            // split the letter on the second character of the name, search.js loads only
+            // the shard which matches the first two characters of the search term
+            QString shardChars;
+            QList<QStringList> shardEntries;
 
+            for (auto dl : *sl) {
+               QSharedPointer<Definition> d = dl->first();
                QString dispName = d->localName();
 
                if (d->definitionType() == Definition::TypeGroup) {
@@ -892,211 +1446,50 @@ void writeJavascriptSearchIndex()
 
                }
 
-               ti << "  ['" << searchId(dispName) << "',['"
-                  << convertToXML(dispName) << "',[";
+               int pos = (! dispName.isEmpty() && dispName.at(0).isHighSurrogate()) ? 2 : 1;
+               int shard = 0;
 
-               if (dl->count() == 1) { 
-                  // item with a unique name
-                  QSharedPointer<MemberDef> md;
+               // a name without a second character can not match a longer search term
+               if (pos < dispName.length()) {
+                  QChar c = dispName.at(pos).toLower();
+                  shard = shardChars.indexOf(c);
 
-                  bool isMemberDef = d->definitionType() == Definition::TypeMember;
-                  if (isMemberDef) {
-                     md = d.dynamicCast<MemberDef>();
+                  if (shard == -1) {
+                     shard = shardChars.length();
+                     shardChars += c;
                   }
+               }
 
-                  QString anchor = d->anchor();
-
-                  ti << "'" << externalRef("../", d->getReference(), true)
-                     << d->getOutputFileBase() << Doxy_Globals::htmlFileExtension;
-                  if (!anchor.isEmpty()) {
-                     ti << "#" << anchor;
-                  }
-                  ti << "',";
-
-                  static bool extLinksInWindow = Config::getBool("external-links-in-window");
-                  if (!extLinksInWindow || d->getReference().isEmpty()) {
-                     ti << "1,";
-                  } else {
-                     ti << "0,";
-                  }
-
-                  if (d->getOuterScope() != Doxy_Globals::globalScope) {
-                     ti << "'" << convertToXML(d->getOuterScope()->name()) << "'";
-
-                  } else if (md) {
-                     QSharedPointer<FileDef> fd = md->getBodyDef();
-
-                     if (fd == 0) {
-                        fd = md->getFileDef();
-                     }
-                     if (fd) {
-                        ti << "'" << convertToXML(fd->localName()) << "'";
-                     }
-
-                  } else {
-                     ti << "''";
-                  }
-
-                  ti << "]]";
-
-               } else { 
-                  // multiple items with the same name
-                  bool overloadedFunction = false;
-                  int childCount = 0;
-
-                  QSharedPointer<Definition> next;
-                  QSharedPointer<Definition> prevScope;  
- 
-                  auto nextIter = dl->begin();   
-
-                  for (auto d : *dl)  {               
-                     QSharedPointer<Definition> scope = d->getOuterScope();
-
-                     if (nextIter != dl->end()) {  
-                        ++nextIter;   
-                     }
-
-                     if (nextIter == dl->end()) {  
-                        next = QSharedPointer<Definition>();
-
-                     } else {
-                        next = *nextIter;
-
-                     }
-                  
-                     QSharedPointer<Definition> nextScope;
-                     QSharedPointer<MemberDef>  md;
-
-                     bool isMemberDef = d->definitionType() == Definition::TypeMember;
-
-                     if (isMemberDef) {
-                        md = d.dynamicCast<MemberDef>();
-                     }
-
-                     if (next) {
-                        nextScope = next->getOuterScope();
-                     }
-
-                     QString anchor = d->anchor();
-
-                     if (childCount > 0) {
-                        ti << "],[";
-                     }
-                     ti << "'" << externalRef("../", d->getReference(), true)
-                        << d->getOutputFileBase() << Doxy_Globals::htmlFileExtension;
-
-                     if (!anchor.isEmpty()) {
-                        ti << "#" << anchor;
-                     }
-                     ti << "',";
-
-                     static bool extLinksInWindow = Config::getBool("external-links-in-window");
-                     if (! extLinksInWindow || d->getReference().isEmpty()) {
-                        ti << "1,";
-                     } else {
-                        ti << "0,";
-                     }
-
-                     bool found = false;
-                     overloadedFunction = ((prevScope != 0 && scope == prevScope) || (scope && scope == nextScope)) 
-                                             && md && (md->isFunction() || md->isSlot());
-
-                     QString prefix;
-
-                     if (md) {
-                        prefix = convertToXML(md->localName());
-                     }
-
-                     if (overloadedFunction) {
-                        // overloaded member function
-                        prefix += convertToXML(md->argsString());
-                        // show argument list to disambiguate overloaded functions
-
-                     } else if (md) {
-                        // unique member function
-                        prefix += "()"; // only to show it is a function
-                     }
-
-                     QString name;
-                     if (d->definitionType() == Definition::TypeClass) {
-
-                        name  = convertToXML(d.dynamicCast<ClassDef>()->displayName());
-                        found = true;
-
-                     } else if (d->definitionType() == Definition::TypeNamespace) {
-
-                        name  = convertToXML(d.dynamicCast<NamespaceDef>()->displayName());
-                        found = true;
-
-                     } else if (scope == 0 || scope == Doxy_Globals::globalScope) { 
-                        // in global scope
-
-                        if (md) {
-                           QSharedPointer<FileDef> fd = md->getBodyDef();
-
-                           if (fd == 0) {
-                              fd = md->getFileDef();
-                           }
-
-                           if (fd) {
-                              if (! prefix.isEmpty()) {
-                                 prefix += ":&#160;";
-                              }
-                              name = prefix + convertToXML(fd->localName());
-                              found = true;
-                           }
-                        }
-
-                     } else if (md && (md->getClassDef() || md->getNamespaceDef())) {
-                        // member in class or namespace scope
-                     
-                        SrcLangExt lang = md->getLanguage();
-                        name = convertToXML(d->getOuterScope()->qualifiedName())
-                               + getLanguageSpecificSeparator(lang) + prefix;
-
-                        found = true;
-
-                     } else if (scope) {
-                        // some thing else? -> show scope
-
-                        name = prefix + convertToXML(scope->name());
-                        found = true;
-                     }
-
-                     if (! found) { 
-                        // fallback
-                        name = prefix + "(" + theTranslator->trGlobalNamespace() + ")";
-                     }
-
-                     ti << "'" << name << "'";
+               while (shard >= shardEntries.count()) {
+                  shardEntries.append(QStringList());
+               }
 
-                     prevScope = scope;
-                     childCount++;
+               shardEntries[shard].append(searchDataEntry(dl));
+            }
 
-                  }
+            // page for the letter loads all the shards
+            bucket.numShards = shardEntries.count();
+            queue.add(bucket);
 
-                  ti << "]]";
-               }
+            for (int q = 0; q < shardEntries.count(); q++) {
+               SearchBucketQueue::Bucket shardBucket;
 
-               ti << "]";
-               itemCount++;
-            }
+               shardBucket.baseName = QString("%1_%2").arg(bucket.baseName).arg(q);
+               shardBucket.isShard  = true;
+               shardBucket.entries  = shardEntries.at(q);
 
-            if (! firstEntry) {
-               ti << endl;
+               queue.add(shardBucket);
             }
 
-            ti << "];" << endl;
-
-         } else {
-            err("Unable to open file for writing %s, error: %d\n", qPrintable(fileName), outFile.error());
-          
+            searchIndexShards[i].insert(p, shardChars);
          }
 
          ++p;
       }
    }
 
+   queue.finish();
+
    {
       QFile f(searchDirName + "/searchdata.js");
 
@@ -1180,6 +1573,50 @@ void writeJavascriptSearchIndex()
          }
 
          t << "};" << endl << endl;
+
+         // for each letter which is split, the second characters of its shards
+         t << "var indexSectionShards =" << endl;
+         t << "{" << endl;
+
+         first = true;
+         j = 0;
+
+         for (int i = 0; i < NUM_SEARCH_INDICES; i++) {
+            if (g_searchIndexCount[i] > 0) {
+
+               if (!first) {
+                  t << "," << endl;
+               }
+
+               t << "  " << j << ": {";
+
+               bool firstShard = true;
+
+               for (auto iter = searchIndexShards[i].begin(); iter != searchIndexShards[i].end(); ++iter) {
+                  QString shardChars = iter.value();
+
+                  shardChars.replace("\\", "\\\\");
+                  shardChars.replace("\"", "\\\"");
+
+                  if (! firstShard) {
+                     t << ",";
+                  }
+
+                  t << " " << iter.key() << ": \"" << shardChars << "\"";
+                  firstShard = false;
+               }
+
+               t << " }";
+               first = false;
+               j++;
+            }
+         }
+
+         if (!first) {
+            t << "\n";
+         }
+
+         t << "};" << endl << endl;
       }
 
       ResourceMgr::instance().copyResourceAs("html/search.js", searchDirName, "search.js");
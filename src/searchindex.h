@@ -20,6 +20,10 @@
 
 #include <QHash>
 #include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QQueue>
+#include <QStringList>
 #include <QVector>
 
 #include <stringmap.h>
@@ -27,6 +31,7 @@
 class Definition;
 class MemberDef;
 class SearchDocEntry;
+class StorageIntf;
 
 /*! Initialize the search indexer */
 void initSearchIndexer();
@@ -37,12 +42,14 @@ void finializeSearchIndexer();
 //------- server side search index ----------------------
 
 struct URL {
+   URL() {}
    URL(const QString &n, const QString &u) : name(n), url(u) {}
    QString name;
    QString url;
 };
 
 struct URLInfo {
+   URLInfo() : urlIdx(0), freq(0) {}
    URLInfo(int idx, int f) : urlIdx(idx), freq(f) {}
    int urlIdx;
    int freq;
@@ -65,10 +72,14 @@ class SearchDefinitionList : public QList<QSharedPointer<Definition>>
 class IndexWord
 {
  public:
+   IndexWord() {}
    IndexWord(const QString &word);
    void addUrlIndex(int, bool);
 
-   const QHash<long, QSharedPointer<URLInfo>> &urls() const {
+   /** Sorts the urls by index and merges the entries for the same url */
+   void sortUrls();
+
+   const QVector<URLInfo> &urls() const {
       return m_urls;
    }
 
@@ -78,7 +89,7 @@ class IndexWord
 
  private:
    QString m_word;
-   QHash<long, QSharedPointer<URLInfo>> m_urls;
+   QVector<URLInfo> m_urls;
 };
 
 class SearchIndexIntf
@@ -113,12 +124,14 @@ class SearchIndex : public SearchIndexIntf
    void write(const QString &file) override;
 
  private:
-   void addWord(const QString &word, bool hiPrio, bool recurse);
+   void addWordPart(const QString &word, bool hiPriority);
 
-   QMap<QString, QSharedPointer<IndexWord>> m_words;
+   // words are stored in the order they are found, sorted once when written
+   QHash<QString, int> m_wordIndex;
+   QVector<IndexWord>  m_words;
 
    QHash<QString,int> m_url2IdMap;
-   QHash<long, QSharedPointer<URL>> m_urls;
+   QVector<URL>       m_urls;
 
    int m_urlIndex;
 };
@@ -140,6 +153,92 @@ class SearchIndexExternal : public SearchIndexIntf
 
 };
 
+/** Records the words added to a search index, used by worker threads which generate pages.
+ *  The caller repeats the recorded calls on the real index in the order of the pages.
+ */
+class SearchIndexRecorder : public SearchIndexIntf
+{
+ public:
+   SearchIndexRecorder(Kind k = Internal) : SearchIndexIntf(k) {}
+
+   void setCurrentDoc(QSharedPointer<Definition> ctx, const QString &anchor, bool isSourceFile) override;
+   void addWord(const QString &word, bool hiPriority) override;
+   void write(const QString &) override {}
+
+   /** Repeats the recorded calls on \a intf */
+   void replay(SearchIndexIntf *intf) const;
+
+   /** Writes the recorded calls, the documents are stored as their definitionKey() */
+   void marshal(StorageIntf *s) const;
+
+   /** Reads calls written by marshal(), returns false if a document no longer exists */
+   bool unmarshal(StorageIntf *s);
+
+   void clear() {
+      m_calls.clear();
+   }
+
+ private:
+   struct Call {
+      QSharedPointer<Definition> ctx;    // null for a word
+      QString text;                      // anchor or word
+      bool flag;                         // isSourceFile or hiPriority
+   };
+
+   QVector<Call> m_calls;
+};
+
+//------- javascript search index ----------------------
+
+class SearchBucketTask;
+
+/** Writes the pages and data files of the javascript search index on the worker threads of the ToolExecutor.
+ *
+ *  The entries of each bucket are collected by the caller, only the formatting and
+ *  writing of the files is done by the workers. At most a fixed number of buckets
+ *  are pending, which bounds memory.
+ */
+class SearchBucketQueue
+{
+ public:
+   struct Bucket {
+      Bucket() : numShards(0), isShard(false) {}
+
+      QString     baseName;
+      int         numShards;      // number of shards for a letter which is split, otherwise 0
+      bool        isShard;
+      QStringList entries;
+   };
+
+   /** When \a background is false the buckets are written by the calling thread */
+   SearchBucketQueue(const QString &searchDirName, bool background);
+   ~SearchBucketQueue();
+
+   /** Queues \a bucket to be written, waits when too many buckets are pending */
+   void add(const Bucket &bucket);
+
+   /** Waits until all queued buckets have been written and reports errors */
+   void finish();
+
+ private:
+   void writeBucket(const Bucket &bucket);
+
+   /** Waits for the oldest pending bucket */
+   void waitForOldest();
+
+   QString m_searchDirName;
+   QString m_loading;
+   QString m_searching;
+   QString m_noMatches;
+
+   QQueue<QPair<int, SearchBucketTask *>> m_pending;
+   QStringList m_errors;
+   bool        m_background;
+   QMutex      m_mutex;
+
+   friend class SearchBucketTask;
+};
+
 void writeJavascriptSearchIndex();
 
 #endif
@@ -0,0 +1,1340 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+#include <QHash>
+#include <QList>
+
+#include <string.h>
+
+#include <selftest.h>
+
+#include <arguments.h>
+#include <classdef.h>
+#include <code.h>
+#include <config.h>
+#include <diagram.h>
+#include <docparser.h>
+#include <dot.h>
+#include <doxy_globals.h>
+#include <doxy_setup.h>
+#include <entry.h>
+#include <filedef.h>
+#include <filestorage.h>
+#include <groupdef.h>
+#include <inputqueue.h>
+#include <marshal.h>
+#include <memberdef.h>
+#include <membername.h>
+#include <message.h>
+#include <namespacedef.h>
+#include <outputgen.h>
+#include <pagedef.h>
+#include <parsequeue.h>
+#include <parser_base.h>
+#include <parser_cstyle.h>
+#include <pre.h>
+#include <printdocvisitor.h>
+#include <scannerstate.h>
+#include <section.h>
+#include <store.h>
+#include <tooltip.h>
+#include <util.h>
+
+// maximum number of differences reported by one test
+static const int s_maxDiffs = 20;
+
+template <class T>
+static void compareField(const QString &path, const char *field, const T &a, const T &b, QStringList &diffs)
+{
+   if (! (a == b)) {
+      diffs.append(path + ": " + field + " differs");
+   }
+}
+
+static void compareArgumentList(const QString &path, const char *field, const ArgumentList &a,
+                  const ArgumentList &b, QStringList &diffs)
+{
+   QString argPath = path + "." + field;
+
+   compareField(argPath, "count",              a.count(),              b.count(),              diffs);
+   compareField(argPath, "constSpecifier",     a.constSpecifier,       b.constSpecifier,       diffs);
+   compareField(argPath, "volatileSpecifier",  a.volatileSpecifier,    b.volatileSpecifier,    diffs);
+   compareField(argPath, "pureSpecifier",      a.pureSpecifier,        b.pureSpecifier,        diffs);
+   compareField(argPath, "refSpecifier",       a.refSpecifier,         b.refSpecifier,         diffs);
+   compareField(argPath, "trailingReturnType", a.trailingReturnType,   b.trailingReturnType,   diffs);
+   compareField(argPath, "isDeleted",          a.isDeleted,            b.isDeleted,            diffs);
+
+   for (int i = 0; i < a.count() && i < b.count(); ++i) {
+      const Argument &argA = a.at(i);
+      const Argument &argB = b.at(i);
+
+      QString itemPath = argPath + QString("[%1]").arg(i);
+
+      compareField(itemPath, "attrib",         argA.attrib,         argB.attrib,         diffs);
+      compareField(itemPath, "type",           argA.type,           argB.type,           diffs);
+      compareField(itemPath, "canType",        argA.canType,        argB.canType,        diffs);
+      compareField(itemPath, "name",           argA.name,           argB.name,           diffs);
+      compareField(itemPath, "array",          argA.array,          argB.array,          diffs);
+      compareField(itemPath, "defval",         argA.defval,         argB.defval,         diffs);
+      compareField(itemPath, "docs",           argA.docs,           argB.docs,           diffs);
+      compareField(itemPath, "typeConstraint", argA.typeConstraint, argB.typeConstraint, diffs);
+   }
+}
+
+/** Compares every field of two entries. Member group and list item ids are handed out by global
+ *  counters, they are skipped unless \a compareIds is set.
+ */
+static void compareEntry(const QString &path, const Entry &a, const Entry &b, bool compareIds, QStringList &diffs)
+{
+   compareField(path, "tagInfo",          a.tagInfo == nullptr,  b.tagInfo == nullptr,  diffs);
+
+   if (a.tagInfo != nullptr && b.tagInfo != nullptr) {
+      compareField(path, "tagInfo.tagName",  a.tagInfo->tagName,  b.tagInfo->tagName,  diffs);
+      compareField(path, "tagInfo.fileName", a.tagInfo->fileName, b.tagInfo->fileName, diffs);
+      compareField(path, "tagInfo.anchor",   a.tagInfo->anchor,   b.tagInfo->anchor,   diffs);
+   }
+
+   compareArgumentList(path, "argList",    a.argList,    b.argList,    diffs);
+   compareArgumentList(path, "typeConstr", a.typeConstr, b.typeConstr, diffs);
+
+   compareField(path, "relatesType",      a.relatesType,         b.relatesType,         diffs);
+   compareField(path, "virt",             a.virt,                b.virt,                diffs);
+   compareField(path, "protection",       a.protection,          b.protection,          diffs);
+   compareField(path, "mtype",            a.mtype,               b.mtype,               diffs);
+   compareField(path, "groupDocType",     a.groupDocType,        b.groupDocType,        diffs);
+   compareField(path, "lang",             a.lang,                b.lang,                diffs);
+   compareField(path, "traits",           a.m_traits.toQByteArray(), b.m_traits.toQByteArray(), diffs);
+
+   compareField(path, "section",          a.section,             b.section,             diffs);
+   compareField(path, "initLines",        a.initLines,           b.initLines,           diffs);
+   compareField(path, "docLine",          a.docLine,             b.docLine,             diffs);
+   compareField(path, "briefLine",        a.briefLine,           b.briefLine,           diffs);
+   compareField(path, "inbodyLine",       a.inbodyLine,          b.inbodyLine,          diffs);
+   compareField(path, "bodyLine",         a.bodyLine,            b.bodyLine,            diffs);
+   compareField(path, "endBodyLine",      a.endBodyLine,         b.endBodyLine,         diffs);
+   compareField(path, "startLine",        a.startLine,           b.startLine,           diffs);
+   compareField(path, "startColumn",      a.startColumn,         b.startColumn,         diffs);
+
+   if (compareIds) {
+      compareField(path, "mGrpId",        a.mGrpId,              b.mGrpId,              diffs);
+   }
+
+   compareField(path, "stat",             a.stat,                b.stat,                diffs);
+   compareField(path, "explicitExternal", a.explicitExternal,    b.explicitExternal,    diffs);
+   compareField(path, "proto",            a.proto,               b.proto,               diffs);
+   compareField(path, "subGrouping",      a.subGrouping,         b.subGrouping,         diffs);
+   compareField(path, "callGraph",        a.callGraph,           b.callGraph,           diffs);
+   compareField(path, "callerGraph",      a.callerGraph,         b.callerGraph,         diffs);
+
+   // template argument lists
+   compareField(path, "tArgLists",        a.tArgLists == nullptr, b.tArgLists == nullptr, diffs);
+
+   if (a.tArgLists != nullptr && b.tArgLists != nullptr) {
+      compareField(path, "tArgLists.count", a.tArgLists->count(), b.tArgLists->count(), diffs);
+
+      for (int i = 0; i < a.tArgLists->count() && i < b.tArgLists->count(); ++i) {
+         compareArgumentList(path, qPrintable(QString("tArgLists[%1]").arg(i)), a.tArgLists->at(i), b.tArgLists->at(i), diffs);
+      }
+   }
+
+   // base classes
+   compareField(path, "extends.count",    a.extends.count(),     b.extends.count(),     diffs);
+
+   for (int i = 0; i < a.extends.count() && i < b.extends.count(); ++i) {
+      compareField(path, "extends.name",  a.extends.at(i).name,  b.extends.at(i).name,  diffs);
+      compareField(path, "extends.prot",  a.extends.at(i).prot,  b.extends.at(i).prot,  diffs);
+      compareField(path, "extends.virt",  a.extends.at(i).virt,  b.extends.at(i).virt,  diffs);
+   }
+
+   // groups
+   compareField(path, "groups",           a.groups == nullptr,   b.groups == nullptr,   diffs);
+
+   if (a.groups != nullptr && b.groups != nullptr) {
+      compareField(path, "groups.count",  a.groups->count(),     b.groups->count(),     diffs);
+
+      for (int i = 0; i < a.groups->count() && i < b.groups->count(); ++i) {
+         compareField(path, "groups.groupname", a.groups->at(i).groupname, b.groups->at(i).groupname, diffs);
+         compareField(path, "groups.pri",       a.groups->at(i).pri,       b.groups->at(i).pri,       diffs);
+      }
+   }
+
+   // anchors
+   compareField(path, "anchors",          a.anchors == nullptr,  b.anchors == nullptr,  diffs);
+
+   if (a.anchors != nullptr && b.anchors != nullptr) {
+      compareField(path, "anchors.count", a.anchors->count(),    b.anchors->count(),    diffs);
+
+      for (int i = 0; i < a.anchors->count() && i < b.anchors->count(); ++i) {
+         const SectionInfo &siA = a.anchors->at(i);
+         const SectionInfo &siB = b.anchors->at(i);
+
+         compareField(path, "anchors.label",    siA.label,    siB.label,    diffs);
+         compareField(path, "anchors.title",    siA.title,    siB.title,    diffs);
+         compareField(path, "anchors.ref",      siA.ref,      siB.ref,      diffs);
+         compareField(path, "anchors.fileName", siA.fileName, siB.fileName, diffs);
+         compareField(path, "anchors.lineNr",   siA.lineNr,   siB.lineNr,   diffs);
+         compareField(path, "anchors.level",    siA.level,    siB.level,    diffs);
+         compareField(path, "anchors.type",     siA.type,     siB.type,     diffs);
+      }
+   }
+
+   // special list items
+   compareField(path, "sli",              a.sli == nullptr,      b.sli == nullptr,      diffs);
+
+   if (a.sli != nullptr && b.sli != nullptr) {
+      compareField(path, "sli.count",     a.sli->count(),        b.sli->count(),        diffs);
+
+      for (int i = 0; i < a.sli->count() && i < b.sli->count(); ++i) {
+         compareField(path, "sli.type",   a.sli->at(i).type,     b.sli->at(i).type,     diffs);
+
+         if (compareIds) {
+            compareField(path, "sli.itemId", a.sli->at(i).itemId, b.sli->at(i).itemId, diffs);
+         }
+      }
+   }
+
+   compareField(path, "type",             a.type,                b.type,                diffs);
+   compareField(path, "name",             a.name,                b.name,                diffs);
+   compareField(path, "args",             a.args,                b.args,                diffs);
+   compareField(path, "bitfields",        a.bitfields,           b.bitfields,           diffs);
+   compareField(path, "program",          a.m_program,           b.m_program,           diffs);
+   compareField(path, "initializer",      a.initializer,         b.initializer,         diffs);
+   compareField(path, "includeFile",      a.includeFile,         b.includeFile,         diffs);
+   compareField(path, "includeName",      a.includeName,         b.includeName,         diffs);
+   compareField(path, "doc",              a.doc,                 b.doc,                 diffs);
+   compareField(path, "docFile",          a.docFile,             b.docFile,             diffs);
+   compareField(path, "brief",            a.brief,               b.brief,               diffs);
+   compareField(path, "briefFile",        a.briefFile,           b.briefFile,           diffs);
+   compareField(path, "inbodyDocs",       a.inbodyDocs,          b.inbodyDocs,          diffs);
+   compareField(path, "inbodyFile",       a.inbodyFile,          b.inbodyFile,          diffs);
+   compareField(path, "relates",          a.relates,             b.relates,             diffs);
+
+   compareField(path, "read",             a.m_read,              b.m_read,              diffs);
+   compareField(path, "write",            a.m_write,             b.m_write,             diffs);
+   compareField(path, "reset",            a.m_reset,             b.m_reset,             diffs);
+   compareField(path, "notify",           a.m_notify,            b.m_notify,            diffs);
+   compareField(path, "revision",         a.m_revision,          b.m_revision,          diffs);
+   compareField(path, "designable",       a.m_designable,        b.m_designable,        diffs);
+   compareField(path, "scriptable",       a.m_scriptable,        b.m_scriptable,        diffs);
+   compareField(path, "stored",           a.m_stored,            b.m_stored,            diffs);
+   compareField(path, "user",             a.m_user,              b.m_user,              diffs);
+
+   compareField(path, "inside",           a.inside,              b.inside,              diffs);
+   compareField(path, "exception",        a.exception,           b.exception,           diffs);
+   compareField(path, "fileName",         a.fileName,            b.fileName,            diffs);
+   compareField(path, "id",               a.id,                  b.id,                  diffs);
+   compareField(path, "hidden",           a.hidden,              b.hidden,              diffs);
+   compareField(path, "artificial",       a.artificial,          b.artificial,          diffs);
+}
+
+static void compareEntryTree(const QString &path, QSharedPointer<Entry> a, QSharedPointer<Entry> b,
+                  bool compareIds, QStringList &diffs)
+{
+   compareEntry(path, *a, *b, compareIds, diffs);
+
+   const QList<QSharedPointer<Entry>> childrenA = a->children();
+   const QList<QSharedPointer<Entry>> childrenB = b->children();
+
+   compareField(path, "children", childrenA.count(), childrenB.count(), diffs);
+
+   for (int i = 0; i < childrenA.count() && i < childrenB.count(); ++i) {
+      QString childPath = path + "/" + childrenA.at(i)->name;
+
+      if (childPath.endsWith("/")) {
+         childPath += QString::number(i);
+      }
+
+      compareEntryTree(childPath, childrenA.at(i), childrenB.at(i), compareIds, diffs);
+   }
+}
+
+static bool reportDiffs(const char *test, const QStringList &diffs)
+{
+   if (diffs.isEmpty()) {
+      return true;
+   }
+
+   for (int i = 0; i < diffs.count() && i < s_maxDiffs; ++i) {
+      err("Self test %s: %s\n", test, qPrintable(diffs.at(i)));
+   }
+
+   if (diffs.count() > s_maxDiffs) {
+      err("Self test %s: %d more differences\n", test, diffs.count() - s_maxDiffs);
+   }
+
+   return false;
+}
+
+// scans one prepared input file into a new Entry tree, as parseFile() does
+static QSharedPointer<Entry> scanFile(const QString &fileName, const QString &buffer)
+{
+   // the project was already processed, applying the defines again would add them twice
+   discardPreprocessorResults(fileName);
+
+   QSharedPointer<Entry> root = QMakeShared<Entry>();
+   QStringList includedFiles;
+
+   getParserForFile(fileName)->parseInput(fileName, buffer, root, ParserMode::SOURCE_FILE, includedFiles, false);
+
+   return root;
+}
+
+/** Preprocesses and scans every second file of a list, two of these threads run side by side */
+class ScannerThread : public QThread
+{
+ public:
+   ScannerThread(const QStringList &fileList, int first)
+      : m_fileList(fileList), m_first(first)
+   {
+   }
+
+   void run() {
+      Doxy_Globals::markdownSupport = Config::getBool("markdown");
+
+      for (int index = m_first; index < m_fileList.count(); index += 2) {
+         const QString &fileName = m_fileList.at(index);
+         m_roots.append(scanFile(fileName, prepareInput(fileName, readInputFile(fileName))));
+      }
+
+      // the scanner state of this thread
+      preFreeScanner();
+      cstyleFreeParser();
+   }
+
+   const QList<QSharedPointer<Entry>> &roots() const {
+      return m_roots;
+   }
+
+ private:
+   QStringList m_fileList;
+   int m_first;
+
+   QList<QSharedPointer<Entry>> m_roots;
+};
+
+/** Runs the preprocessor on the input pipeline thread while the language scanner runs
+ *  on this thread and compares the Entry trees with the trees of a serial run. Then two
+ *  threads preprocess and scan the files side by side and the parse workers scan them.
+ */
+static bool checkScanners()
+{
+   static const int numRounds = 4;
+
+   const QStringList &fileList = Doxy_Globals::g_inputFiles;
+   QList<QSharedPointer<Entry>> expected;
+
+   // files scanned side by side, with their serial Entry tree
+   QStringList parallelFiles;
+   QList<QSharedPointer<Entry>> parallelExpected;
+
+   for (const auto &fileName : fileList) {
+      ScannerState::begin();
+
+      QSharedPointer<Entry> root = scanFile(fileName, prepareInput(fileName, readInputFile(fileName)));
+      expected.append(root);
+
+      // files which use state shared by all files, and markdown pages which switch the
+      // global markdown support, are only scanned by one thread at a time
+      if (! ScannerState::usedShared() && getLanguageFromFileName(fileName) != SrcLangExt_Markdown) {
+         parallelFiles.append(fileName);
+         parallelExpected.append(root);
+      }
+   }
+
+   QStringList diffs;
+
+   for (int round = 0; round < numRounds && diffs.isEmpty(); ++round) {
+      // at least one reader and the pipeline thread
+      InputFileQueue inputQueue(fileList, qMax(4, Config::getInt("num-parse-threads")), prepareInput);
+
+      for (int index = 0; index < fileList.count(); ++index) {
+         QSharedPointer<Entry> root = scanFile(fileList.at(index), inputQueue.take(index));
+         compareEntryTree(fileList.at(index), expected.at(index), root, false, diffs);
+      }
+   }
+
+   for (int round = 0; round < numRounds && diffs.isEmpty(); ++round) {
+      ScannerThread first(parallelFiles, 0);
+      ScannerThread second(parallelFiles, 1);
+
+      first.start();
+      second.start();
+
+      first.wait();
+      second.wait();
+
+      for (int index = 0; index < parallelFiles.count(); ++index) {
+         const ScannerThread &thread = (index % 2 == 0) ? first : second;
+
+         compareEntryTree(parallelFiles.at(index), parallelExpected.at(index), thread.roots().at(index / 2), false, diffs);
+      }
+   }
+
+   int workerFiles = 0;
+
+   for (int round = 0; round < numRounds && diffs.isEmpty(); ++round) {
+      InputFileQueue inputQueue(fileList, qMax(4, Config::getInt("num-parse-threads")), prepareInput);
+      ParseFileQueue parseQueue(fileList, &inputQueue, qMax(4, Config::getInt("num-parse-threads")));
+
+      workerFiles = 0;
+
+      for (int index = 0; index < fileList.count(); ++index) {
+         ParseFileQueue::Result result = parseQueue.take(index);
+         QSharedPointer<Entry> root = result.root;
+
+         if (root) {
+            discardPreprocessorResults(fileList.at(index));
+            ++workerFiles;
+
+         } else {
+            root = scanFile(fileList.at(index), result.convBuf);
+         }
+
+         compareEntryTree(fileList.at(index), expected.at(index), root, false, diffs);
+      }
+   }
+
+   msg("Self test scanners: %d files, %d rounds, %d files scanned side by side, %d files scanned by parse workers\n",
+         fileList.count(), numRounds, parallelFiles.count(), workerFiles);
+
+   return reportDiffs("scanners", diffs);
+}
+
+/** In memory store for the round trip test, with or without a string table */
+class BufferStorage : public StorageIntf
+{
+ public:
+   BufferStorage(bool stringTable) : m_stringTable(stringTable), m_pos(0) {}
+
+   int read(char *buf, uint size) {
+      if (size > uint(m_data.size() - m_pos)) {
+         size = m_data.size() - m_pos;
+      }
+
+      memcpy(buf, m_data.constData() + m_pos, size);
+      m_pos += size;
+
+      return size;
+   }
+
+   int write(const char *buf, uint size) {
+      m_data.append(buf, size);
+      return size;
+   }
+
+   const char *view(uint size) {
+      if (size > uint(m_data.size() - m_pos)) {
+         return nullptr;
+      }
+
+      const char *retval = m_data.constData() + m_pos;
+      m_pos += size;
+
+      return retval;
+   }
+
+   int stringIndex(const QString &str) {
+      if (! m_stringTable) {
+         return -1;
+      }
+
+      auto iter = m_stringIndex.find(str);
+
+      if (iter != m_stringIndex.end()) {
+         return iter.value();
+      }
+
+      m_strings.append(str);
+      m_stringIndex.insert(str, m_strings.count() - 1);
+
+      return m_strings.count() - 1;
+   }
+
+   QString stringAt(uint index) {
+      return m_strings.value(index);
+   }
+
+   bool atEnd() const {
+      return m_pos == m_data.size();
+   }
+
+ private:
+   bool       m_stringTable;
+   int        m_pos;
+   QByteArray m_data;
+
+   QStringList         m_strings;
+   QHash<QString, int> m_stringIndex;
+};
+
+static ArgumentList makeArgumentList(const QString &prefix)
+{
+   ArgumentList retval;
+
+   Argument a;
+   a.attrib         = prefix + "attrib";
+   a.type           = prefix + "type";
+   a.canType        = prefix + "canType";
+   a.name           = prefix + "name";
+   a.array          = prefix + "array";
+   a.defval         = prefix + "defval";
+   a.docs           = prefix + "docs";
+   a.typeConstraint = prefix + "typeConstraint";
+
+   retval.append(a);
+   retval.append(Argument());
+
+   retval.constSpecifier     = true;
+   retval.volatileSpecifier  = true;
+   retval.pureSpecifier      = true;
+   retval.refSpecifier       = RValueRef;
+   retval.trailingReturnType = prefix + "trailingReturnType";
+   retval.isDeleted          = true;
+
+   return retval;
+}
+
+// returns an entry with every field set to a value which differs from the default
+static QSharedPointer<Entry> makeFullEntry()
+{
+   QSharedPointer<Entry> e = QMakeShared<Entry>();
+
+   e->tagInfo           = new TagInfo;
+   e->tagInfo->tagName  = "tagName";
+   e->tagInfo->fileName = "tagFileName";
+   e->tagInfo->anchor   = "tagAnchor";
+
+   e->argList           = makeArgumentList("arg");
+   e->typeConstr        = makeArgumentList("constr");
+
+   e->relatesType       = MemberOf;
+   e->virt              = Virtual;
+   e->protection        = Private;
+   e->mtype             = Slot;
+   e->groupDocType      = Entry::GROUPDOC_WEAK;
+   e->lang              = SrcLangExt_Cpp;
+   e->m_traits.setTrait(Entry::Template);
+
+   e->section           = Entry::CLASS_SEC;
+   e->initLines         = 3;
+   e->docLine           = 5;
+   e->briefLine         = 7;
+   e->inbodyLine        = 11;
+   e->bodyLine          = 13;
+   e->endBodyLine       = 17;
+   e->mGrpId            = 19;
+   e->startLine         = 23;
+   e->startColumn       = 29;
+
+   e->stat              = true;
+   e->explicitExternal  = true;
+   e->proto             = true;
+   e->subGrouping       = ! e->subGrouping;
+   e->callGraph         = ! e->callGraph;
+   e->callerGraph       = ! e->callerGraph;
+
+   e->tArgLists         = new QList<ArgumentList>;
+   e->tArgLists->append(makeArgumentList("template"));
+   e->tArgLists->append(ArgumentList());
+
+   e->extends.append(BaseInfo("base", Protected, Virtual));
+
+   delete e->groups;
+   e->groups = new QList<Grouping>;
+   e->groups->append(Grouping("group", Grouping::GROUPING_INGROUP));
+
+   delete e->anchors;
+   e->anchors = new QList<SectionInfo>;
+   e->anchors->append(SectionInfo("anchorFile", 31, "label", "title", SectionInfo::Subsection, 2, "ref"));
+
+   e->sli = new QList<ListItemInfo>;
+   e->sli->append(ListItemInfo{"todo", 37});
+
+   // long strings are not stored in the string table
+   e->type              = "type";
+   e->name              = "name";
+   e->args              = "args";
+   e->bitfields         = "bitfields";
+   e->m_program         = QString("program ").repeated(100);
+   e->initializer       = "initializer";
+   e->includeFile       = "includeFile";
+   e->includeName       = "includeName";
+   e->doc               = QString::fromUtf8("doc \xc3\xa9 ").repeated(100);
+   e->docFile           = "docFile";
+   e->brief             = "brief";
+   e->briefFile         = "briefFile";
+   e->inbodyDocs        = "inbodyDocs";
+   e->inbodyFile        = "inbodyFile";
+   e->relates           = "relates";
+
+   e->m_read            = "read";
+   e->m_write           = "write";
+   e->m_reset           = "reset";
+   e->m_notify          = "notify";
+   e->m_revision        = "revision";
+   e->m_designable      = "designable";
+   e->m_scriptable      = "scriptable";
+   e->m_stored          = "stored";
+   e->m_user            = "user";
+
+   e->inside            = "inside";
+   e->exception         = "exception";
+   e->fileName          = "fileName";
+   e->id                = "id";
+   e->hidden            = true;
+   e->artificial        = true;
+
+   e->addSubEntry(QMakeShared<Entry>(), e);
+
+   return e;
+}
+
+// marshals the entry trees and compares the unmarshaled copies with the originals
+static void roundTrip(const QString &path, const QList<QSharedPointer<Entry>> &list, bool stringTable, QStringList &diffs)
+{
+   BufferStorage store(stringTable);
+
+   for (auto e : list) {
+      marshalEntryTree(&store, e);
+   }
+
+   for (auto e : list) {
+      compareEntryTree(path + "/" + e->name, e, unmarshalEntryTree(&store), true, diffs);
+   }
+
+   if (! store.atEnd()) {
+      diffs.append(path + ": data left after the last entry");
+   }
+}
+
+// writes the entry trees to a file, opens it again for reading and compares the unmarshaled copies
+static void fileRoundTrip(const QString &path, const QList<QSharedPointer<Entry>> &list, bool mapped, QStringList &diffs)
+{
+   static const uint endMarker = 0x454e4453;     // ENDS
+
+   QString fileName = Config::getString("output-dir") + "/selftest_entries.tmp";
+   FileStorage store(fileName);
+
+   if (! store.open(QIODevice::WriteOnly)) {
+      diffs.append(path + ": unable to open file for writing " + fileName);
+      return;
+   }
+
+   for (auto e : list) {
+      marshalEntryTree(&store, e);
+   }
+
+   // the string table is appended by close()
+   marshalUInt(&store, endMarker);
+   store.close();
+
+   store.setMapEnabled(mapped);
+
+   if (! store.open(QIODevice::ReadOnly)) {
+      diffs.append(path + ": unable to read the string table of " + fileName);
+      QFile::remove(fileName);
+
+      return;
+   }
+
+   if (store.isMapped() != mapped) {
+      diffs.append(path + (mapped ? ": file was not mapped" : ": file was mapped"));
+   }
+
+   for (auto e : list) {
+      compareEntryTree(path + "/" + e->name, e, unmarshalEntryTree(&store), true, diffs);
+   }
+
+   if (unmarshalUInt(&store) != endMarker) {
+      diffs.append(path + ": end marker not found after the last entry");
+   }
+
+   store.close();
+   QFile::remove(fileName);
+}
+
+/** Marshals every Entry of the input files and an entry with all fields set and compares
+ *  the unmarshaled copies field by field. The entries are stored in memory with and without
+ *  a string table, and in a FileStorage which is read through the memory map and through QFile.
+ */
+static bool checkEntries()
+{
+   const QStringList &fileList = Doxy_Globals::g_inputFiles;
+   QStringList diffs;
+
+   QList<QSharedPointer<Entry>> roots;
+
+   for (const auto &fileName : fileList) {
+      roots.append(scanFile(fileName, prepareInput(fileName, readInputFile(fileName))));
+   }
+
+   for (bool stringTable : { false, true }) {
+      roundTrip("full entry", { makeFullEntry() }, stringTable, diffs);
+
+      for (int i = 0; i < fileList.count(); ++i) {
+         roundTrip(fileList.at(i), roots.at(i)->children(), stringTable, diffs);
+      }
+   }
+
+   for (bool mapped : { false, true }) {
+      fileRoundTrip("full entry", { makeFullEntry() }, mapped, diffs);
+
+      for (int i = 0; i < fileList.count(); ++i) {
+         fileRoundTrip(fileList.at(i), roots.at(i)->children(), mapped, diffs);
+      }
+   }
+
+   msg("Self test entries: %d files\n", fileList.count());
+
+   return reportDiffs("entries", diffs);
+}
+
+// loads every entry below \a nav, returns the number of entries loaded
+static int loadEntryTree(QSharedPointer<EntryNav> nav, FileStorage *storage, bool &ok)
+{
+   int retval = 0;
+
+   for (auto child : nav->children()) {
+      if (child->loadEntry(storage)) {
+         ++retval;
+      } else {
+         ok = false;
+      }
+
+      child->releaseEntry();
+      retval += loadEntryTree(child, storage, ok);
+   }
+
+   return retval;
+}
+
+/** Stores the entries of the input files in a FileStorage, as parseFiles() does, and loads every
+ *  entry with EntryNav::loadEntry(). The file is read once through QFile and once through the
+ *  memory map, the number of entries loaded per second is reported for both.
+ */
+static bool benchmarkLoadEntries()
+{
+   static const int numRounds = 10;
+
+   const QStringList &fileList = Doxy_Globals::g_inputFiles;
+   QString storageName = Config::getString("output-dir") + "/selftest_load.tmp";
+
+   FileStorage storage(storageName);
+
+   if (! storage.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s\n", csPrintable(storageName));
+      return false;
+   }
+
+   QSharedPointer<Entry> root = QMakeShared<Entry>();
+   QSharedPointer<EntryNav> rootNav = QMakeShared<EntryNav>(QSharedPointer<EntryNav>(), root);
+   rootNav->setEntry(root);
+
+   for (const auto &fileName : fileList) {
+      QSharedPointer<Entry> fileRoot = scanFile(fileName, prepareInput(fileName, readInputFile(fileName)));
+      fileRoot->createNavigationIndex(rootNav, &storage, QSharedPointer<FileDef>(), fileRoot);
+   }
+
+   storage.close();
+
+   bool retval = true;
+
+   for (bool mapped : { false, true }) {
+      storage.setMapEnabled(mapped);
+
+      if (! storage.open(QIODevice::ReadOnly)) {
+         err("Unable to open file for reading %s\n", csPrintable(storageName));
+         retval = false;
+         break;
+      }
+
+      if (storage.isMapped() != mapped) {
+         err("Self test load-entries: file %s was not mapped into memory\n", csPrintable(storageName));
+         retval = false;
+      }
+
+      QElapsedTimer timer;
+      timer.start();
+
+      int count = 0;
+
+      for (int round = 0; round < numRounds; ++round) {
+         count += loadEntryTree(rootNav, &storage, retval);
+      }
+
+      qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+
+      msg("Self test load-entries: %s, %d entries loaded in %.3f seconds, %.1f entries per second\n",
+                  mapped ? "memory map" : "QFile", count, elapsed / 1000.0, count * 1000.0 / elapsed);
+
+      storage.close();
+   }
+
+   QFile::remove(storageName);
+
+   return retval;
+}
+
+/** Runs dot for small graphs, first with one dot process per graph and then in batches,
+ *  and reports the number of graphs per second for both.
+ */
+static bool benchmarkDotBatch()
+{
+   static const int numGraphs = 200;
+
+   const int batchSize = qMax(16, Config::getInt("dot-batch-size"));
+
+   QDir dir(Config::getString("output-dir") + "/selftest_dot");
+
+   if (! dir.mkpath(dir.absolutePath())) {
+      err("Unable to create directory %s\n", csPrintable(dir.absolutePath()));
+      return false;
+   }
+
+   bool retval = true;
+
+   for (bool batchMode : { false, true }) {
+      const QString mode = batchMode ? "batch" : "single";
+
+      QList<DotRunner *> runners;
+
+      for (int i = 0; i < numGraphs; ++i) {
+         QString fileName = dir.absoluteFilePath(QString("graph_%1_%2.dot").arg(mode).arg(i));
+         QFile f(fileName);
+
+         if (! f.open(QIODevice::WriteOnly)) {
+            err("Unable to open file for writing %s\n", csPrintable(fileName));
+            qDeleteAll(runners);
+
+            return false;
+         }
+
+         // the name of the graph differs per mode, the batch run can not use the graph cache
+         f.write(QString("digraph %1_%2 { node [shape=box]; a -> b; a -> c; b -> d; c -> d; }\n").arg(mode).arg(i).toUtf8());
+         f.close();
+
+         DotRunner *runner = new DotRunner(fileName, QString(), false);
+         runner->addJob("png", fileName + ".png");
+
+         runners.append(runner);
+      }
+
+      QElapsedTimer timer;
+      timer.start();
+
+      if (batchMode) {
+         for (int i = 0; i < runners.count(); i += batchSize) {
+            retval = DotRunner::runBatch(runners.mid(i, batchSize)) && retval;
+         }
+
+      } else {
+         for (auto runner : runners) {
+            retval = runner->run() && retval;
+         }
+      }
+
+      qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+
+      msg("Self test dot-batch: %s mode, %d graphs in %.3f seconds, %.1f graphs per second\n", csPrintable(mode),
+                  numGraphs, elapsed / 1000.0, numGraphs * 1000.0 / elapsed);
+
+      qDeleteAll(runners);
+   }
+
+   dir.removeRecursively();
+
+   return retval;
+}
+
+/** Builds a synthetic hierarchy of 10000 classes and writes the built-in class diagram of each
+ *  class, reports the number of images drawn and encoded per second.
+ */
+static bool benchmarkClassDiagrams()
+{
+   static const int numGroups = 1000;
+
+   QDir dir(Config::getString("output-dir") + "/selftest_diagrams");
+
+   if (! dir.mkpath(dir.absolutePath())) {
+      err("Unable to create directory %s\n", csPrintable(dir.absolutePath()));
+      return false;
+   }
+
+   QList<QSharedPointer<ClassDef>> classes;
+
+   auto addClass = [&classes](const QString &name, QSharedPointer<ClassDef> base) {
+      // not added to the symbol table, the classes are not part of the project
+      QSharedPointer<ClassDef> cd = QMakeShared<ClassDef>("selftest.h", 1, 1, name, ClassDef::Class,
+                  QString(), QString(), false);
+
+      cd->setBriefDescription("Synthetic class", "selftest.h", 1);
+
+      if (base) {
+         cd->insertBaseClass(base, base->name(), Public, Normal);
+         base->insertSubClass(cd, Public, Normal);
+      }
+
+      classes.append(cd);
+
+      return cd;
+   };
+
+   // each group has a root with three sub classes, each of them has two sub classes
+   for (int group = 0; group < numGroups; ++group) {
+      QString prefix = QString("Group%1_").arg(group);
+      QSharedPointer<ClassDef> root = addClass(prefix + "Root", QSharedPointer<ClassDef>());
+
+      for (int i = 0; i < 3; ++i) {
+         QSharedPointer<ClassDef> child = addClass(prefix + QString("Child%1").arg(i), root);
+
+         for (int j = 0; j < 2; ++j) {
+            addClass(prefix + QString("Leaf%1_%2").arg(i).arg(j), child);
+         }
+      }
+   }
+
+   int countBefore   = ClassDiagram::imageCount();
+   qint64 timeBefore = ClassDiagram::imageTime();
+
+   QElapsedTimer timer;
+   timer.start();
+
+   QString buffer;
+   QTextStream t(&buffer);
+
+   for (int i = 0; i < classes.count(); ++i) {
+      ClassDiagram diagram(classes.at(i));
+      diagram.writeImage(t, dir.absolutePath(), QString(), QString("class_%1").arg(i), false);
+   }
+
+   qint64 elapsed   = qMax<qint64>(1, timer.elapsed());
+   int numImages    = ClassDiagram::imageCount() - countBefore;
+   qint64 imageTime = qMax<qint64>(1, ClassDiagram::imageTime() - timeBefore);
+
+   msg("Self test class-diagrams: %d classes, %d images, %.1f images per second, "
+                  "%.1f images per second for drawing and encoding only\n", classes.count(), numImages,
+                  numImages * 1000.0 / elapsed, numImages * 1000000.0 / imageTime);
+
+   dir.removeRecursively();
+
+   return numImages == classes.count();
+}
+
+struct DocBlock {
+   QString fileName;
+   int     line;
+
+   QSharedPointer<Definition> scope;
+   QSharedPointer<MemberDef>  md;
+
+   QString text;
+};
+
+static void addDocBlocks(QList<DocBlock> &blocks, QSharedPointer<Definition> def, QSharedPointer<Definition> scope,
+                  QSharedPointer<MemberDef> md)
+{
+   if (! def->briefDescription().isEmpty()) {
+      blocks.append(DocBlock{ def->briefFile(), def->briefLine(), scope, md, def->briefDescription() });
+   }
+
+   if (! def->documentation().isEmpty()) {
+      blocks.append(DocBlock{ def->docFile(), def->docLine(), scope, md, def->documentation() });
+   }
+
+   if (! def->inbodyDocumentation().isEmpty()) {
+      blocks.append(DocBlock{ def->inbodyFile(), def->inbodyLine(), scope, md, def->inbodyDocumentation() });
+   }
+}
+
+// returns the documentation blocks of all compounds, pages and members of the project
+static QList<DocBlock> collectDocBlocks()
+{
+   QList<DocBlock> blocks;
+
+   for (auto cd : *Doxy_Globals::classSDict) {
+      addDocBlocks(blocks, cd, cd, QSharedPointer<MemberDef>());
+   }
+
+   for (auto nd : *Doxy_Globals::namespaceSDict) {
+      addDocBlocks(blocks, nd, nd, QSharedPointer<MemberDef>());
+   }
+
+   for (auto fn : *Doxy_Globals::inputNameList) {
+      for (auto fd : *fn) {
+         addDocBlocks(blocks, fd, fd, QSharedPointer<MemberDef>());
+      }
+   }
+
+   for (auto gd : *Doxy_Globals::groupSDict) {
+      addDocBlocks(blocks, gd, gd, QSharedPointer<MemberDef>());
+   }
+
+   for (auto pd : *Doxy_Globals::pageSDict) {
+      addDocBlocks(blocks, pd, pd, QSharedPointer<MemberDef>());
+   }
+
+   for (auto mn : *Doxy_Globals::memberNameSDict) {
+      for (auto md : *mn) {
+         addDocBlocks(blocks, md, md->getOuterScope(), md);
+      }
+   }
+
+   for (auto mn : *Doxy_Globals::functionNameSDict) {
+      for (auto md : *mn) {
+         addDocBlocks(blocks, md, md->getOuterScope(), md);
+      }
+   }
+
+   return blocks;
+}
+
+// parses one documentation block and returns the syntax tree as printed by PrintDocVisitor
+static QByteArray parseDocBlock(DocParserContext &parser, const DocBlock &block)
+{
+   DocRoot *root = validatingParseDoc(parser, block.fileName, block.line, block.scope, block.md, block.text, false, false);
+
+   QByteArray retval;
+   PrintDocVisitor visitor(&retval);
+
+   root->accept(&visitor);
+   delete root;
+
+   return retval;
+}
+
+/** Thread for the documentation parser test, parses every n-th block with its own parser context */
+class DocParserTestThread : public QThread
+{
+ public:
+   DocParserTestThread(const QList<DocBlock> &blocks, int first, int step)
+      : m_blocks(blocks), m_first(first), m_step(step) {}
+
+   void run() {
+      DocParserContext parser;
+
+      for (int i = m_first; i < m_blocks.count(); i += m_step) {
+         m_output.append(parseDocBlock(parser, m_blocks.at(i)));
+      }
+   }
+
+   /** Returns the output for the blocks first, first + step, first + 2 * step and so on */
+   const QList<QByteArray> &output() const {
+      return m_output;
+   }
+
+ private:
+   const QList<DocBlock> &m_blocks;
+
+   int m_first;
+   int m_step;
+
+   QList<QByteArray> m_output;
+};
+
+/** Parses the documentation of the project on several threads at once and compares the syntax
+ *  trees with the trees of a serial run.
+ */
+static bool checkDocParser()
+{
+   static const int numRounds = 4;
+
+   const QList<DocBlock> blocks = collectDocBlocks();
+   const int numThreads         = qMax(4, Config::getInt("num-parse-threads"));
+
+   QVector<QByteArray> expected;
+
+   {
+      DocParserContext parser;
+
+      for (const auto &block : blocks) {
+         expected.append(parseDocBlock(parser, block));
+      }
+   }
+
+   QStringList diffs;
+
+   for (int round = 0; round < numRounds && diffs.isEmpty(); ++round) {
+      QList<DocParserTestThread *> threads;
+
+      for (int i = 0; i < numThreads; ++i) {
+         threads.append(new DocParserTestThread(blocks, i, numThreads));
+         threads.last()->start();
+      }
+
+      for (int i = 0; i < numThreads; ++i) {
+         threads.at(i)->wait();
+
+         const QList<QByteArray> &output = threads.at(i)->output();
+
+         for (int j = 0; j < output.count(); ++j) {
+            int index = i + j * numThreads;
+
+            if (output.at(j) != expected.at(index)) {
+               diffs.append(QString("%1 line %2: syntax tree differs").arg(blocks.at(index).fileName).arg(blocks.at(index).line));
+            }
+         }
+      }
+
+      qDeleteAll(threads);
+   }
+
+   msg("Self test docparser: %d documentation blocks, %d threads, %d rounds\n", blocks.count(), numThreads, numRounds);
+
+   return reportDiffs("docparser", diffs);
+}
+
+/** Records the output of a code parser as text, tooltips are sorted since their order is not defined */
+class CodeRecorder : public CodeOutputInterface
+{
+ public:
+   void codify(const QString &s) override {
+      m_text += s;
+   }
+
+   void writeCodeLink(const QString &ref, const QString &file, const QString &anchor, const QString &name,
+                  const QString &tooltip) override {
+      m_text += "[" + ref + "|" + file + "#" + anchor + "|" + name + "|" + tooltip + "]";
+   }
+
+   void writeLineNumber(const QString &ref, const QString &file, const QString &anchor, int lineNumber) override {
+      m_text += "{" + ref + "|" + file + "#" + anchor + "|" + QString::number(lineNumber) + "}";
+   }
+
+   void writeTooltip(const QString &id, const DocLinkInfo &, const QString &decl, const QString &desc,
+                  const SourceLinkInfo &, const SourceLinkInfo &) override {
+      m_tooltips.append(id + "|" + decl + "|" + desc);
+   }
+
+   void startCodeLine(bool) override {
+   }
+
+   void endCodeLine() override {
+      m_text += "\n";
+   }
+
+   void startFontClass(const QString &clsName) override {
+      m_text += "<" + clsName + ">";
+   }
+
+   void endFontClass() override {
+      m_text += "</>";
+   }
+
+   void writeCodeAnchor(const QString &name) override {
+      m_text += "@" + name;
+   }
+
+   void setCurrentDoc(QSharedPointer<Definition>, const QString &, bool) override {
+   }
+
+   void addWord(const QString &, bool) override {
+   }
+
+   QString result() const {
+      QStringList tooltips = m_tooltips;
+      tooltips.sort();
+
+      return m_text + tooltips.join("\n");
+   }
+
+ private:
+   QString m_text;
+   QStringList m_tooltips;
+};
+
+// highlights one source file, the cross references are collected instead of being added to the members
+static QString highlightFile(QSharedPointer<FileDef> fd, const QString &source)
+{
+   ParserInterface *parser = Doxy_Globals::parserManager->getParser(fd->getDefFileExtension());
+
+   CodeRecorder recorder;
+   CrossReferenceList crossReferences;
+
+   captureCrossReferences(&crossReferences);
+
+   parser->resetCodeParserState();
+   parser->parseCode(recorder, QString(), source, fd->getLanguage(), false, QString(), fd);
+
+   captureCrossReferences(nullptr);
+
+   QString retval = recorder.result();
+
+   for (const auto &item : crossReferences) {
+      retval += "\n" + item.first->qualifiedName() + " -> " + item.second->qualifiedName();
+   }
+
+   return retval;
+}
+
+/** Thread for the source browser test, highlights every n-th file */
+class HighlightThread : public QThread
+{
+ public:
+   HighlightThread(const QList<QSharedPointer<FileDef>> &files, const QStringList &sources, int first, int step)
+      : m_files(files), m_sources(sources), m_first(first), m_step(step) {}
+
+   void run() {
+      Doxy_Globals::markdownSupport = Config::getBool("markdown");
+
+      for (int i = m_first; i < m_files.count(); i += m_step) {
+         m_output.append(highlightFile(m_files.at(i), m_sources.at(i)));
+      }
+
+      // the highlighter state of this thread
+      TooltipManager::deleteInstance();
+      codeFreeScanner();
+   }
+
+   /** Returns the output for the files first, first + step, first + 2 * step and so on */
+   const QStringList &output() const {
+      return m_output;
+   }
+
+ private:
+   const QList<QSharedPointer<FileDef>> &m_files;
+   const QStringList &m_sources;
+
+   int m_first;
+   int m_step;
+
+   QStringList m_output;
+};
+
+/** Highlights the source files of the project on several threads at once, the way the source
+ *  workers do, and compares the output and the cross references with a serial run.
+ */
+static bool checkSourceBrowser()
+{
+   static const int numRounds = 4;
+   static const bool filterSourceFiles = Config::getBool("filter-source-files");
+
+   QList<QSharedPointer<FileDef>> files;
+   QStringList sources;
+
+   for (auto fn : *Doxy_Globals::inputNameList) {
+      for (auto fd : *fn) {
+         ParserInterface *parser = Doxy_Globals::parserManager->getParser(fd->getDefFileExtension());
+
+         if (! fd->isReference() && parser->isCodeThreadSafe()) {
+            files.append(fd);
+            sources.append(fileToString(fd->getFilePath(), filterSourceFiles, true));
+         }
+      }
+   }
+
+   QStringList expected;
+
+   for (int i = 0; i < files.count(); ++i) {
+      expected.append(highlightFile(files.at(i), sources.at(i)));
+   }
+
+   const int numThreads = qMax(4, Config::getInt("num-parse-threads"));
+   QStringList diffs;
+
+   for (int round = 0; round < numRounds && diffs.isEmpty(); ++round) {
+      QList<HighlightThread *> threads;
+
+      for (int i = 0; i < numThreads; ++i) {
+         threads.append(new HighlightThread(files, sources, i, numThreads));
+         threads.last()->start();
+      }
+
+      for (int i = 0; i < numThreads; ++i) {
+         threads.at(i)->wait();
+
+         const QStringList &output = threads.at(i)->output();
+
+         for (int j = 0; j < output.count(); ++j) {
+            int index = i + j * numThreads;
+
+            if (output.at(j) != expected.at(index)) {
+               diffs.append(QString("%1: highlighted source differs").arg(files.at(index)->getFilePath()));
+            }
+         }
+      }
+
+      qDeleteAll(threads);
+   }
+
+   msg("Self test source-browser: %d files, %d threads, %d rounds\n", files.count(), numThreads, numRounds);
+
+   return reportDiffs("source-browser", diffs);
+}
+
+struct SelfTestInfo {
+   const char *name;
+   bool (*func)();
+   bool benchmark;         // only run when named
+};
+
+static const SelfTestInfo s_selfTests[] = {
+   { "class-diagrams", benchmarkClassDiagrams, true  },
+   { "dot-batch",      benchmarkDotBatch,      true  },
+   { "docparser",      checkDocParser,         false },
+   { "entries",        checkEntries,           false },
+   { "load-entries",   benchmarkLoadEntries,   true  },
+   { "scanners",       checkScanners,          false },
+   { "source-browser", checkSourceBrowser,     false },
+};
+
+bool runSelfTests(const QStringList &tests)
+{
+   bool retval = true;
+
+   for (const auto &name : tests) {
+      bool found = false;
+
+      for (const auto &test : s_selfTests) {
+
+         if (name == test.name || (name == "all" && ! test.benchmark)) {
+            QElapsedTimer timer;
+            timer.start();
+
+            bool ok = test.func();
+
+            msg("Self test %s %s in %.3f seconds\n", test.name, ok ? "passed" : "FAILED", timer.elapsed() / 1000.0);
+
+            retval = retval && ok;
+            found  = true;
+         }
+      }
+
+      if (! found) {
+         err("Self test \"%s\" is unknown\n", qPrintable(name));
+         retval = false;
+      }
+   }
+
+   return retval;
+}
+
+void printSelfTests()
+{
+   printf("\t%-15s", "all");
+
+   for (const auto &test : s_selfTests) {
+      printf("\t%-15s", test.name);
+   }
+
+   printf("\n");
+}
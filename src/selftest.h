@@ -0,0 +1,31 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef SELFTEST_H
+#define SELFTEST_H
+
+#include <QStringList>
+
+/** Runs the self tests named in \a tests on the parsed project, "all" runs every
+ *  test which is not a benchmark. Returns false if a test failed.
+ */
+bool runSelfTests(const QStringList &tests);
+
+/** Prints the names of the self tests for the usage message */
+void printSelfTests();
+
+#endif
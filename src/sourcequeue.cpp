@@ -0,0 +1,222 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+
+#include <QMutexLocker>
+
+#include <sourcequeue.h>
+
+#include <code.h>
+#include <config.h>
+#include <doxy_globals.h>
+#include <filedef.h>
+#include <inputqueue.h>
+#include <message.h>
+#include <outputlist.h>
+#include <parser_base.h>
+#include <tooltip.h>
+
+SourceFileQueue::SourceFileQueue(const QList<QSharedPointer<FileDef>> &fileList, InputFileQueue *inputQueue,
+                  int numThreads, OutputListFactory createOutputList)
+   : m_fileList(fileList), m_slots(fileList.count()), m_nextIndex(0), m_takenIndex(0), m_stop(false),
+     m_inputQueue(inputQueue), m_searchIndex(Doxy_Globals::searchIndex)
+{
+   numThreads = qMin(32, numThreads);
+
+   if (numThreads == 0) {
+      numThreads = qMax(2, QThread::idealThreadCount());
+   }
+
+   // limit how far the workers may run ahead of the caller, keeps memory bounded
+   m_window = 4 * numThreads;
+
+   if (numThreads > 1 && fileList.count() > 1) {
+
+      for (int i = 0; i < numThreads; i++) {
+         SourceWorkerThread *thread = new SourceWorkerThread(this, createOutputList());
+         thread->start();
+
+         if (thread->isRunning()) {
+            m_workers.append(thread);
+         } else {
+            // no more threads available
+            delete thread;
+         }
+      }
+   }
+}
+
+SourceFileQueue::~SourceFileQueue()
+{
+   {
+      QMutexLocker locker(&m_mutex);
+
+      m_stop = true;
+      m_slotFree.wakeAll();
+   }
+
+   for (auto thread : m_workers) {
+      thread->wait();
+      delete thread;
+   }
+}
+
+SourceFileQueue::Result SourceFileQueue::take(int index)
+{
+   if (m_workers.isEmpty()) {
+      // single threaded mode, the caller writes every file
+      Result retval;
+      retval.source = m_inputQueue->take(index);
+
+      return retval;
+   }
+
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_slots[index].ready) {
+      m_slotReady.wait(&m_mutex);
+   }
+
+   Result retval;
+   qSwap(retval, m_slots[index].result);
+
+   if (index >= m_takenIndex) {
+      m_takenIndex = index + 1;
+      m_slotFree.wakeAll();
+   }
+
+   return retval;
+}
+
+void SourceFileQueue::apply(const Result &result)
+{
+   printWarnings(result.warnings);
+
+   result.indexCalls.replay(Doxy_Globals::indexList);
+
+   if (Doxy_Globals::searchIndex) {
+      result.searchCalls.replay(Doxy_Globals::searchIndex);
+   }
+
+   applyCrossReferences(result.crossReferences);
+}
+
+int SourceFileQueue::claim()
+{
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_stop && m_nextIndex < m_fileList.count() && m_nextIndex >= m_takenIndex + m_window) {
+      // wait for the caller to catch up
+      m_slotFree.wait(&m_mutex);
+   }
+
+   if (m_stop || m_nextIndex >= m_fileList.count()) {
+      return -1;
+   }
+
+   return m_nextIndex++;
+}
+
+void SourceFileQueue::store(int index, const Result &result)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_slots[index].result = result;
+   m_slots[index].ready  = true;
+
+   m_slotReady.wakeAll();
+}
+
+SourceFileQueue::Result SourceFileQueue::process(int index, OutputList &ol, IndexRecorder &indexCalls,
+                  SearchIndexRecorder &searchCalls)
+{
+   QSharedPointer<FileDef> fd = m_fileList.at(index);
+
+   Result retval;
+   QString source = m_inputQueue->take(index);
+
+   ParserInterface *parser = Doxy_Globals::parserManager->getParser(fd->getDefFileExtension());
+
+   if (! parser->isCodeThreadSafe()) {
+      retval.source = source;
+      return retval;
+   }
+
+   QStringList includeFiles;
+
+   captureWarnings(&retval.warnings);
+   captureCrossReferences(&retval.crossReferences);
+
+   if (fd->generateSourceFile()) {
+      fd->writeSource(ol, false, includeFiles, source);
+   } else {
+      fd->parseSource(false, includeFiles, source);
+   }
+
+   captureWarnings(nullptr);
+   captureCrossReferences(nullptr);
+
+   retval.indexCalls = indexCalls;
+   indexCalls.clear();
+
+   retval.searchCalls = searchCalls;
+   searchCalls.clear();
+
+   retval.written = true;
+
+   return retval;
+}
+
+SourceWorkerThread::SourceWorkerThread(SourceFileQueue *queue, OutputList *outputList)
+   : m_queue(queue), m_outputList(outputList)
+{
+}
+
+SourceWorkerThread::~SourceWorkerThread()
+{
+   delete m_outputList;
+}
+
+void SourceWorkerThread::run()
+{
+   Doxy_Globals::markdownSupport = Config::getBool("markdown");
+
+   // the index and search index of this thread only record, the caller applies the calls in file order
+   QSharedPointer<IndexRecorder> indexCalls(new IndexRecorder);
+
+   IndexList indexList;
+   indexList.addIndex(indexCalls);
+
+   SearchIndexIntf *searchIndex = m_queue->m_searchIndex;
+   SearchIndexRecorder searchCalls(searchIndex ? searchIndex->kind() : SearchIndexIntf::Internal);
+
+   Doxy_Globals::indexList   = &indexList;
+   Doxy_Globals::searchIndex = searchIndex ? &searchCalls : nullptr;
+
+   int index;
+
+   while ((index = m_queue->claim()) != -1) {
+      m_queue->store(index, m_queue->process(index, *m_outputList, *indexCalls, searchCalls));
+   }
+
+   Doxy_Globals::indexList   = nullptr;
+   Doxy_Globals::searchIndex = nullptr;
+
+   // the highlighter state of this thread
+   TooltipManager::deleteInstance();
+   codeFreeScanner();
+}
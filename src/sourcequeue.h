@@ -0,0 +1,133 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+
+#ifndef SOURCEQUEUE_H
+#define SOURCEQUEUE_H
+
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <index.h>
+#include <outputlist.h>
+#include <searchindex.h>
+#include <util.h>
+
+class FileDef;
+class InputFileQueue;
+class SourceWorkerThread;
+
+/** Writes the source browser pages on a pool of source worker threads.
+ *
+ *  Each worker highlights files into an OutputList with its own generators, the pages are
+ *  written to separate files. The calls which change state shared between files are recorded
+ *  per file: cross references, the search index and the index list. The results are handed out
+ *  by take() strictly in the order of the file list and the caller applies them with apply().
+ *  This keeps the output identical to a serial run.
+ *
+ *  When the code parser of a file is not thread safe only the source is returned and the
+ *  caller writes the file in order on its own thread.
+ */
+class SourceFileQueue
+{
+ public:
+   /** Result of the source workers for one file */
+   struct Result {
+      Result() : written(false) {}
+
+      QString source;                       // source of the file, only set when the caller has to write it
+      QString warnings;                     // warnings of the highlighter, printed by apply()
+
+      CrossReferenceList  crossReferences;
+      IndexRecorder       indexCalls;
+      SearchIndexRecorder searchCalls;
+
+      bool written;                         // true if a worker wrote or parsed the file
+   };
+
+   /** The workers are only started if more than one thread is requested */
+   SourceFileQueue(const QList<QSharedPointer<FileDef>> &fileList, InputFileQueue *inputQueue, int numThreads,
+                   OutputListFactory createOutputList);
+   ~SourceFileQueue();
+
+   /** Returns the result for the file at position \a index, waits until a worker has written it */
+   Result take(int index);
+
+   /** Applies the recorded calls of \a result on the calling thread */
+   static void apply(const Result &result);
+
+   int threadCount() const {
+      return m_workers.count();
+   }
+
+ private:
+   struct Slot {
+      Slot() : ready(false) {}
+
+      Result result;
+      bool   ready;
+   };
+
+   /** Returns the index of the next file to write or -1 when all files have been claimed */
+   int claim();
+   void store(int index, const Result &result);
+
+   /** Writes or parses the file at position \a index, called on a source worker thread */
+   Result process(int index, OutputList &ol, IndexRecorder &indexCalls, SearchIndexRecorder &searchCalls);
+
+   QList<QSharedPointer<FileDef>> m_fileList;
+   QVector<Slot> m_slots;
+
+   int m_nextIndex;
+   int m_takenIndex;
+   int m_window;
+   bool m_stop;
+
+   InputFileQueue *m_inputQueue;
+
+   // the search index of the caller, workers only record when it exists
+   SearchIndexIntf *m_searchIndex;
+
+   QWaitCondition m_slotReady;
+   QWaitCondition m_slotFree;
+   QMutex m_mutex;
+
+   QList<SourceWorkerThread *> m_workers;
+
+   friend class SourceWorkerThread;
+};
+
+/** Worker thread to write source browser pages for the SourceFileQueue, owns \a outputList */
+class SourceWorkerThread : public QThread
+{
+ public:
+   SourceWorkerThread(SourceFileQueue *queue, OutputList *outputList);
+   ~SourceWorkerThread();
+
+   void run();
+
+ private:
+   SourceFileQueue *m_queue;
+   OutputList *m_outputList;
+};
+
+#endif
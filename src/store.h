@@ -35,6 +35,29 @@ class StorageIntf
 
    /*! Write \a size bytes from \a buf into the store. */
    virtual int write(const char *buf, uint size) = 0;
+
+   /*! Returns a pointer to the next \a size bytes and skips them, the data is
+    *  not copied. Returns a null pointer if the store does not support this,
+    *  the caller then has to use read().
+    */
+   virtual const char *view(uint size) {
+      (void) size;
+      return nullptr;
+   }
+
+   /*! Returns the position of \a str in the string table of the store, the string
+    *  is added if required. Returns -1 if the store does not have a string table.
+    */
+   virtual int stringIndex(const QString &str) {
+      (void) str;
+      return -1;
+   }
+
+   /*! Returns the string at position \a index in the string table */
+   virtual QString stringAt(uint index) {
+      (void) index;
+      return QString();
+   }
 };
 
 /*! @brief The Store is a file based memory manager.
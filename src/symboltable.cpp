@@ -0,0 +1,117 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QMutexLocker>
+
+#include <symboltable.h>
+
+SymbolId SymbolTable::intern(const QString &name)
+{
+   QMutexLocker locker(&m_mutex);
+
+   auto iter = m_ids.find(name);
+
+   if (iter != m_ids.end()) {
+      return iter.value();
+   }
+
+   SymbolId id = m_names.count();
+
+   m_ids.insert(name, id);
+   m_names.append(name);
+   m_definitions.append(QVector<Definition *>());
+
+   return id;
+}
+
+SymbolId SymbolTable::find(const QString &name) const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_ids.value(name, InvalidId);
+}
+
+QString SymbolTable::name(SymbolId id) const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_names.value(id);
+}
+
+SymbolId SymbolTable::insert(const QString &name, Definition *def)
+{
+   SymbolId id = intern(name);
+
+   // stored in the order of insertion, definitions() returns the most recent one first
+   QMutexLocker locker(&m_mutex);
+   m_definitions[id].append(def);
+
+   return id;
+}
+
+void SymbolTable::remove(SymbolId id, Definition *def)
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (id >= (SymbolId)m_definitions.count()) {
+      return;
+   }
+
+   m_definitions[id].removeAll(def);
+}
+
+SymbolTable::Definitions SymbolTable::definitions(SymbolId id) const
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (id >= (SymbolId)m_definitions.count()) {
+      return Definitions();
+   }
+
+   return Definitions(m_definitions.at(id));
+}
+
+SymbolTable::Definitions SymbolTable::definitions(const QString &name) const
+{
+   return definitions(find(name));
+}
+
+bool SymbolTable::contains(const QString &name) const
+{
+   QMutexLocker locker(&m_mutex);
+
+   SymbolId id = m_ids.value(name, InvalidId);
+
+   if (id == InvalidId) {
+      return false;
+   }
+
+   return ! m_definitions.at(id).isEmpty();
+}
+
+QVector<Definition *> SymbolTable::allDefinitions() const
+{
+   QMutexLocker locker(&m_mutex);
+
+   QVector<Definition *> retval;
+
+   for (const auto &list : m_definitions) {
+      for (auto iter = list.crbegin(); iter != list.crend(); ++iter) {
+         retval.append(*iter);
+      }
+   }
+
+   return retval;
+}
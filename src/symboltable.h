@@ -0,0 +1,108 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+class Definition;
+
+typedef uint SymbolId;
+
+/** @brief Index of all definitions by their unqualified name.
+ *
+ *  Every name is interned once and gets a SymbolId. The definitions sharing a
+ *  name are kept in one contiguous list, indexed directly by the id, so a lookup
+ *  hashes the name once and comparing two names only compares two ids.
+ *  Ids stay valid for the whole run, even when all definitions of a name are removed.
+ */
+class SymbolTable
+{
+ public:
+   static const SymbolId InvalidId = 0xffffffff;
+
+   /** Returns the id of \a name, the name is added if required */
+   SymbolId intern(const QString &name);
+
+   /** Returns the id of \a name or InvalidId if the name was never added */
+   SymbolId find(const QString &name) const;
+
+   QString name(SymbolId id) const;
+
+   /** Adds \a def under \a name and returns the id of the name */
+   SymbolId insert(const QString &name, Definition *def);
+   void remove(SymbolId id, Definition *def);
+
+   /** @brief Range over the definitions of one name, most recently added first.
+    *
+    *  Holds an implicitly shared copy of the list in the table, creating it does not copy
+    *  the definitions and it stays valid when the table changes.
+    */
+   class Definitions
+   {
+    public:
+      Definitions()
+      {}
+
+      Definitions(const QVector<Definition *> &list)
+         : m_list(list)
+      {}
+
+      QVector<Definition *>::const_reverse_iterator begin() const {
+         return m_list.crbegin();
+      }
+
+      QVector<Definition *>::const_reverse_iterator end() const {
+         return m_list.crend();
+      }
+
+      bool isEmpty() const {
+         return m_list.isEmpty();
+      }
+
+    private:
+      QVector<Definition *> m_list;
+   };
+
+   /** Returns the definitions with the given name, lookups rely on the most recent
+    *  definition coming first when two matches have the same distance
+    */
+   Definitions definitions(SymbolId id) const;
+   Definitions definitions(const QString &name) const;
+
+   /** Returns true if at least one definition has the given name */
+   bool contains(const QString &name) const;
+
+   /** Returns all definitions grouped by name, the names in the order they were first added
+    *  and the definitions of each name most recently added first
+    */
+   QVector<Definition *> allDefinitions() const;
+
+ private:
+   QHash<QString, SymbolId> m_ids;
+
+   QVector<QString> m_names;
+   QVector<QVector<Definition *>> m_definitions;
+
+   mutable QMutex m_mutex;
+};
+
+#endif
@@ -0,0 +1,477 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <stdio.h>
+
+#include <toolexecutor.h>
+
+#include <config.h>
+#include <message.h>
+#include <portable.h>
+
+// set for the worker threads, a job which waits for another job on a worker has to run jobs itself
+static thread_local bool s_isWorker = false;
+
+// jobs run by a waiting worker may wait themselves, this limits the depth of the stack
+static thread_local int s_nesting = 0;
+static const int s_maxNesting     = 8;
+
+ToolExecutor *ToolExecutor::instance()
+{
+   static ToolExecutor executor;
+   return &executor;
+}
+
+ToolExecutor::ToolExecutor()
+   : m_nextId(1), m_stop(false)
+{
+   m_numThreads = qMin(32, Config::getInt("tool-num-threads"));
+
+   if (m_numThreads <= 0) {
+      m_numThreads = qMax(2, QThread::idealThreadCount());
+   }
+
+   const QStringList timeouts = Config::getList("tool-timeouts");
+
+   for (const auto &item : timeouts) {
+      int i = item.indexOf('=');
+
+      bool ok     = false;
+      int seconds = item.mid(i + 1).trimmed().toInt(&ok);
+
+      if (i == -1 || ! ok || seconds < 0) {
+         warn_uncond("Ignoring entry '%s' of TOOL TIMEOUTS, the expected format is <tool>=<seconds>\n", csPrintable(item));
+         continue;
+      }
+
+      m_timeouts.insert(item.left(i).trimmed(), seconds * 1000);
+   }
+}
+
+int ToolExecutor::submit(const QString &tool, const QString &command, const QString &args, const QString &failMessage,
+                  const QList<int> &dependsOn, bool commandHasConsole, const QString &workDir)
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (m_workers.isEmpty()) {
+      startWorkers();
+   }
+
+   int id = m_nextId++;
+
+   Job &job        = m_jobs[id];
+   job.tool        = tool;
+   job.command     = command;
+   job.args        = args;
+   job.workDir     = workDir.isEmpty() ? QDir::currentPath() : workDir;
+   job.failMessage = failMessage;
+   job.dependsOn   = dependsOn;
+   job.state       = Waiting;
+   job.exitCode    = -1;
+   job.console     = commandHasConsole;
+   job.cancelled   = false;
+   job.task        = nullptr;
+
+   m_queue.append(id);
+   m_jobReady.wakeAll();
+
+   return id;
+}
+
+int ToolExecutor::submitTask(ToolTask *task, const QString &failMessage, const QList<int> &dependsOn)
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (m_workers.isEmpty()) {
+      startWorkers();
+   }
+
+   int id = m_nextId++;
+
+   Job &job        = m_jobs[id];
+   job.failMessage = failMessage;
+   job.dependsOn   = dependsOn;
+   job.task        = task;
+   job.state       = Waiting;
+   job.exitCode    = -1;
+   job.console     = false;
+   job.cancelled   = false;
+
+   m_queue.append(id);
+   m_jobReady.wakeAll();
+
+   return id;
+}
+
+int ToolExecutor::wait(int id)
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (! m_jobs.contains(id)) {
+      return -1;
+   }
+
+   while (m_jobs[id].state != Finished) {
+      // no worker threads available or the caller is a worker, the calling thread runs the jobs
+      int next = -1;
+
+      if (m_workers.isEmpty() || (s_isWorker && s_nesting < s_maxNesting)) {
+         next = takeReady(id);
+      }
+
+      if (next != -1) {
+         locker.unlock();
+
+         ++s_nesting;
+         runJob(next);
+         --s_nesting;
+
+         locker.relock();
+
+      } else {
+         m_jobDone.wait(&m_mutex);
+      }
+   }
+
+   return m_jobs[id].exitCode;
+}
+
+int ToolExecutor::run(const QString &tool, const QString &command, const QString &args, bool commandHasConsole,
+                  const QString &workDir)
+{
+   int id = submit(tool, command, args, QString(), QList<int>(), commandHasConsole, workDir);
+   int exitCode = wait(id);
+
+   QMutexLocker locker(&m_mutex);
+   m_jobs.remove(id);
+
+   return exitCode;
+}
+
+bool ToolExecutor::waitAll()
+{
+   bool retval = true;
+
+   QMutexLocker locker(&m_mutex);
+
+   QList<int> ids = m_jobs.keys();
+   std::sort(ids.begin(), ids.end());
+
+   locker.unlock();
+
+   for (auto id : ids) {
+      wait(id);
+   }
+
+   locker.relock();
+
+   // report in the order the jobs were submitted
+   for (auto id : ids) {
+      const Job &job = m_jobs[id];
+
+      if (job.exitCode != 0 && ! job.cancelled && ! job.failMessage.isEmpty()) {
+         err("%s, exit code: %d\n%s", csPrintable(job.failMessage), job.exitCode, csPrintable(job.errorOutput));
+         retval = false;
+      }
+   }
+
+   m_jobs.clear();
+   m_queue.clear();
+
+   for (const auto &fileName : m_removeFiles) {
+      QFile::remove(fileName);
+   }
+
+   m_removeFiles.clear();
+
+   // stop the worker threads, they are started again by the next submit
+   m_stop = true;
+   m_jobReady.wakeAll();
+
+   QList<ToolWorkerThread *> workers = m_workers;
+   m_workers.clear();
+
+   locker.unlock();
+
+   for (auto thread : workers) {
+      thread->wait();
+      delete thread;
+   }
+
+   locker.relock();
+   m_stop = false;
+
+   return retval;
+}
+
+int ToolExecutor::pendingCount() const
+{
+   QMutexLocker locker(&m_mutex);
+   return m_jobs.count();
+}
+
+void ToolExecutor::storeSignature(int id, const QString &sigFile, const QString &signature)
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (! m_jobs.contains(id)) {
+      return;
+   }
+
+   Job &job = m_jobs[id];
+
+   if (job.state == Finished) {
+      if (job.exitCode == 0) {
+         writeSignature(sigFile, signature);
+      }
+
+   } else {
+      job.sigFile   = sigFile;
+      job.signature = signature;
+   }
+}
+
+void ToolExecutor::removeWhenDone(const QString &fileName)
+{
+   QMutexLocker locker(&m_mutex);
+   m_removeFiles.append(fileName);
+}
+
+QString ToolExecutor::signature(const QString &inFile, const QString &command)
+{
+   QFile f(inFile);
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      return QString();
+   }
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+   hash.addData(f.readAll());
+   hash.addData(command.toUtf8());
+
+   return QString::fromLatin1(hash.result().toHex());
+}
+
+bool ToolExecutor::isUpToDate(const QString &sigFile, const QString &signature, const QStringList &outputs)
+{
+   if (signature.isEmpty()) {
+      return false;
+   }
+
+   for (const auto &output : outputs) {
+      if (! QFileInfo(output).exists()) {
+         return false;
+      }
+   }
+
+   QFile f(sigFile);
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      return false;
+   }
+
+   return QString::fromLatin1(f.readAll()) == signature;
+}
+
+void ToolExecutor::writeSignature(const QString &sigFile, const QString &signature)
+{
+   QFile f(sigFile);
+
+   if (f.open(QIODevice::WriteOnly)) {
+      f.write(signature.toLatin1());
+   }
+}
+
+void ToolExecutor::startWorkers()
+{
+   for (int i = 0; i < m_numThreads; i++) {
+      ToolWorkerThread *thread = new ToolWorkerThread(this);
+      thread->start();
+
+      if (thread->isRunning()) {
+         m_workers.append(thread);
+      } else {
+         // no more threads available
+         delete thread;
+      }
+   }
+}
+
+int ToolExecutor::claim()
+{
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_stop) {
+      int id = takeReady();
+
+      if (id != -1) {
+         return id;
+      }
+
+      m_jobReady.wait(&m_mutex);
+   }
+
+   return -1;
+}
+
+int ToolExecutor::takeReady(int preferred)
+{
+   int i = m_queue.indexOf(preferred);
+
+   if (i > 0) {
+      // the job a caller waits for is run first
+      m_queue.move(i, 0);
+   }
+
+   i = 0;
+
+   while (i < m_queue.count()) {
+      Job &job = m_jobs[m_queue.at(i)];
+
+      bool ready  = true;
+      bool failed = false;
+
+      for (auto depId : job.dependsOn) {
+         auto iter = m_jobs.find(depId);
+
+         if (iter == m_jobs.end()) {
+            // job was done before the last waitAll()
+            continue;
+         }
+
+         if (iter->state != Finished) {
+            ready = false;
+
+         } else if (iter->exitCode != 0) {
+            failed = true;
+         }
+      }
+
+      if (failed) {
+         // the failure of the dependency is reported, not the job which was skipped
+         job.state     = Finished;
+         job.cancelled = true;
+
+         m_queue.removeAt(i);
+         m_jobDone.wakeAll();
+
+         // jobs which depend on this one can be cancelled now
+         i = 0;
+         continue;
+      }
+
+      if (ready) {
+         int id = m_queue.takeAt(i);
+         job.state = Running;
+
+         return id;
+      }
+
+      ++i;
+   }
+
+   return -1;
+}
+
+void ToolExecutor::runJob(int id)
+{
+   QString tool;
+   QString command;
+   QString args;
+   QString workDir;
+
+   ToolTask *task;
+   bool console;
+
+   {
+      // copy the job, m_jobs may be changed by other threads while the tool runs
+      QMutexLocker locker(&m_mutex);
+      const Job &job = m_jobs[id];
+
+      tool    = job.tool;
+      command = job.command;
+      args    = job.args;
+      workDir = job.workDir;
+      task    = job.task;
+      console = job.console;
+   }
+
+   QString errorOutput;
+   int exitCode;
+
+   if (task != nullptr) {
+      exitCode = task->run();
+
+   } else {
+      exitCode = portable_systemCapture(command, args, workDir, timeout(tool), errorOutput, console);
+   }
+
+   QMutexLocker locker(&m_mutex);
+   Job &job = m_jobs[id];
+
+   job.exitCode = exitCode;
+   job.state    = Finished;
+
+   if (exitCode == 0 && ! job.sigFile.isEmpty()) {
+      writeSignature(job.sigFile, job.signature);
+   }
+
+   if (exitCode != 0 && ! job.failMessage.isEmpty()) {
+      // reported by waitAll()
+      job.errorOutput = errorOutput;
+
+   } else if (! errorOutput.isEmpty()) {
+      fprintf(stderr, "%s", csPrintable(errorOutput));
+
+      if (! errorOutput.endsWith('\n')) {
+         fprintf(stderr, "\n");
+      }
+   }
+
+   m_jobDone.wakeAll();
+
+   // jobs which depend on this one may be ready
+   m_jobReady.wakeAll();
+}
+
+int ToolExecutor::timeout(const QString &tool)
+{
+   return m_timeouts.value(tool, 0);
+}
+
+ToolWorkerThread::ToolWorkerThread(ToolExecutor *executor)
+   : m_executor(executor)
+{
+}
+
+void ToolWorkerThread::run()
+{
+   s_isWorker = true;
+
+   int id;
+
+   while ((id = m_executor->claim()) != -1) {
+      m_executor->runJob(id);
+   }
+}
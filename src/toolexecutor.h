@@ -0,0 +1,168 @@
+/*************************************************************************
+ *
+ * Copyright (C) 2014-2016 Barbara Geller & Ansel Sermersheim
+ * Copyright (C) 1997-2014 by Dimitri van Heesch.
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License version 2
+ * is hereby granted. No representations are made about the suitability of
+ * this software for any purpose. It is provided "as is" without express or
+ * implied warranty. See the GNU General Public License for more details.
+ *
+ * Documents produced by DoxyPress are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+*************************************************************************/
+
+#ifndef TOOLEXECUTOR_H
+#define TOOLEXECUTOR_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+
+class ToolWorkerThread;
+
+/** Work which runs inside the process on a worker of the ToolExecutor, for example converting the output of a tool */
+class ToolTask
+{
+ public:
+   virtual ~ToolTask() {}
+
+   /** Returns 0 on success, like the exit code of a tool */
+   virtual int run() = 0;
+};
+
+/** Runs external tools like dot, latex, mscgen and epstopdf on a shared pool of worker threads.
+ *
+ *  The number of tools which run at the same time is limited by the option tool-num-threads,
+ *  this limit holds for all callers together. A job is run in the directory passed to submit(),
+ *  by default the one which was current when it was submitted. It may depend on other jobs and
+ *  only starts after these jobs finished successfully. Anything a tool writes to stderr is captured and printed as one block when
+ *  the tool is done, so the output of tools running in parallel is not mixed up.
+ *
+ *  A ToolTask is scheduled like a tool. It does not change the current directory and has to use
+ *  absolute paths.
+ */
+class ToolExecutor
+{
+ public:
+   static ToolExecutor *instance();
+
+   /** Adds a job and returns its id. The \a tool name selects the timeout from the option tool-timeouts.
+    *  When the job fails and \a failMessage is not empty the failure is reported by waitAll(). Pages are
+    *  written on several threads, callers there must pass \a workDir instead of changing the current directory.
+    */
+   int submit(const QString &tool, const QString &command, const QString &args, const QString &failMessage = QString(),
+              const QList<int> &dependsOn = QList<int>(), bool commandHasConsole = true, const QString &workDir = QString());
+
+   /** Adds a \a task which runs on a worker thread and returns its id. The caller owns the task, it must
+    *  not be deleted before wait() returned for this id.
+    */
+   int submitTask(ToolTask *task, const QString &failMessage = QString(), const QList<int> &dependsOn = QList<int>());
+
+   /** Waits until job \a id is done, returns the exit code or -1 if the job could not be run */
+   int wait(int id);
+
+   /** Runs a command and waits for it to finish, this is the replacement for portable_system() */
+   int run(const QString &tool, const QString &command, const QString &args, bool commandHasConsole = true,
+           const QString &workDir = QString());
+
+   /** Waits for all jobs and reports the failures, returns false if a job failed */
+   bool waitAll();
+
+   /** Number of jobs which were submitted and not yet waited for */
+   int pendingCount() const;
+
+   /** Number of jobs which can run at the same time */
+   int threadCount() const {
+      return m_numThreads;
+   }
+
+   /** Writes \a signature to \a sigFile once job \a id has finished successfully */
+   void storeSignature(int id, const QString &sigFile, const QString &signature);
+
+   /** Removes \a fileName after waitAll(), used for temporary input files of jobs running in the background */
+   void removeWhenDone(const QString &fileName);
+
+   /** Returns a signature of the contents of \a inFile and the \a command used to convert it */
+   static QString signature(const QString &inFile, const QString &command);
+
+   /** Returns true if all \a outputs exist and \a sigFile contains \a signature, the conversion can be skipped */
+   static bool isUpToDate(const QString &sigFile, const QString &signature, const QStringList &outputs);
+
+ private:
+   enum State { Waiting, Running, Finished };
+
+   struct Job {
+      QString tool;
+      QString command;
+      QString args;
+      QString workDir;
+      QString failMessage;
+      QString errorOutput;
+      QString sigFile;
+      QString signature;
+
+      QList<int> dependsOn;
+
+      ToolTask *task;
+
+      State state;
+      int   exitCode;
+      bool  console;
+      bool  cancelled;
+   };
+
+   ToolExecutor();
+
+   void startWorkers();
+
+   /** Returns the id of the next job which can be run, -1 when the executor is stopped */
+   int claim();
+
+   /** Returns the id of a job whose dependencies are done or -1, \a preferred is checked first.
+    *  The mutex must be locked.
+    */
+   int takeReady(int preferred = -1);
+   void runJob(int id);
+
+   int timeout(const QString &tool);
+
+   static void writeSignature(const QString &sigFile, const QString &signature);
+
+   QHash<int, Job> m_jobs;
+   QList<int>      m_queue;
+   QHash<QString, int> m_timeouts;
+   QStringList         m_removeFiles;
+
+   int  m_nextId;
+   int  m_numThreads;
+   bool m_stop;
+
+   QList<ToolWorkerThread *> m_workers;
+
+   QWaitCondition m_jobReady;
+   QWaitCondition m_jobDone;
+   mutable QMutex m_mutex;
+
+   friend class ToolWorkerThread;
+};
+
+/** Worker thread which runs the jobs of the ToolExecutor */
+class ToolWorkerThread : public QThread
+{
+ public:
+   ToolWorkerThread(ToolExecutor *executor);
+   void run();
+
+ private:
+   ToolExecutor *m_executor;
+};
+
+#endif
@@ -25,7 +25,7 @@
 #include <outputgen.h>
 #include <util.h>
 
-TooltipManager *TooltipManager::s_theInstance = 0;
+thread_local TooltipManager *TooltipManager::s_theInstance = 0;
 
 TooltipManager::TooltipManager()
 {   
@@ -44,6 +44,12 @@ TooltipManager *TooltipManager::instance()
    return s_theInstance;
 }
 
+void TooltipManager::deleteInstance()
+{
+   delete s_theInstance;
+   s_theInstance = 0;
+}
+
 void TooltipManager::clearTooltips()
 {
    m_tooltipInfo.clear();
@@ -25,6 +25,10 @@ class TooltipManager
 {
  public:
    static TooltipManager *instance();
+
+   /** Deletes the instance of the calling thread */
+   static void deleteInstance();
+
    void clearTooltips();
    void addTooltip(QSharedPointer<Definition> d);
    void writeTooltips(CodeOutputInterface &ol);
@@ -35,7 +39,8 @@ class TooltipManager
    TooltipManager();
    ~TooltipManager();
 
-   static TooltipManager *s_theInstance;
+   // one instance per thread, source files are highlighted on several threads
+   static thread_local TooltipManager *s_theInstance;
 };
 
 #endif
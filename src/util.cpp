@@ -20,6 +20,7 @@
 #include <QCryptographicHash>
 #include <QDateTime>
 #include <QHash>
+#include <QMutex>
 #include <QRegExp>
 #include <QTextCodec>
 
@@ -29,6 +30,7 @@
 
 #include <util.h>
 
+#include <buildstate.h>
 #include <config.h>
 #include <defargs.h>
 #include <doxy_globals.h>
@@ -62,12 +64,14 @@ struct FindFileCacheElem {
 
 const int MAX_STACK_SIZE = 1000;
 
-static QHash<QString, QSharedPointer<MemberDef>>   s_resolvedTypedefs;
-static QHash<QString, QSharedPointer<Definition>>  s_visitedNamespaces;
+// recursion guards of the symbol resolution, kept per thread since source files are highlighted in parallel
+static thread_local QHash<QString, QSharedPointer<MemberDef>>   s_resolvedTypedefs;
+static thread_local QHash<QString, QSharedPointer<Definition>>  s_visitedNamespaces;
 
-static QSet<QString> s_aliasesProcessed;
+static thread_local QSet<QString> s_aliasesProcessed;
 
 static QCache<QPair<const FileNameDict *, QString>, FindFileCacheElem> s_findFileDefCache;
+static QMutex s_findFileDefLock;
 
 // forward declaration
 static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> scope, QSharedPointer<FileDef> fileScope,
@@ -170,7 +174,7 @@ QString removeAnonymousScopes(const QString &s)
       return result;
    }
 
-   static QRegExp re("[ :]*@[0-9]+[: ]*");
+   static thread_local QRegExp re("[ :]*@[0-9]+[: ]*");
    int i;
    int len;
    int sl = s.length();
@@ -219,7 +223,7 @@ QString replaceAnonymousScopes(const QString &s, const QString&replacement)
       return result;
    }
 
-   static QRegExp re("@[0-9]+");
+   static thread_local QRegExp re("@[0-9]+");
    int i;
    int len;
    int sl = s.length();
@@ -497,7 +501,7 @@ QSharedPointer<NamespaceDef> getResolvedNamespace(const QString &name)
       return QSharedPointer<NamespaceDef>();
    }
 
-   QString subst = Doxy_Globals::namespaceAliasDict[name];
+   QString subst = Doxy_Globals::namespaceAliasDict.value(name);
 
    if (subst.isEmpty()) {
       return Doxy_Globals::namespaceSDict->find(name);
@@ -508,7 +512,7 @@ QSharedPointer<NamespaceDef> getResolvedNamespace(const QString &name)
       // recursion detection guard
       QString newSubst;
 
-      while ( ! (newSubst = Doxy_Globals::namespaceAliasDict[subst]).isEmpty() && count < 10) {
+      while ( ! (newSubst = Doxy_Globals::namespaceAliasDict.value(subst)).isEmpty() && count < 10) {
          subst = newSubst;
          count++;
       }
@@ -672,9 +676,9 @@ static QString substTypedef(QSharedPointer<Definition> scopeDef, QSharedPointer<
       return result;
    }
 
-   auto iter = Doxy_Globals::glossary().find(phraseName);
+   const SymbolTable::Definitions defList = Doxy_Globals::glossary().definitions(phraseName);
 
-   if (iter == Doxy_Globals::glossary().end()) {
+   if (defList.isEmpty()) {
       // could not find a matching def
       return "";
    }
@@ -683,12 +687,12 @@ static QString substTypedef(QSharedPointer<Definition> scopeDef, QSharedPointer<
 
    QSharedPointer<MemberDef> bestMatch;
 
-   while (iter != Doxy_Globals::glossary().end() && iter.key() == phraseName)  {
+   for (auto item : defList) {
       // search for the best match, only look at members
 
-      if (iter.value()->definitionType() == Definition::TypeMember) {
+      if (item->definitionType() == Definition::TypeMember) {
          // which are also typedefs
-         QSharedPointer<Definition> sharedPtr = sharedFrom(iter.value());
+         QSharedPointer<Definition> sharedPtr = sharedFrom(item);
          QSharedPointer<MemberDef> md = sharedPtr.dynamicCast<MemberDef>();
 
          if (md->isTypedef()) {
@@ -703,8 +707,6 @@ static QString substTypedef(QSharedPointer<Definition> scopeDef, QSharedPointer<
             }
          }
       }
-
-      ++iter;
    }
 
    if (bestMatch) {
@@ -831,7 +833,7 @@ bool accessibleViaUsingClass(const StringMap<QSharedPointer<Definition>> *cl, QS
 static bool accessibleViaUsingNamespace(const NamespaceSDict *nl, QSharedPointer<FileDef> fileScope, QSharedPointer<Definition> item,
                                  const QString &explicitScopePart = "")
 {
-   static QSet<QString> visitedDict;
+   static thread_local QSet<QString> visitedDict;
 
    if (nl) {
       // check used namespaces for the class
@@ -951,7 +953,7 @@ class AccessStack
  */
 int isAccessibleFrom(QSharedPointer<Definition> scopeDef, QSharedPointer<FileDef> fileScope, QSharedPointer<Definition> item)
 {
-   static AccessStack accessStack;
+   static thread_local AccessStack accessStack;
 
    if (accessStack.find(scopeDef, fileScope, item)) {
       return -1;
@@ -1059,7 +1061,7 @@ int isAccessibleFromWithExpScope(QSharedPointer<Definition> scopeDef, QSharedPoi
       return isAccessibleFrom(scopeDef, fileScope, item);
    }
 
-   static AccessStack accessStack;
+   static thread_local AccessStack accessStack;
    if (accessStack.find(scopeDef, fileScope, item, explicitScopePart)) {
       return -1;
    }
@@ -1361,13 +1363,14 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> s
       return QSharedPointer<ClassDef>();
    }
 
-   if (! Doxy_Globals::glossary().contains(name)) {
+   SymbolId nameId = Doxy_Globals::glossary().find(name);
+
+   if (nameId == SymbolTable::InvalidId) {
       // -p (for ObjC protocols)
 
-      if (! Doxy_Globals::glossary().contains(name + "-p")) {
+      if (Doxy_Globals::glossary().find(name + "-p") == SymbolTable::InvalidId) {
          return QSharedPointer<ClassDef>();
       }
-
    }
 
    bool hasUsingStatements = (fileScope && ((fileScope->getUsedNamespaces() &&
@@ -1377,55 +1380,36 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> s
    // Since it is often the case that the same name is searched in the same
    // scope over an over again (especially for the linked source code generation)
    // we use a cache to collect previous results. This is possible since the
-   // result of a lookup is deterministic. As the key we use the concatenated
-   // scope, the name to search for and the explicit scope prefix. The speedup
+   // result of a lookup is deterministic. As the key we use the scope object,
+   // the name to search for and the explicit scope prefix. The speedup
    // achieved by this simple cache can be enormous.
 
-   int scopeNameLen = scope->name().length() + 1;
-   int nameLen = name.length() + 1;
-   int explicitPartLen = explicitScopePart.length();
-
-   int fileScopeLen;
-
-   if (hasUsingStatements) {
-       fileScopeLen = 1 + fileScope->getFilePath().length();
-
-   } else {
-      fileScopeLen = 0;
-
-   }
-
-   QString key = scope->name( ) + "+" + name + "+" + explicitScopePart;
-
    // if a file scope is given and contains using statements we should also use the file part
    // in the key (as a class name can be in two different namespaces and a using statement in
-   // a file can select one of them).
+   // a file can select one of them)
 
-   if (hasUsingStatements) {
-      key += "+" + fileScope->name();
-   }
-
-   LookupInfo *pval = Doxy_Globals::lookupCache->object(key);
+   LookupKey key(scope.data(), nameId, explicitScopePart, hasUsingStatements ? fileScope.data() : nullptr);
+   LookupInfo info;
 
-   if (pval) {
+   if (Doxy_Globals::lookupCache->find(key, info)) {
 
       if (pTemplSpec) {
-         *pTemplSpec = pval->templSpec;
+         *pTemplSpec = info.templSpec;
       }
 
       if (pTypeDef) {
-         *pTypeDef = pval->typeDef;
+         *pTypeDef = info.typeDef;
       }
 
       if (pResolvedType) {
-         *pResolvedType = pval->resolvedType;
+         *pResolvedType = info.resolvedType;
       }
 
-      return pval->classDef;
+      return info.classDef;
 
    } else {
       // not found, we already add a 0 to avoid the possibility of endless recursion
-      Doxy_Globals::lookupCache->insert(key, new LookupInfo);
+      Doxy_Globals::lookupCache->insert(key, LookupInfo());
    }
 
    QSharedPointer<ClassDef> bestMatch;
@@ -1437,15 +1421,11 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> s
    // init at "infinite"
    int minDistance = 10000;
 
-   auto iter = Doxy_Globals::glossary().find(name);
-
-   while (iter != Doxy_Globals::glossary().end() && iter.key() == name)  {
-      QSharedPointer<Definition> def = sharedFrom(iter.value());
+   for (auto item : Doxy_Globals::glossary().definitions(nameId)) {
+      QSharedPointer<Definition> def = sharedFrom(item);
 
       getResolvedSymbol(scope, fileScope, def, explicitScopePart, &actTemplParams,
                         minDistance, bestMatch, bestTypedef, bestTemplSpec, bestResolvedType);
-
-      ++iter;
    }
 
    if (pTypeDef) {
@@ -1460,18 +1440,7 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<Definition> s
       *pResolvedType = bestResolvedType;
    }
 
-   pval = Doxy_Globals::lookupCache->object(key);
-
-   if (pval) {
-      pval->classDef     = bestMatch;
-      pval->typeDef      = bestTypedef;
-      pval->templSpec    = bestTemplSpec;
-      pval->resolvedType = bestResolvedType;
-
-   } else {
-      Doxy_Globals::lookupCache->insert(key, new LookupInfo(bestMatch, bestTypedef, bestTemplSpec, bestResolvedType));
-
-   }
+   Doxy_Globals::lookupCache->insert(key, LookupInfo(bestMatch, bestTypedef, bestTemplSpec, bestResolvedType));
 
    return bestMatch;
 }
@@ -1845,8 +1814,8 @@ void linkifyText(const TextGeneratorIntf &out, QSharedPointer<Definition> scope,
       return;
    }
 
-   static QRegExp regExp("[a-z_A-Z\\x80-\\xFF][~!a-z_A-Z0-9$\\\\.:\\x80-\\xFF]*");
-   static QRegExp regExpSplit(",");
+   static thread_local QRegExp regExp("[a-z_A-Z\\x80-\\xFF][~!a-z_A-Z0-9$\\\\.:\\x80-\\xFF]*");
+   static thread_local QRegExp regExpSplit(",");
 
    int matchLen;
    int index = 0;
@@ -2355,6 +2324,8 @@ QString fileToString(const QString &name, bool filter, bool isSourceCode)
       // read from file
       QFileInfo fi(name);
 
+      BuildState::addDependency(fi.absoluteFilePath());
+
       if (! fi.exists() || ! fi.isFile()) {
          err("Unable to find file `%s'\n", qPrintable(name));
          return "";
@@ -3191,7 +3162,7 @@ static QString extractCanonicalType(QSharedPointer<Definition> def, QSharedPoint
          // if we did not use up the templSpec already (i.e. type is not a template specialization)
          // then resolve any identifiers inside
 
-         static QRegExp re("[a-z_A-Z\\x80-\\xFF][a-z_A-Z0-9\\x80-\\xFF]*");
+         static thread_local QRegExp re("[a-z_A-Z\\x80-\\xFF][a-z_A-Z0-9\\x80-\\xFF]*");
          int tp = 0;
          int tl;
          int ti;
@@ -4458,6 +4429,9 @@ QSharedPointer<FileDef> findFileDef(const FileNameDict *fnDict, const QString &n
       return QSharedPointer<FileDef>();
    }
 
+   // the preprocessor calls this method from the input pipeline thread
+   QMutexLocker locker(&s_findFileDefLock);
+
    // set up the key
    QPair<const FileNameDict *, QString> key(fnDict, name);
 
@@ -4823,10 +4797,12 @@ QString convertNameToFile(const QString &name, bool allowDots, bool allowUndersc
    if (shortNames) {
       // use short names only
       static QHash<QString, int> usedNames;
+      static QMutex usedNamesLock;
 
       static int count = 1;
       int num;
 
+      QMutexLocker locker(&usedNamesLock);
       auto value = usedNames.find(name);
 
       if (value != usedNames.end()) {
@@ -5256,7 +5232,7 @@ QString convertCharEntities(const QString &str)
       return retval;
    }
 
-   static QRegExp entityPat("&[a-zA-Z]+[0-9]*;");
+   static thread_local QRegExp entityPat("&[a-zA-Z]+[0-9]*;");
 
    int i = 0;
    int p;
@@ -5377,8 +5353,8 @@ void addMembersToMemberGroup(QSharedPointer<MemberList> ml, MemberGroupSDict **p
  */
 int extractClassNameFromType(const QString &type, int &pos, QString &name, QString &templSpec, SrcLangExt lang)
 {
-   static const QRegExp re_norm("[a-z_A-Z\\x80-\\xFF][a-z_A-Z0-9:\\x80-\\xFF]*");
-   static const QRegExp re_ftn("[a-z_A-Z\\x80-\\xFF][()=_a-z_A-Z0-9:\\x80-\\xFF]*");
+   static thread_local const QRegExp re_norm("[a-z_A-Z\\x80-\\xFF][a-z_A-Z0-9:\\x80-\\xFF]*");
+   static thread_local const QRegExp re_ftn("[a-z_A-Z\\x80-\\xFF][()=_a-z_A-Z0-9:\\x80-\\xFF]*");
    QRegExp re;
 
    name.resize(0);
@@ -5484,7 +5460,7 @@ QString normalizeNonTemplateArgumentsInString(const QString &name, QSharedPointe
    p++;
    QString result = name.left(p);
 
-   static QRegExp re("[a-z_A-Z\\x80-\\xFF][a-z_A-Z0-9\\x80-\\xFF]*");
+   static thread_local QRegExp re("[a-z_A-Z\\x80-\\xFF][a-z_A-Z0-9\\x80-\\xFF]*");
    int l, i;
 
    // for each identifier in the template part (e.g. B<T> -> T)
@@ -5544,7 +5520,7 @@ QString substituteTemplateArgumentsInString(const QString &name, ArgumentList *f
 
    QString result;
 
-   static QRegExp re("[a-z_A-Z\\x80-\\xFF][a-z_A-Z0-9\\x80-\\xFF]*");
+   static thread_local QRegExp re("[a-z_A-Z\\x80-\\xFF][a-z_A-Z0-9\\x80-\\xFF]*");
    int p = 0, l, i;
 
    // for each identifier in the base class name (e.g. B<T> -> B and T)
@@ -6193,26 +6169,11 @@ void filterLatexString(QTextStream &t, const QString &text, bool insideTabbing,
 
 QString rtfFormatBmkStr(const QString &key)
 {
-   // To overcome the 40-character tag limitation, we substitute a short arbitrary string for the name
-   // supplied, and keep track of the correspondence between names and strings.
-
-   static uint64_t nextTag = 0;
-   static QHash<QString, uint64_t> tagDict;
-
-   auto item = tagDict.find(key);
-
-   if (item == tagDict.end()) {
-      // this particular name has not yet been added to the list. Add it now and
-      // associate it with the next tag value. then increment next tag
-
-      tagDict.insert(key, nextTag);
-      item = tagDict.find(key);
-
-      // increment part
-      nextTag++;
-   }
+   // To overcome the 40-character tag limitation, we substitute a short string for the name supplied.
+   // The string is derived from the name, so the same name gets the same tag on every page
 
-   return QString::number(item.value(), 16);
+   QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5).toHex();
+   return QString::fromLatin1(hash.left(16));
 }
 
 
@@ -6325,7 +6286,7 @@ void replaceNamespaceAliases(QString &scope, int i)
 {
    while (i > 0) {
       QString ns = scope.left(i);
-      QString s  = Doxy_Globals::namespaceAliasDict[ns];
+      QString s  = Doxy_Globals::namespaceAliasDict.value(ns);
 
       if (! s.isEmpty()) {
          scope = s + scope.right(scope.length() - i);
@@ -6360,7 +6321,7 @@ QString stripPath(const QString &s)
 /** returns \c true iff string \a s contains word \a w */
 bool containsWord(const QString &s, const QString &word)
 {
-   static QRegExp wordExp("[a-z_A-Z\\x80-\\xFF]+");
+   static thread_local QRegExp wordExp("[a-z_A-Z\\x80-\\xFF]+");
    int p = 0, i, l;
 
    while ((i = wordExp.indexIn(s, p)) != -1) {
@@ -6378,7 +6339,7 @@ bool containsWord(const QString &s, const QString &word)
 
 bool findAndRemoveWord(QString &str, const QString &word)
 {
-   static QRegExp wordExp("[a-z_A-Z\\x80-\\xFF]+");
+   static thread_local QRegExp wordExp("[a-z_A-Z\\x80-\\xFF]+");
    int p = 0;
    int i;
    int l;
@@ -6494,9 +6455,9 @@ QSharedPointer<MemberDef> getMemberFromSymbol(QSharedPointer<Definition> scope,
       return bestMatch;
    }
 
-   auto iter = Doxy_Globals::glossary().find(name);
+   const SymbolTable::Definitions defList = Doxy_Globals::glossary().definitions(name);
 
-   if (iter == Doxy_Globals::glossary().end()) {
+   if (defList.isEmpty()) {
       return bestMatch;
    }
 
@@ -6518,25 +6479,22 @@ QSharedPointer<MemberDef> getMemberFromSymbol(QSharedPointer<Definition> scope,
    int minDistance = 10000;
 
    // find the closest matching definition
-   while (iter != Doxy_Globals::glossary().end() && iter.key() == name)  {
+   for (auto item : defList) {
       // search for the best match, only look at members
 
-      if (iter.value()->definitionType() == Definition::TypeMember) {
+      if (item->definitionType() == Definition::TypeMember) {
          s_visitedNamespaces.clear();
 
-         QSharedPointer<Definition> def = sharedFrom(iter.value());
+         QSharedPointer<Definition> def = sharedFrom(item);
          int distance = isAccessibleFromWithExpScope(scope, fileScope, def, explicitScopePart);
 
          if (distance != -1 && distance < minDistance) {
             minDistance = distance;
 
-            QSharedPointer<Definition> def = sharedFrom(iter.value());
-            QSharedPointer<MemberDef> md   = def.dynamicCast<MemberDef>();
+            QSharedPointer<MemberDef> md = def.dynamicCast<MemberDef>();
             bestMatch = md;
          }
       }
-
-      ++iter;
    }
 
    return bestMatch;
@@ -6759,7 +6717,7 @@ static QString escapeCommas(const QString &s)
 static QString expandAliasRec(const QString &s, bool allowRecursion)
 {
    QString result;
-   static QRegExp cmdPat("[\\\\@][a-z_A-Z][a-z_A-Z0-9]*");
+   static thread_local QRegExp cmdPat("[\\\\@][a-z_A-Z][a-z_A-Z0-9]*");
 
    QString value = s;
 
@@ -7063,7 +7021,7 @@ QString filterTitle(const QString &title)
 {
    QString tf;
 
-   static QRegExp re("%[A-Z_a-z]");
+   static thread_local QRegExp re("%[A-Z_a-z]");
    int p = 0, i, l;
 
    while ((i = re.indexIn(title, p)) != -1) {
@@ -7219,7 +7177,7 @@ QString replaceColorMarkers(const QString &str)
       return result;
    }
 
-   static QRegExp re("##([0-9A-Fa-f][0-9A-Fa-f])");
+   static thread_local QRegExp re("##([0-9A-Fa-f][0-9A-Fa-f])");
 
    static int hue   = Config::getInt("html-colorstyle-hue");
    static int sat   = Config::getInt("html-colorstyle-sat");
@@ -7286,6 +7244,45 @@ bool copyFile(const QString &src, const QString &dest)
    return true;
 }
 
+/** Returns the base name, in \a outDir, of the file for an inline graph with the contents \a text.
+ *  The name only depends on the contents, so pages can be written in any order.
+ */
+QString inlineGraphBaseName(const QString &outDir, const QString &prefix, const QString &text)
+{
+   QByteArray hash = QCryptographicHash::hash(text.toUtf8(), QCryptographicHash::Md5).toHex();
+   return outDir + "/" + prefix + QString::fromLatin1(hash);
+}
+
+/** Writes \a data to \a fileName unless the file already holds it. A graph which is shown on
+ *  several pages is stored in one file, which may be in use by a tool started for another page.
+ */
+bool writeInlineGraphFile(const QString &fileName, const QByteArray &data)
+{
+   static QMutex lock;
+   QMutexLocker locker(&lock);
+
+   QFile f(fileName);
+
+   if (f.open(QIODevice::ReadOnly)) {
+      bool unchanged = (f.readAll() == data);
+      f.close();
+
+      if (unchanged) {
+         return true;
+      }
+   }
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file for writing %s, error: %d\n", csPrintable(fileName), f.error());
+      return false;
+   }
+
+   f.write(data);
+   f.close();
+
+   return true;
+}
+
 /** Returns the section of text, in between a pair of markers.
  *  Full lines are returned, excluding the lines on which the markers appear.
  */
@@ -7512,11 +7509,121 @@ bool docFileVisibleInIndex(QSharedPointer<FileDef> fd)
    return retval;
 }
 
+// cross references of a source worker thread, applied by the caller in the order of the files
+static thread_local CrossReferenceList *s_crossReferenceBuffer = nullptr;
+
+void captureCrossReferences(CrossReferenceList *buffer)
+{
+   s_crossReferenceBuffer = buffer;
+}
+
+void applyCrossReferences(const CrossReferenceList &list)
+{
+   for (const auto &item : list) {
+      addDocCrossReference(item.first, item.second);
+   }
+}
+
+QString definitionKey(QSharedPointer<Definition> def)
+{
+   if (def == nullptr) {
+      return QString();
+   }
+
+   return QString::number(def->definitionType()) + ":" + def->getDefFileName() + ":" +
+          def->qualifiedName() + "#" + def->anchor();
+}
+
+static void addDefinitionKey(QHash<QString, QSharedPointer<Definition>> &map, QSharedPointer<Definition> def)
+{
+   QString key = definitionKey(def);
+
+   if (map.contains(key)) {
+      // more than one definition, the key can not be used
+      map.insert(key, QSharedPointer<Definition>());
+
+   } else {
+      map.insert(key, def);
+
+   }
+}
+
+QSharedPointer<Definition> findDefinitionByKey(const QString &key)
+{
+   static QHash<QString, QSharedPointer<Definition>> map;
+   static bool initialized = false;
+
+   static QMutex lock;
+   QMutexLocker locker(&lock);
+
+   if (! initialized) {
+      // called after all symbols are known, built once on first use
+      for (auto cd : *Doxy_Globals::classSDict) {
+         addDefinitionKey(map, cd);
+      }
+
+      for (auto cd : *Doxy_Globals::hiddenClasses) {
+         addDefinitionKey(map, cd);
+      }
+
+      for (auto nd : *Doxy_Globals::namespaceSDict) {
+         addDefinitionKey(map, nd);
+      }
+
+      for (auto fn : *Doxy_Globals::inputNameList) {
+         for (auto fd : *fn) {
+            addDefinitionKey(map, fd);
+         }
+      }
+
+      for (auto gd : *Doxy_Globals::groupSDict) {
+         addDefinitionKey(map, gd);
+      }
+
+      for (auto pd : *Doxy_Globals::pageSDict) {
+         addDefinitionKey(map, pd);
+      }
+
+      for (auto pd : *Doxy_Globals::exampleSDict) {
+         addDefinitionKey(map, pd);
+      }
+
+      if (Doxy_Globals::mainPage) {
+         addDefinitionKey(map, Doxy_Globals::mainPage);
+      }
+
+      for (auto dd : Doxy_Globals::directories) {
+         addDefinitionKey(map, dd);
+      }
+
+      for (auto mn : *Doxy_Globals::memberNameSDict) {
+         for (auto md : *mn) {
+            addDefinitionKey(map, md);
+         }
+      }
+
+      for (auto mn : *Doxy_Globals::functionNameSDict) {
+         for (auto md : *mn) {
+            addDefinitionKey(map, md);
+         }
+      }
+
+      initialized = true;
+   }
+
+   return map.value(key);
+}
+
 void addDocCrossReference(QSharedPointer<MemberDef> src, QSharedPointer<MemberDef> dst)
 {
    static bool referencedByRelation = Config::getBool("ref-by-relation");
    static bool referencesRelation   = Config::getBool("ref-relation");
 
+   if (s_crossReferenceBuffer) {
+      s_crossReferenceBuffer->append(qMakePair(src, dst));
+      return;
+   }
+
    if (dst->isTypedef() || dst->isEnumerate()) {
       return;   // do not add types
    }
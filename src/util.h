@@ -21,8 +21,10 @@
 #include <QList>
 #include <QDir>
 #include <QFileInfo>
+#include <QPair>
 #include <QStringList>
 #include <QTextStream>
+#include <QVector>
 
 #include <ctype.h>
 #include <types.h>
@@ -334,6 +336,8 @@ void writeColoredImgData(ColoredImgDataItem data);
 QString replaceColorMarkers(const QString &str);
 
 bool copyFile(const QString &src, const QString &dest);
+QString inlineGraphBaseName(const QString &outDir, const QString &prefix, const QString &text);
+bool writeInlineGraphFile(const QString &fileName, const QByteArray &data);
 QString extractBlock(const QString &text, const QString &marker);
 QString correctURL(const QString &url, const QString &relPath);
 
@@ -346,6 +350,22 @@ bool srcFileVisibleInIndex(QSharedPointer<FileDef> fd);
 
 void addDocCrossReference(QSharedPointer<MemberDef> src, QSharedPointer<MemberDef> dst);
 
+using CrossReferenceList = QVector<QPair<QSharedPointer<MemberDef>, QSharedPointer<MemberDef>>>;
+
+/** Appends the calls of addDocCrossReference() made on the calling thread to \a buffer instead of
+ *  applying them, passing a null pointer applies them again. Used by the source worker threads.
+ */
+void captureCrossReferences(CrossReferenceList *buffer);
+
+/** Applies cross references which were held back by captureCrossReferences(), in order */
+void applyCrossReferences(const CrossReferenceList &list);
+
+/** Returns a key which identifies \a def in the next run, empty for a null pointer */
+QString definitionKey(QSharedPointer<Definition> def);
+
+/** Returns the definition of a key returned by definitionKey(), null if it is unknown or ambiguous */
+QSharedPointer<Definition> findDefinitionByKey(const QString &key);
+
 uint getUtf8Code( const QString &s, int idx );
 uint getUtf8CodeToLower( const QString &s, int idx );
 uint getUtf8CodeToUpper( const QString &s, int idx );